@@ -295,8 +295,8 @@ extern "C"
     // Model loading functions.
     //
 
-#include "../GLUS/glus_shape_wavefront.h"
 #include "../GLUS/glus_wavefront.h"
+#include "../GLUS/glus_shape_wavefront.h"
 
     //
     // Logging
@@ -335,9 +335,15 @@ extern "C"
 #include "../GLUS/glus_image_tga.h"
 #include "../GLUS/glus_image_hdr.h"
 #include "../GLUS/glus_image_pkm.h"
+#include "../GLUS/glus_image_mipmap.h"
+#include "../GLUS/glus_image_etc.h"
+#include "../GLUS/glus_image_bc.h"
+#include "../GLUS/glus_image_dds.h"
+#include "../GLUS/glus_image_ktx.h"
 
 #include "../GLUS/glus_file_text.h"
 #include "../GLUS/glus_file_binary.h"
+#include "../GLUS/glus_file_map.h"
 
     //
     // IBL (Image-Based Lighting)
@@ -53,6 +53,9 @@
 #define GLUS_UNSIGNED_INT 0x1405
 #define GLUS_FLOAT 0x1406
 #define GLUS_DOUBLE 0x140A
+#define GLUS_HALF_FLOAT 0x140B
+#define GLUS_UNSIGNED_INT_10F_11F_11F_REV 0x8C3B
+#define GLUS_UNSIGNED_INT_5_9_9_9_REV 0x8C3E
 
 #define GLUS_VERSION 0x1F02
 #define GLUS_EXTENSIONS 0x1F03
@@ -64,6 +67,11 @@
 
 #define GLUS_FRAMEBUFFER 0x8D40
 
+#define GLUS_REPEAT 0x2901
+#define GLUS_CLAMP_TO_EDGE 0x812F
+#define GLUS_MIRRORED_REPEAT 0x8370
+
+#define GLUS_ETC1_RGB8_OES 0x8D64
 #define GLUS_COMPRESSED_R11_EAC 0x9270
 #define GLUS_COMPRESSED_SIGNED_R11_EAC 0x9271
 #define GLUS_COMPRESSED_RG11_EAC 0x9272
@@ -71,6 +79,12 @@
 #define GLUS_COMPRESSED_RGB8_ETC2 0x9274
 #define GLUS_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9276
 #define GLUS_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#define GLUS_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GLUS_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#define GLUS_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#define GLUS_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#define GLUS_COMPRESSED_RED_RGTC1 0x8DBB
+#define GLUS_COMPRESSED_RG_RGTC2 0x8DBD
 
 #define GLUS_PI 3.1415926535897932384626433832795f
 
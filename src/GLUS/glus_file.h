@@ -57,6 +57,50 @@ typedef struct _GLUSbinaryfile
 
 } GLUSbinaryfile;
 
+/**
+ * Structure used for read-only memory mapped file access.
+ */
+typedef struct _GLUSmappedfile
+{
+    /**
+     * Read-only view of the file content. Not null terminated.
+     */
+    const GLUSubyte* data;
+
+    /**
+     * The length of the file in bytes.
+     */
+    size_t length;
+
+    /**
+     * Platform specific mapping handle. Used internally.
+     */
+    GLUSvoid* handle;
+
+} GLUSmappedfile;
+
+/**
+ * Structure used for reading data through user supplied callbacks, e.g. from an archive or a decompressor.
+ */
+typedef struct _GLUSstream
+{
+    /**
+     * Reads up to size bytes into buffer and returns the number of bytes read. Returning 0 ends the stream.
+     */
+    size_t (*read)(GLUSvoid* userData, GLUSvoid* buffer, size_t size);
+
+    /**
+     * Passed unchanged to the read function.
+     */
+    GLUSvoid* userData;
+
+    /**
+     * Total length of the stream in bytes, if known. Otherwise 0. Used to allocate the read buffer at once.
+     */
+    size_t length;
+
+} GLUSstream;
+
 /**
  * Opens the file whose name is specified in the parameter filename and
  * associates it with a stream that can be identified in future operations by the FILE pointer returned.
@@ -58,6 +58,24 @@
  */
 #define GLUS_GLTF_ALPHA_BLEND 2
 
+/**
+ * Vertex layout: one buffer per attribute stream of a primitive. Missing
+ * normals, tangents and texture coordinates get zero-filled buffers.
+ */
+#define GLUS_GLTF_LAYOUT_SEPARATE 0
+
+/**
+ * Vertex layout: the attributes of a primitive are interleaved in one buffer,
+ * which also holds the indices. Missing attributes use constant values.
+ */
+#define GLUS_GLTF_LAYOUT_INTERLEAVED 1
+
+/**
+ * Vertex layout: the interleaved vertices and the indices of all primitives are
+ * suballocated from one buffer, GLUSgltfScene::sceneBuffer.
+ */
+#define GLUS_GLTF_LAYOUT_SCENE 2
+
 /**
  * Animation target path: node translation (vec3).
  */
@@ -111,6 +129,31 @@ typedef struct _GLUSgltfMaterial
     GLint   emissiveTexCoordSet;
 } GLUSgltfMaterial;
 
+/**
+ * GPU geometry of one primitive of a glTF mesh: the vertex, index and morph
+ * buffers plus the VAO. Nodes instancing the same mesh share the geometry, so
+ * it is uploaded once; the primitives carry copies of the GL names.
+ */
+typedef struct _GLUSgltfGeometry
+{
+    GLint  meshIndex;      /* index of the mesh in the parsed tree */
+    GLint  meshPrimitive;  /* index of the primitive within the mesh */
+    GLint  skinned;        /* GLUS_TRUE when the joint and weight streams are uploaded */
+    GLint  referenceCount; /* primitives using the geometry; deleted with the last one */
+    size_t byteSize;       /* bytes of all buffers of the geometry */
+} GLUSgltfGeometry;
+
+/**
+ * Geometry memory of a scene, see glusGltfGetGeometryStatistics().
+ */
+typedef struct _GLUSgltfGeometryStatistics
+{
+    GLint  primitiveCount; /* renderable primitives */
+    GLint  geometryCount;  /* uploaded geometries */
+    size_t uploadedBytes;  /* bytes of the uploaded buffers */
+    size_t unsharedBytes;  /* bytes, if every primitive had its own buffers */
+} GLUSgltfGeometryStatistics;
+
 /**
  * A single renderable primitive. The VAO binds attribute streams that match the
  * GLUS glTF PBR vertex shaders:
@@ -120,6 +163,13 @@ typedef struct _GLUSgltfMaterial
  *   location 3 = vec2 texCoord0
  *   location 4 = vec4 joints0  (skinned primitives only)
  *   location 5 = vec4 weights0 (skinned primitives only)
+ * The streams and indices keep the component type of their accessors, e.g.
+ * normalized unsigned bytes or 16 bit indices; only sparse accessors are
+ * expanded to float and 32 bit indices.
+ *
+ * With GLUS_GLTF_LAYOUT_SEPARATE each stream has its own vbo* buffer. With the
+ * interleaved layouts the streams are in vbo, starting at vertexOffset, and
+ * the vbo* names are 0; ibo is the same buffer as vbo.
  */
 typedef struct _GLUSgltfPrimitive
 {
@@ -134,6 +184,10 @@ typedef struct _GLUSgltfPrimitive
     GLuint  vboTexCoord1; /* 0 when TEXCOORD_1 is absent */
     GLuint  vboColor;     /* 0 when COLOR_0 is absent */
     GLuint  ibo;         /* 0 when non-indexed */
+    GLuint  vbo;          /* interleaved vertices, 0 with GLUS_GLTF_LAYOUT_SEPARATE */
+    GLsizei vertexStride; /* bytes per interleaved vertex */
+    GLintptr vertexOffset; /* byte offset of the first vertex in vbo */
+    GLintptr indexOffset;  /* byte offset of the first index in ibo */
     GLsizei vertexCount; /* used when ibo == 0 */
     GLsizei indexCount;  /* used when ibo != 0 */
     GLenum  indexType;   /* GL_UNSIGNED_INT, GL_UNSIGNED_SHORT, ... */
@@ -145,13 +199,15 @@ typedef struct _GLUSgltfPrimitive
     /* Transform linkage. */
     GLint   nodeIndex; /* owning node, -1 if none */
     GLint   skinIndex; /* -1 = not skinned, else index into GLUSgltfScene::skins */
+    GLint   geometryIndex; /* index into GLUSgltfScene::geometries */
 
     /* Static model + normal matrices; updated each frame for animated, non-skinned primitives. */
     GLfloat modelMatrix[16];
     GLfloat normalMatrix[9];
 
     /* Morph targets (core). Per-target deltas are packed into SSBOs and blended
-     * in the morph vertex shader; weights are animated each frame. */
+     * in the morph vertex shader; weights are animated each frame and belong to
+     * the primitive, the SSBOs to the shared geometry. */
     GLint    morphTargetCount;
     GLuint   morphPositionSSBO; /* 0 if the primitive has no morph targets */
     GLuint   morphNormalSSBO;   /* 0 if no normal deltas */
@@ -251,6 +307,10 @@ typedef struct _GLUSgltfCamera
 /**
  * Options for glusGltfLoadSceneWith(). Pass NULL to glusGltfLoadScene() for the
  * defaults shown below.
+ *
+ * Zero initialise the structure (memset or = {0}) before setting its members,
+ * so members added in later versions are 0 and keep their previous behaviour.
+ * An unknown vertexLayout falls back to GLUS_GLTF_LAYOUT_SEPARATE with a warning.
  */
 typedef struct _GLUSgltfLoadOptions
 {
@@ -265,6 +325,12 @@ typedef struct _GLUSgltfLoadOptions
      * glusGltfGetCgltfData(), but creates no mesh or texture GPU objects.
      */
     GLUSboolean uploadMeshes;
+    /**
+     * GLUS_GLTF_LAYOUT_SEPARATE (default), GLUS_GLTF_LAYOUT_INTERLEAVED or
+     * GLUS_GLTF_LAYOUT_SCENE. The interleaved layouts need fewer buffer binds
+     * and fetch all attributes of a vertex from one cache line.
+     */
+    GLUSenum    vertexLayout;
 } GLUSgltfLoadOptions;
 
 /**
@@ -284,6 +350,13 @@ typedef struct _GLUSgltfScene
     GLUSgltfPrimitive* primitives;
     GLint             primitiveCount;
 
+    /* Geometry shared by the primitives, one per mesh primitive (and skinning). */
+    GLUSgltfGeometry* geometries;
+    GLint            geometryCount;
+
+    /* Vertices and indices of all primitives with GLUS_GLTF_LAYOUT_SCENE, else 0. */
+    GLuint           sceneBuffer;
+
     GLUSgltfSkin*     skins;
     GLint            skinCount;
 
@@ -313,6 +386,25 @@ typedef struct _GLUSgltfScene
     GLUSchar* basePath;
 } GLUSgltfScene;
 
+/**
+ * State of a scene loaded with glusGltfLoadStart(). The fields are updated by
+ * glusGltfLoadPoll().
+ */
+typedef struct _GLUSgltfLoader
+{
+    /**
+     * GLUS_TRUE as soon as the nodes, skins, animations and cameras are built.
+     * From then on the scene can be animated and drawn while it is loading:
+     * primitiveCount grows with every uploaded primitive. The texture list and
+     * the bounds are written while loading and valid when it is finished.
+     */
+    GLUSboolean sceneReady;
+    GLint       primitiveTotal;  /* primitives of the scene, known with sceneReady */
+    GLint       imageTotal;      /* images of the materials, 0 until known */
+    GLint       imagesUploaded;
+    GLUSvoid*   handle;          /* internal state, do not modify */
+} GLUSgltfLoader;
+
 /**
  * Load a glTF 2.0 asset (.glb or .gltf) using default options. Equivalent to
  * glusGltfLoadSceneWith() with sceneIndex = -1 and sRGB colour textures.
@@ -335,6 +427,47 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadScene(const GLUSchar* filename, GLU
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadSceneWith(const GLUSchar* filename, const GLUSgltfLoadOptions* options, GLUSgltfScene* scene);
 
+/**
+ * Start loading a glTF 2.0 asset in the background. Parsing, building the
+ * node tables, decoding images and converting accessors run on a loading
+ * thread; the OpenGL objects are created by glusGltfLoadPoll() on the calling
+ * thread, which has to own the context. If no thread can be started, the scene
+ * is loaded before the function returns.
+ *
+ * @param filename Path to the .glb / .gltf file. Copied, so it can be released.
+ * @param options  Options, or NULL for defaults. Copied.
+ * @param scene    Scene to fill. Must stay valid and must not be destroyed until glusGltfLoadFinish().
+ * @param loader   Receives the loading state.
+ *
+ * @return GLUS_TRUE, if loading was started.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadStart(const GLUSchar* filename, const GLUSgltfLoadOptions* options, GLUSgltfScene* scene, GLUSgltfLoader* loader);
+
+/**
+ * Create the OpenGL objects prepared by the loading thread, e.g. once per
+ * frame. Textures and primitives are uploaded in order until one of the
+ * budgets is used up; at least one object is uploaded per call, if one is
+ * ready. With GLUS_GLTF_LAYOUT_SCENE the primitives become visible after the
+ * scene buffer has been uploaded completely.
+ *
+ * @param loader     The loading state.
+ * @param timeBudget Maximum time in seconds to spend, 0 for no limit.
+ * @param byteBudget Maximum number of bytes to upload, 0 for no limit.
+ *
+ * @return GLUS_TRUE, if loading is finished or failed. Then call glusGltfLoadFinish().
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadPoll(GLUSgltfLoader* loader, GLUSdouble timeBudget, size_t byteBudget);
+
+/**
+ * Complete loading without a budget, wait for the loading thread and free the
+ * loading state. Has to be called for every started load.
+ *
+ * @param loader The loading state.
+ *
+ * @return GLUS_TRUE, if the scene was loaded. Otherwise the scene is empty.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadFinish(GLUSgltfLoader* loader);
+
 /**
  * Free all GPU objects and host memory owned by a scene. Safe to call on a
  * zero-initialised scene.
@@ -402,6 +535,18 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusGltfUpdateTransforms(GLUSgltfScene* scene);
  */
 GLUSAPI GLUSvoid GLUSAPIENTRY glusGltfCameraMatrices(const GLUSgltfScene* scene, GLUSint cameraIndex, GLUSfloat viewportAspect, GLUSfloat viewOut[16], GLUSfloat projOut[16]);
 
+/**
+ * CPU-side accounting of the geometry memory of a scene. The sizes are those
+ * passed to glBufferData, so the saving of sharing mesh geometry between nodes
+ * can be checked without querying the GPU.
+ *
+ * @param scene      Loaded scene.
+ * @param statistics Receives the statistics.
+ *
+ * @return GLUS_TRUE on success.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfGetGeometryStatistics(const GLUSgltfScene* scene, GLUSgltfGeometryStatistics* statistics);
+
 /**
  * Extension hook: the parsed cgltf tree, kept alive until glusGltfDestroyScene.
  * Applications that need glTF extension data (e.g. KHR_gaussian_splatting)
@@ -23,6 +23,25 @@
 #ifndef GLUS_IMAGE_H_
 #define GLUS_IMAGE_H_
 
+/**
+ * Maximum number of mipmap levels, which is enough for an image of 65535 x 65535 pixels.
+ */
+#define GLUS_MAX_MIPMAP_LEVELS 16
+
+/**
+ * Mipmap filters. The box filter averages 2 x 2 texels, the Kaiser windowed sinc filter keeps the levels sharper.
+ */
+#define GLUS_MIPMAP_BOX 0
+#define GLUS_MIPMAP_KAISER 1
+
+/**
+ * Quality of the ETC1 encoder. Fast uses the average color of each sub block, normal also tries a darker and a brighter color,
+ * high searches all neighboring colors.
+ */
+#define GLUS_ETC1_FAST 0
+#define GLUS_ETC1_NORMAL 1
+#define GLUS_ETC1_HIGH 2
+
 /**
  * Structure used for Targa Image File loading.
  */
@@ -44,7 +63,7 @@ typedef struct _GLUStgaimage
     GLUSushort depth;
 
     /**
-     * Pixel data.
+     * Pixel data. Aligned to GLUS_MEMORY_DATA_ALIGNMENT, if allocated by GLUS.
      */
     GLUSubyte* data;
 
@@ -59,6 +78,12 @@ typedef struct _GLUStgaimage
      */
     GLUSenum format;
 
+    /**
+     * Set by GLUS to data, if GLUS allocated the pixel data aligned. Otherwise, e.g. for data allocated by hand with glusMemoryMalloc, it has to differ from data.
+     * glusImageDestroyTga frees the pixel data with glusMemoryFreeAligned, if both are equal, and with glusMemoryFree otherwise.
+     */
+    GLUSvoid* alignedData;
+
 } GLUStgaimage;
 
 /**
@@ -82,7 +107,8 @@ typedef struct _GLUShdrimage
     GLUSushort depth;
 
     /**
-     * Pixel data.
+     * Pixel data. Aligned to GLUS_MEMORY_DATA_ALIGNMENT, if allocated by GLUS.
+     * For other types than GLUS_FLOAT, the data has to be cast to GLUSushort* or GLUSuint*.
      */
     GLUSfloat* data;
 
@@ -91,6 +117,25 @@ typedef struct _GLUShdrimage
      */
     GLUSenum format;
 
+    /**
+     * Storage type of the pixel data, which can be passed to glTexImage2D. Can be:
+     *
+     * GLUS_FLOAT (GL_RGB32F)
+     * GLUS_HALF_FLOAT (GL_RGB16F)
+     * GLUS_UNSIGNED_INT_5_9_9_9_REV (GL_RGB9_E5, only GLUS_RGB)
+     * GLUS_UNSIGNED_INT_10F_11F_11F_REV (GL_R11F_G11F_B10F, only GLUS_RGB)
+     *
+     * Values exceeding the range of a type are clamped. The packed types clamp negative values to zero.
+     * 0, e.g. in a zero initialized structure filled by hand, is treated as GLUS_FLOAT.
+     */
+    GLUSenum type;
+
+    /**
+     * Set by GLUS to data, if GLUS allocated the pixel data aligned. Otherwise, e.g. for data allocated by hand with glusMemoryMalloc, it has to differ from data.
+     * glusImageDestroyHdr frees the pixel data with glusMemoryFreeAligned, if both are equal, and with glusMemoryFree otherwise.
+     */
+    GLUSvoid* alignedData;
+
 } GLUShdrimage;
 
 /**
@@ -130,4 +175,170 @@ typedef struct _GLUSpkmimage
 
 } GLUSpkmimage;
 
+/**
+ * Options for generating mipmaps. A zero initialized structure selects the default behavior.
+ */
+typedef struct _GLUSmipmapOptions
+{
+    /**
+     * GLUS_MIPMAP_BOX (default) or GLUS_MIPMAP_KAISER.
+     */
+    GLUSenum filter;
+
+    /**
+     * GLUS_TRUE, if the color channels of a TGA image are sRGB encoded. The texels are filtered in linear space.
+     */
+    GLUSboolean sRGB;
+
+    /**
+     * GLUS_FALSE (default), if the color of RGBA texels is not premultiplied. The color is weighted by alpha while filtering,
+     * so transparent texels do not bleed into the visible ones.
+     * GLUS_TRUE, if the color is premultiplied. All channels are filtered the same way.
+     */
+    GLUSboolean premultipliedAlpha;
+
+} GLUSmipmapOptions;
+
+/**
+ * Mipmap chain of a TGA image. All levels are stored in one allocation.
+ */
+typedef struct _GLUStgamipmaps
+{
+    /**
+     * Number of levels, including the base level.
+     */
+    GLUSint numberLevels;
+
+    /**
+     * The levels, starting with a copy of the base image. The data of each level is aligned to GLUS_MEMORY_DATA_ALIGNMENT.
+     */
+    GLUStgaimage levels[GLUS_MAX_MIPMAP_LEVELS];
+
+} GLUStgamipmaps;
+
+/**
+ * Mipmap chain of a HDR image. All levels are stored in one allocation.
+ */
+typedef struct _GLUShdrmipmaps
+{
+    /**
+     * Number of levels, including the base level.
+     */
+    GLUSint numberLevels;
+
+    /**
+     * The levels, starting with a copy of the base image. The data of each level is aligned to GLUS_MEMORY_DATA_ALIGNMENT.
+     */
+    GLUShdrimage levels[GLUS_MAX_MIPMAP_LEVELS];
+
+} GLUShdrmipmaps;
+
+/**
+ * Block compressed image (BC1, BC3, BC4 or BC5) with its mipmap levels. All levels are stored in one allocation.
+ */
+typedef struct _GLUSbcimage
+{
+    /**
+     * Width of the base level.
+     */
+    GLUSushort width;
+
+    /**
+     * Height of the base level.
+     */
+    GLUSushort height;
+
+    /**
+     * Number of levels, including the base level. Each level has half the width and height of the previous one, rounded down, but at least 1.
+     */
+    GLUSint numberLevels;
+
+    /**
+     * Compressed data of all levels, starting with the base level. The levels follow each other without padding.
+     */
+    GLUSubyte* data;
+
+    /**
+     * Size of all levels in bytes.
+     */
+    GLUSint imageSize;
+
+    /**
+     * Offset of each level in the data.
+     */
+    GLUSint levelOffsets[GLUS_MAX_MIPMAP_LEVELS];
+
+    /**
+     * Size of each level in bytes.
+     */
+    GLUSint levelSizes[GLUS_MAX_MIPMAP_LEVELS];
+
+    /**
+     * Internal format of the image. Can be:
+     *
+     * GLUS_COMPRESSED_RGB_S3TC_DXT1_EXT (BC1)
+     * GLUS_COMPRESSED_SRGB_S3TC_DXT1_EXT (BC1)
+     * GLUS_COMPRESSED_RGBA_S3TC_DXT5_EXT (BC3)
+     * GLUS_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT (BC3)
+     * GLUS_COMPRESSED_RED_RGTC1 (BC4)
+     * GLUS_COMPRESSED_RG_RGTC2 (BC5)
+     */
+    GLUSenum internalformat;
+
+} GLUSbcimage;
+
+/**
+ * Reader decoding rows of a TGA or HDR file on demand. Only a bounded cache of decoded row tiles is kept in memory.
+ */
+typedef struct _GLUSimagereader
+{
+    /**
+     * Width of the image.
+     */
+    GLUSint width;
+
+    /**
+     * Height of the image.
+     */
+    GLUSint height;
+
+    /**
+     * Format of the image, see GLUStgaimage and GLUShdrimage.
+     */
+    GLUSenum format;
+
+    /**
+     * Internal state. Do not modify.
+     */
+    GLUSvoid* handle;
+
+} GLUSimagereader;
+
+/**
+ * Writer encoding a TGA or HDR file row by row, without holding the image in memory.
+ */
+typedef struct _GLUSimagewriter
+{
+    /**
+     * Width of the image.
+     */
+    GLUSint width;
+
+    /**
+     * Height of the image.
+     */
+    GLUSint height;
+
+    /**
+     * Format of the image, see GLUStgaimage and GLUShdrimage.
+     */
+    GLUSenum format;
+
+    /**
+     * Internal state. Do not modify.
+     */
+    GLUSvoid* handle;
+
+} GLUSimagewriter;
+
 #endif /* GLUS_IMAGE_H_ */
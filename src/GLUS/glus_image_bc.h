@@ -0,0 +1,72 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GLUS_IMAGE_BC_H_
+#define GLUS_IMAGE_BC_H_
+
+/**
+ * Compresses a TGA image to BC1, BC3, BC4 or BC5 on the CPU, e.g. for baking desktop textures offline.
+ * BC1 and BC3 use the color, BC3 also the alpha channel. BC4 uses the red and BC5 the red and green channel.
+ * Luminance images are used as gray and images without alpha as opaque.
+ * Sizes, which are not a multiple of four, are padded by repeating the last row and column.
+ * Large images are encoded on several threads.
+ *
+ * @param bcimage			The structure to fill with the compressed image. Has to be destroyed with glusImageDestroyBc.
+ * @param tgaimage			The image to compress. Only images with a depth of 1 are supported.
+ * @param internalformat	One of the formats listed in GLUSbcimage.
+ *
+ * @return GLUS_TRUE, if encoding succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageEncodeBc(GLUSbcimage* bcimage, const GLUStgaimage* tgaimage, const GLUSenum internalformat);
+
+/**
+ * Compresses all levels of a TGA mipmap chain, e.g. as generated by glusImageGenerateMipmapsTga.
+ *
+ * @param bcimage			The structure to fill with the compressed levels. Has to be destroyed with glusImageDestroyBc.
+ * @param mipmaps			The mipmap chain to compress. Each level has to have half the size of the previous one.
+ * @param internalformat	One of the formats listed in GLUSbcimage.
+ *
+ * @return GLUS_TRUE, if encoding succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageEncodeBcMipmaps(GLUSbcimage* bcimage, const GLUStgamipmaps* mipmaps, const GLUSenum internalformat);
+
+/**
+ * Decodes one level of a block compressed image on the CPU.
+ * BC1 results in GLUS_RGB, BC3 in GLUS_RGBA and BC4 in GLUS_LUMINANCE images. BC5 results in a GLUS_RGB image with blue set to zero.
+ * Large images are decoded on several threads.
+ *
+ * @param tgaimage	The structure to fill with the decoded image. Has to be destroyed with glusImageDestroyTga.
+ * @param bcimage	The compressed image.
+ * @param level		The level to decode.
+ *
+ * @return GLUS_TRUE, if decoding succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageDecodeBc(GLUStgaimage* tgaimage, const GLUSbcimage* bcimage, const GLUSint level);
+
+/**
+ * Destroys the content of a block compressed image. Has to be called for freeing the resources.
+ *
+ * @param bcimage The block compressed image.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusImageDestroyBc(GLUSbcimage* bcimage);
+
+#endif /* GLUS_IMAGE_BC_H_ */
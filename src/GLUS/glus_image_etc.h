@@ -0,0 +1,52 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GLUS_IMAGE_ETC_H_
+#define GLUS_IMAGE_ETC_H_
+
+/**
+ * Decodes an ETC1, ETC2 or EAC compressed PKM image on the CPU, e.g. for validating compressed textures without a GPU.
+ * RGB formats result in GLUS_RGB, punch through alpha and RGBA8 in GLUS_RGBA and R11 in GLUS_LUMINANCE images.
+ * RG11 results in a GLUS_RGB image with blue set to zero. 11 bit values are rounded to 8 bit, signed values are mapped from [-1, 1] to [0, 255].
+ * Large images are decoded on several threads.
+ *
+ * @param tgaimage	The structure to fill with the decoded image. Has to be destroyed with glusImageDestroyTga.
+ * @param pkmimage	The compressed image.
+ *
+ * @return GLUS_TRUE, if decoding succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageDecodePkm(GLUStgaimage* tgaimage, const GLUSpkmimage* pkmimage);
+
+/**
+ * Compresses a TGA image to ETC1, which can also be used as GLUS_COMPRESSED_RGB8_ETC2. Alpha is ignored and single channel images are compressed as gray.
+ * Sizes, which are not a multiple of four, are padded by repeating the last row and column.
+ * Large images are encoded on several threads.
+ *
+ * @param pkmimage	The structure to fill with the compressed image. The internal format is GLUS_ETC1_RGB8_OES. Has to be destroyed with glusImageDestroyPkm.
+ * @param tgaimage	The image to compress.
+ * @param quality	GLUS_ETC1_FAST, GLUS_ETC1_NORMAL or GLUS_ETC1_HIGH.
+ *
+ * @return GLUS_TRUE, if encoding succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageEncodePkm(GLUSpkmimage* pkmimage, const GLUStgaimage* tgaimage, const GLUSenum quality);
+
+#endif /* GLUS_IMAGE_ETC_H_ */
@@ -24,7 +24,7 @@
 #define GLUS_IMAGE_HDR_H_
 
 /**
- * Creates a HDR image.
+ * Creates a HDR image with the storage type GLUS_FLOAT.
  *
  * @param hdrimage	The structure to fill the HDR data.
  * @param width 	Width of the image.
@@ -47,7 +47,64 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage* hdrimage, GLUS
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage* hdrimage);
 
 /**
- * Saves a HDR file.
+ * Loads a HDR file and stores the pixels with the given type. Half floats take half, the packed types a third of the memory
+ * and can be uploaded without another conversion.
+ *
+ * @param filename The name of the file to load.
+ * @param hdrimage The structure to fill the HDR data.
+ * @param type GLUS_FLOAT, GLUS_HALF_FLOAT, GLUS_UNSIGNED_INT_5_9_9_9_REV or GLUS_UNSIGNED_INT_10F_11F_11F_REV.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdrWithType(const GLUSchar* filename, GLUShdrimage* hdrimage, GLUSenum type);
+
+/**
+ * Loads a HDR image from memory, e.g. from an archive or a memory mapped asset bundle.
+ * The memory is only read during the call.
+ *
+ * @param data The HDR file content.
+ * @param size The size of the file content in bytes.
+ * @param hdrimage The structure to fill the HDR data.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromMemory(const GLUSubyte* data, size_t size, GLUShdrimage* hdrimage);
+
+/**
+ * Loads a HDR image from memory and stores the pixels with the given type, see glusImageLoadHdrWithType.
+ *
+ * @param data The HDR file content.
+ * @param size The size of the file content in bytes.
+ * @param hdrimage The structure to fill the HDR data.
+ * @param type The storage type of the pixels.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromMemoryWithType(const GLUSubyte* data, size_t size, GLUShdrimage* hdrimage, GLUSenum type);
+
+/**
+ * Loads a HDR image from a stream. The stream is read until its end.
+ *
+ * @param stream The stream providing the HDR file content.
+ * @param hdrimage The structure to fill the HDR data.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromStream(const GLUSstream* stream, GLUShdrimage* hdrimage);
+
+/**
+ * Loads a HDR image from a stream and stores the pixels with the given type, see glusImageLoadHdrWithType.
+ *
+ * @param stream The stream providing the HDR file content.
+ * @param hdrimage The structure to fill the HDR data.
+ * @param type The storage type of the pixels.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromStreamWithType(const GLUSstream* stream, GLUShdrimage* hdrimage, GLUSenum type);
+
+/**
+ * Saves a HDR file. Images of all storage types can be saved.
  *
  * @param filename The name of the file to save.
  * @param hdrimage The structure with the HDR data.
@@ -56,6 +113,83 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUS
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageSaveHdr(const GLUSchar* filename, const GLUShdrimage* hdrimage);
 
+/**
+ * Saves a HDR file with run length encoded scanlines. Images narrower than 8 or wider than 32767 pixels are saved uncompressed.
+ *
+ * @param filename The name of the file to save.
+ * @param hdrimage The structure with the HDR data.
+ *
+ * @return GLUS_TRUE, if saving succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageSaveHdrRle(const GLUSchar* filename, const GLUShdrimage* hdrimage);
+
+/**
+ * Opens a HDR file for reading rows on demand. Rows are decoded in tiles of several rows, which are kept in a cache of bounded size,
+ * so images larger than the memory can be processed. New RLE scanlines have to start at the beginning of a row, as written by all common encoders.
+ *
+ * @param filename The name of the file to read.
+ * @param reader The reader structure, providing the size and the format of the image.
+ * @param cacheSize Maximum size of the decoded tiles in bytes. At least two tiles are kept. Pass 0 for a default of 32 MB.
+ *
+ * @return GLUS_TRUE, if opening succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageOpenHdrReader(const GLUSchar* filename, GLUSimagereader* reader, size_t cacheSize);
+
+/**
+ * Reads consecutive rows of a HDR image as RGB. Rows are in the same order as from glusImageLoadHdr, so row 0 is the last one in the file.
+ * Rows can be read in any order, but reading them in descending order avoids decoding a tile twice.
+ *
+ * @param reader The reader structure.
+ * @param rows Receives the rows. Has to hold numberRows * width * 3 values.
+ * @param firstRow The first row to read.
+ * @param numberRows The number of rows to read.
+ *
+ * @return GLUS_TRUE, if reading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageReadHdrRows(GLUSimagereader* reader, GLUSfloat* rows, GLUSint firstRow, GLUSint numberRows);
+
+/**
+ * Closes a HDR reader and frees its resources.
+ *
+ * @param reader The reader structure.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusImageCloseHdrReader(GLUSimagereader* reader);
+
+/**
+ * Opens a HDR file for writing RGB rows. Only one scanline is held in memory.
+ *
+ * @param filename The name of the file to save.
+ * @param writer The writer structure.
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param compress GLUS_TRUE, if the scanlines are run length encoded, see glusImageSaveHdrRle.
+ *
+ * @return GLUS_TRUE, if opening succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageOpenHdrWriter(const GLUSchar* filename, GLUSimagewriter* writer, GLUSint width, GLUSint height, GLUSboolean compress);
+
+/**
+ * Writes consecutive RGB rows of a HDR image. As the file starts with the top row, the blocks of rows have to be written from the top to the bottom:
+ * the first call writes the rows ending with row height - 1, the last call the rows starting with row 0.
+ *
+ * @param writer The writer structure.
+ * @param rows The rows to write, in the same order as in a GLUShdrimage.
+ * @param firstRow The first row to write. firstRow + numberRows has to be the number of rows not written so far.
+ * @param numberRows The number of rows to write.
+ *
+ * @return GLUS_TRUE, if writing succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageWriteHdrRows(GLUSimagewriter* writer, const GLUSfloat* rows, GLUSint firstRow, GLUSint numberRows);
+
+/**
+ * Closes a HDR writer and frees its resources.
+ *
+ * @param writer The writer structure.
+ *
+ * @return GLUS_TRUE, if all rows have been written and the file was closed successfully.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageCloseHdrWriter(GLUSimagewriter* writer);
+
 /**
  * Destroys the content of a HDR structure. Has to be called for freeing the resources.
  *
@@ -75,4 +209,32 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusImageDestroyHdr(GLUShdrimage* hdrimage);
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageSampleHdr2D(GLUSfloat rgb[3], const GLUShdrimage* hdrimage, const GLUSfloat st[2]);
 
+/**
+ * Samples many color values from a HDR 2D image at once.
+ * Sampling uses a bilinear filter. Several samples are processed together with vector instructions, if available.
+ * With GLUS_CLAMP_TO_EDGE, the result is the same as from glusImageSampleHdr2D.
+ *
+ * @param rgb 			The resulting, sampled color values. Each sample has as many values as a texel of the image,
+ * 						so it has to hold 1, 3 or 4 * numberSamples values.
+ * @param hdrimage 		The HDR image structure, containing the 2D texel data.
+ * @param st			Texture coordinates, where to sample the 2D texture. Has to hold 2 * numberSamples values.
+ * @param numberSamples	Number of samples.
+ * @param wrapS			Wrap mode of the s coordinate: GLUS_CLAMP_TO_EDGE, GLUS_REPEAT or GLUS_MIRRORED_REPEAT.
+ * @param wrapT			Wrap mode of the t coordinate.
+ *
+ * @return GLUS_TRUE, if sampling succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageSampleHdr2DBatch(GLUSfloat* rgb, const GLUShdrimage* hdrimage, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT);
+
+/**
+ * Converts a HDR image to another storage type. Source and target can not be the same.
+ *
+ * @param targetImage The HDR image structure, containing the converted image.
+ * @param sourceImage The HDR image structure, which will be converted.
+ * @param targetType  The storage type of the target image, see GLUShdrimage.
+ *
+ * @return GLUS_TRUE, if conversion succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageConvertHdr(GLUShdrimage* targetImage, const GLUShdrimage* sourceImage, const GLUSenum targetType);
+
 #endif /* GLUS_IMAGE_HDR_H_ */
@@ -0,0 +1,64 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GLUS_IMAGE_MIPMAP_H_
+#define GLUS_IMAGE_MIPMAP_H_
+
+/**
+ * Generates the full mipmap chain of a TGA image, e.g. for offline baking or for uploading all levels with glTexImage2D.
+ * Each level has half the width and height of the previous one, rounded down, until both are 1.
+ *
+ * @param mipmaps	The structure to fill with the levels.
+ * @param tgaimage	The base image. Only images with a depth of 1 are supported.
+ * @param options	The filter options. If NULL, the defaults are used.
+ *
+ * @return GLUS_TRUE, if generating succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageGenerateMipmapsTga(GLUStgamipmaps* mipmaps, const GLUStgaimage* tgaimage, const GLUSmipmapOptions* options);
+
+/**
+ * Destroys the content of a TGA mipmap chain. Has to be called for freeing the resources.
+ *
+ * @param mipmaps The TGA mipmap chain.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusImageDestroyMipmapsTga(GLUStgamipmaps* mipmaps);
+
+/**
+ * Generates the full mipmap chain of a HDR image. Negative values, e.g. from the ringing of the Kaiser filter, are clamped to zero.
+ * The sRGB option is ignored, as HDR images are linear. Images of all storage types are filtered as float and the levels have the type GLUS_FLOAT.
+ *
+ * @param mipmaps	The structure to fill with the levels.
+ * @param hdrimage	The base image. Only images with a depth of 1 are supported.
+ * @param options	The filter options. If NULL, the defaults are used.
+ *
+ * @return GLUS_TRUE, if generating succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageGenerateMipmapsHdr(GLUShdrmipmaps* mipmaps, const GLUShdrimage* hdrimage, const GLUSmipmapOptions* options);
+
+/**
+ * Destroys the content of a HDR mipmap chain. Has to be called for freeing the resources.
+ *
+ * @param mipmaps The HDR mipmap chain.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusImageDestroyMipmapsHdr(GLUShdrmipmaps* mipmaps);
+
+#endif /* GLUS_IMAGE_MIPMAP_H_ */
@@ -33,6 +33,38 @@
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar* filename, GLUSpkmimage* pkmimage);
 
+/**
+ * Loads a PKM image from memory, e.g. from an archive or a memory mapped asset bundle.
+ * The memory is only read during the call.
+ *
+ * @param data The PKM file content.
+ * @param size The size of the file content in bytes.
+ * @param pkmimage The structure to fill the PKM data.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadPkmFromMemory(const GLUSubyte* data, size_t size, GLUSpkmimage* pkmimage);
+
+/**
+ * Loads a PKM image from a stream. The stream is read until its end.
+ *
+ * @param stream The stream providing the PKM file content.
+ * @param pkmimage The structure to fill the PKM data.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadPkmFromStream(const GLUSstream* stream, GLUSpkmimage* pkmimage);
+
+/**
+ * Saves a PKM image. ETC1 images are saved as version 1.0, all other formats as version 2.0.
+ *
+ * @param filename The name of the file to save.
+ * @param pkmimage The structure with the PKM data.
+ *
+ * @return GLUS_TRUE, if saving succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageSavePkm(const GLUSchar* filename, const GLUSpkmimage* pkmimage);
+
 /**
  * Destroys the content of a PKM structure. Has to be called for freeing the resources.
  *
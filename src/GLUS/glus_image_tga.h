@@ -46,6 +46,28 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusImageCreateTga(GLUStgaimage* tgaimage, GLUS
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage* tgaimage);
 
+/**
+ * Loads a TGA image from memory, e.g. from an archive or a memory mapped asset bundle.
+ * The memory is only read during the call.
+ *
+ * @param data The TGA file content.
+ * @param size The size of the file content in bytes.
+ * @param tgaimage The structure to fill the TGA data.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadTgaFromMemory(const GLUSubyte* data, size_t size, GLUStgaimage* tgaimage);
+
+/**
+ * Loads a TGA image from a stream. The stream is read until its end.
+ *
+ * @param stream The stream providing the TGA file content.
+ * @param tgaimage The structure to fill the TGA data.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadTgaFromStream(const GLUSstream* stream, GLUStgaimage* tgaimage);
+
 /**
  * Saves a TGA file.
  *
@@ -56,6 +78,83 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUS
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageSaveTga(const GLUSchar* filename, const GLUStgaimage* tgaimage);
 
+/**
+ * Saves a run length encoded TGA file. Rows of equal pixels, e.g. in screenshots or masks, take only a fraction of the space.
+ *
+ * @param filename The name of the file to save.
+ * @param tgaimage The structure with the TGA data.
+ *
+ * @return GLUS_TRUE, if saving succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageSaveTgaRle(const GLUSchar* filename, const GLUStgaimage* tgaimage);
+
+/**
+ * Opens a TGA file for reading rows on demand. Rows are decoded in tiles of several rows, which are kept in a cache of bounded size,
+ * so images larger than the memory can be processed. Color mapped images are not supported.
+ *
+ * @param filename The name of the file to read.
+ * @param reader The reader structure, providing the size and the format of the image.
+ * @param cacheSize Maximum size of the decoded tiles in bytes. At least two tiles are kept. Pass 0 for a default of 32 MB.
+ *
+ * @return GLUS_TRUE, if opening succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageOpenTgaReader(const GLUSchar* filename, GLUSimagereader* reader, size_t cacheSize);
+
+/**
+ * Reads consecutive rows of a TGA image. Rows are in the same order and format as from glusImageLoadTga.
+ * Rows can be read in any order, but reading them in ascending order avoids decoding a tile twice.
+ *
+ * @param reader The reader structure.
+ * @param rows Receives the rows. Has to hold numberRows * width pixels.
+ * @param firstRow The first row to read.
+ * @param numberRows The number of rows to read.
+ *
+ * @return GLUS_TRUE, if reading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageReadTgaRows(GLUSimagereader* reader, GLUSubyte* rows, GLUSint firstRow, GLUSint numberRows);
+
+/**
+ * Closes a TGA reader and frees its resources.
+ *
+ * @param reader The reader structure.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusImageCloseTgaReader(GLUSimagereader* reader);
+
+/**
+ * Opens a TGA file for writing rows one after another. Only one row is held in memory.
+ *
+ * @param filename The name of the file to save.
+ * @param writer The writer structure.
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param format The format of the image: GLUS_RGB, GLUS_RGBA, GLUS_LUMINANCE, GLUS_ALPHA or GLUS_RED.
+ * @param compress GLUS_TRUE, if the rows are run length encoded, see glusImageSaveTgaRle.
+ *
+ * @return GLUS_TRUE, if opening succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageOpenTgaWriter(const GLUSchar* filename, GLUSimagewriter* writer, GLUSint width, GLUSint height, GLUSenum format, GLUSboolean compress);
+
+/**
+ * Writes consecutive rows of a TGA image. Rows have to be written in ascending order, starting with row 0.
+ *
+ * @param writer The writer structure.
+ * @param rows The rows to write.
+ * @param firstRow The first row to write. Has to be the number of rows written so far.
+ * @param numberRows The number of rows to write.
+ *
+ * @return GLUS_TRUE, if writing succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageWriteTgaRows(GLUSimagewriter* writer, const GLUSubyte* rows, GLUSint firstRow, GLUSint numberRows);
+
+/**
+ * Closes a TGA writer and frees its resources.
+ *
+ * @param writer The writer structure.
+ *
+ * @return GLUS_TRUE, if all rows have been written and the file was closed successfully.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageCloseTgaWriter(GLUSimagewriter* writer);
+
 /**
  * Destroys the content of a TGA structure. Has to be called for freeing the resources.
  *
@@ -75,6 +174,22 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusImageDestroyTga(GLUStgaimage* tgaimage);
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusImageSampleTga2D(GLUSubyte rgba[4], const GLUStgaimage* tgaimage, const GLUSfloat st[2]);
 
+/**
+ * Samples many RGBA color values from a TGA 2D image at once.
+ * Sampling uses a bilinear filter. Several samples are processed together with vector instructions, if available.
+ * With GLUS_CLAMP_TO_EDGE, the result is the same as from glusImageSampleTga2D.
+ *
+ * @param rgba 			The resulting, sampled RGBA color values. Has to hold 4 * numberSamples values.
+ * @param tgaimage 		The TGA image structure, containing the 2D texel data.
+ * @param st			Texture coordinates, where to sample the 2D texture. Has to hold 2 * numberSamples values.
+ * @param numberSamples	Number of samples.
+ * @param wrapS			Wrap mode of the s coordinate: GLUS_CLAMP_TO_EDGE, GLUS_REPEAT or GLUS_MIRRORED_REPEAT.
+ * @param wrapT			Wrap mode of the t coordinate.
+ *
+ * @return GLUS_TRUE, if sampling succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageSampleTga2DBatch(GLUSubyte* rgba, const GLUStgaimage* tgaimage, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT);
+
 /**
  * Converts a TGA image into another color format.
  * Source and target can not be the same.
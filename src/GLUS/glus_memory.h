@@ -23,6 +23,85 @@
 #ifndef GLUS_MEMORY_H_
 #define GLUS_MEMORY_H_
 
+/**
+ * Alignment of image data, shape attribute arrays and raytrace buffers. Matches a cache line and the widest SIMD registers.
+ */
+#define GLUS_MEMORY_DATA_ALIGNMENT 64
+
+/**
+ * Alignment of memory returned by an arena. Every allocation occupies its size rounded up to this value.
+ */
+#define GLUS_MEMORY_ARENA_ALIGNMENT 16
+
+/**
+ * Default size of an arena block in bytes.
+ */
+#define GLUS_MEMORY_ARENA_BLOCK_SIZE 65536
+
+/**
+ * Number of entries in the allocation size histogram.
+ */
+#define GLUS_MEMORY_HISTOGRAM_SIZE 32
+
+/**
+ * Allocation statistics. Only gathered, if GLUS is built with GLUS_MEMORY_STATISTICS.
+ */
+typedef struct _GLUSmemorystatistics
+{
+    /**
+     * Bytes currently allocated.
+     */
+    size_t liveBytes;
+
+    /**
+     * Highest number of bytes allocated at the same time.
+     */
+    size_t peakBytes;
+
+    /**
+     * Number of current allocations.
+     */
+    size_t liveAllocations;
+
+    /**
+     * Number of all allocations so far.
+     */
+    size_t totalAllocations;
+
+    /**
+     * Number of all allocations by size. Entry i counts the sizes from 2^i to 2^(i+1) - 1. Entry 0 also counts zero sized allocations and the last entry all larger ones.
+     */
+    size_t histogram[GLUS_MEMORY_HISTOGRAM_SIZE];
+
+} GLUSmemorystatistics;
+
+/**
+ * Arena for short living allocations. Memory is taken from large blocks by incrementing a pointer and is released all at once.
+ */
+typedef struct _GLUSmemoryArena
+{
+    /**
+     * Chain of the allocated blocks, starting with the current one. Used internally.
+     */
+    GLUSvoid* blocks;
+
+    /**
+     * Next free byte in the current block.
+     */
+    GLUSubyte* current;
+
+    /**
+     * End of the current block.
+     */
+    GLUSubyte* end;
+
+    /**
+     * Size of a new block in bytes.
+     */
+    size_t blockSize;
+
+} GLUSmemoryArena;
+
 /**
  * Allocate memory block.
  *
@@ -39,4 +118,120 @@ GLUSAPI void* GLUSAPIENTRY glusMemoryMalloc(size_t size);
  */
 GLUSAPI void GLUSAPIENTRY glusMemoryFree(void* pointer);
 
+/**
+ * Allocate aligned memory block.
+ *
+ * @param size Size of the memory block in bytes.
+ * @param alignment Alignment of the memory block in bytes. Has to be a power of two.
+ *
+ * @return Returns on success the pointer to allocated memory. Otherwise null is returned.
+ */
+GLUSAPI GLUSvoid* GLUSAPIENTRY glusMemoryMallocAligned(size_t size, size_t alignment);
+
+/**
+ * Deallocate aligned memory block.
+ *
+ * @param pointer Pointer to a memory block previously allocated with glusMemoryMallocAligned.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusMemoryFreeAligned(GLUSvoid* pointer);
+
+/**
+ * Begins an arena. No memory is allocated until the first allocation.
+ *
+ * @param arena The arena to initialize.
+ * @param blockSize Size of a memory block in bytes. If all allocations of the arena fit into one block, only one memory block is allocated.
+ *                  If 0, GLUS_MEMORY_ARENA_BLOCK_SIZE is used.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusMemoryArenaBegin(GLUSmemoryArena* arena, size_t blockSize);
+
+/**
+ * Allocates memory from an arena. The memory is aligned to GLUS_MEMORY_ARENA_ALIGNMENT and can not be freed individually.
+ *
+ * @param arena The arena to allocate from.
+ * @param size Size of the memory in bytes.
+ *
+ * @return Returns on success the pointer to allocated memory. Otherwise null is returned.
+ */
+GLUSAPI GLUSvoid* GLUSAPIENTRY glusMemoryArenaAlloc(GLUSmemoryArena* arena, size_t size);
+
+/**
+ * Releases all allocations of an arena, but keeps the arena for further allocations.
+ * If more than one block was needed, the blocks are freed and the next block is as large as all of them together.
+ * So repeated use of the arena settles on a single block.
+ *
+ * @param arena The arena to reset.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusMemoryArenaReset(GLUSmemoryArena* arena);
+
+/**
+ * Ends an arena and frees all its memory.
+ *
+ * @param arena The arena to end.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusMemoryArenaEnd(GLUSmemoryArena* arena);
+
+/**
+ * Allocate memory block and account it to the given tag.
+ * If GLUS is built with GLUS_MEMORY_STATISTICS, glusMemoryMalloc is redirected to this function using the source file and line as tag.
+ *
+ * @param size Size of the memory block in bytes.
+ * @param tag Name the allocation is accounted to, e.g. a source file. The string has to stay valid as long as the program is running.
+ * @param line Line number, which is printed in the leak report.
+ *
+ * @return Returns on success the pointer to allocated memory. Otherwise null is returned.
+ */
+GLUSAPI GLUSvoid* GLUSAPIENTRY glusMemoryMallocTagged(size_t size, const GLUSchar* tag, const GLUSint line);
+
+/**
+ * Allocate aligned memory block and account it to the given tag.
+ * If GLUS is built with GLUS_MEMORY_STATISTICS, glusMemoryMallocAligned is redirected to this function using the source file and line as tag.
+ *
+ * @param size Size of the memory block in bytes.
+ * @param alignment Alignment of the memory block in bytes. Has to be a power of two.
+ * @param tag Name the allocation is accounted to, e.g. a source file. The string has to stay valid as long as the program is running.
+ * @param line Line number, which is printed in the leak report.
+ *
+ * @return Returns on success the pointer to allocated memory. Otherwise null is returned.
+ */
+GLUSAPI GLUSvoid* GLUSAPIENTRY glusMemoryMallocAlignedTagged(size_t size, size_t alignment, const GLUSchar* tag, const GLUSint line);
+
+/**
+ * Gets the statistics of all allocations.
+ *
+ * @param statistics The statistics are stored into this structure.
+ *
+ * @return GLUS_TRUE, if GLUS is built with GLUS_MEMORY_STATISTICS. Otherwise the structure is set to zero.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMemoryGetStatistics(GLUSmemorystatistics* statistics);
+
+/**
+ * Gets the number of different tags allocations have been accounted to.
+ *
+ * @return The number of tags.
+ */
+GLUSAPI GLUSuint GLUSAPIENTRY glusMemoryGetNumberTags(GLUSvoid);
+
+/**
+ * Gets the statistics of the allocations accounted to one tag.
+ *
+ * @param index Index of the tag, smaller than glusMemoryGetNumberTags().
+ * @param tag The name of the tag is stored here.
+ * @param statistics The statistics are stored into this structure.
+ *
+ * @return GLUS_TRUE, if the tag exists.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMemoryGetTagStatistics(const GLUSuint index, const GLUSchar** tag, GLUSmemorystatistics* statistics);
+
+/**
+ * Prints all allocations, which have not been freed, to the log. Is executed at program exit, if GLUS is built with GLUS_MEMORY_STATISTICS.
+ *
+ * @return The number of allocations, which have not been freed.
+ */
+GLUSAPI GLUSuint GLUSAPIENTRY glusMemoryReportLeaks(GLUSvoid);
+
+#if defined(GLUS_MEMORY_STATISTICS)
+#define glusMemoryMalloc(size) glusMemoryMallocTagged(size, __FILE__, __LINE__)
+#define glusMemoryMallocAligned(size, alignment) glusMemoryMallocAlignedTagged(size, alignment, __FILE__, __LINE__)
+#endif
+
 #endif /* GLUS_MEMORY_H_ */
@@ -23,6 +23,24 @@
 #ifndef GLUS_RAYTRACE_H_
 #define GLUS_RAYTRACE_H_
 
+/**
+ * Creates a buffer for ray tracing, e.g. a position or direction buffer. The buffer is aligned to GLUS_MEMORY_DATA_ALIGNMENT.
+ *
+ * @param numberComponents	Number of floats per pixel, e.g. 4 for positions or 3 plus padding for directions.
+ * @param width				Width of the buffer.
+ * @param height			Height of the buffer.
+ *
+ * @return The buffer or 0, if the creation failed. The buffer has to be released with glusRaytraceDestroyBufferf.
+ */
+GLUSAPI GLUSfloat* GLUSAPIENTRY glusRaytraceCreateBufferf(const GLUSint numberComponents, const GLUSint width, const GLUSint height);
+
+/**
+ * Destroys a buffer created by glusRaytraceCreateBufferf.
+ *
+ * @param buffer	The buffer to destroy.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusRaytraceDestroyBufferf(GLUSfloat* buffer);
+
 /**
  * Creates normals in a buffer for ray traced perspective projection. Directions are pointing to -Z direction.
  *
@@ -54,7 +54,7 @@ typedef struct _GLUSshape
     GLUSfloat* texCoords;
 
     /**
-     * All above values in one array. Not created by the model loader.
+     * All above values in one array. Not created by the model loader. Aligned to GLUS_MEMORY_DATA_ALIGNMENT, if allocated by GLUS.
      */
     GLUSfloat* allAttributes;
 
@@ -81,6 +81,12 @@ typedef struct _GLUSshape
      */
     GLUSenum mode;
 
+    /**
+     * Set by GLUS to allAttributes, if GLUS allocated the array aligned. Otherwise, e.g. for an array allocated by hand with glusMemoryMalloc, it has to differ from allAttributes.
+     * glusShapeDestroyf frees allAttributes with glusMemoryFreeAligned, if both are equal, and with glusMemoryFree otherwise.
+     */
+    GLUSvoid* alignedAttributes;
+
 } GLUSshape;
 
 /**
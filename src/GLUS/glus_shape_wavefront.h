@@ -33,4 +33,15 @@
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeLoadWavefront(const GLUSchar* filename, GLUSshape* shape);
 
+/**
+ * Loads a wavefront object file using the given options.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param options The load options. If NULL, the defaults are used.
+ * @param shape The data is stored into this structure.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeLoadWavefrontWith(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSshape* shape);
+
 #endif /* GLUS_SHAPE_WAVEFRONT_H_ */
@@ -330,6 +330,35 @@ typedef struct _GLUSscene
 
 } GLUSscene;
 
+/**
+ * Options for loading a wavefront file. A zero initialized structure selects the default behavior.
+ */
+typedef struct _GLUSwavefrontLoadOptions
+{
+    /**
+     * GLUS_FALSE (default) welds identical vertex, normal and texture coordinate combinations into one vertex
+     * and references them through the indices.
+     * GLUS_TRUE keeps one vertex per triangle corner, as done by previous versions.
+     */
+    GLUSboolean expandVertices;
+
+    /**
+     * 0 or 1 (default) parses the file on the calling thread.
+     * Larger values split the file at line boundaries into chunks, which are parsed by up to this number of threads.
+     * The result is identical to the single threaded parsing.
+     * If GLUS is built with the static heap allocator, the chunks are parsed on the calling thread.
+     */
+    GLUSuint numberThreads;
+
+    /**
+     * GLUS_TRUE stores the loaded data in a binary cache file next to the source file, named like the source file plus ".cache".
+     * Following loads take the data from the cache, as long as size and modification time of the source file and of its material files do not change.
+     * Used by glusWavefrontLoadWith and glusWavefrontLoadSceneWith. Files with more than 16 material libraries are not cached.
+     */
+    GLUSboolean useCache;
+
+} GLUSwavefrontLoadOptions;
+
 /**
  * Loads a wavefront object file with groups and materials.
  *
@@ -340,6 +369,17 @@ typedef struct _GLUSscene
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoad(const GLUSchar* filename, GLUSwavefront* wavefront);
 
+/**
+ * Loads a wavefront object file with groups and materials using the given options.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param options The load options. If NULL, the defaults are used.
+ * @param wavefront The data is stored into this structure.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoadWith(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSwavefront* wavefront);
+
 /**
  * Destroys the wavefront structure by freeing the allocated memory. VBOs, VAOs and textures are not freed.
  *
@@ -357,6 +397,17 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusWavefrontDestroy(GLUSwavefront* wavefront);
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoadScene(const GLUSchar* filename, GLUSscene* scene);
 
+/**
+ * Loads a wavefront scene file with objects, groups and materials using the given options.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param options The load options. If NULL, the defaults are used.
+ * @param scene The data is stored into this structure.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoadSceneWith(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSscene* scene);
+
 /**
  * Destroys the wavefront structure by freeing the allocated memory. VBOs, VAOs and textures are not freed.
  *
@@ -364,4 +415,13 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoadScene(const GLUSchar* filename
  */
 GLUSAPI GLUSvoid GLUSAPIENTRY glusWavefrontDestroyScene(GLUSscene* scene);
 
+/**
+ * Returns the peak amount of temporary memory, which was needed while parsing the last wavefront file.
+ * This covers glusWavefrontLoad, glusWavefrontLoadScene, glusShapeLoadWavefront and glusLineLoadWavefront.
+ * The returned memory does not include the memory of the loaded data.
+ *
+ * @return The peak temporary memory in bytes.
+ */
+GLUSAPI size_t GLUSAPIENTRY glusWavefrontGetPeakScratchMemory(GLUSvoid);
+
 #endif /* GLUS_WAVEFRONT_H_ */
@@ -22,6 +22,11 @@
 
 #include "GL/glus.h"
 
+/**
+ * Initial read buffer size for streams of unknown length.
+ */
+#define GLUS_FILE_STREAM_CHUNK 65536
+
 GLUSboolean _glusFileCheckRead(FILE* f, size_t actualRead, size_t expectedRead)
 {
     if (!f)
@@ -59,6 +64,80 @@ GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrit
     return GLUS_TRUE;
 }
 
+GLUSboolean _glusFileReadStream(const GLUSstream* stream, GLUSubyte** data, size_t* length)
+{
+    GLUSubyte* buffer = 0;
+    GLUSubyte* grownBuffer;
+
+    size_t capacity  = 0;
+    size_t used      = 0;
+    size_t bytesRead = 1;
+
+    if (!stream || !stream->read || !data || !length)
+    {
+        return GLUS_FALSE;
+    }
+
+    *data   = 0;
+    *length = 0;
+
+    // Read until the stream ends. With a known length, the buffer is only grown to detect the end.
+    while (bytesRead)
+    {
+        if (used == capacity)
+        {
+            if (!capacity)
+            {
+                capacity = stream->length ? stream->length + 1 : GLUS_FILE_STREAM_CHUNK;
+            }
+            else if (capacity <= ((size_t)-1) / 2)
+            {
+                capacity *= 2;
+            }
+            else
+            {
+                glusMemoryFree(buffer);
+
+                return GLUS_FALSE;
+            }
+
+            grownBuffer = (GLUSubyte*)glusMemoryMalloc(capacity);
+
+            if (!grownBuffer)
+            {
+                glusMemoryFree(buffer);
+
+                return GLUS_FALSE;
+            }
+
+            if (buffer)
+            {
+                memcpy(grownBuffer, buffer, used);
+
+                glusMemoryFree(buffer);
+            }
+
+            buffer = grownBuffer;
+        }
+
+        bytesRead = stream->read(stream->userData, buffer + used, capacity - used);
+
+        if (bytesRead > capacity - used)
+        {
+            glusMemoryFree(buffer);
+
+            return GLUS_FALSE;
+        }
+
+        used += bytesRead;
+    }
+
+    *data   = buffer;
+    *length = used;
+
+    return GLUS_TRUE;
+}
+
 FILE* GLUSAPIENTRY glusFileOpen(const char* filename, const char* mode)
 {
     char buffer[GLUS_MAX_FILENAME];
@@ -0,0 +1,387 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(_WIN32)
+
+#define WIN32_LEAN_AND_MEAN
+
+#include <windows.h>
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define GLUS_FILE_MAP_POSIX
+
+#endif
+
+#include "GL/glus.h"
+
+extern GLUSboolean _glusFileCheckRead(FILE* f, size_t actualRead, size_t expectedRead);
+
+#if defined(_WIN32) || defined(GLUS_FILE_MAP_POSIX)
+
+static GLUSboolean glusFileMapBuildFilename(const GLUSchar* filename, GLUSchar* buffer)
+{
+    if (strlen(filename) + strlen(GLUS_BASE_DIRECTORY) >= GLUS_MAX_FILENAME)
+    {
+        return GLUS_FALSE;
+    }
+
+    strcpy(buffer, GLUS_BASE_DIRECTORY);
+    strcat(buffer, filename);
+
+    return GLUS_TRUE;
+}
+
+#endif
+
+#if defined(_WIN32)
+
+GLUSboolean GLUSAPIENTRY glusFileMap(const GLUSchar* filename, GLUSmappedfile* mappedfile)
+{
+    GLUSchar buffer[GLUS_MAX_FILENAME];
+
+    HANDLE        file;
+    HANDLE        mapping;
+    LARGE_INTEGER size;
+
+    if (!filename || !mappedfile)
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(mappedfile, 0, sizeof(GLUSmappedfile));
+
+    if (!glusFileMapBuildFilename(filename, buffer))
+    {
+        return GLUS_FALSE;
+    }
+
+    file = CreateFileA(buffer, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!GetFileSizeEx(file, &size) || (GLUSuint64)size.QuadPart > (GLUSuint64)((size_t)-1))
+    {
+        CloseHandle(file);
+
+        return GLUS_FALSE;
+    }
+
+    // Empty files can not be mapped, but are valid.
+    if (size.QuadPart == 0)
+    {
+        CloseHandle(file);
+
+        return GLUS_TRUE;
+    }
+
+    mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+
+    // The mapping keeps the file open.
+    CloseHandle(file);
+
+    if (!mapping)
+    {
+        return GLUS_FALSE;
+    }
+
+    mappedfile->data = (const GLUSubyte*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (!mappedfile->data)
+    {
+        CloseHandle(mapping);
+
+        return GLUS_FALSE;
+    }
+
+    mappedfile->length = (size_t)size.QuadPart;
+    mappedfile->handle = (GLUSvoid*)mapping;
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Retrieves the size and the last modification time of a file. Used to validate cached data.
+ */
+GLUSboolean _glusFileMapGetStatus(const GLUSchar* filename, GLUSuint64* size, GLUSuint64* time)
+{
+    GLUSchar buffer[GLUS_MAX_FILENAME];
+
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+
+    if (!filename || !size || !time)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!glusFileMapBuildFilename(filename, buffer))
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!GetFileAttributesExA(buffer, GetFileExInfoStandard, &attributes))
+    {
+        return GLUS_FALSE;
+    }
+
+    *size = ((GLUSuint64)attributes.nFileSizeHigh << 32) | (GLUSuint64)attributes.nFileSizeLow;
+    *time = ((GLUSuint64)attributes.ftLastWriteTime.dwHighDateTime << 32) | (GLUSuint64)attributes.ftLastWriteTime.dwLowDateTime;
+
+    return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusFileUnmap(GLUSmappedfile* mappedfile)
+{
+    if (!mappedfile)
+    {
+        return;
+    }
+
+    if (mappedfile->data)
+    {
+        UnmapViewOfFile((LPCVOID)mappedfile->data);
+    }
+
+    if (mappedfile->handle)
+    {
+        CloseHandle((HANDLE)mappedfile->handle);
+    }
+
+    memset(mappedfile, 0, sizeof(GLUSmappedfile));
+}
+
+#elif defined(GLUS_FILE_MAP_POSIX)
+
+GLUSboolean GLUSAPIENTRY glusFileMap(const GLUSchar* filename, GLUSmappedfile* mappedfile)
+{
+    GLUSchar buffer[GLUS_MAX_FILENAME];
+
+    int         file;
+    struct stat status;
+    void*       data;
+
+    if (!filename || !mappedfile)
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(mappedfile, 0, sizeof(GLUSmappedfile));
+
+    if (!glusFileMapBuildFilename(filename, buffer))
+    {
+        return GLUS_FALSE;
+    }
+
+    file = open(buffer, O_RDONLY);
+
+    if (file < 0)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (fstat(file, &status) != 0 || !S_ISREG(status.st_mode) || (GLUSuint64)status.st_size > (GLUSuint64)((size_t)-1))
+    {
+        close(file);
+
+        return GLUS_FALSE;
+    }
+
+    // Empty files can not be mapped, but are valid.
+    if (status.st_size == 0)
+    {
+        close(file);
+
+        return GLUS_TRUE;
+    }
+
+    data = mmap(0, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+    // The mapping keeps the file referenced.
+    close(file);
+
+    if (data == MAP_FAILED)
+    {
+        return GLUS_FALSE;
+    }
+
+#if defined(POSIX_MADV_SEQUENTIAL)
+    posix_madvise(data, (size_t)status.st_size, POSIX_MADV_SEQUENTIAL);
+#endif
+
+    mappedfile->data   = (const GLUSubyte*)data;
+    mappedfile->length = (size_t)status.st_size;
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Retrieves the size and the last modification time of a file. Used to validate cached data.
+ */
+GLUSboolean _glusFileMapGetStatus(const GLUSchar* filename, GLUSuint64* size, GLUSuint64* time)
+{
+    GLUSchar buffer[GLUS_MAX_FILENAME];
+
+    struct stat status;
+
+    if (!filename || !size || !time)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!glusFileMapBuildFilename(filename, buffer))
+    {
+        return GLUS_FALSE;
+    }
+
+    if (stat(buffer, &status) != 0 || !S_ISREG(status.st_mode))
+    {
+        return GLUS_FALSE;
+    }
+
+    *size = (GLUSuint64)status.st_size;
+    *time = (GLUSuint64)status.st_mtime;
+
+    return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusFileUnmap(GLUSmappedfile* mappedfile)
+{
+    if (!mappedfile)
+    {
+        return;
+    }
+
+    if (mappedfile->data)
+    {
+        munmap((void*)mappedfile->data, mappedfile->length);
+    }
+
+    memset(mappedfile, 0, sizeof(GLUSmappedfile));
+}
+
+#else
+
+GLUSboolean GLUSAPIENTRY glusFileMap(const GLUSchar* filename, GLUSmappedfile* mappedfile)
+{
+    FILE*      f;
+    long       length;
+    size_t     elementsRead;
+    GLUSubyte* data;
+
+    if (!filename || !mappedfile)
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(mappedfile, 0, sizeof(GLUSmappedfile));
+
+    f = glusFileOpen(filename, "rb");
+
+    if (!f)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (fseek(f, 0, SEEK_END))
+    {
+        glusFileClose(f);
+
+        return GLUS_FALSE;
+    }
+
+    length = ftell(f);
+
+    if (length < 0)
+    {
+        glusFileClose(f);
+
+        return GLUS_FALSE;
+    }
+
+    if (length == 0)
+    {
+        glusFileClose(f);
+
+        return GLUS_TRUE;
+    }
+
+    data = (GLUSubyte*)glusMemoryMalloc((size_t)length);
+
+    if (!data)
+    {
+        glusFileClose(f);
+
+        return GLUS_FALSE;
+    }
+
+    rewind(f);
+
+    elementsRead = fread(data, 1, (size_t)length, f);
+
+    if (!_glusFileCheckRead(f, elementsRead, (size_t)length))
+    {
+        glusMemoryFree(data);
+
+        return GLUS_FALSE;
+    }
+
+    glusFileClose(f);
+
+    mappedfile->data   = data;
+    mappedfile->length = (size_t)length;
+    mappedfile->handle = (GLUSvoid*)data;
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Without a file system API, the modification time is not available.
+ */
+GLUSboolean _glusFileMapGetStatus(const GLUSchar* filename, GLUSuint64* size, GLUSuint64* time)
+{
+    return GLUS_FALSE;
+}
+
+GLUSvoid GLUSAPIENTRY glusFileUnmap(GLUSmappedfile* mappedfile)
+{
+    if (!mappedfile)
+    {
+        return;
+    }
+
+    if (mappedfile->handle)
+    {
+        glusMemoryFree(mappedfile->handle);
+    }
+
+    memset(mappedfile, 0, sizeof(GLUSmappedfile));
+}
+
+#endif
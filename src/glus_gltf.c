@@ -43,18 +43,93 @@ typedef struct _GLUSgltfImageCacheEntry
 {
     cgltf_image* image;
     GLuint       texture;
+    /* Color space of the first use, which selects the internal format. */
+    GLUSboolean  sRGB;
+    /* Decoded RGBA pixels, only held between decoding and uploading. */
+    GLUSubyte*   pixels;
+    GLint        width;
+    GLint        height;
 } GLUSgltfImageCacheEntry;
 
+/* Images decoded together by the worker threads. */
+typedef struct _GLUSgltfImageBatch
+{
+    GLUSgltfImageCacheEntry* entries;
+    const GLUSchar*          basePath;
+} GLUSgltfImageBatch;
+
 typedef struct _GLUSgltfLoadContext
 {
     GLUSgltfScene*           scene;
+    const GLUSchar*          filename;
     const GLUSchar*          basePath;
+    GLint                    sceneIndex;
     GLUSboolean              sRGB;
+    GLUSboolean              uploadMeshes;
     GLUSgltfImageCacheEntry* cache;
     GLUSint                  cacheCount;
     GLUSint                  cacheCap;
+    /* Scratch memory for the streams of the primitives, reset when all are uploaded. */
+    GLUSmemoryArena          scratch;
+    /* GLUS_TRUE, if prepared geometry still refers to the scratch memory. */
+    GLUSboolean              scratchInUse;
+    /* First primitive index of each mesh in the geometry lookup. */
+    GLint*                   meshPrimitiveOffsets;
+    /* [mesh primitive][skinned] -> 1 + index of the primitive owning the geometry, 0 if not uploaded yet. */
+    GLint*                   geometryLookup;
+    /* GLUS_GLTF_LAYOUT_SEPARATE, GLUS_GLTF_LAYOUT_INTERLEAVED or GLUS_GLTF_LAYOUT_SCENE. */
+    GLUSenum                 layout;
+    /* Content of the scene buffer, uploaded after all primitives are packed. */
+    GLUSubyte*               staging;
+    size_t                   stagingSize;
+    size_t                   stagingCapacity;
+    size_t                   stagingUploaded;
+    /* Prepared geometry, indexed like GLUSgltfScene::geometries. */
+    struct _GLUSgltfGeometryStaging* geometryStagings;
+    /* Source of each primitive, for filling the material on the context thread. */
+    cgltf_primitive**        sourcePrimitives;
+    /* World matrices at load time, as the application may animate the scene while it is loading. */
+    GLfloat*                 worldMatrices;
+    GLint                    primitiveTotal;
+
+    /* GLUS_TRUE, if the CPU work runs on a loading thread. Else each published step is uploaded right away. */
+    GLUSboolean              async;
+    /* Progress of the loading thread. Only accessed with the library lock held while loading asynchronously. */
+    GLUSboolean              sceneReady;
+    GLUSboolean              imagesCollected;
+    GLUSboolean              cpuDone;
+    GLUSboolean              failed;
+    GLint                    imagesDecoded;
+    GLint                    primitivesPrepared;
+    /* Progress of the context thread, also read by the loading thread. */
+    GLint                    imagesUploaded;
+    GLint                    primitivesUploaded;
+    GLUSboolean              gpuStarted;
+    GLUSboolean              gpuDone;
 } GLUSgltfLoadContext;
 
+/* Handle of a load started with glusGltfLoadStart(). */
+typedef struct _GLUSgltfAsyncLoad
+{
+    GLUSgltfLoadContext context;
+    GLUSchar*           filename;
+    GLUSvoid*           thread;
+} GLUSgltfAsyncLoad;
+
+extern GLUSvoid _glusThreadRun(GLUSvoid (*function)(GLUSvoid* data, GLUSuint index), GLUSvoid* data, GLUSuint numberTasks, GLUSuint numberThreads);
+extern GLUSuint _glusThreadGetNumberProcessors(GLUSvoid);
+extern GLUSvoid* _glusThreadStart(GLUSvoid (*function)(GLUSvoid* data, GLUSuint index), GLUSvoid* data);
+extern GLUSvoid _glusThreadJoin(GLUSvoid* thread);
+extern GLUSvoid _glusThreadSleep(GLUSuint milliseconds);
+extern GLUSvoid _glusThreadLock(GLUSvoid);
+extern GLUSvoid _glusThreadUnlock(GLUSvoid);
+
+extern size_t _glusGltfLayoutVertex(const size_t* elementSizes, GLint numberStreams, size_t* offsets);
+
+extern GLUSvoid _glusGltfInterleave(GLUSubyte* target, size_t stride, const size_t* offsets, const size_t* elementSizes, const GLUSubyte* const* sources, const size_t* sourceStrides, GLint numberStreams, size_t numberVertices);
+
+extern size_t _glusGltfSuballocate(size_t* used, size_t size, size_t alignment);
+
 static GLUSchar* gltfCopyString(const GLUSchar* s)
 {
     GLUSint  n;
@@ -271,51 +346,121 @@ static GLUSvoid gltfApplySampler(cgltf_sampler* sampler)
     }
 }
 
-static GLuint gltfLoadImageTexture(GLUSgltfLoadContext* ctx, cgltf_image* image, GLUSboolean sRGB)
+/* Add an image to the cache. The first use decides the color space. */
+static GLUSgltfImageCacheEntry* gltfCollectImage(GLUSgltfLoadContext* ctx, cgltf_image* image, GLUSboolean sRGB)
 {
-    GLint     w, h;
-    GLUSubyte* pix;
-    GLuint    tex;
-    GLint     internalFmt;
-    GLint     i;
+    GLUSgltfImageCacheEntry* entry;
+    GLint                    i;
 
-    if (!image)
-    {
-        return ctx->scene->defaultWhiteTexture;
-    }
     for (i = 0; i < ctx->cacheCount; i++)
     {
         if (ctx->cache[i].image == image)
         {
-            return ctx->cache[i].texture;
+            return &ctx->cache[i];
         }
     }
+    if (ctx->cacheCount >= ctx->cacheCap)
+    {
+        return NULL;
+    }
+
+    entry = &ctx->cache[ctx->cacheCount++];
+    memset(entry, 0, sizeof(*entry));
+    entry->image = image;
+    entry->sRGB  = sRGB;
 
-    pix = gltfLoadImagePixels(image, ctx->basePath, &w, &h);
-    if (!pix)
+    return entry;
+}
+
+/* Collect the images of a material in the order gltfFillMaterial uses them. */
+static GLUSvoid gltfCollectMaterialImages(GLUSgltfLoadContext* ctx, cgltf_material* mat)
+{
+    if (!mat)
     {
-        glusLogPrint(GLUS_LOG_WARNING, "glTF: failed to load image '%s'", image->uri ? image->uri : "(embedded)");
-        return ctx->scene->defaultWhiteTexture;
+        return;
     }
+    if (mat->has_pbr_metallic_roughness)
+    {
+        if (mat->pbr_metallic_roughness.base_color_texture.texture && mat->pbr_metallic_roughness.base_color_texture.texture->image)
+        {
+            gltfCollectImage(ctx, mat->pbr_metallic_roughness.base_color_texture.texture->image, ctx->sRGB);
+        }
+        if (mat->pbr_metallic_roughness.metallic_roughness_texture.texture && mat->pbr_metallic_roughness.metallic_roughness_texture.texture->image)
+        {
+            gltfCollectImage(ctx, mat->pbr_metallic_roughness.metallic_roughness_texture.texture->image, GLUS_FALSE);
+        }
+    }
+    if (mat->normal_texture.texture && mat->normal_texture.texture->image)
+    {
+        gltfCollectImage(ctx, mat->normal_texture.texture->image, GLUS_FALSE);
+    }
+    if (mat->occlusion_texture.texture && mat->occlusion_texture.texture->image)
+    {
+        gltfCollectImage(ctx, mat->occlusion_texture.texture->image, GLUS_FALSE);
+    }
+    if (mat->emissive_texture.texture && mat->emissive_texture.texture->image)
+    {
+        gltfCollectImage(ctx, mat->emissive_texture.texture->image, ctx->sRGB);
+    }
+}
 
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    internalFmt = sRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFmt, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pix);
+/* Worker task: decode one image of a batch. Only reads the glTF data. */
+static GLUSvoid gltfDecodeImageTask(GLUSvoid* data, GLUSuint index)
+{
+    GLUSgltfImageBatch*      batch = (GLUSgltfImageBatch*)data;
+    GLUSgltfImageCacheEntry* entry = &batch->entries[index];
+
+    entry->pixels = gltfLoadImagePixels(entry->image, batch->basePath, &entry->width, &entry->height);
+}
+
+/* Create the texture of a decoded image on the context thread and release the pixels. */
+static GLUSvoid gltfUploadImage(GLUSgltfImageCacheEntry* entry)
+{
+    if (!entry->pixels)
+    {
+        glusLogPrint(GLUS_LOG_WARNING, "glTF: failed to load image '%s'", entry->image->uri ? entry->image->uri : "(embedded)");
+        return;
+    }
+
+    glGenTextures(1, &entry->texture);
+    glBindTexture(GL_TEXTURE_2D, entry->texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, entry->sRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8, entry->width, entry->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, entry->pixels);
     glGenerateMipmap(GL_TEXTURE_2D);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    stbi_image_free(pix);
+    stbi_image_free(entry->pixels);
+    entry->pixels = NULL;
+}
+
+static GLuint gltfLoadImageTexture(GLUSgltfLoadContext* ctx, cgltf_image* image, GLUSboolean sRGB)
+{
+    GLUSgltfImageCacheEntry* entry;
+    GLint                    i;
 
-    if (ctx->cacheCount < ctx->cacheCap)
+    if (!image)
     {
-        ctx->cache[ctx->cacheCount].image   = image;
-        ctx->cache[ctx->cacheCount].texture = tex;
-        ctx->cacheCount++;
+        return ctx->scene->defaultWhiteTexture;
     }
-    return tex;
+    for (i = 0; i < ctx->cacheCount; i++)
+    {
+        if (ctx->cache[i].image == image)
+        {
+            return ctx->cache[i].texture ? ctx->cache[i].texture : ctx->scene->defaultWhiteTexture;
+        }
+    }
+
+    /* Images not collected by gltfDecodeImages are decoded on this thread. */
+    entry = gltfCollectImage(ctx, image, sRGB);
+    if (!entry)
+    {
+        return ctx->scene->defaultWhiteTexture;
+    }
+    entry->pixels = gltfLoadImagePixels(image, ctx->basePath, &entry->width, &entry->height);
+    gltfUploadImage(entry);
+
+    return entry->texture ? entry->texture : ctx->scene->defaultWhiteTexture;
 }
 
 static GLint gltfTypeComponents(cgltf_type t)
@@ -345,8 +490,10 @@ static GLint gltfTypeComponents(cgltf_type t)
  * included (cgltf_accessor_unpack_floats applies sparse; the per-element
  * cgltf_accessor_read_float does not). When the accessor's component count is
  * smaller than the requested one (e.g. a VEC3 colour uploaded as vec4), the
- * trailing components are padded (alpha -> 1.0 for vec4, else 0.0). */
-static GLfloat* gltfReadAccessorFloats(cgltf_accessor* acc, GLint components)
+ * trailing components are padded (alpha -> 1.0 for vec4, else 0.0).
+ * With a scratch arena the array lives in the arena, otherwise it is malloc'ed
+ * and owned by the caller. */
+static GLfloat* gltfReadAccessorFloats(GLUSmemoryArena* scratch, cgltf_accessor* acc, GLint components)
 {
     GLint     native;
     GLint     n;
@@ -361,7 +508,14 @@ static GLfloat* gltfReadAccessorFloats(cgltf_accessor* acc, GLint components)
     }
     native = gltfTypeComponents(acc->type);
     n      = (GLint)acc->count;
-    out    = (GLfloat*)malloc((size_t)n * (size_t)components * sizeof(GLfloat));
+    if (scratch)
+    {
+        out = (GLfloat*)glusMemoryArenaAlloc(scratch, (size_t)n * (size_t)components * sizeof(GLfloat));
+    }
+    else
+    {
+        out = (GLfloat*)malloc((size_t)n * (size_t)components * sizeof(GLfloat));
+    }
     if (!out)
     {
         return NULL;
@@ -371,10 +525,20 @@ static GLfloat* gltfReadAccessorFloats(cgltf_accessor* acc, GLint components)
         cgltf_accessor_unpack_floats(acc, out, (cgltf_size)n * (cgltf_size)native);
         return out;
     }
-    tmp = (GLfloat*)malloc((size_t)n * (size_t)native * sizeof(GLfloat));
+    if (scratch)
+    {
+        tmp = (GLfloat*)glusMemoryArenaAlloc(scratch, (size_t)n * (size_t)native * sizeof(GLfloat));
+    }
+    else
+    {
+        tmp = (GLfloat*)malloc((size_t)n * (size_t)native * sizeof(GLfloat));
+    }
     if (!tmp)
     {
-        free(out);
+        if (!scratch)
+        {
+            free(out);
+        }
         return NULL;
     }
     cgltf_accessor_unpack_floats(acc, tmp, (cgltf_size)n * (cgltf_size)native);
@@ -389,80 +553,216 @@ static GLfloat* gltfReadAccessorFloats(cgltf_accessor* acc, GLint components)
             out[i * components + c] = (components == 4 && c == 3) ? 1.0f : 0.0f;
         }
     }
-    free(tmp);
+    if (!scratch)
+    {
+        free(tmp);
+    }
     return out;
 }
 
-static GLuint gltfUploadFloatStream(cgltf_accessor* acc, GLint components)
+/* Layout of an uploaded vertex stream, as passed to glVertexAttribPointer. */
+typedef struct _GLUSgltfStreamFormat
 {
-    GLuint   vbo = 0;
-    GLfloat* buf;
+    GLint     components;
+    GLenum    type;
+    GLboolean normalized;
+} GLUSgltfStreamFormat;
 
-    buf = gltfReadAccessorFloats(acc, components);
-    if (!buf)
+/* Number of attribute locations of the GLUS glTF vertex shaders. */
+#define GLUS_GLTF_STREAMS 8
+
+/* A buffer of a geometry, created on the context thread by gltfUploadGeometry. */
+typedef struct _GLUSgltfStagedBuffer
+{
+    GLenum           target;
+    const GLUSubyte* data;
+    size_t           size;
+    GLuint*          name;
+} GLUSgltfStagedBuffer;
+
+/* CPU side result of gltfPrepareGeometry: the buffers to create and the
+ * attribute layout of the VAO. The data points into the glTF buffers or the
+ * scratch arena, so it has to be uploaded before the arena is reset. */
+typedef struct _GLUSgltfGeometryStaging
+{
+    /* Index of the primitive the geometry is uploaded for. */
+    GLint                owner;
+    GLUSboolean          valid;
+    GLUSboolean          indexed;
+    /* Streams, indices and the three morph target buffers. */
+    GLUSgltfStagedBuffer buffers[GLUS_GLTF_STREAMS + 4];
+    GLint                bufferCount;
+    GLUSgltfStreamFormat format[GLUS_GLTF_STREAMS];
+    size_t               offsets[GLUS_GLTF_STREAMS];
+    GLUSboolean          enabled[GLUS_GLTF_STREAMS];
+} GLUSgltfGeometryStaging;
+
+static GLenum gltfComponentType(cgltf_component_type t)
+{
+    switch (t)
     {
+    case cgltf_component_type_r_8:
+        return GL_BYTE;
+    case cgltf_component_type_r_8u:
+        return GL_UNSIGNED_BYTE;
+    case cgltf_component_type_r_16:
+        return GL_SHORT;
+    case cgltf_component_type_r_16u:
+        return GL_UNSIGNED_SHORT;
+    case cgltf_component_type_r_32u:
+        return GL_UNSIGNED_INT;
+    case cgltf_component_type_r_32f:
+        return GL_FLOAT;
+    case cgltf_component_type_invalid:
+    default:
         return 0;
     }
-    glGenBuffers(1, &vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, (GLsizei)((size_t)acc->count * (size_t)components * sizeof(GLfloat)), buf, GL_STATIC_DRAW);
-    free(buf);
-    return vbo;
 }
 
-static GLuint gltfUploadZeroStream(GLsizei count, GLint components)
+/* Pointer to the elements of a non-sparse accessor in the loaded buffer, or
+ * NULL when the data has to be assembled by cgltf. */
+static const GLUSubyte* gltfAccessorData(const cgltf_accessor* acc)
+{
+    const GLUSubyte* data;
+
+    if (acc->is_sparse || !acc->buffer_view || gltfComponentType(acc->component_type) == 0)
+    {
+        return NULL;
+    }
+    data = (const GLUSubyte*)cgltf_buffer_view_data(acc->buffer_view);
+    if (!data)
+    {
+        return NULL;
+    }
+    return data + acc->offset;
+}
+
+/* Add a buffer to a staging. Its size is added to byteSize. */
+static GLUSvoid gltfStageBuffer(GLUSgltfGeometryStaging* staging, GLenum target, const GLUSubyte* data, size_t size, GLuint* name, size_t* byteSize)
+{
+    GLUSgltfStagedBuffer* buffer = &staging->buffers[staging->bufferCount++];
+
+    buffer->target = target;
+    buffer->data   = data;
+    buffer->size   = size;
+    buffer->name   = name;
+    *byteSize += size;
+}
+
+/* Stage the elements of an accessor in their component type. Tightly packed
+ * elements are uploaded straight from the buffer, interleaved ones are
+ * gathered in the scratch arena first. */
+static GLUSboolean gltfStageNative(GLUSmemoryArena* scratch, GLUSgltfGeometryStaging* staging, GLenum target, const cgltf_accessor* acc, const GLUSubyte* data, size_t elementSize, GLuint* name, size_t* byteSize)
 {
-    GLuint   vbo = 0;
-    GLfloat* buf = (GLfloat*)calloc((size_t)count * (size_t)components, sizeof(GLfloat));
+    GLUSubyte* packed;
+    size_t     i;
+
+    if (acc->stride != elementSize)
+    {
+        packed = (GLUSubyte*)glusMemoryArenaAlloc(scratch, (size_t)acc->count * elementSize);
+        if (!packed)
+        {
+            return GLUS_FALSE;
+        }
+        for (i = 0; i < (size_t)acc->count; i++)
+        {
+            memcpy(packed + i * elementSize, data + i * acc->stride, elementSize);
+        }
+        data = packed;
+    }
+    gltfStageBuffer(staging, target, data, (size_t)acc->count * elementSize, name, byteSize);
+    return GLUS_TRUE;
+}
+
+/* The stage functions add the size of each staged buffer to byteSize.
+ * Streams keep the component type of the accessor, e.g. normalized bytes for
+ * texture coordinates or colours; missing components are filled in by GL
+ * (z = 0, w = 1), as the float path does. Only sparse accessors are expanded
+ * to float with the requested number of components. */
+static GLUSboolean gltfStageStream(GLUSmemoryArena* scratch, GLUSgltfGeometryStaging* staging, cgltf_accessor* acc, GLint components, GLUSgltfStreamFormat* format, GLuint* name, size_t* byteSize)
+{
+    GLfloat*         buf;
+    const GLUSubyte* data;
+
+    data = gltfAccessorData(acc);
+    if (data)
+    {
+        format->components = gltfTypeComponents(acc->type);
+        format->type       = gltfComponentType(acc->component_type);
+        format->normalized = acc->normalized ? GL_TRUE : GL_FALSE;
+        return gltfStageNative(scratch, staging, GL_ARRAY_BUFFER, acc, data, (size_t)format->components * cgltf_component_size(acc->component_type), name, byteSize);
+    }
+
+    buf = gltfReadAccessorFloats(scratch, acc, components);
     if (!buf)
     {
-        return 0;
+        return GLUS_FALSE;
     }
-    glGenBuffers(1, &vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, (GLsizei)((size_t)count * (size_t)components * sizeof(GLfloat)), buf, GL_STATIC_DRAW);
-    free(buf);
-    return vbo;
+    format->components = components;
+    format->type       = GL_FLOAT;
+    format->normalized = GL_FALSE;
+    gltfStageBuffer(staging, GL_ARRAY_BUFFER, (const GLUSubyte*)buf, (size_t)acc->count * (size_t)components * sizeof(GLfloat), name, byteSize);
+    return GLUS_TRUE;
 }
 
-static GLUSvoid gltfUploadIndices(cgltf_accessor* acc, GLuint* outIbo, GLsizei* outCount, GLenum* outType)
+static GLUSboolean gltfStageZeroStream(GLUSmemoryArena* scratch, GLUSgltfGeometryStaging* staging, GLsizei count, GLint components, GLUSgltfStreamFormat* format, GLuint* name, size_t* byteSize)
 {
-    GLsizei  n;
-    GLint    i;
-    GLuint*  ibuf;
-    GLfloat* fbuf;
+    GLfloat* buf = (GLfloat*)glusMemoryArenaAlloc(scratch, (size_t)count * (size_t)components * sizeof(GLfloat));
+    if (!buf)
+    {
+        return GLUS_FALSE;
+    }
+    memset(buf, 0, (size_t)count * (size_t)components * sizeof(GLfloat));
+    format->components = components;
+    format->type       = GL_FLOAT;
+    format->normalized = GL_FALSE;
+    gltfStageBuffer(staging, GL_ARRAY_BUFFER, (const GLUSubyte*)buf, (size_t)count * (size_t)components * sizeof(GLfloat), name, byteSize);
+    return GLUS_TRUE;
+}
 
-    if (!acc)
+static GLUSvoid gltfStageIndices(GLUSmemoryArena* scratch, GLUSgltfGeometryStaging* staging, cgltf_accessor* acc, GLUSgltfPrimitive* gp, size_t* byteSize)
+{
+    GLsizei          n;
+    GLint            i;
+    GLuint*          ibuf;
+    GLfloat*         fbuf;
+    const GLUSubyte* data;
+
+    n = (GLsizei)acc->count;
+
+    /* Unsigned byte, short and int indices are uploaded as they are. */
+    data = gltfAccessorData(acc);
+    if (data && (acc->component_type == cgltf_component_type_r_8u || acc->component_type == cgltf_component_type_r_16u || acc->component_type == cgltf_component_type_r_32u))
     {
-        *outIbo   = 0;
-        *outCount = 0;
+        if (gltfStageNative(scratch, staging, GL_ELEMENT_ARRAY_BUFFER, acc, data, cgltf_component_size(acc->component_type), &gp->ibo, byteSize))
+        {
+            gp->indexCount   = n;
+            gp->indexType    = gltfComponentType(acc->component_type);
+            staging->indexed = GLUS_TRUE;
+        }
         return;
     }
-    n    = (GLsizei)acc->count;
-    /* Read sparse-aware as floats, then cast to GLuint. */
-    fbuf = gltfReadAccessorFloats(acc, 1);
+
+    /* Sparse indices: read sparse-aware as floats, then cast to GLuint. */
+    fbuf = gltfReadAccessorFloats(scratch, acc, 1);
     if (!fbuf)
     {
         return;
     }
-    ibuf = (GLuint*)malloc((size_t)n * sizeof(GLuint));
+    ibuf = (GLuint*)glusMemoryArenaAlloc(scratch, (size_t)n * sizeof(GLuint));
     if (!ibuf)
     {
-        free(fbuf);
         return;
     }
     for (i = 0; i < n; i++)
     {
         ibuf[i] = (GLuint)fbuf[i];
     }
-    free(fbuf);
 
-    glGenBuffers(1, outIbo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *outIbo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizei)((size_t)n * sizeof(GLuint)), ibuf, GL_STATIC_DRAW);
-    free(ibuf);
-    *outCount = n;
-    *outType  = GL_UNSIGNED_INT;
+    gltfStageBuffer(staging, GL_ELEMENT_ARRAY_BUFFER, (const GLUSubyte*)ibuf, (size_t)n * sizeof(GLuint), &gp->ibo, byteSize);
+    gp->indexCount   = n;
+    gp->indexType    = GL_UNSIGNED_INT;
+    staging->indexed = GLUS_TRUE;
 }
 
 static cgltf_accessor* gltfFindAttribute(cgltf_primitive* prim, cgltf_attribute_type type, GLint index)
@@ -479,6 +779,105 @@ static cgltf_accessor* gltfFindAttribute(cgltf_primitive* prim, cgltf_attribute_
     return NULL;
 }
 
+/* The progress of an asynchronous load is shared between the loading and the context thread. */
+static GLUSvoid gltfLock(const GLUSgltfLoadContext* ctx)
+{
+    if (ctx->async)
+    {
+        _glusThreadLock();
+    }
+}
+
+static GLUSvoid gltfUnlock(const GLUSgltfLoadContext* ctx)
+{
+    if (ctx->async)
+    {
+        _glusThreadUnlock();
+    }
+}
+
+static GLUSboolean gltfUploadReady(GLUSgltfLoadContext* ctx, GLUSdouble timeBudget, size_t byteBudget);
+
+/* Called by the loading stages after publishing progress. A synchronous load uploads the new objects right away. */
+static GLUSvoid gltfPublished(GLUSgltfLoadContext* ctx)
+{
+    if (!ctx->async)
+    {
+        gltfUploadReady(ctx, 0.0, 0);
+    }
+}
+
+/* Decode the images of all primitives, which will be loaded, on the worker
+ * threads. A batch holds one image per processor and is published for
+ * uploading before the next one is decoded. An asynchronous load waits while
+ * two batches are not uploaded, so only a few decoded images are in memory. */
+static GLUSvoid gltfDecodeImages(GLUSgltfLoadContext* ctx)
+{
+    GLUSgltfScene*     scene = ctx->scene;
+    cgltf_data*        data = scene->cgltfData;
+    GLUSgltfImageBatch batch;
+    GLUSuint           numberThreads;
+    GLUSuint           numberImages;
+    GLint              first;
+    GLint              waiting;
+    GLint              ni;
+    GLint              pi;
+
+    for (ni = 0; ni < scene->nodeCount; ni++)
+    {
+        cgltf_mesh* mesh;
+
+        if (scene->nodes[ni].meshIndex < 0)
+        {
+            continue;
+        }
+        mesh = &data->meshes[scene->nodes[ni].meshIndex];
+        for (pi = 0; pi < (GLint)mesh->primitives_count; pi++)
+        {
+            if (gltfFindAttribute(&mesh->primitives[pi], cgltf_attribute_type_position, 0))
+            {
+                gltfCollectMaterialImages(ctx, mesh->primitives[pi].material);
+            }
+        }
+    }
+
+    gltfLock(ctx);
+    ctx->imagesCollected = GLUS_TRUE;
+    gltfUnlock(ctx);
+
+    numberThreads  = _glusThreadGetNumberProcessors();
+    batch.basePath = ctx->basePath;
+
+    for (first = 0; first < ctx->cacheCount; first += (GLint)numberImages)
+    {
+        numberImages = (GLUSuint)(ctx->cacheCount - first);
+        if (numberImages > numberThreads)
+        {
+            numberImages = numberThreads;
+        }
+
+        while (ctx->async)
+        {
+            gltfLock(ctx);
+            waiting = ctx->imagesDecoded - ctx->imagesUploaded;
+            gltfUnlock(ctx);
+            if (waiting < 2 * (GLint)numberThreads)
+            {
+                break;
+            }
+            _glusThreadSleep(1);
+        }
+
+        batch.entries = &ctx->cache[first];
+        _glusThreadRun(gltfDecodeImageTask, &batch, numberImages, numberThreads);
+
+        gltfLock(ctx);
+        ctx->imagesDecoded = first + (GLint)numberImages;
+        gltfUnlock(ctx);
+        gltfPublished(ctx);
+    }
+}
+
 static cgltf_accessor* gltfFindTargetAttribute(cgltf_morph_target* tgt, cgltf_attribute_type type)
 {
     GLint i;
@@ -493,9 +892,9 @@ static cgltf_accessor* gltfFindTargetAttribute(cgltf_morph_target* tgt, cgltf_at
     return NULL;
 }
 
-/* Upload per-target POSITION / NORMAL / TANGENT deltas into SSBOs packed as
+/* Stage per-target POSITION / NORMAL / TANGENT deltas for SSBOs packed as
  * [target][vertex]. Sparse-aware via gltfReadAccessorFloats. */
-static GLUSvoid gltfUploadMorphDeltas(GLUSgltfPrimitive* gp, cgltf_primitive* prim, GLsizei vertCount, GLint mt)
+static GLUSvoid gltfStageMorphDeltas(GLUSmemoryArena* scratch, GLUSgltfGeometryStaging* staging, GLUSgltfPrimitive* gp, cgltf_primitive* prim, GLsizei vertCount, GLint mt, size_t* byteSize)
 {
     GLfloat* posBuf;
     GLfloat* norBuf = NULL;
@@ -505,16 +904,29 @@ static GLUSvoid gltfUploadMorphDeltas(GLUSgltfPrimitive* gp, cgltf_primitive* pr
     GLint    hasT = 0;
     size_t   posFloats = (size_t)mt * (size_t)vertCount * 3u;
 
-    posBuf = (GLfloat*)calloc(posFloats, sizeof(GLfloat));
+    posBuf = (GLfloat*)glusMemoryArenaAlloc(scratch, posFloats * sizeof(GLfloat));
+    if (!posBuf)
+    {
+        return;
+    }
+    memset(posBuf, 0, posFloats * sizeof(GLfloat));
     if (mt > 0 && gltfFindTargetAttribute(&prim->targets[0], cgltf_attribute_type_normal))
     {
-        hasN   = 1;
-        norBuf = (GLfloat*)calloc(posFloats, sizeof(GLfloat));
+        norBuf = (GLfloat*)glusMemoryArenaAlloc(scratch, posFloats * sizeof(GLfloat));
+        if (norBuf)
+        {
+            hasN = 1;
+            memset(norBuf, 0, posFloats * sizeof(GLfloat));
+        }
     }
     if (mt > 0 && gltfFindTargetAttribute(&prim->targets[0], cgltf_attribute_type_tangent))
     {
-        hasT   = 1;
-        tanBuf = (GLfloat*)calloc((size_t)mt * (size_t)vertCount * 4u, sizeof(GLfloat));
+        tanBuf = (GLfloat*)glusMemoryArenaAlloc(scratch, (size_t)mt * (size_t)vertCount * 4u * sizeof(GLfloat));
+        if (tanBuf)
+        {
+            hasT = 1;
+            memset(tanBuf, 0, (size_t)mt * (size_t)vertCount * 4u * sizeof(GLfloat));
+        }
     }
 
     for (ti = 0; ti < mt; ti++)
@@ -525,11 +937,10 @@ static GLUSvoid gltfUploadMorphDeltas(GLUSgltfPrimitive* gp, cgltf_primitive* pr
         a = gltfFindTargetAttribute(tgt, cgltf_attribute_type_position);
         if (a)
         {
-            GLfloat* tmp = gltfReadAccessorFloats(a, 3);
+            GLfloat* tmp = gltfReadAccessorFloats(scratch, a, 3);
             if (tmp)
             {
                 memcpy(posBuf + (size_t)ti * vertCount * 3, tmp, (size_t)vertCount * 3 * sizeof(GLfloat));
-                free(tmp);
             }
         }
         if (hasN)
@@ -537,12 +948,11 @@ static GLUSvoid gltfUploadMorphDeltas(GLUSgltfPrimitive* gp, cgltf_primitive* pr
             a = gltfFindTargetAttribute(tgt, cgltf_attribute_type_normal);
             if (a)
             {
-                GLfloat* tmp = gltfReadAccessorFloats(a, 3);
+                GLfloat* tmp = gltfReadAccessorFloats(scratch, a, 3);
                 if (tmp)
                 {
                     memcpy(norBuf + (size_t)ti * vertCount * 3, tmp, (size_t)vertCount * 3 * sizeof(GLfloat));
-                    free(tmp);
-                }
+                    }
             }
         }
         if (hasT)
@@ -550,36 +960,24 @@ static GLUSvoid gltfUploadMorphDeltas(GLUSgltfPrimitive* gp, cgltf_primitive* pr
             a = gltfFindTargetAttribute(tgt, cgltf_attribute_type_tangent);
             if (a)
             {
-                GLfloat* tmp = gltfReadAccessorFloats(a, 4);
+                GLfloat* tmp = gltfReadAccessorFloats(scratch, a, 4);
                 if (tmp)
                 {
                     memcpy(tanBuf + (size_t)ti * vertCount * 4, tmp, (size_t)vertCount * 4 * sizeof(GLfloat));
-                    free(tmp);
-                }
+                    }
             }
         }
     }
 
-    glGenBuffers(1, &gp->morphPositionSSBO);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, gp->morphPositionSSBO);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, (GLsizei)(posFloats * sizeof(GLfloat)), posBuf, GL_STATIC_DRAW);
+    gltfStageBuffer(staging, GL_SHADER_STORAGE_BUFFER, (const GLUSubyte*)posBuf, posFloats * sizeof(GLfloat), &gp->morphPositionSSBO, byteSize);
     if (norBuf)
     {
-        glGenBuffers(1, &gp->morphNormalSSBO);
-        glBindBuffer(GL_SHADER_STORAGE_BUFFER, gp->morphNormalSSBO);
-        glBufferData(GL_SHADER_STORAGE_BUFFER, (GLsizei)(posFloats * sizeof(GLfloat)), norBuf, GL_STATIC_DRAW);
+        gltfStageBuffer(staging, GL_SHADER_STORAGE_BUFFER, (const GLUSubyte*)norBuf, posFloats * sizeof(GLfloat), &gp->morphNormalSSBO, byteSize);
     }
     if (tanBuf)
     {
-        glGenBuffers(1, &gp->morphTangentSSBO);
-        glBindBuffer(GL_SHADER_STORAGE_BUFFER, gp->morphTangentSSBO);
-        glBufferData(GL_SHADER_STORAGE_BUFFER, (GLsizei)((size_t)mt * vertCount * 4 * sizeof(GLfloat)), tanBuf, GL_STATIC_DRAW);
+        gltfStageBuffer(staging, GL_SHADER_STORAGE_BUFFER, (const GLUSubyte*)tanBuf, (size_t)mt * vertCount * 4 * sizeof(GLfloat), &gp->morphTangentSSBO, byteSize);
     }
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-
-    free(posBuf);
-    free(norBuf);
-    free(tanBuf);
 }
 
 static GLenum gltfPrimitiveMode(cgltf_primitive_type t)
@@ -742,141 +1140,465 @@ static GLUSvoid gltfExpandBounds(GLUSgltfScene* scene, const cgltf_float minP[3]
     }
 }
 
-static GLUSvoid gltfProcessNodeMeshes(GLUSgltfLoadContext* ctx, GLint nodeIndex, GLint* cursor)
+/* Components each location is read with when an accessor has to be expanded to float. */
+static const GLint gltfStreamComponents[GLUS_GLTF_STREAMS] = { 3, 3, 4, 2, 4, 4, 2, 4 };
+
+/* Constant value of a location without a stream. Joints and weights are only enabled for skinned primitives. */
+static const GLfloat gltfStreamDefaults[GLUS_GLTF_STREAMS][4] = { { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f },
+                                                                  { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } };
+
+/* Elements of an accessor for packing: in place and in the component type of
+ * the accessor, or expanded to float in the scratch arena for sparse ones. */
+static const GLUSubyte* gltfSourceStream(GLUSmemoryArena* scratch, cgltf_accessor* acc, GLint components, GLUSgltfStreamFormat* format, size_t* elementSize, size_t* sourceStride)
 {
-    GLUSgltfScene* scene = ctx->scene;
-    cgltf_data*    data = scene->cgltfData;
-    cgltf_node*    cnode = &data->nodes[nodeIndex];
-    cgltf_mesh*    mesh = cnode->mesh;
-    GLint          skinIdx = scene->nodes[nodeIndex].skinIndex;
-    GLint          pi;
+    const GLUSubyte* data;
 
-    for (pi = 0; pi < (GLint)mesh->primitives_count; pi++)
+    data = gltfAccessorData(acc);
+    if (data)
     {
-        cgltf_primitive*  prim = &mesh->primitives[pi];
-        GLUSgltfPrimitive* gp;
-        cgltf_accessor    *accPos, *accNor, *accTan, *accUV0, *accUV1, *accColor, *accJoints, *accWeights;
-        GLsizei           vertCount;
-        GLfloat           tmp[16];
-        GLint             ti;
-        cgltf_float*      weights;
-        cgltf_size        weightCount;
+        format->components = gltfTypeComponents(acc->type);
+        format->type       = gltfComponentType(acc->component_type);
+        format->normalized = acc->normalized ? GL_TRUE : GL_FALSE;
+        *elementSize       = (size_t)format->components * cgltf_component_size(acc->component_type);
+        *sourceStride      = acc->stride;
+        return data;
+    }
 
-        accPos = gltfFindAttribute(prim, cgltf_attribute_type_position, 0);
-        if (!accPos)
+    format->components = components;
+    format->type       = GL_FLOAT;
+    format->normalized = GL_FALSE;
+    *elementSize       = (size_t)components * sizeof(GLfloat);
+    *sourceStride      = *elementSize;
+    return (const GLUSubyte*)gltfReadAccessorFloats(scratch, acc, components);
+}
+
+/* Indices of an accessor for packing, see gltfSourceStream. Sparse indices are converted to GLuint. */
+static const GLUSubyte* gltfSourceIndices(GLUSmemoryArena* scratch, cgltf_accessor* acc, GLenum* type, size_t* indexSize, size_t* sourceStride)
+{
+    const GLUSubyte* data;
+    GLfloat*         fbuf;
+    GLuint*          ibuf;
+    size_t           i;
+
+    data = gltfAccessorData(acc);
+    if (data && (acc->component_type == cgltf_component_type_r_8u || acc->component_type == cgltf_component_type_r_16u || acc->component_type == cgltf_component_type_r_32u))
+    {
+        *type         = gltfComponentType(acc->component_type);
+        *indexSize    = cgltf_component_size(acc->component_type);
+        *sourceStride = acc->stride;
+        return data;
+    }
+
+    fbuf = gltfReadAccessorFloats(scratch, acc, 1);
+    ibuf = (GLuint*)glusMemoryArenaAlloc(scratch, (size_t)acc->count * sizeof(GLuint));
+    if (!fbuf || !ibuf)
+    {
+        return NULL;
+    }
+    for (i = 0; i < (size_t)acc->count; i++)
+    {
+        ibuf[i] = (GLuint)fbuf[i];
+    }
+    *type         = GL_UNSIGNED_INT;
+    *indexSize    = sizeof(GLuint);
+    *sourceStride = sizeof(GLuint);
+    return (const GLUSubyte*)ibuf;
+}
+
+/* Interleave the streams of a primitive and append its indices. With
+ * GLUS_GLTF_LAYOUT_SCENE the data is appended to the scene buffer, which is
+ * uploaded after all primitives are packed; else the primitive gets its own
+ * buffer. The bytes of the primitive are returned. */
+static size_t gltfPackGeometry(GLUSgltfLoadContext* ctx, GLUSgltfPrimitive* gp, cgltf_primitive* prim, cgltf_accessor* streams[GLUS_GLTF_STREAMS], GLUSgltfGeometryStaging* staging)
+{
+    GLUSgltfStreamFormat* format = staging->format;
+    size_t*               offsets = staging->offsets;
+    const GLUSubyte* sources[GLUS_GLTF_STREAMS + 1];
+    size_t           elementSizes[GLUS_GLTF_STREAMS + 1];
+    size_t           sourceStrides[GLUS_GLTF_STREAMS + 1];
+    size_t           indexOffset = 0;
+    size_t           indexElementOffset = 0;
+    size_t           vertexBytes;
+    size_t           indexBytes = 0;
+    size_t           used = 0;
+    size_t           stagedBytes = 0;
+    size_t           vertexCount = (size_t)streams[0]->count;
+    GLUSubyte*       target;
+    GLint            l;
+
+    for (l = 0; l < GLUS_GLTF_STREAMS; l++)
+    {
+        sources[l]       = NULL;
+        elementSizes[l]  = 0;
+        sourceStrides[l] = 0;
+        if (streams[l])
+        {
+            sources[l] = gltfSourceStream(&ctx->scratch, streams[l], gltfStreamComponents[l], &format[l], &elementSizes[l], &sourceStrides[l]);
+            if (!sources[l])
+            {
+                return 0;
+            }
+        }
+    }
+
+    /* The indices are handled as a stream of its own, one index per element. */
+    if (prim->indices)
+    {
+        sources[GLUS_GLTF_STREAMS] = gltfSourceIndices(&ctx->scratch, prim->indices, &gp->indexType, &elementSizes[GLUS_GLTF_STREAMS], &sourceStrides[GLUS_GLTF_STREAMS]);
+        if (!sources[GLUS_GLTF_STREAMS])
         {
-            continue;
+            return 0;
         }
+        indexBytes = (size_t)prim->indices->count * elementSizes[GLUS_GLTF_STREAMS];
+    }
 
-        gp = &scene->primitives[(*cursor)++];
-        memset(gp, 0, sizeof(*gp));
-        gp->nodeIndex = nodeIndex;
-        gp->skinIndex = skinIdx;
-        gp->mode      = gltfPrimitiveMode(prim->type);
-        gp->indexType = GL_UNSIGNED_INT;
+    gp->vertexStride = (GLsizei)_glusGltfLayoutVertex(elementSizes, GLUS_GLTF_STREAMS, offsets);
+    vertexBytes      = (size_t)gp->vertexStride * vertexCount;
+
+    if (ctx->layout == GLUS_GLTF_LAYOUT_SCENE)
+    {
+        used = ctx->stagingSize;
+    }
+    gp->vertexOffset = (GLintptr)_glusGltfSuballocate(&used, vertexBytes, (size_t)gp->vertexStride);
+    if (prim->indices)
+    {
+        indexOffset     = _glusGltfSuballocate(&used, indexBytes, elementSizes[GLUS_GLTF_STREAMS]);
+        gp->indexOffset = (GLintptr)indexOffset;
+    }
+
+    if (ctx->layout == GLUS_GLTF_LAYOUT_SCENE)
+    {
+        if (used > ctx->stagingCapacity)
+        {
+            size_t     capacity = ctx->stagingCapacity ? ctx->stagingCapacity : 1024 * 1024;
+            GLUSubyte* grown;
+
+            while (capacity < used)
+            {
+                capacity *= 2;
+            }
+            grown = (GLUSubyte*)realloc(ctx->staging, capacity);
+            if (!grown)
+            {
+                return 0;
+            }
+            ctx->staging         = grown;
+            ctx->stagingCapacity = capacity;
+        }
+        /* Padding between the ranges stays defined. */
+        memset(ctx->staging + ctx->stagingSize, 0, used - ctx->stagingSize);
+        ctx->stagingSize = used;
+        target           = ctx->staging;
+    }
+    else
+    {
+        target = (GLUSubyte*)glusMemoryArenaAlloc(&ctx->scratch, used);
+        if (!target)
+        {
+            return 0;
+        }
+    }
+
+    _glusGltfInterleave(target + gp->vertexOffset, (size_t)gp->vertexStride, offsets, elementSizes, sources, sourceStrides, GLUS_GLTF_STREAMS, vertexCount);
+    if (prim->indices)
+    {
+        _glusGltfInterleave(target + indexOffset, elementSizes[GLUS_GLTF_STREAMS], &indexElementOffset, &elementSizes[GLUS_GLTF_STREAMS], &sources[GLUS_GLTF_STREAMS], &sourceStrides[GLUS_GLTF_STREAMS], 1, (size_t)prim->indices->count);
+        gp->indexCount   = (GLsizei)prim->indices->count;
+        staging->indexed = GLUS_TRUE;
+    }
+    else
+    {
+        gp->vertexCount = (GLsizei)vertexCount;
+    }
+
+    for (l = 0; l < GLUS_GLTF_STREAMS; l++)
+    {
+        staging->enabled[l] = streams[l] ? GLUS_TRUE : GLUS_FALSE;
+    }
+    if (ctx->layout != GLUS_GLTF_LAYOUT_SCENE)
+    {
+        gltfStageBuffer(staging, GL_ARRAY_BUFFER, target, used, &gp->vbo, &stagedBytes);
+    }
+
+    return vertexBytes + indexBytes;
+}
+
+/* Attribute buffers of a primitive by location, for GLUS_GLTF_LAYOUT_SEPARATE. */
+static GLUSvoid gltfStreamNames(GLUSgltfPrimitive* gp, GLuint* names[GLUS_GLTF_STREAMS])
+{
+    names[0] = &gp->vboPosition;
+    names[1] = &gp->vboNormal;
+    names[2] = &gp->vboTangent;
+    names[3] = &gp->vboTexCoord0;
+    names[4] = &gp->vboJoints;
+    names[5] = &gp->vboWeights;
+    names[6] = &gp->vboTexCoord1;
+    names[7] = &gp->vboColor;
+}
+
+/* Convert the vertex, index and morph streams of a mesh primitive for
+ * uploading. Only touches memory, so it runs on the loading thread. The
+ * counts and the layout are stored in gp; the bytes to upload are returned. */
+static size_t gltfPrepareGeometry(GLUSgltfLoadContext* ctx, GLUSgltfPrimitive* gp, cgltf_primitive* prim, GLint skinned, GLUSgltfGeometryStaging* staging)
+{
+    cgltf_accessor* streams[GLUS_GLTF_STREAMS];
+    GLuint*         names[GLUS_GLTF_STREAMS];
+    GLsizei         vertCount;
+    size_t          byteSize = 0;
+    GLint           l;
 
-        accNor     = gltfFindAttribute(prim, cgltf_attribute_type_normal, 0);
-        accTan     = gltfFindAttribute(prim, cgltf_attribute_type_tangent, 0);
-        accUV0     = gltfFindAttribute(prim, cgltf_attribute_type_texcoord, 0);
-        accUV1     = gltfFindAttribute(prim, cgltf_attribute_type_texcoord, 1);
-        accColor   = gltfFindAttribute(prim, cgltf_attribute_type_color, 0);
-        accJoints  = gltfFindAttribute(prim, cgltf_attribute_type_joints, 0);
-        accWeights = gltfFindAttribute(prim, cgltf_attribute_type_weights, 0);
+    streams[0] = gltfFindAttribute(prim, cgltf_attribute_type_position, 0);
+    streams[1] = gltfFindAttribute(prim, cgltf_attribute_type_normal, 0);
+    streams[2] = gltfFindAttribute(prim, cgltf_attribute_type_tangent, 0);
+    streams[3] = gltfFindAttribute(prim, cgltf_attribute_type_texcoord, 0);
+    streams[4] = skinned ? gltfFindAttribute(prim, cgltf_attribute_type_joints, 0) : NULL;
+    streams[5] = skinned ? gltfFindAttribute(prim, cgltf_attribute_type_weights, 0) : NULL;
+    streams[6] = gltfFindAttribute(prim, cgltf_attribute_type_texcoord, 1);
+    streams[7] = gltfFindAttribute(prim, cgltf_attribute_type_color, 0);
 
-        vertCount = (GLsizei)accPos->count;
+    gltfStreamNames(gp, names);
 
-        gp->vboPosition  = gltfUploadFloatStream(accPos, 3);
-        gp->vboNormal    = accNor ? gltfUploadFloatStream(accNor, 3) : gltfUploadZeroStream(vertCount, 3);
-        gp->vboTangent   = accTan ? gltfUploadFloatStream(accTan, 4) : gltfUploadZeroStream(vertCount, 4);
-        gp->vboTexCoord0 = accUV0 ? gltfUploadFloatStream(accUV0, 2) : gltfUploadZeroStream(vertCount, 2);
-        gp->vboTexCoord1 = accUV1 ? gltfUploadFloatStream(accUV1, 2) : 0;
-        gp->vboColor     = accColor ? gltfUploadFloatStream(accColor, 4) : 0;
+    vertCount = (GLsizei)streams[0]->count;
 
-        if (skinIdx >= 0 && accJoints && accWeights)
+    memset(staging, 0, sizeof(*staging));
+    staging->valid = GLUS_TRUE;
+
+    if (ctx->layout == GLUS_GLTF_LAYOUT_SEPARATE)
+    {
+        for (l = 0; l < GLUS_GLTF_STREAMS; l++)
         {
-            gp->vboJoints  = gltfUploadFloatStream(accJoints, 4);
-            gp->vboWeights = gltfUploadFloatStream(accWeights, 4);
+            if (streams[l])
+            {
+                staging->enabled[l] = gltfStageStream(&ctx->scratch, staging, streams[l], gltfStreamComponents[l], &staging->format[l], names[l], &byteSize);
+            }
+            else if (l >= 1 && l <= 3)
+            {
+                /* Normal, tangent and texCoord0 always have a buffer in this layout. */
+                staging->enabled[l] = gltfStageZeroStream(&ctx->scratch, staging, vertCount, gltfStreamComponents[l], &staging->format[l], names[l], &byteSize);
+            }
         }
 
         if (prim->indices)
         {
-            gltfUploadIndices(prim->indices, &gp->ibo, &gp->indexCount, &gp->indexType);
+            gltfStageIndices(&ctx->scratch, staging, prim->indices, gp, &byteSize);
         }
         else
         {
             gp->vertexCount = vertCount;
         }
+    }
+    else
+    {
+        byteSize = gltfPackGeometry(ctx, gp, prim, streams, staging);
+        if (byteSize == 0)
+        {
+            glusLogPrint(GLUS_LOG_ERROR, "glTF: out of memory while packing a primitive");
+            staging->valid = GLUS_FALSE;
+            return 0;
+        }
+    }
+
+    /* Morph targets (core): delta SSBO upload. The weights belong to the node. */
+    gp->morphTargetCount = (GLint)prim->targets_count;
+    if (gp->morphTargetCount > GLUS_GLTF_MAX_MORPH_TARGETS)
+    {
+        glusLogPrint(GLUS_LOG_WARNING, "glTF: %d morph targets, clamping to %d",
+                     gp->morphTargetCount, GLUS_GLTF_MAX_MORPH_TARGETS);
+        gp->morphTargetCount = GLUS_GLTF_MAX_MORPH_TARGETS;
+    }
+    if (gp->morphTargetCount > 0)
+    {
+        gltfStageMorphDeltas(&ctx->scratch, staging, gp, prim, vertCount, gp->morphTargetCount, &byteSize);
+    }
+
+    return byteSize;
+}
+
+/* Create the buffers and the VAO of a prepared geometry. The GL names are stored in gp. */
+static GLUSvoid gltfUploadGeometry(GLUSgltfLoadContext* ctx, GLUSgltfPrimitive* gp, const GLUSgltfGeometryStaging* staging)
+{
+    const GLUSgltfStagedBuffer* buffer;
+    GLuint*                     names[GLUS_GLTF_STREAMS];
+    GLint                       l;
+
+    for (l = 0; l < staging->bufferCount; l++)
+    {
+        buffer = &staging->buffers[l];
+        glGenBuffers(1, buffer->name);
+        glBindBuffer(buffer->target, *buffer->name);
+        glBufferData(buffer->target, (GLsizeiptr)buffer->size, buffer->data, GL_STATIC_DRAW);
+    }
+    if (gp->morphPositionSSBO)
+    {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    if (ctx->layout == GLUS_GLTF_LAYOUT_SCENE)
+    {
+        gp->vbo = ctx->scene->sceneBuffer;
+    }
+    if (ctx->layout != GLUS_GLTF_LAYOUT_SEPARATE && staging->indexed)
+    {
+        gp->ibo = gp->vbo;
+    }
+
+    if (!staging->valid)
+    {
+        return;
+    }
 
-        glGenVertexArrays(1, &gp->vao);
-        glBindVertexArray(gp->vao);
+    gltfStreamNames(gp, names);
 
-        glBindBuffer(GL_ARRAY_BUFFER, gp->vboPosition);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
-        glEnableVertexAttribArray(0);
-        glBindBuffer(GL_ARRAY_BUFFER, gp->vboNormal);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
-        glEnableVertexAttribArray(1);
-        glBindBuffer(GL_ARRAY_BUFFER, gp->vboTangent);
-        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 0, 0);
-        glEnableVertexAttribArray(2);
-        glBindBuffer(GL_ARRAY_BUFFER, gp->vboTexCoord0);
-        glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, 0, 0);
-        glEnableVertexAttribArray(3);
-        if (gp->vboJoints)
+    glGenVertexArrays(1, &gp->vao);
+    glBindVertexArray(gp->vao);
+
+    for (l = 0; l < GLUS_GLTF_STREAMS; l++)
+    {
+        if (staging->enabled[l])
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, gp->vbo ? gp->vbo : *names[l]);
+            glVertexAttribPointer((GLuint)l, staging->format[l].components, staging->format[l].type, staging->format[l].normalized, gp->vertexStride, (const GLvoid*)(gp->vertexOffset + (GLintptr)staging->offsets[l]));
+            glEnableVertexAttribArray((GLuint)l);
+        }
+        else if (l != 4 && l != 5)
         {
-            glBindBuffer(GL_ARRAY_BUFFER, gp->vboJoints);
-            glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, 0, 0);
-            glEnableVertexAttribArray(4);
-            glBindBuffer(GL_ARRAY_BUFFER, gp->vboWeights);
-            glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, 0, 0);
-            glEnableVertexAttribArray(5);
+            /* When absent a constant default is used so the shader always has valid input. */
+            glVertexAttrib4fv((GLuint)l, gltfStreamDefaults[l]);
         }
+    }
 
-        /* TEXCOORD_1 (location 6) and COLOR_0 (location 7). When absent a
-         * constant default is used so the shader always has valid input. */
-        if (gp->vboTexCoord1)
+    if (gp->ibo)
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gp->ibo);
+    }
+    glBindVertexArray(0);
+}
+
+/* Take over the geometry of a primitive uploaded for another node instancing the same mesh. */
+static GLUSvoid gltfShareGeometry(GLUSgltfPrimitive* gp, const GLUSgltfPrimitive* owner)
+{
+    gp->vao               = owner->vao;
+    gp->vboPosition       = owner->vboPosition;
+    gp->vboNormal         = owner->vboNormal;
+    gp->vboTangent        = owner->vboTangent;
+    gp->vboTexCoord0      = owner->vboTexCoord0;
+    gp->vboJoints         = owner->vboJoints;
+    gp->vboWeights        = owner->vboWeights;
+    gp->vboTexCoord1      = owner->vboTexCoord1;
+    gp->vboColor          = owner->vboColor;
+    gp->ibo               = owner->ibo;
+    gp->vbo               = owner->vbo;
+    gp->vertexStride      = owner->vertexStride;
+    gp->vertexOffset      = owner->vertexOffset;
+    gp->indexOffset       = owner->indexOffset;
+    gp->vertexCount       = owner->vertexCount;
+    gp->indexCount        = owner->indexCount;
+    gp->indexType         = owner->indexType;
+    gp->morphTargetCount  = owner->morphTargetCount;
+    gp->morphPositionSSBO = owner->morphPositionSSBO;
+    gp->morphNormalSSBO   = owner->morphNormalSSBO;
+    gp->morphTangentSSBO  = owner->morphTangentSSBO;
+    gp->geometryIndex     = owner->geometryIndex;
+}
+
+/* Prepare the primitives of a node on the loading thread. Each primitive is
+ * published for uploading as soon as it is prepared. */
+static GLUSvoid gltfPrepareNodeMeshes(GLUSgltfLoadContext* ctx, GLint nodeIndex, GLint* cursor)
+{
+    GLUSgltfScene* scene = ctx->scene;
+    cgltf_data*    data = scene->cgltfData;
+    cgltf_node*    cnode = &data->nodes[nodeIndex];
+    cgltf_mesh*    mesh = cnode->mesh;
+    GLint          meshIndex = scene->nodes[nodeIndex].meshIndex;
+    GLint          skinIdx = scene->nodes[nodeIndex].skinIndex;
+    GLint          pi;
+
+    for (pi = 0; pi < (GLint)mesh->primitives_count; pi++)
+    {
+        cgltf_primitive*         prim = &mesh->primitives[pi];
+        GLUSgltfPrimitive*       gp;
+        const GLUSgltfPrimitive* owner;
+        GLUSgltfGeometry*        geometry;
+        GLUSgltfGeometryStaging* staging;
+        cgltf_accessor*          accPos;
+        GLint                    skinned;
+        GLint*                   lookup;
+        GLfloat                  tmp[16];
+        GLint                    ti;
+        GLUSboolean              idle;
+        cgltf_float*             weights;
+        cgltf_size               weightCount;
+
+        accPos = gltfFindAttribute(prim, cgltf_attribute_type_position, 0);
+        if (!accPos)
         {
-            glBindBuffer(GL_ARRAY_BUFFER, gp->vboTexCoord1);
-            glVertexAttribPointer(6, 2, GL_FLOAT, GL_FALSE, 0, 0);
-            glEnableVertexAttribArray(6);
+            continue;
         }
-        else
+
+        /* The scratch memory can be reused, once all prepared geometry is uploaded. */
+        gltfLock(ctx);
+        idle = ctx->primitivesUploaded == *cursor ? GLUS_TRUE : GLUS_FALSE;
+        gltfUnlock(ctx);
+        if (idle || !ctx->scratchInUse)
         {
-            glVertexAttrib2f(6, 0.0f, 0.0f);
+            glusMemoryArenaReset(&ctx->scratch);
+            ctx->scratchInUse = GLUS_FALSE;
         }
-        if (gp->vboColor)
+
+        gp = &scene->primitives[*cursor];
+        memset(gp, 0, sizeof(*gp));
+        gp->nodeIndex = nodeIndex;
+        gp->skinIndex = skinIdx;
+        gp->mode      = gltfPrimitiveMode(prim->type);
+        gp->indexType = GL_UNSIGNED_INT;
+
+        ctx->sourcePrimitives[*cursor] = prim;
+
+        /* The geometry depends on the mesh primitive and, through the joint
+         * and weight streams, on the node being skinned. */
+        skinned = (skinIdx >= 0 && gltfFindAttribute(prim, cgltf_attribute_type_joints, 0) && gltfFindAttribute(prim, cgltf_attribute_type_weights, 0)) ? 1 : 0;
+        lookup  = &ctx->geometryLookup[(ctx->meshPrimitiveOffsets[meshIndex] + pi) * 2 + skinned];
+
+        if (*lookup > 0)
         {
-            glBindBuffer(GL_ARRAY_BUFFER, gp->vboColor);
-            glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, 0, 0);
-            glEnableVertexAttribArray(7);
+            /* The GL names of the owner are taken over when the primitive is uploaded,
+             * as they may still be written on the context thread. */
+            owner                = &scene->primitives[*lookup - 1];
+            gp->vertexStride     = owner->vertexStride;
+            gp->vertexOffset     = owner->vertexOffset;
+            gp->indexOffset      = owner->indexOffset;
+            gp->vertexCount      = owner->vertexCount;
+            gp->indexCount       = owner->indexCount;
+            gp->indexType        = owner->indexType;
+            gp->morphTargetCount = owner->morphTargetCount;
+            gp->geometryIndex    = owner->geometryIndex;
         }
         else
         {
-            glVertexAttrib4f(7, 1.0f, 1.0f, 1.0f, 1.0f);
-        }
+            geometry = &scene->geometries[scene->geometryCount];
+            staging  = &ctx->geometryStagings[scene->geometryCount];
+            geometry->meshIndex     = meshIndex;
+            geometry->meshPrimitive = pi;
+            geometry->skinned       = skinned;
+            geometry->byteSize      = gltfPrepareGeometry(ctx, gp, prim, skinned, staging);
+            staging->owner          = *cursor;
+            if (staging->bufferCount > 0)
+            {
+                ctx->scratchInUse = GLUS_TRUE;
+            }
 
-        if (gp->ibo)
-        {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gp->ibo);
+            gp->geometryIndex = scene->geometryCount++;
+            *lookup           = *cursor + 1;
         }
-        glBindVertexArray(0);
-
-        gltfFillMaterial(ctx, &gp->material, prim->material, accTan);
+        scene->geometries[gp->geometryIndex].referenceCount++;
 
-        memcpy(gp->modelMatrix, scene->nodes[nodeIndex].worldMatrix, sizeof(gp->modelMatrix));
+        memcpy(gp->modelMatrix, &ctx->worldMatrices[nodeIndex * 16], sizeof(gp->modelMatrix));
         memcpy(tmp, gp->modelMatrix, sizeof(tmp));
         glusMatrix4x4Inversef(tmp);
         glusMatrix4x4Transposef(tmp);
         glusMatrix4x4ExtractMatrix3x3f(gp->normalMatrix, tmp);
 
-        /* Morph targets (core): default weights + delta SSBO upload. */
-        gp->morphTargetCount = (GLint)prim->targets_count;
-        if (gp->morphTargetCount > GLUS_GLTF_MAX_MORPH_TARGETS)
-        {
-            glusLogPrint(GLUS_LOG_WARNING, "glTF: %d morph targets, clamping to %d",
-                         gp->morphTargetCount, GLUS_GLTF_MAX_MORPH_TARGETS);
-            gp->morphTargetCount = GLUS_GLTF_MAX_MORPH_TARGETS;
-        }
+        /* Morph targets (core): default weights of the node or the mesh. */
         if (gp->morphTargetCount > 0)
         {
             weights     = cnode->weights_count ? cnode->weights : mesh->weights;
@@ -886,14 +1608,44 @@ static GLUSvoid gltfProcessNodeMeshes(GLUSgltfLoadContext* ctx, GLint nodeIndex,
             {
                 gp->morphWeights[ti] = ((cgltf_size)ti < weightCount) ? (GLfloat)weights[ti] : 0.0f;
             }
-            gltfUploadMorphDeltas(gp, prim, vertCount, gp->morphTargetCount);
         }
 
         if (accPos->has_min && accPos->has_max)
         {
             gltfExpandBounds(scene, accPos->min, accPos->max, gp->modelMatrix);
         }
+
+        (*cursor)++;
+
+        gltfLock(ctx);
+        ctx->primitivesPrepared = *cursor;
+        gltfUnlock(ctx);
+        gltfPublished(ctx);
+    }
+}
+
+/* Create the GL objects of a prepared primitive on the context thread. */
+static size_t gltfUploadPrimitive(GLUSgltfLoadContext* ctx, GLint index)
+{
+    GLUSgltfScene*                 scene = ctx->scene;
+    GLUSgltfPrimitive*             gp = &scene->primitives[index];
+    const GLUSgltfGeometryStaging* staging = &ctx->geometryStagings[gp->geometryIndex];
+    cgltf_primitive*               prim = ctx->sourcePrimitives[index];
+    size_t                         byteSize = 0;
+
+    if (staging->owner == index)
+    {
+        gltfUploadGeometry(ctx, gp, staging);
+        byteSize = scene->geometries[gp->geometryIndex].byteSize;
+    }
+    else
+    {
+        gltfShareGeometry(gp, &scene->primitives[staging->owner]);
     }
+
+    gltfFillMaterial(ctx, &gp->material, prim->material, gltfFindAttribute(prim, cgltf_attribute_type_tangent, 0));
+
+    return byteSize;
 }
 
 static GLUSvoid gltfBuildNodes(GLUSgltfScene* scene)
@@ -1034,8 +1786,9 @@ static GLUSvoid gltfBuildRootNodes(GLUSgltfScene* scene, GLint sceneIndex)
 
 static GLUSvoid gltfBuildSkins(GLUSgltfScene* scene)
 {
-    cgltf_data* data = scene->cgltfData;
-    GLint       si, ji;
+    cgltf_data*     data = scene->cgltfData;
+    GLint           si, ji;
+    GLUSmemoryArena scratch;
 
     scene->skinCount = (GLint)data->skins_count;
     if (scene->skinCount <= 0)
@@ -1044,6 +1797,8 @@ static GLUSvoid gltfBuildSkins(GLUSgltfScene* scene)
     }
     scene->skins = (GLUSgltfSkin*)calloc((size_t)scene->skinCount, sizeof(GLUSgltfSkin));
 
+    glusMemoryArenaBegin(&scratch, 0);
+
     for (si = 0; si < scene->skinCount; si++)
     {
         cgltf_skin*   cs = &data->skins[si];
@@ -1076,14 +1831,16 @@ static GLUSvoid gltfBuildSkins(GLUSgltfScene* scene)
             {
                 rc = gs->jointCount;
             }
-            ibm = gltfReadAccessorFloats(cs->inverse_bind_matrices, 16);
+            glusMemoryArenaReset(&scratch);
+            ibm = gltfReadAccessorFloats(&scratch, cs->inverse_bind_matrices, 16);
             if (ibm)
             {
                 memcpy(gs->inverseBindMatrices, ibm, (size_t)rc * 16 * sizeof(GLfloat));
-                free(ibm);
             }
         }
     }
+
+    glusMemoryArenaEnd(&scratch);
 }
 
 static GLUSvoid gltfBuildAnimations(GLUSgltfScene* scene)
@@ -1163,8 +1920,8 @@ static GLUSvoid gltfBuildAnimations(GLUSgltfScene* scene)
             ac->keyframeCount = (GLint)sampler->input->count;
             ac->componentCount = comp;
 
-            ac->times  = gltfReadAccessorFloats(sampler->input, 1);
-            ac->values = gltfReadAccessorFloats(sampler->output, comp);
+            ac->times  = gltfReadAccessorFloats(NULL, sampler->input, 1);
+            ac->values = gltfReadAccessorFloats(NULL, sampler->output, comp);
             if (!ac->times || !ac->values)
             {
                 free(ac->times);
@@ -1431,41 +2188,248 @@ static GLUSvoid gltfApplyAnimation(GLUSgltfScene* scene)
     }
 }
 
-GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadSceneWith(const GLUSchar* filename, const GLUSgltfLoadOptions* options, GLUSgltfScene* scene)
+/* At least one object is uploaded per call, then until a budget is used up. */
+static GLUSboolean gltfBudgetLeft(GLUSboolean uploaded, size_t bytes, size_t byteBudget, GLUSdouble startTime, GLUSdouble timeBudget)
 {
-    cgltf_options       gltfOptions;
-    cgltf_data*         data = NULL;
-    cgltf_result        res;
-    GLUSgltfLoadContext ctx;
-    GLint               sceneIndex;
-    GLUSboolean         sRGB;
-    GLUSboolean         uploadMeshes;
-    GLint               cursor = 0;
-    GLint               ni;
-    GLint               totalPrimitives = 0;
-    GLint               imgCap;
-    GLint               i;
-    GLfloat             dx, dy, dz;
+    if (!uploaded)
+    {
+        return GLUS_TRUE;
+    }
+    if (byteBudget > 0 && bytes >= byteBudget)
+    {
+        return GLUS_FALSE;
+    }
+    if (timeBudget > 0.0 && glfwGetTime() - startTime >= timeBudget)
+    {
+        return GLUS_FALSE;
+    }
+    return GLUS_TRUE;
+}
 
-    if (!filename || !scene)
+/* Create the OpenGL objects of everything prepared so far, in order: the
+ * textures, the scene buffer and the primitives. Called on the context thread.
+ * Returns GLUS_TRUE, when the scene is complete or loading failed. */
+static GLUSboolean gltfUploadReady(GLUSgltfLoadContext* ctx, GLUSdouble timeBudget, size_t byteBudget)
+{
+    GLUSgltfScene* scene = ctx->scene;
+    GLUSdouble     startTime = timeBudget > 0.0 ? glfwGetTime() : 0.0;
+    size_t         bytes = 0;
+    GLUSboolean    uploaded = GLUS_FALSE;
+    GLUSboolean    sceneReady;
+    GLUSboolean    imagesCollected;
+    GLUSboolean    cpuDone;
+    GLUSboolean    failed;
+    GLint          imagesDecoded;
+    GLint          primitivesPrepared;
+    size_t         chunk;
+    GLint          i;
+    GLfloat        dx, dy, dz;
+
+    if (ctx->gpuDone)
+    {
+        return GLUS_TRUE;
+    }
+
+    gltfLock(ctx);
+    sceneReady         = ctx->sceneReady;
+    imagesCollected    = ctx->imagesCollected;
+    cpuDone            = ctx->cpuDone;
+    failed             = ctx->failed;
+    imagesDecoded      = ctx->imagesDecoded;
+    primitivesPrepared = ctx->primitivesPrepared;
+    gltfUnlock(ctx);
+
+    if (cpuDone && failed)
+    {
+        ctx->gpuDone = GLUS_TRUE;
+        return GLUS_TRUE;
+    }
+    if (!sceneReady)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!ctx->gpuStarted)
+    {
+        ctx->gpuStarted = GLUS_TRUE;
+        if (ctx->uploadMeshes)
+        {
+            scene->defaultWhiteTexture  = gltfCreateTexture1x1(255, 255, 255, 255);
+            scene->defaultNormalTexture = gltfCreateTexture1x1(128, 128, 255, 255);
+        }
+    }
+
+    while (ctx->imagesUploaded < imagesDecoded && gltfBudgetLeft(uploaded, bytes, byteBudget, startTime, timeBudget))
+    {
+        GLUSgltfImageCacheEntry* entry = &ctx->cache[ctx->imagesUploaded];
+
+        bytes += (size_t)entry->width * (size_t)entry->height * 4;
+        gltfUploadImage(entry);
+        uploaded = GLUS_TRUE;
+
+        gltfLock(ctx);
+        ctx->imagesUploaded++;
+        gltfUnlock(ctx);
+    }
+
+    /* The materials reference the textures, so the primitives follow the images. */
+    if (!imagesCollected || ctx->imagesUploaded < ctx->cacheCount)
+    {
+        return GLUS_FALSE;
+    }
+
+    /* The scene buffer is complete, when the last primitive is packed. Large
+     * buffers are uploaded in chunks to stay within the budget. */
+    if (ctx->layout == GLUS_GLTF_LAYOUT_SCENE && ctx->uploadMeshes)
+    {
+        if (!cpuDone)
+        {
+            return GLUS_FALSE;
+        }
+        if (!scene->sceneBuffer && ctx->stagingSize > 0)
+        {
+            glGenBuffers(1, &scene->sceneBuffer);
+            glBindBuffer(GL_ARRAY_BUFFER, scene->sceneBuffer);
+            if (timeBudget <= 0.0 && byteBudget == 0)
+            {
+                glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)ctx->stagingSize, ctx->staging, GL_STATIC_DRAW);
+                ctx->stagingUploaded = ctx->stagingSize;
+            }
+            else
+            {
+                glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)ctx->stagingSize, NULL, GL_STATIC_DRAW);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        while (ctx->stagingUploaded < ctx->stagingSize && gltfBudgetLeft(uploaded, bytes, byteBudget, startTime, timeBudget))
+        {
+            chunk = ctx->stagingSize - ctx->stagingUploaded;
+            if (byteBudget > bytes && chunk > byteBudget - bytes)
+            {
+                chunk = byteBudget - bytes;
+            }
+            else if (byteBudget == 0 && chunk > 4 * 1024 * 1024)
+            {
+                chunk = 4 * 1024 * 1024;
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, scene->sceneBuffer);
+            glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)ctx->stagingUploaded, (GLsizeiptr)chunk, ctx->staging + ctx->stagingUploaded);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            ctx->stagingUploaded += chunk;
+            bytes += chunk;
+            uploaded = GLUS_TRUE;
+        }
+        if (ctx->stagingUploaded < ctx->stagingSize)
+        {
+            return GLUS_FALSE;
+        }
+    }
+
+    while (ctx->primitivesUploaded < primitivesPrepared && gltfBudgetLeft(uploaded, bytes, byteBudget, startTime, timeBudget))
+    {
+        bytes += gltfUploadPrimitive(ctx, ctx->primitivesUploaded);
+        uploaded = GLUS_TRUE;
+
+        gltfLock(ctx);
+        ctx->primitivesUploaded++;
+        gltfUnlock(ctx);
+        scene->primitiveCount = ctx->primitivesUploaded;
+    }
+
+    if (!cpuDone || ctx->primitivesUploaded < primitivesPrepared)
     {
         return GLUS_FALSE;
     }
+
+    if (ctx->uploadMeshes)
+    {
+        if (ctx->cacheCount > 0)
+        {
+            scene->textures = (GLuint*)malloc(sizeof(GLuint) * (size_t)ctx->cacheCount);
+            for (i = 0; i < ctx->cacheCount; i++)
+            {
+                /* Images failing to load use the default texture. */
+                if (ctx->cache[i].texture)
+                {
+                    scene->textures[scene->textureCount++] = ctx->cache[i].texture;
+                }
+            }
+        }
+
+        if (scene->primitiveCount > 0)
+        {
+            scene->sceneCenter[0] = (scene->sceneMin[0] + scene->sceneMax[0]) * 0.5f;
+            scene->sceneCenter[1] = (scene->sceneMin[1] + scene->sceneMax[1]) * 0.5f;
+            scene->sceneCenter[2] = (scene->sceneMin[2] + scene->sceneMax[2]) * 0.5f;
+            dx                    = scene->sceneMax[0] - scene->sceneMin[0];
+            dy                    = scene->sceneMax[1] - scene->sceneMin[1];
+            dz                    = scene->sceneMax[2] - scene->sceneMin[2];
+            scene->sceneRadius    = sqrtf(dx * dx + dy * dy + dz * dz) * 0.5f;
+            if (scene->sceneRadius < 0.01f)
+            {
+                scene->sceneRadius = 1.0f;
+            }
+        }
+
+        free(ctx->staging);
+        glusMemoryArenaEnd(&ctx->scratch);
+        free(ctx->geometryLookup);
+        free(ctx->meshPrimitiveOffsets);
+        free(ctx->cache);
+        free(ctx->geometryStagings);
+        free(ctx->sourcePrimitives);
+        free(ctx->worldMatrices);
+    }
+
+    glusLogPrint(GLUS_LOG_INFO, "glTF: loaded '%s' (%d nodes, %d primitives, %d geometries, %d textures, %d animations, %d cameras)",
+                 ctx->filename, scene->nodeCount, scene->primitiveCount, scene->geometryCount, scene->textureCount, scene->animationCount, scene->cameraCount);
+
+    ctx->gpuDone = GLUS_TRUE;
+
+    return GLUS_TRUE;
+}
+
+static GLUSvoid gltfInitContext(GLUSgltfLoadContext* ctx, const GLUSchar* filename, const GLUSgltfLoadOptions* options, GLUSgltfScene* scene)
+{
+    memset(ctx, 0, sizeof(*ctx));
     memset(scene, 0, sizeof(*scene));
     scene->activeAnimation = -1;
 
-    sceneIndex   = options ? options->sceneIndex : -1;
-    sRGB         = options ? options->sRGBColorTextures : GLUS_TRUE;
-    uploadMeshes = options ? options->uploadMeshes : GLUS_TRUE;
+    ctx->scene        = scene;
+    ctx->filename     = filename;
+    ctx->sceneIndex   = options ? options->sceneIndex : -1;
+    ctx->sRGB         = options ? options->sRGBColorTextures : GLUS_TRUE;
+    ctx->uploadMeshes = options ? options->uploadMeshes : GLUS_TRUE;
+    ctx->layout       = options ? options->vertexLayout : GLUS_GLTF_LAYOUT_SEPARATE;
+
+    /* E.g. garbage from an options structure, which was not zero initialised. */
+    if (ctx->layout != GLUS_GLTF_LAYOUT_SEPARATE && ctx->layout != GLUS_GLTF_LAYOUT_INTERLEAVED && ctx->layout != GLUS_GLTF_LAYOUT_SCENE)
+    {
+        glusLogPrint(GLUS_LOG_WARNING, "glTF: unknown vertex layout %u, using GLUS_GLTF_LAYOUT_SEPARATE", (GLUSuint)ctx->layout);
+        ctx->layout = GLUS_GLTF_LAYOUT_SEPARATE;
+    }
+}
+
+/* Parse the asset and build everything not depending on the context. */
+static GLUSboolean gltfLoadStructure(GLUSgltfLoadContext* ctx)
+{
+    GLUSgltfScene* scene = ctx->scene;
+    cgltf_options  gltfOptions;
+    cgltf_data*    data = NULL;
+    cgltf_result   res;
+    GLint          meshPrimitives = 0;
+    GLint          imgCap;
+    GLint          ni;
+    GLint          i;
 
     memset(&gltfOptions, 0, sizeof(gltfOptions));
-    res = cgltf_parse_file(&gltfOptions, filename, &data);
+    res = cgltf_parse_file(&gltfOptions, ctx->filename, &data);
     if (res != cgltf_result_success)
     {
-        glusLogPrint(GLUS_LOG_ERROR, "glTF: cgltf_parse_file failed (%d) for '%s'", res, filename);
+        glusLogPrint(GLUS_LOG_ERROR, "glTF: cgltf_parse_file failed (%d) for '%s'", res, ctx->filename);
         return GLUS_FALSE;
     }
-    res = cgltf_load_buffers(&gltfOptions, data, filename);
+    res = cgltf_load_buffers(&gltfOptions, data, ctx->filename);
     if (res != cgltf_result_success)
     {
         glusLogPrint(GLUS_LOG_ERROR, "glTF: cgltf_load_buffers failed (%d)", res);
@@ -1484,92 +2448,229 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadSceneWith(const GLUSchar* filename,
     }
 
     scene->basePath = (GLUSchar*)malloc(1024);
-    gltfDeriveBasePath(filename, scene->basePath, 1024);
+    gltfDeriveBasePath(ctx->filename, scene->basePath, 1024);
+    ctx->basePath = scene->basePath;
 
     scene->sceneMin[0] = scene->sceneMin[1] = scene->sceneMin[2] = 1e30f;
     scene->sceneMax[0] = scene->sceneMax[1] = scene->sceneMax[2] = -1e30f;
     scene->sceneRadius                                            = 1.0f;
 
     gltfBuildNodes(scene);
-    gltfBuildRootNodes(scene, sceneIndex);
+    gltfBuildRootNodes(scene, ctx->sceneIndex);
     gltfBuildSkins(scene);
     gltfBuildAnimations(scene);
     gltfBuildCameras(scene);
 
     glusGltfUpdateTransforms(scene);
 
-    if (uploadMeshes)
+    if (ctx->uploadMeshes)
     {
-        scene->defaultWhiteTexture  = gltfCreateTexture1x1(255, 255, 255, 255);
-        scene->defaultNormalTexture = gltfCreateTexture1x1(128, 128, 255, 255);
-
         for (ni = 0; ni < scene->nodeCount; ni++)
         {
             if (scene->nodes[ni].meshIndex >= 0)
             {
-                totalPrimitives += (GLint)data->meshes[scene->nodes[ni].meshIndex].primitives_count;
+                ctx->primitiveTotal += (GLint)data->meshes[scene->nodes[ni].meshIndex].primitives_count;
             }
         }
-        if (totalPrimitives > 0)
+        if (ctx->primitiveTotal > 0)
         {
-            scene->primitives = (GLUSgltfPrimitive*)calloc((size_t)totalPrimitives, sizeof(GLUSgltfPrimitive));
+            scene->primitives      = (GLUSgltfPrimitive*)calloc((size_t)ctx->primitiveTotal, sizeof(GLUSgltfPrimitive));
+            scene->geometries      = (GLUSgltfGeometry*)calloc((size_t)ctx->primitiveTotal, sizeof(GLUSgltfGeometry));
+            ctx->geometryStagings  = (GLUSgltfGeometryStaging*)calloc((size_t)ctx->primitiveTotal, sizeof(GLUSgltfGeometryStaging));
+            ctx->sourcePrimitives  = (cgltf_primitive**)calloc((size_t)ctx->primitiveTotal, sizeof(cgltf_primitive*));
         }
 
-        ctx.scene      = scene;
-        ctx.basePath   = scene->basePath;
-        ctx.sRGB       = sRGB;
-        imgCap         = (GLint)data->images_count > 0 ? (GLint)data->images_count : 1;
-        ctx.cache      = (GLUSgltfImageCacheEntry*)calloc((size_t)imgCap, sizeof(GLUSgltfImageCacheEntry));
-        ctx.cacheCount = 0;
-        ctx.cacheCap   = imgCap;
-
-        for (ni = 0; ni < scene->nodeCount; ni++)
+        /* Nodes instancing the same mesh share its geometry. The lookup has a
+         * slot per mesh primitive for the unskinned and the skinned variant. */
+        ctx->meshPrimitiveOffsets = (GLint*)malloc(sizeof(GLint) * ((size_t)data->meshes_count + 1));
+        for (i = 0; i < (GLint)data->meshes_count; i++)
         {
-            if (scene->nodes[ni].meshIndex >= 0)
-            {
-                gltfProcessNodeMeshes(&ctx, ni, &cursor);
-            }
+            ctx->meshPrimitiveOffsets[i] = meshPrimitives;
+            meshPrimitives += (GLint)data->meshes[i].primitives_count;
         }
-        scene->primitiveCount = cursor;
+        ctx->geometryLookup = (GLint*)calloc((size_t)meshPrimitives * 2 + 1, sizeof(GLint));
+
+        imgCap        = (GLint)data->images_count > 0 ? (GLint)data->images_count : 1;
+        ctx->cache    = (GLUSgltfImageCacheEntry*)calloc((size_t)imgCap, sizeof(GLUSgltfImageCacheEntry));
+        ctx->cacheCap = imgCap;
+        glusMemoryArenaBegin(&ctx->scratch, 0);
 
-        if (ctx.cacheCount > 0)
+        ctx->worldMatrices = (GLfloat*)malloc(sizeof(GLfloat) * 16 * ((size_t)scene->nodeCount + 1));
+        for (ni = 0; ni < scene->nodeCount; ni++)
         {
-            scene->textures = (GLuint*)malloc(sizeof(GLuint) * (size_t)ctx.cacheCount);
-            for (i = 0; i < ctx.cacheCount; i++)
-            {
-                scene->textures[i] = ctx.cache[i].texture;
-            }
-            scene->textureCount = ctx.cacheCount;
+            memcpy(&ctx->worldMatrices[ni * 16], scene->nodes[ni].worldMatrix, sizeof(GLfloat) * 16);
         }
-        free(ctx.cache);
+    }
 
-        if (scene->primitiveCount > 0)
+    if (scene->animationCount > 0)
+    {
+        glusGltfSetActiveAnimation(scene, 0);
+    }
+
+    return GLUS_TRUE;
+}
+
+/* Everything not needing the context: parsing, decoding the images and converting the accessors. */
+static GLUSvoid gltfLoadCpu(GLUSgltfLoadContext* ctx)
+{
+    GLUSgltfScene* scene = ctx->scene;
+    GLint          cursor = 0;
+    GLint          ni;
+
+    if (!gltfLoadStructure(ctx))
+    {
+        gltfLock(ctx);
+        ctx->failed  = GLUS_TRUE;
+        ctx->cpuDone = GLUS_TRUE;
+        gltfUnlock(ctx);
+        return;
+    }
+
+    gltfLock(ctx);
+    ctx->sceneReady = GLUS_TRUE;
+    gltfUnlock(ctx);
+    gltfPublished(ctx);
+
+    if (ctx->uploadMeshes)
+    {
+        gltfDecodeImages(ctx);
+
+        for (ni = 0; ni < scene->nodeCount; ni++)
         {
-            scene->sceneCenter[0] = (scene->sceneMin[0] + scene->sceneMax[0]) * 0.5f;
-            scene->sceneCenter[1] = (scene->sceneMin[1] + scene->sceneMax[1]) * 0.5f;
-            scene->sceneCenter[2] = (scene->sceneMin[2] + scene->sceneMax[2]) * 0.5f;
-            dx                    = scene->sceneMax[0] - scene->sceneMin[0];
-            dy                    = scene->sceneMax[1] - scene->sceneMin[1];
-            dz                    = scene->sceneMax[2] - scene->sceneMin[2];
-            scene->sceneRadius    = sqrtf(dx * dx + dy * dy + dz * dz) * 0.5f;
-            if (scene->sceneRadius < 0.01f)
+            if (scene->nodes[ni].meshIndex >= 0)
             {
-                scene->sceneRadius = 1.0f;
+                gltfPrepareNodeMeshes(ctx, ni, &cursor);
             }
         }
     }
+    else
+    {
+        gltfLock(ctx);
+        ctx->imagesCollected = GLUS_TRUE;
+        gltfUnlock(ctx);
+    }
 
-    if (scene->animationCount > 0)
+    gltfLock(ctx);
+    ctx->cpuDone = GLUS_TRUE;
+    gltfUnlock(ctx);
+    gltfPublished(ctx);
+}
+
+static GLUSvoid gltfLoadThread(GLUSvoid* data, GLUSuint index)
+{
+    (void)index;
+
+    gltfLoadCpu((GLUSgltfLoadContext*)data);
+}
+
+GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadSceneWith(const GLUSchar* filename, const GLUSgltfLoadOptions* options, GLUSgltfScene* scene)
+{
+    GLUSgltfLoadContext ctx;
+
+    if (!filename || !scene)
     {
-        glusGltfSetActiveAnimation(scene, 0);
+        return GLUS_FALSE;
+    }
+
+    gltfInitContext(&ctx, filename, options, scene);
+    gltfLoadCpu(&ctx);
+    gltfUploadReady(&ctx, 0.0, 0);
+
+    return !ctx.failed;
+}
+
+GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadStart(const GLUSchar* filename, const GLUSgltfLoadOptions* options, GLUSgltfScene* scene, GLUSgltfLoader* loader)
+{
+    GLUSgltfAsyncLoad* load;
+
+    if (!filename || !scene || !loader)
+    {
+        return GLUS_FALSE;
+    }
+    memset(loader, 0, sizeof(*loader));
+
+    load = (GLUSgltfAsyncLoad*)calloc(1, sizeof(GLUSgltfAsyncLoad));
+    if (!load)
+    {
+        return GLUS_FALSE;
     }
+    load->filename = gltfCopyString(filename);
+    if (!load->filename)
+    {
+        free(load);
+        return GLUS_FALSE;
+    }
+
+    gltfInitContext(&load->context, load->filename, options, scene);
+    load->context.async = GLUS_TRUE;
 
-    glusLogPrint(GLUS_LOG_INFO, "glTF: loaded '%s' (%d nodes, %d primitives, %d textures, %d animations, %d cameras)",
-                 filename, scene->nodeCount, scene->primitiveCount, scene->textureCount, scene->animationCount, scene->cameraCount);
+    load->thread = _glusThreadStart(gltfLoadThread, &load->context);
+    if (!load->thread)
+    {
+        /* Load on this thread, uploading each step right away. */
+        load->context.async = GLUS_FALSE;
+        gltfLoadCpu(&load->context);
+    }
+
+    loader->handle = load;
 
     return GLUS_TRUE;
 }
 
+GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadPoll(GLUSgltfLoader* loader, GLUSdouble timeBudget, size_t byteBudget)
+{
+    GLUSgltfAsyncLoad*   load;
+    GLUSgltfLoadContext* ctx;
+    GLUSboolean          done;
+
+    if (!loader || !loader->handle)
+    {
+        return GLUS_TRUE;
+    }
+    load = (GLUSgltfAsyncLoad*)loader->handle;
+    ctx  = &load->context;
+
+    done = gltfUploadReady(ctx, timeBudget, byteBudget);
+
+    gltfLock(ctx);
+    loader->sceneReady     = ctx->sceneReady;
+    loader->primitiveTotal = ctx->primitiveTotal;
+    loader->imageTotal     = ctx->imagesCollected ? ctx->cacheCount : 0;
+    gltfUnlock(ctx);
+    loader->imagesUploaded = ctx->imagesUploaded;
+
+    return done;
+}
+
+GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadFinish(GLUSgltfLoader* loader)
+{
+    GLUSgltfAsyncLoad* load;
+    GLUSboolean        result;
+
+    if (!loader || !loader->handle)
+    {
+        return GLUS_FALSE;
+    }
+    load = (GLUSgltfAsyncLoad*)loader->handle;
+
+    while (!glusGltfLoadPoll(loader, 0.0, 0))
+    {
+        _glusThreadSleep(1);
+    }
+    if (load->thread)
+    {
+        _glusThreadJoin(load->thread);
+    }
+
+    result = !load->context.failed;
+
+    free(load->filename);
+    free(load);
+    loader->handle = NULL;
+
+    return result;
+}
+
 GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfLoadScene(const GLUSchar* filename, GLUSgltfScene* scene)
 {
     return glusGltfLoadSceneWith(filename, NULL, scene);
@@ -1588,6 +2689,12 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusGltfDestroyScene(GLUSgltfScene* scene)
         for (i = 0; i < scene->primitiveCount; i++)
         {
             GLUSgltfPrimitive* gp = &scene->primitives[i];
+            free(gp->morphWeights);
+            /* Shared geometry is deleted with its last reference. */
+            if (scene->geometries && --scene->geometries[gp->geometryIndex].referenceCount > 0)
+            {
+                continue;
+            }
             if (gp->vao)
             {
                 glDeleteVertexArrays(1, &gp->vao);
@@ -1624,7 +2731,12 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusGltfDestroyScene(GLUSgltfScene* scene)
             {
                 glDeleteBuffers(1, &gp->vboWeights);
             }
-            if (gp->ibo)
+            /* Packed layouts store the indices in the vertex buffer. */
+            if (gp->vbo && gp->vbo != scene->sceneBuffer)
+            {
+                glDeleteBuffers(1, &gp->vbo);
+            }
+            if (gp->ibo && gp->ibo != gp->vbo && gp->ibo != scene->sceneBuffer)
             {
                 glDeleteBuffers(1, &gp->ibo);
             }
@@ -1640,10 +2752,14 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusGltfDestroyScene(GLUSgltfScene* scene)
             {
                 glDeleteBuffers(1, &gp->morphTangentSSBO);
             }
-            free(gp->morphWeights);
         }
         free(scene->primitives);
     }
+    if (scene->sceneBuffer)
+    {
+        glDeleteBuffers(1, &scene->sceneBuffer);
+    }
+    free(scene->geometries);
     if (scene->nodes)
     {
         for (i = 0; i < scene->nodeCount; i++)
@@ -1845,7 +2961,7 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusGltfDrawPrimitive(const GLUSgltfScene* scene,
     glBindVertexArray(gp->vao);
     if (gp->ibo)
     {
-        glDrawElements(gp->mode, gp->indexCount, gp->indexType, 0);
+        glDrawElements(gp->mode, gp->indexCount, gp->indexType, (const GLvoid*)gp->indexOffset);
     }
     else
     {
@@ -1871,3 +2987,27 @@ GLUSAPI const GLUSchar* GLUSAPIENTRY glusGltfGetBasePath(const GLUSgltfScene* sc
     }
     return scene->basePath;
 }
+
+GLUSAPI GLUSboolean GLUSAPIENTRY glusGltfGetGeometryStatistics(const GLUSgltfScene* scene, GLUSgltfGeometryStatistics* statistics)
+{
+    GLint i;
+
+    if (!statistics)
+    {
+        return GLUS_FALSE;
+    }
+    memset(statistics, 0, sizeof(*statistics));
+    if (!scene)
+    {
+        return GLUS_FALSE;
+    }
+
+    statistics->primitiveCount = scene->primitiveCount;
+    statistics->geometryCount  = scene->geometryCount;
+    for (i = 0; i < scene->geometryCount; i++)
+    {
+        statistics->uploadedBytes += scene->geometries[i].byteSize;
+        statistics->unsharedBytes += scene->geometries[i].byteSize * (size_t)scene->geometries[i].referenceCount;
+    }
+    return GLUS_TRUE;
+}
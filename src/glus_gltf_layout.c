@@ -0,0 +1,148 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "GL/glus.h"
+
+#include <string.h>
+
+/*
+ * CPU side packing of glTF vertex streams. The functions do not call OpenGL,
+ * so the layouts can be built and checked without a context.
+ */
+
+/* Alignment of attributes, vertices and index ranges in bytes. */
+#define GLUS_GLTF_LAYOUT_ALIGNMENT 4
+
+static size_t gltfLayoutAlign(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Computes the offsets of interleaved attributes. Each attribute starts at a
+ * multiple of four bytes. Streams with an element size of 0 are absent and get
+ * the offset 0.
+ *
+ * @return The stride of a vertex, a multiple of four bytes.
+ */
+size_t _glusGltfLayoutVertex(const size_t* elementSizes, GLint numberStreams, size_t* offsets)
+{
+    size_t stride = 0;
+    GLint  i;
+
+    for (i = 0; i < numberStreams; i++)
+    {
+        if (elementSizes[i] == 0)
+        {
+            offsets[i] = 0;
+
+            continue;
+        }
+
+        offsets[i] = stride;
+
+        stride = gltfLayoutAlign(stride + elementSizes[i], GLUS_GLTF_LAYOUT_ALIGNMENT);
+    }
+
+    return stride;
+}
+
+/**
+ * Interleaves the streams of numberVertices vertices. Each source element is
+ * copied to its offset in the vertex; padding bytes are set to zero.
+ */
+GLUSvoid _glusGltfInterleave(GLUSubyte* target, size_t stride, const size_t* offsets, const size_t* elementSizes, const GLUSubyte* const* sources, const size_t* sourceStrides, GLint numberStreams, size_t numberVertices)
+{
+    size_t v;
+    GLint  i;
+
+    memset(target, 0, stride * numberVertices);
+
+    for (i = 0; i < numberStreams; i++)
+    {
+        const GLUSubyte* source = sources[i];
+        GLUSubyte*       vertex = target + offsets[i];
+
+        if (elementSizes[i] == 0 || !source)
+        {
+            continue;
+        }
+
+        /* Common element sizes are copied with a constant size, which the compiler turns into plain moves. */
+        switch (elementSizes[i])
+        {
+        case 4:
+            for (v = 0; v < numberVertices; v++, vertex += stride, source += sourceStrides[i])
+            {
+                memcpy(vertex, source, 4);
+            }
+            break;
+        case 8:
+            for (v = 0; v < numberVertices; v++, vertex += stride, source += sourceStrides[i])
+            {
+                memcpy(vertex, source, 8);
+            }
+            break;
+        case 12:
+            for (v = 0; v < numberVertices; v++, vertex += stride, source += sourceStrides[i])
+            {
+                memcpy(vertex, source, 12);
+            }
+            break;
+        case 16:
+            for (v = 0; v < numberVertices; v++, vertex += stride, source += sourceStrides[i])
+            {
+                memcpy(vertex, source, 16);
+            }
+            break;
+        default:
+            for (v = 0; v < numberVertices; v++, vertex += stride, source += sourceStrides[i])
+            {
+                memcpy(vertex, source, elementSizes[i]);
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * Reserves size bytes at the end of a buffer, of which used bytes are taken.
+ * The range starts at a multiple of the alignment and of four bytes.
+ *
+ * @return The offset of the range.
+ */
+size_t _glusGltfSuballocate(size_t* used, size_t size, size_t alignment)
+{
+    size_t offset;
+
+    if (alignment < GLUS_GLTF_LAYOUT_ALIGNMENT)
+    {
+        alignment = GLUS_GLTF_LAYOUT_ALIGNMENT;
+    }
+
+    /* The vertex stride is a multiple of four, but not necessarily a power of two. */
+    offset = gltfLayoutAlign(*used, alignment);
+
+    *used = offset + size;
+
+    return offset;
+}
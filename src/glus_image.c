@@ -20,8 +20,53 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+// Vector instructions are only used, if they are enabled for the compiler.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+#define GLUS_IMAGE_SSE2
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+#define GLUS_IMAGE_NEON
+
+#endif
+
 #include "GL/glus.h"
 
+/**
+ * Number of samples, which are processed together. Has to be a multiple of four.
+ */
+#define GLUS_IMAGE_SAMPLE_BLOCK 64
+
+extern GLUSvoid _glusImageHdrUnpack(GLUSfloat* target, GLUSenum type, const GLUSvoid* source, size_t numberPixels, GLUSint numberChannels);
+
+/**
+ * Sample points of a block along one axis.
+ */
+typedef struct _GLUSimageSampleAxis
+{
+    /**
+     * Texel, which contains the coordinate.
+     */
+    GLUSint texel[GLUS_IMAGE_SAMPLE_BLOCK];
+
+    /**
+     * Neighbor texel towards the coordinate.
+     */
+    GLUSint neighbor[GLUS_IMAGE_SAMPLE_BLOCK];
+
+    /**
+     * Weight of the texel and of the neighbor.
+     */
+    GLUSfloat weight[GLUS_IMAGE_SAMPLE_BLOCK];
+    GLUSfloat inverseWeight[GLUS_IMAGE_SAMPLE_BLOCK];
+
+} GLUSimageSampleAxis;
+
 GLUSvoid _glusImageGatherSamplePoints(GLUSint sampleIndex[4], GLUSfloat sampleWeight[2], const GLUSfloat st[2], GLUSint width, GLUSint height, GLUSint stride)
 {
     GLUSfloat pixelTexCoord[2];
@@ -104,3 +149,853 @@ GLUSvoid _glusImageGatherSamplePoints(GLUSint sampleIndex[4], GLUSfloat sampleWe
 
     sampleIndex[3] += sampleIndex[2];
 }
+
+#if defined(GLUS_IMAGE_SSE2)
+
+static __m128i glusImageMinEpi32(__m128i a, __m128i b)
+{
+    __m128i greater = _mm_cmpgt_epi32(a, b);
+
+    return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+}
+
+static __m128i glusImageMaxEpi32(__m128i a, __m128i b)
+{
+    __m128i greater = _mm_cmpgt_epi32(a, b);
+
+    return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+}
+
+/**
+ * Floor of four values. Values of 2^23 and more are already integers and are kept, as well as NaN.
+ */
+static __m128 glusImageFloor4(__m128 value)
+{
+    __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(value));
+    __m128 small = _mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), value), _mm_set1_ps(8388608.0f));
+
+    truncated = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, value), _mm_set1_ps(1.0f)));
+
+    return _mm_or_ps(_mm_and_ps(small, truncated), _mm_andnot_ps(small, value));
+}
+
+/**
+ * Gathers the sample points along the s (axis 0) or t (axis 1) axis. The number of samples has to be a multiple of four.
+ */
+static GLUSvoid glusImageGatherAxis(GLUSimageSampleAxis* axis, const GLUSfloat* st, GLUSint axisIndex, GLUSint numberSamples, GLUSint size, GLUSenum wrap)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 range = wrap == GLUS_MIRRORED_REPEAT ? _mm_set1_ps(2.0f) : one;
+    const __m128 scale = _mm_set1_ps((GLUSfloat)size);
+
+    const __m128i period = _mm_set1_epi32(wrap == GLUS_MIRRORED_REPEAT ? 2 * size : size);
+    const __m128i last = _mm_set1_epi32(size - 1);
+    const __m128i lastMirrored = _mm_set1_epi32(2 * size - 1);
+
+    __m128 first, second;
+    __m128 pixelTexCoord;
+    __m128 pixelTexCoordCenter;
+    __m128 delta;
+    __m128 weight;
+
+    __m128i texel;
+    __m128i neighbor;
+    __m128i mirror;
+
+    GLUSint i;
+
+    for (i = 0; i < numberSamples; i += 4)
+    {
+        first = _mm_loadu_ps(st + i * 2);
+        second = _mm_loadu_ps(st + i * 2 + 4);
+
+        if (axisIndex == 0)
+        {
+            pixelTexCoord = _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+        }
+        else
+        {
+            pixelTexCoord = _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+
+        if (wrap == GLUS_REPEAT)
+        {
+            pixelTexCoord = _mm_sub_ps(pixelTexCoord, glusImageFloor4(pixelTexCoord));
+        }
+        else if (wrap == GLUS_MIRRORED_REPEAT)
+        {
+            pixelTexCoord = _mm_mul_ps(pixelTexCoord, half);
+            pixelTexCoord = _mm_sub_ps(pixelTexCoord, glusImageFloor4(pixelTexCoord));
+            pixelTexCoord = _mm_add_ps(pixelTexCoord, pixelTexCoord);
+        }
+
+        // The second operand is returned for NaN, so the coordinate is always in range.
+        pixelTexCoord = _mm_mul_ps(_mm_min_ps(_mm_max_ps(pixelTexCoord, zero), range), scale);
+
+        // The coordinate is not negative, so truncation is the floor.
+        texel = _mm_cvttps_epi32(pixelTexCoord);
+
+        pixelTexCoordCenter = _mm_add_ps(_mm_cvtepi32_ps(texel), half);
+
+        delta = _mm_sub_ps(pixelTexCoordCenter, pixelTexCoord);
+
+        weight = _mm_sub_ps(one, _mm_andnot_ps(sign, delta));
+
+        // A coordinate of exactly 1.0 blends the last texel with its left neighbor, like the single sample functions.
+        if (wrap == GLUS_CLAMP_TO_EDGE)
+        {
+            texel = glusImageMinEpi32(texel, last);
+        }
+
+        // The comparisons are -1 for true.
+        neighbor = _mm_sub_epi32(texel, _mm_castps_si128(_mm_cmplt_ps(delta, zero)));
+        neighbor = _mm_add_epi32(neighbor, _mm_castps_si128(_mm_cmpgt_ps(delta, zero)));
+
+        if (wrap == GLUS_CLAMP_TO_EDGE)
+        {
+            neighbor = glusImageMaxEpi32(glusImageMinEpi32(neighbor, last), _mm_setzero_si128());
+        }
+        else
+        {
+            texel = _mm_sub_epi32(texel, _mm_andnot_si128(_mm_cmpgt_epi32(period, texel), period));
+
+            neighbor = _mm_add_epi32(neighbor, _mm_and_si128(_mm_cmplt_epi32(neighbor, _mm_setzero_si128()), period));
+            neighbor = _mm_sub_epi32(neighbor, _mm_andnot_si128(_mm_cmpgt_epi32(period, neighbor), period));
+
+            if (wrap == GLUS_MIRRORED_REPEAT)
+            {
+                mirror = _mm_cmpgt_epi32(_mm_add_epi32(last, _mm_set1_epi32(1)), texel);
+                texel = _mm_or_si128(_mm_and_si128(mirror, texel), _mm_andnot_si128(mirror, _mm_sub_epi32(lastMirrored, texel)));
+
+                mirror = _mm_cmpgt_epi32(_mm_add_epi32(last, _mm_set1_epi32(1)), neighbor);
+                neighbor = _mm_or_si128(_mm_and_si128(mirror, neighbor), _mm_andnot_si128(mirror, _mm_sub_epi32(lastMirrored, neighbor)));
+            }
+        }
+
+        _mm_storeu_si128((__m128i*)(axis->texel + i), texel);
+        _mm_storeu_si128((__m128i*)(axis->neighbor + i), neighbor);
+        _mm_storeu_ps(axis->weight + i, weight);
+        _mm_storeu_ps(axis->inverseWeight + i, _mm_sub_ps(one, weight));
+    }
+}
+
+static __m128 glusImageBilinear4(__m128 texel00, __m128 texel10, __m128 texel01, __m128 texel11, const GLUSimageSampleAxis* axisS, const GLUSimageSampleAxis* axisT, GLUSint index)
+{
+    __m128 weightS = _mm_set1_ps(axisS->weight[index]);
+    __m128 inverseWeightS = _mm_set1_ps(axisS->inverseWeight[index]);
+    __m128 weightT = _mm_set1_ps(axisT->weight[index]);
+    __m128 inverseWeightT = _mm_set1_ps(axisT->inverseWeight[index]);
+
+    __m128 result;
+
+    // Same order of operations as the single sample functions.
+    result = _mm_mul_ps(_mm_mul_ps(texel00, weightS), weightT);
+    result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(texel10, inverseWeightS), weightT));
+    result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(texel01, weightS), inverseWeightT));
+    result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(texel11, inverseWeightS), inverseWeightT));
+
+    return result;
+}
+
+/**
+ * Loads a texel into the RGB(A) lanes. A single channel is replicated into the RGB lanes.
+ * All texels but the last one of the image are followed by at least one byte.
+ */
+static __m128 glusImageLoadTexelub(const GLUSubyte* texel, const GLUSubyte* lastTexel, const GLUSint stride)
+{
+    GLUSuint value;
+
+    if (stride == 4 || (stride == 3 && texel != lastTexel))
+    {
+        memcpy(&value, texel, 4);
+    }
+    else if (stride == 3)
+    {
+        value = (GLUSuint)texel[0] | ((GLUSuint)texel[1] << 8) | ((GLUSuint)texel[2] << 16);
+    }
+    else
+    {
+        value = (GLUSuint)texel[0] * 0x00010101;
+    }
+
+    return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((GLUSint)value), _mm_setzero_si128()), _mm_setzero_si128()));
+}
+
+static GLUSvoid glusImageFilterTexelsub(GLUSubyte* rgba, const GLUSubyte* data, const GLUSubyte* lastTexel, size_t rowStride, const GLUSint stride, const GLUSimageSampleAxis* axisS, const GLUSimageSampleAxis* axisT, GLUSint numberSamples)
+{
+    const GLUSubyte* row0;
+    const GLUSubyte* row1;
+
+    __m128i result;
+    GLUSuint value;
+
+    GLUSint i;
+
+    for (i = 0; i < numberSamples; i++)
+    {
+        row0 = data + (size_t)axisT->texel[i] * rowStride;
+        row1 = data + (size_t)axisT->neighbor[i] * rowStride;
+
+        result = _mm_cvttps_epi32(glusImageBilinear4(glusImageLoadTexelub(row0 + axisS->texel[i] * stride, lastTexel, stride), glusImageLoadTexelub(row0 + axisS->neighbor[i] * stride, lastTexel, stride), glusImageLoadTexelub(row1 + axisS->texel[i] * stride, lastTexel, stride), glusImageLoadTexelub(row1 + axisS->neighbor[i] * stride, lastTexel, stride), axisS, axisT, i));
+
+        result = _mm_packs_epi32(result, result);
+        value = (GLUSuint)_mm_cvtsi128_si32(_mm_packus_epi16(result, result));
+
+        if (stride != 4)
+        {
+            value |= 0xFF000000;
+        }
+
+        memcpy(rgba + i * 4, &value, 4);
+    }
+}
+
+/**
+ * Loads a texel. A single channel is replicated into all lanes.
+ * All texels but the last one of the image are followed by at least one float.
+ */
+static __m128 glusImageLoadTexelf(const GLUSfloat* texel, const GLUSfloat* lastTexel, const GLUSint stride)
+{
+    if (stride == 4 || (stride == 3 && texel != lastTexel))
+    {
+        return _mm_loadu_ps(texel);
+    }
+    else if (stride == 3)
+    {
+        return _mm_set_ps(0.0f, texel[2], texel[1], texel[0]);
+    }
+
+    return _mm_set1_ps(texel[0]);
+}
+
+static GLUSvoid glusImageFilterTexelsf(GLUSfloat* result, const GLUSfloat* data, const GLUSfloat* lastTexel, size_t rowStride, const GLUSint stride, const GLUSimageSampleAxis* axisS, const GLUSimageSampleAxis* axisT, GLUSint numberSamples)
+{
+    const GLUSfloat* row0;
+    const GLUSfloat* row1;
+
+    __m128 value;
+    GLUSfloat texel[4];
+
+    GLUSint i;
+
+    for (i = 0; i < numberSamples; i++)
+    {
+        row0 = data + (size_t)axisT->texel[i] * rowStride;
+        row1 = data + (size_t)axisT->neighbor[i] * rowStride;
+
+        value = glusImageBilinear4(glusImageLoadTexelf(row0 + axisS->texel[i] * stride, lastTexel, stride), glusImageLoadTexelf(row0 + axisS->neighbor[i] * stride, lastTexel, stride), glusImageLoadTexelf(row1 + axisS->texel[i] * stride, lastTexel, stride), glusImageLoadTexelf(row1 + axisS->neighbor[i] * stride, lastTexel, stride), axisS, axisT, i);
+
+        if (stride == 4)
+        {
+            _mm_storeu_ps(result + i * 4, value);
+        }
+        else if (stride == 3)
+        {
+            _mm_storeu_ps(texel, value);
+
+            memcpy(result + i * 3, texel, 3 * sizeof(GLUSfloat));
+        }
+        else
+        {
+            _mm_store_ss(result + i, value);
+        }
+    }
+}
+
+#elif defined(GLUS_IMAGE_NEON)
+
+/**
+ * Floor of four values. Values of 2^23 and more are already integers and are kept, as well as NaN.
+ */
+static float32x4_t glusImageFloor4(float32x4_t value)
+{
+    float32x4_t truncated = vcvtq_f32_s32(vcvtq_s32_f32(value));
+    uint32x4_t small = vcltq_f32(vabsq_f32(value), vdupq_n_f32(8388608.0f));
+
+    truncated = vsubq_f32(truncated, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(truncated, value), vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+
+    return vbslq_f32(small, truncated, value);
+}
+
+/**
+ * Gathers the sample points along the s (axis 0) or t (axis 1) axis. The number of samples has to be a multiple of four.
+ */
+static GLUSvoid glusImageGatherAxis(GLUSimageSampleAxis* axis, const GLUSfloat* st, GLUSint axisIndex, GLUSint numberSamples, GLUSint size, GLUSenum wrap)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t range = vdupq_n_f32(wrap == GLUS_MIRRORED_REPEAT ? 2.0f : 1.0f);
+    const float32x4_t scale = vdupq_n_f32((GLUSfloat)size);
+
+    const int32x4_t period = vdupq_n_s32(wrap == GLUS_MIRRORED_REPEAT ? 2 * size : size);
+    const int32x4_t last = vdupq_n_s32(size - 1);
+    const int32x4_t lastMirrored = vdupq_n_s32(2 * size - 1);
+
+    float32x4_t pixelTexCoord;
+    float32x4_t pixelTexCoordCenter;
+    float32x4_t delta;
+    float32x4_t weight;
+
+    int32x4_t texel;
+    int32x4_t neighbor;
+
+    GLUSint i;
+
+    for (i = 0; i < numberSamples; i += 4)
+    {
+        pixelTexCoord = axisIndex == 0 ? vld2q_f32(st + i * 2).val[0] : vld2q_f32(st + i * 2).val[1];
+
+        if (wrap == GLUS_REPEAT)
+        {
+            pixelTexCoord = vsubq_f32(pixelTexCoord, glusImageFloor4(pixelTexCoord));
+        }
+        else if (wrap == GLUS_MIRRORED_REPEAT)
+        {
+            pixelTexCoord = vmulq_f32(pixelTexCoord, half);
+            pixelTexCoord = vsubq_f32(pixelTexCoord, glusImageFloor4(pixelTexCoord));
+            pixelTexCoord = vaddq_f32(pixelTexCoord, pixelTexCoord);
+        }
+
+        // The comparison is false for NaN, so the coordinate is always in range.
+        pixelTexCoord = vbslq_f32(vcgeq_f32(pixelTexCoord, zero), pixelTexCoord, zero);
+        pixelTexCoord = vmulq_f32(vminq_f32(pixelTexCoord, range), scale);
+
+        // The coordinate is not negative, so truncation is the floor.
+        texel = vcvtq_s32_f32(pixelTexCoord);
+
+        pixelTexCoordCenter = vaddq_f32(vcvtq_f32_s32(texel), half);
+
+        delta = vsubq_f32(pixelTexCoordCenter, pixelTexCoord);
+
+        weight = vsubq_f32(one, vabsq_f32(delta));
+
+        // A coordinate of exactly 1.0 blends the last texel with its left neighbor, like the single sample functions.
+        if (wrap == GLUS_CLAMP_TO_EDGE)
+        {
+            texel = vminq_s32(texel, last);
+        }
+
+        // The comparisons are -1 for true.
+        neighbor = vsubq_s32(texel, vreinterpretq_s32_u32(vcltq_f32(delta, zero)));
+        neighbor = vaddq_s32(neighbor, vreinterpretq_s32_u32(vcgtq_f32(delta, zero)));
+
+        if (wrap == GLUS_CLAMP_TO_EDGE)
+        {
+            neighbor = vmaxq_s32(vminq_s32(neighbor, last), vdupq_n_s32(0));
+        }
+        else
+        {
+            texel = vsubq_s32(texel, vandq_s32(vreinterpretq_s32_u32(vcgeq_s32(texel, period)), period));
+
+            neighbor = vaddq_s32(neighbor, vandq_s32(vreinterpretq_s32_u32(vcltq_s32(neighbor, vdupq_n_s32(0))), period));
+            neighbor = vsubq_s32(neighbor, vandq_s32(vreinterpretq_s32_u32(vcgeq_s32(neighbor, period)), period));
+
+            if (wrap == GLUS_MIRRORED_REPEAT)
+            {
+                texel = vbslq_s32(vcleq_s32(texel, last), texel, vsubq_s32(lastMirrored, texel));
+
+                neighbor = vbslq_s32(vcleq_s32(neighbor, last), neighbor, vsubq_s32(lastMirrored, neighbor));
+            }
+        }
+
+        vst1q_s32(axis->texel + i, texel);
+        vst1q_s32(axis->neighbor + i, neighbor);
+        vst1q_f32(axis->weight + i, weight);
+        vst1q_f32(axis->inverseWeight + i, vsubq_f32(one, weight));
+    }
+}
+
+static float32x4_t glusImageBilinear4(float32x4_t texel00, float32x4_t texel10, float32x4_t texel01, float32x4_t texel11, const GLUSimageSampleAxis* axisS, const GLUSimageSampleAxis* axisT, GLUSint index)
+{
+    float32x4_t weightS = vdupq_n_f32(axisS->weight[index]);
+    float32x4_t inverseWeightS = vdupq_n_f32(axisS->inverseWeight[index]);
+    float32x4_t weightT = vdupq_n_f32(axisT->weight[index]);
+    float32x4_t inverseWeightT = vdupq_n_f32(axisT->inverseWeight[index]);
+
+    float32x4_t result;
+
+    // Same order of operations as the single sample functions.
+    result = vmulq_f32(vmulq_f32(texel00, weightS), weightT);
+    result = vaddq_f32(result, vmulq_f32(vmulq_f32(texel10, inverseWeightS), weightT));
+    result = vaddq_f32(result, vmulq_f32(vmulq_f32(texel01, weightS), inverseWeightT));
+    result = vaddq_f32(result, vmulq_f32(vmulq_f32(texel11, inverseWeightS), inverseWeightT));
+
+    return result;
+}
+
+/**
+ * Loads a texel into the RGB(A) lanes. A single channel is replicated into the RGB lanes.
+ * All texels but the last one of the image are followed by at least one byte.
+ */
+static float32x4_t glusImageLoadTexelub(const GLUSubyte* texel, const GLUSubyte* lastTexel, const GLUSint stride)
+{
+    GLUSuint value;
+
+    if (stride == 4 || (stride == 3 && texel != lastTexel))
+    {
+        memcpy(&value, texel, 4);
+    }
+    else if (stride == 3)
+    {
+        value = (GLUSuint)texel[0] | ((GLUSuint)texel[1] << 8) | ((GLUSuint)texel[2] << 16);
+    }
+    else
+    {
+        value = (GLUSuint)texel[0] * 0x00010101;
+    }
+
+    return vcvtq_f32_u32(vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(value))))));
+}
+
+static GLUSvoid glusImageFilterTexelsub(GLUSubyte* rgba, const GLUSubyte* data, const GLUSubyte* lastTexel, size_t rowStride, const GLUSint stride, const GLUSimageSampleAxis* axisS, const GLUSimageSampleAxis* axisT, GLUSint numberSamples)
+{
+    const GLUSubyte* row0;
+    const GLUSubyte* row1;
+
+    uint16x4_t result;
+    GLUSuint value;
+
+    GLUSint i;
+
+    for (i = 0; i < numberSamples; i++)
+    {
+        row0 = data + (size_t)axisT->texel[i] * rowStride;
+        row1 = data + (size_t)axisT->neighbor[i] * rowStride;
+
+        result = vmovn_u32(vcvtq_u32_f32(glusImageBilinear4(glusImageLoadTexelub(row0 + axisS->texel[i] * stride, lastTexel, stride), glusImageLoadTexelub(row0 + axisS->neighbor[i] * stride, lastTexel, stride), glusImageLoadTexelub(row1 + axisS->texel[i] * stride, lastTexel, stride), glusImageLoadTexelub(row1 + axisS->neighbor[i] * stride, lastTexel, stride), axisS, axisT, i)));
+
+        value = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(result, result))), 0);
+
+        if (stride != 4)
+        {
+            value |= 0xFF000000;
+        }
+
+        memcpy(rgba + i * 4, &value, 4);
+    }
+}
+
+/**
+ * Loads a texel. A single channel is replicated into all lanes.
+ * All texels but the last one of the image are followed by at least one float.
+ */
+static float32x4_t glusImageLoadTexelf(const GLUSfloat* texel, const GLUSfloat* lastTexel, const GLUSint stride)
+{
+    if (stride == 4 || (stride == 3 && texel != lastTexel))
+    {
+        return vld1q_f32(texel);
+    }
+    else if (stride == 3)
+    {
+        return vsetq_lane_f32(texel[2], vcombine_f32(vld1_f32(texel), vdup_n_f32(0.0f)), 2);
+    }
+
+    return vdupq_n_f32(texel[0]);
+}
+
+static GLUSvoid glusImageFilterTexelsf(GLUSfloat* result, const GLUSfloat* data, const GLUSfloat* lastTexel, size_t rowStride, const GLUSint stride, const GLUSimageSampleAxis* axisS, const GLUSimageSampleAxis* axisT, GLUSint numberSamples)
+{
+    const GLUSfloat* row0;
+    const GLUSfloat* row1;
+
+    float32x4_t value;
+    GLUSfloat texel[4];
+
+    GLUSint i;
+
+    for (i = 0; i < numberSamples; i++)
+    {
+        row0 = data + (size_t)axisT->texel[i] * rowStride;
+        row1 = data + (size_t)axisT->neighbor[i] * rowStride;
+
+        value = glusImageBilinear4(glusImageLoadTexelf(row0 + axisS->texel[i] * stride, lastTexel, stride), glusImageLoadTexelf(row0 + axisS->neighbor[i] * stride, lastTexel, stride), glusImageLoadTexelf(row1 + axisS->texel[i] * stride, lastTexel, stride), glusImageLoadTexelf(row1 + axisS->neighbor[i] * stride, lastTexel, stride), axisS, axisT, i);
+
+        if (stride == 4)
+        {
+            vst1q_f32(result + i * 4, value);
+        }
+        else if (stride == 3)
+        {
+            vst1q_f32(texel, value);
+
+            memcpy(result + i * 3, texel, 3 * sizeof(GLUSfloat));
+        }
+        else
+        {
+            vst1q_lane_f32(result + i, value, 0);
+        }
+    }
+}
+
+#else
+
+/**
+ * Gathers the sample points along the s (axis 0) or t (axis 1) axis.
+ */
+static GLUSvoid glusImageGatherAxis(GLUSimageSampleAxis* axis, const GLUSfloat* st, GLUSint axisIndex, GLUSint numberSamples, GLUSint size, GLUSenum wrap)
+{
+    GLUSfloat range = wrap == GLUS_MIRRORED_REPEAT ? 2.0f : 1.0f;
+    GLUSint period = wrap == GLUS_MIRRORED_REPEAT ? 2 * size : size;
+
+    GLUSfloat pixelTexCoord;
+    GLUSfloat pixelTexCoordCenter;
+    GLUSfloat delta;
+
+    GLUSint texel, neighbor;
+
+    GLUSint i;
+
+    for (i = 0; i < numberSamples; i++)
+    {
+        pixelTexCoord = st[i * 2 + axisIndex];
+
+        if (wrap == GLUS_REPEAT)
+        {
+            pixelTexCoord = pixelTexCoord - floorf(pixelTexCoord);
+        }
+        else if (wrap == GLUS_MIRRORED_REPEAT)
+        {
+            pixelTexCoord = pixelTexCoord * 0.5f;
+            pixelTexCoord = pixelTexCoord - floorf(pixelTexCoord);
+            pixelTexCoord = pixelTexCoord + pixelTexCoord;
+        }
+
+        // Also catches NaN.
+        if (!(pixelTexCoord >= 0.0f))
+        {
+            pixelTexCoord = 0.0f;
+        }
+        else if (pixelTexCoord > range)
+        {
+            pixelTexCoord = range;
+        }
+
+        pixelTexCoord = pixelTexCoord * (GLUSfloat)size;
+
+        texel = (GLUSint)pixelTexCoord;
+
+        pixelTexCoordCenter = (GLUSfloat)texel + 0.5f;
+
+        delta = pixelTexCoordCenter - pixelTexCoord;
+
+        // A coordinate of exactly 1.0 blends the last texel with its left neighbor, like the single sample functions.
+        if (wrap == GLUS_CLAMP_TO_EDGE && texel > size - 1)
+        {
+            texel = size - 1;
+        }
+
+        neighbor = texel;
+        if (delta > 0.0f)
+        {
+            neighbor--;
+        }
+        else if (delta < 0.0f)
+        {
+            neighbor++;
+        }
+
+        if (wrap == GLUS_CLAMP_TO_EDGE)
+        {
+            if (neighbor > size - 1)
+            {
+                neighbor = size - 1;
+            }
+            else if (neighbor < 0)
+            {
+                neighbor = 0;
+            }
+        }
+        else
+        {
+            if (texel >= period)
+            {
+                texel -= period;
+            }
+
+            if (neighbor < 0)
+            {
+                neighbor += period;
+            }
+            else if (neighbor >= period)
+            {
+                neighbor -= period;
+            }
+
+            if (wrap == GLUS_MIRRORED_REPEAT)
+            {
+                if (texel >= size)
+                {
+                    texel = period - 1 - texel;
+                }
+
+                if (neighbor >= size)
+                {
+                    neighbor = period - 1 - neighbor;
+                }
+            }
+        }
+
+        axis->texel[i] = texel;
+        axis->neighbor[i] = neighbor;
+        axis->weight[i] = 1.0f - fabsf(delta);
+        axis->inverseWeight[i] = 1.0f - axis->weight[i];
+    }
+}
+
+static GLUSvoid glusImageFilterTexelsub(GLUSubyte* rgba, const GLUSubyte* data, const GLUSubyte* lastTexel, size_t rowStride, const GLUSint stride, const GLUSimageSampleAxis* axisS, const GLUSimageSampleAxis* axisT, GLUSint numberSamples)
+{
+    const GLUSubyte* texel00;
+    const GLUSubyte* texel10;
+    const GLUSubyte* texel01;
+    const GLUSubyte* texel11;
+
+    GLUSfloat value;
+
+    GLUSint i, k;
+
+    (void)lastTexel;
+
+    for (i = 0; i < numberSamples; i++)
+    {
+        texel00 = data + (size_t)axisT->texel[i] * rowStride + axisS->texel[i] * stride;
+        texel10 = data + (size_t)axisT->texel[i] * rowStride + axisS->neighbor[i] * stride;
+        texel01 = data + (size_t)axisT->neighbor[i] * rowStride + axisS->texel[i] * stride;
+        texel11 = data + (size_t)axisT->neighbor[i] * rowStride + axisS->neighbor[i] * stride;
+
+        for (k = 0; k < stride; k++)
+        {
+            value = (GLUSfloat)texel00[k] * axisS->weight[i] * axisT->weight[i];
+            value += (GLUSfloat)texel10[k] * axisS->inverseWeight[i] * axisT->weight[i];
+            value += (GLUSfloat)texel01[k] * axisS->weight[i] * axisT->inverseWeight[i];
+            value += (GLUSfloat)texel11[k] * axisS->inverseWeight[i] * axisT->inverseWeight[i];
+
+            rgba[i * 4 + k] = (GLUSubyte)value;
+        }
+
+        for (k = stride; k < 3; k++)
+        {
+            rgba[i * 4 + k] = rgba[i * 4];
+        }
+
+        if (stride < 4)
+        {
+            rgba[i * 4 + 3] = 255;
+        }
+    }
+}
+
+static GLUSvoid glusImageFilterTexelsf(GLUSfloat* result, const GLUSfloat* data, const GLUSfloat* lastTexel, size_t rowStride, const GLUSint stride, const GLUSimageSampleAxis* axisS, const GLUSimageSampleAxis* axisT, GLUSint numberSamples)
+{
+    const GLUSfloat* texel00;
+    const GLUSfloat* texel10;
+    const GLUSfloat* texel01;
+    const GLUSfloat* texel11;
+
+    GLUSint i, k;
+
+    (void)lastTexel;
+
+    for (i = 0; i < numberSamples; i++)
+    {
+        texel00 = data + (size_t)axisT->texel[i] * rowStride + axisS->texel[i] * stride;
+        texel10 = data + (size_t)axisT->texel[i] * rowStride + axisS->neighbor[i] * stride;
+        texel01 = data + (size_t)axisT->neighbor[i] * rowStride + axisS->texel[i] * stride;
+        texel11 = data + (size_t)axisT->neighbor[i] * rowStride + axisS->neighbor[i] * stride;
+
+        for (k = 0; k < stride; k++)
+        {
+            result[i * stride + k] = texel00[k] * axisS->weight[i] * axisT->weight[i];
+            result[i * stride + k] += texel10[k] * axisS->inverseWeight[i] * axisT->weight[i];
+            result[i * stride + k] += texel01[k] * axisS->weight[i] * axisT->inverseWeight[i];
+            result[i * stride + k] += texel11[k] * axisS->inverseWeight[i] * axisT->inverseWeight[i];
+        }
+    }
+}
+
+#endif
+
+static GLUSboolean glusImageCheckSampleBatch(const GLUSvoid* result, const GLUSvoid* data, GLUSint width, GLUSint height, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT)
+{
+    if (!result || !data || !st || width <= 0 || height <= 0 || numberSamples < 0)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (wrapS != GLUS_REPEAT && wrapS != GLUS_CLAMP_TO_EDGE && wrapS != GLUS_MIRRORED_REPEAT)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (wrapT != GLUS_REPEAT && wrapT != GLUS_CLAMP_TO_EDGE && wrapT != GLUS_MIRRORED_REPEAT)
+    {
+        return GLUS_FALSE;
+    }
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Gathers the sample points of a block of samples. The coordinates of a partial block are padded to a multiple of four samples.
+ *
+ * @return The number of samples in the block.
+ */
+static GLUSint glusImageGatherBlock(GLUSimageSampleAxis* axisS, GLUSimageSampleAxis* axisT, const GLUSfloat* st, GLUSint numberSamples, GLUSint width, GLUSint height, GLUSenum wrapS, GLUSenum wrapT)
+{
+    GLUSfloat padded[2 * GLUS_IMAGE_SAMPLE_BLOCK];
+
+    GLUSint blockSamples = numberSamples;
+
+    if (blockSamples > GLUS_IMAGE_SAMPLE_BLOCK)
+    {
+        blockSamples = GLUS_IMAGE_SAMPLE_BLOCK;
+    }
+
+    if (blockSamples % 4 != 0)
+    {
+        memset(padded, 0, sizeof(padded));
+        memcpy(padded, st, blockSamples * 2 * sizeof(GLUSfloat));
+
+        st = padded;
+    }
+
+    glusImageGatherAxis(axisS, st, 0, (blockSamples + 3) & ~3, width, wrapS);
+    glusImageGatherAxis(axisT, st, 1, (blockSamples + 3) & ~3, height, wrapT);
+
+    return blockSamples;
+}
+
+GLUSboolean _glusImageSampleBatchub(GLUSubyte* rgba, const GLUSubyte* data, GLUSint width, GLUSint height, GLUSint stride, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT)
+{
+    GLUSimageSampleAxis axisS;
+    GLUSimageSampleAxis axisT;
+
+    const GLUSubyte* lastTexel;
+    size_t rowStride;
+
+    GLUSint i, blockSamples;
+
+    if (!glusImageCheckSampleBatch(rgba, data, width, height, st, numberSamples, wrapS, wrapT))
+    {
+        return GLUS_FALSE;
+    }
+
+    lastTexel = data + ((size_t)width * height - 1) * stride;
+    rowStride = (size_t)width * stride;
+
+    for (i = 0; i < numberSamples; i += blockSamples)
+    {
+        blockSamples = glusImageGatherBlock(&axisS, &axisT, st + i * 2, numberSamples - i, width, height, wrapS, wrapT);
+
+        // The stride is a constant in each call, so the texel loads are specialized.
+        if (stride == 4)
+        {
+            glusImageFilterTexelsub(rgba + i * 4, data, lastTexel, rowStride, 4, &axisS, &axisT, blockSamples);
+        }
+        else if (stride == 3)
+        {
+            glusImageFilterTexelsub(rgba + i * 4, data, lastTexel, rowStride, 3, &axisS, &axisT, blockSamples);
+        }
+        else
+        {
+            glusImageFilterTexelsub(rgba + i * 4, data, lastTexel, rowStride, 1, &axisS, &axisT, blockSamples);
+        }
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean _glusImageSampleBatchf(GLUSfloat* result, const GLUSfloat* data, GLUSint width, GLUSint height, GLUSint stride, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT)
+{
+    GLUSimageSampleAxis axisS;
+    GLUSimageSampleAxis axisT;
+
+    const GLUSfloat* lastTexel;
+    size_t rowStride;
+
+    GLUSint i, blockSamples;
+
+    if (!glusImageCheckSampleBatch(result, data, width, height, st, numberSamples, wrapS, wrapT))
+    {
+        return GLUS_FALSE;
+    }
+
+    lastTexel = data + ((size_t)width * height - 1) * stride;
+    rowStride = (size_t)width * stride;
+
+    for (i = 0; i < numberSamples; i += blockSamples)
+    {
+        blockSamples = glusImageGatherBlock(&axisS, &axisT, st + i * 2, numberSamples - i, width, height, wrapS, wrapT);
+
+        // The stride is a constant in each call, so the texel loads are specialized.
+        if (stride == 4)
+        {
+            glusImageFilterTexelsf(result + i * 4, data, lastTexel, rowStride, 4, &axisS, &axisT, blockSamples);
+        }
+        else if (stride == 3)
+        {
+            glusImageFilterTexelsf(result + i * 3, data, lastTexel, rowStride, 3, &axisS, &axisT, blockSamples);
+        }
+        else
+        {
+            glusImageFilterTexelsf(result + i, data, lastTexel, rowStride, 1, &axisS, &axisT, blockSamples);
+        }
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean _glusImageSampleBatchPackedf(GLUSfloat* result, const GLUSubyte* data, GLUSenum type, size_t texelSize, GLUSint width, GLUSint height, GLUSint stride, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT)
+{
+    GLUSimageSampleAxis axisS;
+    GLUSimageSampleAxis axisT;
+
+    // The four texels of each sample are gathered and converted to float at once.
+    GLUSubyte packed[4][GLUS_IMAGE_SAMPLE_BLOCK * 16];
+    GLUSfloat texels[4][GLUS_IMAGE_SAMPLE_BLOCK * 4];
+
+    size_t rowStride;
+
+    GLUSint i, j, k, blockSamples;
+
+    if (!glusImageCheckSampleBatch(result, data, width, height, st, numberSamples, wrapS, wrapT) || texelSize == 0 || texelSize > 16)
+    {
+        return GLUS_FALSE;
+    }
+
+    rowStride = (size_t)width * texelSize;
+
+    for (i = 0; i < numberSamples; i += blockSamples)
+    {
+        blockSamples = glusImageGatherBlock(&axisS, &axisT, st + i * 2, numberSamples - i, width, height, wrapS, wrapT);
+
+        for (j = 0; j < blockSamples; j++)
+        {
+            memcpy(&packed[0][j * texelSize], data + (size_t)axisT.texel[j] * rowStride + axisS.texel[j] * texelSize, texelSize);
+            memcpy(&packed[1][j * texelSize], data + (size_t)axisT.texel[j] * rowStride + axisS.neighbor[j] * texelSize, texelSize);
+            memcpy(&packed[2][j * texelSize], data + (size_t)axisT.neighbor[j] * rowStride + axisS.texel[j] * texelSize, texelSize);
+            memcpy(&packed[3][j * texelSize], data + (size_t)axisT.neighbor[j] * rowStride + axisS.neighbor[j] * texelSize, texelSize);
+        }
+
+        for (k = 0; k < 4; k++)
+        {
+            _glusImageHdrUnpack(texels[k], type, packed[k], blockSamples, stride);
+        }
+
+        for (j = 0; j < blockSamples; j++)
+        {
+            for (k = 0; k < stride; k++)
+            {
+                result[(i + j) * stride + k] = texels[0][j * stride + k] * axisS.weight[j] * axisT.weight[j];
+                result[(i + j) * stride + k] += texels[1][j * stride + k] * axisS.inverseWeight[j] * axisT.weight[j];
+                result[(i + j) * stride + k] += texels[2][j * stride + k] * axisS.weight[j] * axisT.inverseWeight[j];
+                result[(i + j) * stride + k] += texels[3][j * stride + k] * axisS.inverseWeight[j] * axisT.inverseWeight[j];
+            }
+        }
+    }
+
+    return GLUS_TRUE;
+}
@@ -0,0 +1,1127 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// Vector instructions are only used, if they are enabled for the compiler.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+#define GLUS_IMAGE_SSE2
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+#define GLUS_IMAGE_NEON
+
+#endif
+
+#include "GL/glus.h"
+
+/**
+ * Number of blocks, from which a level is decoded or encoded on several threads.
+ */
+#define GLUS_BC_PARALLEL_BLOCKS 1024
+
+/**
+ * Number of least squares refinements of the color end points.
+ */
+#define GLUS_BC_REFINEMENTS 2
+
+/**
+ * Number of iterations for finding the principal axis of the block colors.
+ */
+#define GLUS_BC_AXIS_ITERATIONS 8
+
+extern GLUSvoid _glusThreadRun(GLUSvoid (*function)(GLUSvoid* data, GLUSuint index), GLUSvoid* data, GLUSuint numberTasks, GLUSuint numberThreads);
+extern GLUSuint _glusThreadGetNumberProcessors(GLUSvoid);
+
+/**
+ * Decoding or encoding of a level, which is split into bands of block rows.
+ */
+typedef struct _GLUSbcBands
+{
+    GLUSubyte* blocks;
+    GLUSubyte* pixels;
+
+    GLUSint width;
+    GLUSint height;
+
+    GLUSint numberChannels;
+
+    GLUSint blocksPerRow;
+    GLUSint blockRows;
+    GLUSint blockRowsPerBand;
+
+    GLUSint blockSize;
+
+    GLUSenum internalformat;
+
+} GLUSbcBands;
+
+/**
+ * Weight of the first end point for each color index in four color mode.
+ */
+static const GLUSfloat g_bcColorWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+static GLUSint glusBcClamp(GLUSint value, GLUSint min, GLUSint max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
+
+/**
+ * @return The size of a block in bytes or 0, if the format is not supported.
+ */
+static GLUSint glusBcGetBlockSize(GLUSenum internalformat)
+{
+    switch (internalformat)
+    {
+    case GLUS_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GLUS_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GLUS_COMPRESSED_RED_RGTC1:
+        return 8;
+    case GLUS_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GLUS_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+    case GLUS_COMPRESSED_RG_RGTC2:
+        return 16;
+    }
+
+    return 0;
+}
+
+static GLUSuint glusBcPack565(const GLUSint color[3])
+{
+    return (GLUSuint)(((color[0] * 31 + 127) / 255) << 11 | ((color[1] * 63 + 127) / 255) << 5 | ((color[2] * 31 + 127) / 255));
+}
+
+static GLUSvoid glusBcUnpack565(GLUSint color[3], GLUSuint value)
+{
+    color[0] = (GLUSint)((value >> 11) & 0x1F);
+    color[1] = (GLUSint)((value >> 5) & 0x3F);
+    color[2] = (GLUSint)(value & 0x1F);
+
+    color[0] = (color[0] << 3) | (color[0] >> 2);
+    color[1] = (color[1] << 2) | (color[1] >> 4);
+    color[2] = (color[2] << 3) | (color[2] >> 2);
+}
+
+/**
+ * Builds the four colors of a color block. In three color mode, the last color is transparent black.
+ */
+static GLUSvoid glusBcBuildColorPalette(GLUSint palette[4][4], GLUSuint color0, GLUSuint color1, GLUSboolean fourColors)
+{
+    GLUSint c;
+
+    glusBcUnpack565(palette[0], color0);
+    glusBcUnpack565(palette[1], color1);
+
+    for (c = 0; c < 3; c++)
+    {
+        if (fourColors)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+        }
+        else
+        {
+            palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+            palette[3][c] = 0;
+        }
+    }
+
+    palette[0][3] = 255;
+    palette[1][3] = 255;
+    palette[2][3] = 255;
+    palette[3][3] = fourColors ? 255 : 0;
+}
+
+/**
+ * Builds the eight values of a BC4 block. If the first end point is not greater than the second, six values are interpolated and 0 and 255 are added.
+ */
+static GLUSvoid glusBcBuildValuePalette(GLUSint palette[8], GLUSint value0, GLUSint value1)
+{
+    GLUSint i;
+
+    palette[0] = value0;
+    palette[1] = value1;
+
+    if (value0 > value1)
+    {
+        for (i = 2; i < 8; i++)
+        {
+            palette[i] = ((8 - i) * value0 + (i - 1) * value1 + 3) / 7;
+        }
+    }
+    else
+    {
+        for (i = 2; i < 6; i++)
+        {
+            palette[i] = ((6 - i) * value0 + (i - 1) * value1 + 2) / 5;
+        }
+
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+static GLUSvoid glusBcDecodeColorBlock(GLUSubyte pixels[16][4], const GLUSubyte* block, GLUSboolean alwaysFourColors)
+{
+    GLUSint palette[4][4];
+
+    GLUSuint color0  = (GLUSuint)block[0] | (GLUSuint)block[1] << 8;
+    GLUSuint color1  = (GLUSuint)block[2] | (GLUSuint)block[3] << 8;
+    GLUSuint indices = (GLUSuint)block[4] | (GLUSuint)block[5] << 8 | (GLUSuint)block[6] << 16 | (GLUSuint)block[7] << 24;
+
+    GLUSint i, c;
+
+    glusBcBuildColorPalette(palette, color0, color1, alwaysFourColors || color0 > color1);
+
+    for (i = 0; i < 16; i++)
+    {
+        for (c = 0; c < 4; c++)
+        {
+            pixels[i][c] = (GLUSubyte)palette[(indices >> (2 * i)) & 3][c];
+        }
+    }
+}
+
+static GLUSvoid glusBcDecodeValueBlock(GLUSubyte pixels[16][4], GLUSint channel, const GLUSubyte* block)
+{
+    GLUSint palette[8];
+
+    GLUSuint indices;
+
+    GLUSint i;
+
+    glusBcBuildValuePalette(palette, block[0], block[1]);
+
+    // Sixteen three bit indices, stored as two groups of eight in three bytes each.
+    indices = (GLUSuint)block[2] | (GLUSuint)block[3] << 8 | (GLUSuint)block[4] << 16;
+
+    for (i = 0; i < 8; i++)
+    {
+        pixels[i][channel] = (GLUSubyte)palette[(indices >> (3 * i)) & 7];
+    }
+
+    indices = (GLUSuint)block[5] | (GLUSuint)block[6] << 8 | (GLUSuint)block[7] << 16;
+
+    for (i = 0; i < 8; i++)
+    {
+        pixels[8 + i][channel] = (GLUSubyte)palette[(indices >> (3 * i)) & 7];
+    }
+}
+
+static GLUSvoid glusBcDecodeBlock(GLUSubyte pixels[16][4], const GLUSubyte* block, GLUSenum internalformat)
+{
+    GLUSint i;
+
+    switch (internalformat)
+    {
+    case GLUS_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GLUS_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        glusBcDecodeColorBlock(pixels, block, GLUS_FALSE);
+        break;
+    case GLUS_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GLUS_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        // The color block of BC3 always has four colors.
+        glusBcDecodeColorBlock(pixels, block + 8, GLUS_TRUE);
+        glusBcDecodeValueBlock(pixels, 3, block);
+        break;
+    case GLUS_COMPRESSED_RED_RGTC1:
+        glusBcDecodeValueBlock(pixels, 0, block);
+        break;
+    case GLUS_COMPRESSED_RG_RGTC2:
+        glusBcDecodeValueBlock(pixels, 0, block);
+        glusBcDecodeValueBlock(pixels, 1, block + 8);
+        for (i = 0; i < 16; i++)
+        {
+            pixels[i][2] = 0;
+        }
+        break;
+    }
+}
+
+/**
+ * Selects the closest palette color for each pixel.
+ *
+ * @return The squared error of the block.
+ */
+static GLUSfloat glusBcSelectColors(GLUSuint selected[16], const GLUSfloat red[16], const GLUSfloat green[16], const GLUSfloat blue[16], const GLUSint palette[4][4])
+{
+    GLUSfloat sum;
+
+    GLUSint i, k;
+
+#if defined(GLUS_IMAGE_SSE2)
+    __m128 paletteRed[4];
+    __m128 paletteGreen[4];
+    __m128 paletteBlue[4];
+
+    __m128 r, g, b, difference, error, bestError, closer;
+    __m128 errorSum = _mm_setzero_ps();
+
+    __m128i bestIndex;
+
+    GLUSfloat sums[4];
+
+    for (k = 0; k < 4; k++)
+    {
+        paletteRed[k]   = _mm_set1_ps((GLUSfloat)palette[k][0]);
+        paletteGreen[k] = _mm_set1_ps((GLUSfloat)palette[k][1]);
+        paletteBlue[k]  = _mm_set1_ps((GLUSfloat)palette[k][2]);
+    }
+
+    for (i = 0; i < 16; i += 4)
+    {
+        r = _mm_loadu_ps(red + i);
+        g = _mm_loadu_ps(green + i);
+        b = _mm_loadu_ps(blue + i);
+
+        bestError = _mm_set1_ps(1.0e30f);
+        bestIndex = _mm_setzero_si128();
+
+        for (k = 0; k < 4; k++)
+        {
+            difference = _mm_sub_ps(r, paletteRed[k]);
+            error      = _mm_mul_ps(difference, difference);
+            difference = _mm_sub_ps(g, paletteGreen[k]);
+            error      = _mm_add_ps(error, _mm_mul_ps(difference, difference));
+            difference = _mm_sub_ps(b, paletteBlue[k]);
+            error      = _mm_add_ps(error, _mm_mul_ps(difference, difference));
+
+            closer = _mm_cmplt_ps(error, bestError);
+
+            bestError = _mm_min_ps(error, bestError);
+            bestIndex = _mm_or_si128(_mm_and_si128(_mm_castps_si128(closer), _mm_set1_epi32(k)), _mm_andnot_si128(_mm_castps_si128(closer), bestIndex));
+        }
+
+        errorSum = _mm_add_ps(errorSum, bestError);
+
+        _mm_storeu_si128((__m128i*)(selected + i), bestIndex);
+    }
+
+    _mm_storeu_ps(sums, errorSum);
+
+    sum = sums[0] + sums[1] + sums[2] + sums[3];
+#elif defined(GLUS_IMAGE_NEON)
+    float32x4_t paletteRed[4];
+    float32x4_t paletteGreen[4];
+    float32x4_t paletteBlue[4];
+
+    float32x4_t r, g, b, difference, error, bestError;
+    float32x4_t errorSum = vdupq_n_f32(0.0f);
+
+    uint32x4_t bestIndex, closer;
+
+    for (k = 0; k < 4; k++)
+    {
+        paletteRed[k]   = vdupq_n_f32((GLUSfloat)palette[k][0]);
+        paletteGreen[k] = vdupq_n_f32((GLUSfloat)palette[k][1]);
+        paletteBlue[k]  = vdupq_n_f32((GLUSfloat)palette[k][2]);
+    }
+
+    for (i = 0; i < 16; i += 4)
+    {
+        r = vld1q_f32(red + i);
+        g = vld1q_f32(green + i);
+        b = vld1q_f32(blue + i);
+
+        bestError = vdupq_n_f32(1.0e30f);
+        bestIndex = vdupq_n_u32(0);
+
+        for (k = 0; k < 4; k++)
+        {
+            difference = vsubq_f32(r, paletteRed[k]);
+            error      = vmulq_f32(difference, difference);
+            difference = vsubq_f32(g, paletteGreen[k]);
+            error      = vmlaq_f32(error, difference, difference);
+            difference = vsubq_f32(b, paletteBlue[k]);
+            error      = vmlaq_f32(error, difference, difference);
+
+            closer = vcltq_f32(error, bestError);
+
+            bestError = vminq_f32(error, bestError);
+            bestIndex = vbslq_u32(closer, vdupq_n_u32((uint32_t)k), bestIndex);
+        }
+
+        errorSum = vaddq_f32(errorSum, bestError);
+
+        vst1q_u32(selected + i, bestIndex);
+    }
+
+    sum = vgetq_lane_f32(errorSum, 0) + vgetq_lane_f32(errorSum, 1) + vgetq_lane_f32(errorSum, 2) + vgetq_lane_f32(errorSum, 3);
+#else
+    GLUSfloat difference, error, bestError;
+
+    sum = 0.0f;
+
+    for (i = 0; i < 16; i++)
+    {
+        bestError   = 1.0e30f;
+        selected[i] = 0;
+
+        for (k = 0; k < 4; k++)
+        {
+            difference = red[i] - (GLUSfloat)palette[k][0];
+            error = difference * difference;
+            difference = green[i] - (GLUSfloat)palette[k][1];
+            error += difference * difference;
+            difference = blue[i] - (GLUSfloat)palette[k][2];
+            error += difference * difference;
+
+            if (error < bestError)
+            {
+                bestError   = error;
+                selected[i] = (GLUSuint)k;
+            }
+        }
+
+        sum += bestError;
+    }
+#endif
+
+    return sum;
+}
+
+/**
+ * Evaluates two end points in four color mode.
+ *
+ * @return The squared error of the block.
+ */
+static GLUSfloat glusBcEvaluateColors(GLUSuint* indices, const GLUSfloat red[16], const GLUSfloat green[16], const GLUSfloat blue[16], GLUSuint color0, GLUSuint color1)
+{
+    GLUSint palette[4][4];
+
+    GLUSuint selected[16];
+
+    GLUSfloat error;
+
+    GLUSint i;
+
+    glusBcBuildColorPalette(palette, color0, color1, GLUS_TRUE);
+
+    error = glusBcSelectColors(selected, red, green, blue, (const GLUSint(*)[4])palette);
+
+    *indices = 0;
+    for (i = 0; i < 16; i++)
+    {
+        *indices |= selected[i] << (2 * i);
+    }
+
+    return error;
+}
+
+/**
+ * Fits the end points to the pixels by least squares, keeping the indices.
+ *
+ * @return GLUS_FALSE, if the indices do not allow a fit, e.g. if all select the same end point.
+ */
+static GLUSboolean glusBcRefineColors(GLUSuint* color0, GLUSuint* color1, GLUSuint indices, const GLUSfloat* const channels[3])
+{
+    GLUSfloat alphaSquared = 0.0f;
+    GLUSfloat betaSquared  = 0.0f;
+    GLUSfloat alphaBeta    = 0.0f;
+
+    GLUSfloat alphaPixel[3] = { 0.0f, 0.0f, 0.0f };
+    GLUSfloat betaPixel[3]  = { 0.0f, 0.0f, 0.0f };
+
+    GLUSint endPoint0[3];
+    GLUSint endPoint1[3];
+
+    GLUSfloat alpha, beta, determinant;
+
+    GLUSint i, c;
+
+    for (i = 0; i < 16; i++)
+    {
+        alpha = g_bcColorWeights[(indices >> (2 * i)) & 3];
+        beta  = 1.0f - alpha;
+
+        alphaSquared += alpha * alpha;
+        betaSquared  += beta * beta;
+        alphaBeta    += alpha * beta;
+
+        for (c = 0; c < 3; c++)
+        {
+            alphaPixel[c] += alpha * channels[c][i];
+            betaPixel[c]  += beta * channels[c][i];
+        }
+    }
+
+    determinant = alphaSquared * betaSquared - alphaBeta * alphaBeta;
+
+    if (determinant < 1.0e-3f)
+    {
+        return GLUS_FALSE;
+    }
+
+    for (c = 0; c < 3; c++)
+    {
+        endPoint0[c] = glusBcClamp((GLUSint)((alphaPixel[c] * betaSquared - betaPixel[c] * alphaBeta) / determinant + 0.5f), 0, 255);
+        endPoint1[c] = glusBcClamp((GLUSint)((betaPixel[c] * alphaSquared - alphaPixel[c] * alphaBeta) / determinant + 0.5f), 0, 255);
+    }
+
+    *color0 = glusBcPack565(endPoint0);
+    *color1 = glusBcPack565(endPoint1);
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Encodes the color of a block in four color mode. The initial end points are the extents of the colors along their principal axis,
+ * which are then refined by least squares fitting.
+ */
+static GLUSvoid glusBcEncodeColorBlock(GLUSubyte* block, const GLUSubyte pixels[16][4])
+{
+    GLUSfloat red[16];
+    GLUSfloat green[16];
+    GLUSfloat blue[16];
+
+    const GLUSfloat* const channels[3] = { red, green, blue };
+
+    GLUSfloat mean[3]          = { 0.0f, 0.0f, 0.0f };
+    GLUSfloat covariance[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+    GLUSfloat axis[3];
+    GLUSfloat next[3];
+    GLUSfloat difference[3];
+
+    GLUSint endPoint0[3];
+    GLUSint endPoint1[3];
+
+    GLUSfloat projection, minProjection, maxProjection, length, error, refinedError;
+
+    GLUSuint color0, color1, indices, refinedColor0, refinedColor1, refinedIndices, swap;
+
+    GLUSint i, c, k, iteration;
+
+    for (i = 0; i < 16; i++)
+    {
+        red[i]   = (GLUSfloat)pixels[i][0];
+        green[i] = (GLUSfloat)pixels[i][1];
+        blue[i]  = (GLUSfloat)pixels[i][2];
+
+        for (c = 0; c < 3; c++)
+        {
+            mean[c] += (GLUSfloat)pixels[i][c];
+        }
+    }
+
+    for (c = 0; c < 3; c++)
+    {
+        mean[c] /= 16.0f;
+    }
+
+    for (i = 0; i < 16; i++)
+    {
+        for (c = 0; c < 3; c++)
+        {
+            difference[c] = channels[c][i] - mean[c];
+        }
+
+        for (c = 0; c < 3; c++)
+        {
+            for (k = c; k < 3; k++)
+            {
+                covariance[c][k] += difference[c] * difference[k];
+            }
+        }
+    }
+
+    covariance[1][0] = covariance[0][1];
+    covariance[2][0] = covariance[0][2];
+    covariance[2][1] = covariance[1][2];
+
+    // Power iteration, starting with the diagonal, which is a good guess for most blocks.
+    axis[0] = 1.0f;
+    axis[1] = 1.0f;
+    axis[2] = 1.0f;
+
+    for (iteration = 0; iteration < GLUS_BC_AXIS_ITERATIONS; iteration++)
+    {
+        length = 0.0f;
+
+        for (c = 0; c < 3; c++)
+        {
+            next[c] = covariance[c][0] * axis[0] + covariance[c][1] * axis[1] + covariance[c][2] * axis[2];
+
+            length = fabsf(next[c]) > length ? fabsf(next[c]) : length;
+        }
+
+        if (length < 1.0e-6f)
+        {
+            break;
+        }
+
+        for (c = 0; c < 3; c++)
+        {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    length = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+
+    minProjection = 0.0f;
+    maxProjection = 0.0f;
+
+    for (i = 0; i < 16; i++)
+    {
+        projection = (red[i] - mean[0]) * axis[0] + (green[i] - mean[1]) * axis[1] + (blue[i] - mean[2]) * axis[2];
+
+        minProjection = projection < minProjection ? projection : minProjection;
+        maxProjection = projection > maxProjection ? projection : maxProjection;
+    }
+
+    for (c = 0; c < 3; c++)
+    {
+        endPoint0[c] = glusBcClamp((GLUSint)(mean[c] + axis[c] * maxProjection / length + 0.5f), 0, 255);
+        endPoint1[c] = glusBcClamp((GLUSint)(mean[c] + axis[c] * minProjection / length + 0.5f), 0, 255);
+    }
+
+    color0 = glusBcPack565(endPoint0);
+    color1 = glusBcPack565(endPoint1);
+
+    error = glusBcEvaluateColors(&indices, red, green, blue, color0, color1);
+
+    for (iteration = 0; iteration < GLUS_BC_REFINEMENTS; iteration++)
+    {
+        if (!glusBcRefineColors(&refinedColor0, &refinedColor1, indices, channels))
+        {
+            break;
+        }
+
+        refinedError = glusBcEvaluateColors(&refinedIndices, red, green, blue, refinedColor0, refinedColor1);
+
+        if (refinedError >= error)
+        {
+            break;
+        }
+
+        color0  = refinedColor0;
+        color1  = refinedColor1;
+        indices = refinedIndices;
+        error   = refinedError;
+    }
+
+    // Four color mode requires the first end point to be greater. Swapping the end points swaps index 0 with 1 and 2 with 3.
+    if (color0 < color1)
+    {
+        swap   = color0;
+        color0 = color1;
+        color1 = swap;
+
+        indices ^= 0x55555555;
+    }
+    else if (color0 == color1)
+    {
+        indices = 0;
+    }
+
+    block[0] = (GLUSubyte)color0;
+    block[1] = (GLUSubyte)(color0 >> 8);
+    block[2] = (GLUSubyte)color1;
+    block[3] = (GLUSubyte)(color1 >> 8);
+    block[4] = (GLUSubyte)indices;
+    block[5] = (GLUSubyte)(indices >> 8);
+    block[6] = (GLUSubyte)(indices >> 16);
+    block[7] = (GLUSubyte)(indices >> 24);
+}
+
+/**
+ * Encodes one channel of a block with eight values between the minimum and maximum.
+ */
+static GLUSvoid glusBcEncodeValueBlock(GLUSubyte* block, const GLUSubyte pixels[16][4], GLUSint channel)
+{
+    GLUSubyte values[16];
+    GLUSubyte selected[16];
+
+    GLUSint palette[8];
+
+    GLUSuint indices;
+
+    GLUSint minValue = 255;
+    GLUSint maxValue = 0;
+
+    GLUSint i, k;
+
+#if defined(GLUS_IMAGE_SSE2)
+    __m128i value, paletteValue, difference, bestDifference, closer, bestIndex;
+#elif defined(GLUS_IMAGE_NEON)
+    uint8x16_t value, difference, bestDifference, closer, bestIndex;
+#else
+    GLUSint difference, bestDifference;
+#endif
+
+    for (i = 0; i < 16; i++)
+    {
+        values[i] = pixels[i][channel];
+
+        minValue = values[i] < minValue ? values[i] : minValue;
+        maxValue = values[i] > maxValue ? values[i] : maxValue;
+    }
+
+    block[0] = (GLUSubyte)maxValue;
+    block[1] = (GLUSubyte)minValue;
+
+    if (minValue == maxValue)
+    {
+        memset(block + 2, 0, 6);
+
+        return;
+    }
+
+    glusBcBuildValuePalette(palette, maxValue, minValue);
+
+#if defined(GLUS_IMAGE_SSE2)
+    value = _mm_loadu_si128((const __m128i*)values);
+
+    bestDifference = _mm_set1_epi8((char)0xFF);
+    bestIndex      = _mm_setzero_si128();
+
+    for (k = 0; k < 8; k++)
+    {
+        paletteValue = _mm_set1_epi8((char)palette[k]);
+
+        difference = _mm_or_si128(_mm_subs_epu8(value, paletteValue), _mm_subs_epu8(paletteValue, value));
+
+        // Unsigned difference < best difference, as there is no unsigned byte compare.
+        closer = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_min_epu8(difference, bestDifference), bestDifference), _mm_set1_epi8((char)0xFF));
+
+        bestDifference = _mm_min_epu8(difference, bestDifference);
+        bestIndex      = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi8((char)k)), _mm_andnot_si128(closer, bestIndex));
+    }
+
+    _mm_storeu_si128((__m128i*)selected, bestIndex);
+#elif defined(GLUS_IMAGE_NEON)
+    value = vld1q_u8(values);
+
+    bestDifference = vdupq_n_u8(0xFF);
+    bestIndex      = vdupq_n_u8(0);
+
+    for (k = 0; k < 8; k++)
+    {
+        difference = vabdq_u8(value, vdupq_n_u8((uint8_t)palette[k]));
+
+        closer = vcltq_u8(difference, bestDifference);
+
+        bestDifference = vminq_u8(difference, bestDifference);
+        bestIndex      = vbslq_u8(closer, vdupq_n_u8((uint8_t)k), bestIndex);
+    }
+
+    vst1q_u8(selected, bestIndex);
+#else
+    for (i = 0; i < 16; i++)
+    {
+        bestDifference = 256;
+        selected[i]    = 0;
+
+        for (k = 0; k < 8; k++)
+        {
+            difference = values[i] > palette[k] ? values[i] - palette[k] : palette[k] - values[i];
+
+            if (difference < bestDifference)
+            {
+                bestDifference = difference;
+                selected[i]    = (GLUSubyte)k;
+            }
+        }
+    }
+#endif
+
+    indices = 0;
+    for (i = 0; i < 8; i++)
+    {
+        indices |= (GLUSuint)selected[i] << (3 * i);
+    }
+
+    block[2] = (GLUSubyte)indices;
+    block[3] = (GLUSubyte)(indices >> 8);
+    block[4] = (GLUSubyte)(indices >> 16);
+
+    indices = 0;
+    for (i = 0; i < 8; i++)
+    {
+        indices |= (GLUSuint)selected[8 + i] << (3 * i);
+    }
+
+    block[5] = (GLUSubyte)indices;
+    block[6] = (GLUSubyte)(indices >> 8);
+    block[7] = (GLUSubyte)(indices >> 16);
+}
+
+static GLUSvoid glusBcEncodeBlock(GLUSubyte* block, const GLUSubyte pixels[16][4], GLUSenum internalformat)
+{
+    switch (internalformat)
+    {
+    case GLUS_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GLUS_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        glusBcEncodeColorBlock(block, pixels);
+        break;
+    case GLUS_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GLUS_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        glusBcEncodeValueBlock(block, pixels, 3);
+        glusBcEncodeColorBlock(block + 8, pixels);
+        break;
+    case GLUS_COMPRESSED_RED_RGTC1:
+        glusBcEncodeValueBlock(block, pixels, 0);
+        break;
+    case GLUS_COMPRESSED_RG_RGTC2:
+        glusBcEncodeValueBlock(block, pixels, 0);
+        glusBcEncodeValueBlock(block + 8, pixels, 1);
+        break;
+    }
+}
+
+static GLUSvoid glusBcDecodeBand(GLUSvoid* data, GLUSuint index)
+{
+    GLUSbcBands* bands = (GLUSbcBands*)data;
+
+    GLUSubyte pixels[16][4];
+
+    GLUSubyte* target;
+
+    GLUSint blockX, blockY, x, y, c, width, height;
+
+    GLUSint firstRow = (GLUSint)index * bands->blockRowsPerBand;
+    GLUSint lastRow  = firstRow + bands->blockRowsPerBand;
+
+    if (lastRow > bands->blockRows)
+    {
+        lastRow = bands->blockRows;
+    }
+
+    for (blockY = firstRow; blockY < lastRow; blockY++)
+    {
+        height = bands->height - blockY * 4 < 4 ? bands->height - blockY * 4 : 4;
+
+        for (blockX = 0; blockX < bands->blocksPerRow; blockX++)
+        {
+            glusBcDecodeBlock(pixels, bands->blocks + ((size_t)blockY * bands->blocksPerRow + blockX) * bands->blockSize, bands->internalformat);
+
+            width = bands->width - blockX * 4 < 4 ? bands->width - blockX * 4 : 4;
+
+            for (y = 0; y < height; y++)
+            {
+                target = bands->pixels + (((size_t)blockY * 4 + y) * bands->width + blockX * 4) * bands->numberChannels;
+
+                if (bands->numberChannels == 4)
+                {
+                    memcpy(target, pixels[y * 4], width * 4);
+                }
+                else
+                {
+                    for (x = 0; x < width; x++)
+                    {
+                        for (c = 0; c < bands->numberChannels; c++)
+                        {
+                            target[x * bands->numberChannels + c] = pixels[y * 4 + x][c];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+static GLUSvoid glusBcEncodeBand(GLUSvoid* data, GLUSuint index)
+{
+    GLUSbcBands* bands = (GLUSbcBands*)data;
+
+    GLUSubyte pixels[16][4];
+
+    const GLUSubyte* source;
+
+    GLUSint blockX, blockY, x, y;
+
+    GLUSint firstRow = (GLUSint)index * bands->blockRowsPerBand;
+    GLUSint lastRow  = firstRow + bands->blockRowsPerBand;
+
+    if (lastRow > bands->blockRows)
+    {
+        lastRow = bands->blockRows;
+    }
+
+    for (blockY = firstRow; blockY < lastRow; blockY++)
+    {
+        for (blockX = 0; blockX < bands->blocksPerRow; blockX++)
+        {
+            // Blocks at the right and bottom border repeat the last pixel.
+            for (y = 0; y < 4; y++)
+            {
+                for (x = 0; x < 4; x++)
+                {
+                    source = bands->pixels + ((size_t)glusBcClamp(blockY * 4 + y, 0, bands->height - 1) * bands->width + glusBcClamp(blockX * 4 + x, 0, bands->width - 1)) * bands->numberChannels;
+
+                    if (bands->numberChannels >= 3)
+                    {
+                        pixels[y * 4 + x][0] = source[0];
+                        pixels[y * 4 + x][1] = source[1];
+                        pixels[y * 4 + x][2] = source[2];
+                        pixels[y * 4 + x][3] = bands->numberChannels == 4 ? source[3] : 255;
+                    }
+                    else
+                    {
+                        pixels[y * 4 + x][0] = source[0];
+                        pixels[y * 4 + x][1] = source[0];
+                        pixels[y * 4 + x][2] = source[0];
+                        pixels[y * 4 + x][3] = 255;
+                    }
+                }
+            }
+
+            glusBcEncodeBlock(bands->blocks + ((size_t)blockY * bands->blocksPerRow + blockX) * bands->blockSize, (const GLUSubyte(*)[4])pixels, bands->internalformat);
+        }
+    }
+}
+
+/**
+ * Runs the band function on as many threads as useful.
+ */
+static GLUSvoid glusBcRunBands(GLUSvoid (*function)(GLUSvoid* data, GLUSuint index), GLUSbcBands* bands)
+{
+    GLUSuint numberBands = 1;
+
+    if ((size_t)bands->blocksPerRow * bands->blockRows >= GLUS_BC_PARALLEL_BLOCKS)
+    {
+        numberBands = _glusThreadGetNumberProcessors();
+    }
+
+    if (numberBands > (GLUSuint)bands->blockRows)
+    {
+        numberBands = (GLUSuint)bands->blockRows;
+    }
+
+    bands->blockRowsPerBand = (bands->blockRows + (GLUSint)numberBands - 1) / (GLUSint)numberBands;
+
+    numberBands = (GLUSuint)((bands->blockRows + bands->blockRowsPerBand - 1) / bands->blockRowsPerBand);
+
+    _glusThreadRun(function, bands, numberBands, numberBands);
+}
+
+/**
+ * Compresses the given levels into one allocation.
+ */
+static GLUSboolean glusBcEncodeLevels(GLUSbcimage* bcimage, const GLUStgaimage* levels, GLUSint numberLevels, GLUSenum internalformat)
+{
+    GLUSbcBands bands;
+
+    size_t imageSize = 0;
+    size_t levelSize;
+
+    GLUSint blockSize, width, height, level;
+
+    if (!bcimage)
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(bcimage, 0, sizeof(GLUSbcimage));
+
+    blockSize = glusBcGetBlockSize(internalformat);
+
+    if (blockSize == 0 || numberLevels < 1 || numberLevels > GLUS_MAX_MIPMAP_LEVELS)
+    {
+        return GLUS_FALSE;
+    }
+
+    for (level = 0; level < numberLevels; level++)
+    {
+        width  = levels[0].width >> level;
+        height = levels[0].height >> level;
+
+        width  = width > 0 ? width : 1;
+        height = height > 0 ? height : 1;
+
+        if (!levels[level].data || levels[level].width != width || levels[level].height != height || levels[level].depth > 1)
+        {
+            return GLUS_FALSE;
+        }
+
+        levelSize = (size_t)((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+
+        bcimage->levelOffsets[level] = (GLUSint)imageSize;
+        bcimage->levelSizes[level]   = (GLUSint)levelSize;
+
+        imageSize += levelSize;
+    }
+
+    if (imageSize > 0x7FFFFFFF)
+    {
+        memset(bcimage, 0, sizeof(GLUSbcimage));
+
+        return GLUS_FALSE;
+    }
+
+    bcimage->data = (GLUSubyte*)glusMemoryMalloc(imageSize);
+
+    if (!bcimage->data)
+    {
+        memset(bcimage, 0, sizeof(GLUSbcimage));
+
+        return GLUS_FALSE;
+    }
+
+    for (level = 0; level < numberLevels; level++)
+    {
+        bands.numberChannels = 1;
+        if (levels[level].format == GLUS_RGB)
+        {
+            bands.numberChannels = 3;
+        }
+        else if (levels[level].format == GLUS_RGBA)
+        {
+            bands.numberChannels = 4;
+        }
+
+        bands.width          = levels[level].width;
+        bands.height         = levels[level].height;
+        bands.blocksPerRow   = (bands.width + 3) / 4;
+        bands.blockRows      = (bands.height + 3) / 4;
+        bands.blockSize      = blockSize;
+        bands.internalformat = internalformat;
+
+        bands.pixels = levels[level].data;
+        bands.blocks = bcimage->data + bcimage->levelOffsets[level];
+
+        glusBcRunBands(glusBcEncodeBand, &bands);
+    }
+
+    bcimage->width          = levels[0].width;
+    bcimage->height         = levels[0].height;
+    bcimage->numberLevels   = numberLevels;
+    bcimage->imageSize      = (GLUSint)imageSize;
+    bcimage->internalformat = internalformat;
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageEncodeBc(GLUSbcimage* bcimage, const GLUStgaimage* tgaimage, const GLUSenum internalformat)
+{
+    if (!tgaimage)
+    {
+        return GLUS_FALSE;
+    }
+
+    return glusBcEncodeLevels(bcimage, tgaimage, 1, internalformat);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageEncodeBcMipmaps(GLUSbcimage* bcimage, const GLUStgamipmaps* mipmaps, const GLUSenum internalformat)
+{
+    if (!mipmaps)
+    {
+        return GLUS_FALSE;
+    }
+
+    return glusBcEncodeLevels(bcimage, mipmaps->levels, mipmaps->numberLevels, internalformat);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageDecodeBc(GLUStgaimage* tgaimage, const GLUSbcimage* bcimage, const GLUSint level)
+{
+    GLUSbcBands bands;
+
+    if (!tgaimage || !bcimage || !bcimage->data)
+    {
+        return GLUS_FALSE;
+    }
+
+    tgaimage->width  = 0;
+    tgaimage->height = 0;
+    tgaimage->depth  = 0;
+    tgaimage->data   = 0;
+    tgaimage->format = 0;
+
+    if (level < 0 || level >= bcimage->numberLevels)
+    {
+        return GLUS_FALSE;
+    }
+
+    switch (bcimage->internalformat)
+    {
+    case GLUS_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GLUS_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GLUS_COMPRESSED_RG_RGTC2:
+        tgaimage->format     = GLUS_RGB;
+        bands.numberChannels = 3;
+        break;
+    case GLUS_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GLUS_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        tgaimage->format     = GLUS_RGBA;
+        bands.numberChannels = 4;
+        break;
+    case GLUS_COMPRESSED_RED_RGTC1:
+        tgaimage->format     = GLUS_LUMINANCE;
+        bands.numberChannels = 1;
+        break;
+    default:
+        return GLUS_FALSE;
+    }
+
+    bands.width          = bcimage->width >> level;
+    bands.height         = bcimage->height >> level;
+    bands.width          = bands.width > 0 ? bands.width : 1;
+    bands.height         = bands.height > 0 ? bands.height : 1;
+    bands.blocksPerRow   = (bands.width + 3) / 4;
+    bands.blockRows      = (bands.height + 3) / 4;
+    bands.blockSize      = glusBcGetBlockSize(bcimage->internalformat);
+    bands.internalformat = bcimage->internalformat;
+
+    if (bcimage->levelOffsets[level] < 0 || bcimage->levelSizes[level] < 0 || (size_t)bcimage->levelSizes[level] < (size_t)bands.blocksPerRow * bands.blockRows * bands.blockSize || bcimage->levelOffsets[level] + bcimage->levelSizes[level] > bcimage->imageSize)
+    {
+        tgaimage->format = 0;
+
+        return GLUS_FALSE;
+    }
+
+    bands.blocks = bcimage->data + bcimage->levelOffsets[level];
+    bands.pixels = (GLUSubyte*)glusMemoryMallocAligned((size_t)bands.width * bands.height * bands.numberChannels, GLUS_MEMORY_DATA_ALIGNMENT);
+
+    if (!bands.pixels)
+    {
+        tgaimage->format = 0;
+
+        return GLUS_FALSE;
+    }
+
+    glusBcRunBands(glusBcDecodeBand, &bands);
+
+    tgaimage->width       = (GLUSushort)bands.width;
+    tgaimage->height      = (GLUSushort)bands.height;
+    tgaimage->depth       = 1;
+    tgaimage->data        = bands.pixels;
+    tgaimage->alignedData = bands.pixels;
+
+    return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusImageDestroyBc(GLUSbcimage* bcimage)
+{
+    if (!bcimage)
+    {
+        return;
+    }
+
+    if (bcimage->data)
+    {
+        glusMemoryFree(bcimage->data);
+    }
+
+    memset(bcimage, 0, sizeof(GLUSbcimage));
+}
@@ -0,0 +1,150 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "GL/glus.h"
+
+/**
+ * Size of the DDS magic number and header and of the DX10 header extension.
+ */
+#define GLUS_DDS_HEADER_SIZE 128
+#define GLUS_DDS_HEADER_DX10_SIZE 20
+
+extern GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrite);
+
+static GLUSvoid glusDdsWriteUint(GLUSubyte* buffer, GLUSuint value)
+{
+    buffer[0] = (GLUSubyte)value;
+    buffer[1] = (GLUSubyte)(value >> 8);
+    buffer[2] = (GLUSubyte)(value >> 16);
+    buffer[3] = (GLUSubyte)(value >> 24);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageSaveDds(const GLUSchar* filename, const GLUSbcimage* bcimage)
+{
+    FILE*       file;
+    GLUSubyte   buffer[GLUS_DDS_HEADER_SIZE + GLUS_DDS_HEADER_DX10_SIZE];
+    size_t      headerSize = GLUS_DDS_HEADER_SIZE;
+    size_t      elementsWritten;
+    const char* fourCC;
+    GLUSuint    dxgiFormat = 0;
+    GLUSuint    flags;
+    GLUSuint    caps;
+
+    // check, if we have a valid pointer
+    if (!filename || !bcimage || !bcimage->data || bcimage->imageSize <= 0 || bcimage->numberLevels < 1 || bcimage->numberLevels > GLUS_MAX_MIPMAP_LEVELS)
+    {
+        return GLUS_FALSE;
+    }
+
+    switch (bcimage->internalformat)
+    {
+    case GLUS_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        fourCC = "DXT1";
+        break;
+    case GLUS_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        fourCC = "DXT5";
+        break;
+    case GLUS_COMPRESSED_RED_RGTC1:
+        fourCC = "ATI1";
+        break;
+    case GLUS_COMPRESSED_RG_RGTC2:
+        fourCC = "ATI2";
+        break;
+    case GLUS_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        // DXGI_FORMAT_BC1_UNORM_SRGB
+        fourCC = "DX10";
+        dxgiFormat = 72;
+        break;
+    case GLUS_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        // DXGI_FORMAT_BC3_UNORM_SRGB
+        fourCC = "DX10";
+        dxgiFormat = 78;
+        break;
+    default:
+        return GLUS_FALSE;
+    }
+
+    memset(buffer, 0, sizeof(buffer));
+
+    // DDSD_CAPS, DDSD_HEIGHT, DDSD_WIDTH, DDSD_PIXELFORMAT and DDSD_LINEARSIZE, plus DDSD_MIPMAPCOUNT.
+    flags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x80000;
+    // DDSCAPS_TEXTURE, plus DDSCAPS_COMPLEX and DDSCAPS_MIPMAP.
+    caps = 0x1000;
+
+    if (bcimage->numberLevels > 1)
+    {
+        flags |= 0x20000;
+        caps |= 0x8 | 0x400000;
+    }
+
+    memcpy(buffer, "DDS ", 4);
+
+    glusDdsWriteUint(buffer + 4, 124);
+    glusDdsWriteUint(buffer + 8, flags);
+    glusDdsWriteUint(buffer + 12, bcimage->height);
+    glusDdsWriteUint(buffer + 16, bcimage->width);
+    glusDdsWriteUint(buffer + 20, (GLUSuint)bcimage->levelSizes[0]);
+    glusDdsWriteUint(buffer + 28, (GLUSuint)bcimage->numberLevels);
+
+    // Pixel format with DDPF_FOURCC.
+    glusDdsWriteUint(buffer + 76, 32);
+    glusDdsWriteUint(buffer + 80, 0x4);
+    memcpy(buffer + 84, fourCC, 4);
+
+    glusDdsWriteUint(buffer + 108, caps);
+
+    if (dxgiFormat)
+    {
+        // Two dimensional texture with one array element.
+        glusDdsWriteUint(buffer + 128, dxgiFormat);
+        glusDdsWriteUint(buffer + 132, 3);
+        glusDdsWriteUint(buffer + 140, 1);
+
+        headerSize += GLUS_DDS_HEADER_DX10_SIZE;
+    }
+
+    file = glusFileOpen(filename, "wb");
+
+    if (!file)
+    {
+        return GLUS_FALSE;
+    }
+
+    elementsWritten = fwrite(buffer, 1, headerSize, file);
+
+    if (!_glusFileCheckWrite(file, elementsWritten, headerSize))
+    {
+        return GLUS_FALSE;
+    }
+
+    // The levels are stored in the same order as in the file.
+    elementsWritten = fwrite(bcimage->data, 1, (size_t)bcimage->imageSize, file);
+
+    if (!_glusFileCheckWrite(file, elementsWritten, (size_t)bcimage->imageSize))
+    {
+        return GLUS_FALSE;
+    }
+
+    glusFileClose(file);
+
+    return GLUS_TRUE;
+}
@@ -0,0 +1,1246 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// Vector instructions are only used, if they are enabled for the compiler.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+#define GLUS_IMAGE_SSE2
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+#define GLUS_IMAGE_NEON
+
+#endif
+
+#include "GL/glus.h"
+
+/**
+ * Number of blocks, from which an image is decoded or encoded on several threads.
+ */
+#define GLUS_ETC_PARALLEL_BLOCKS 1024
+
+extern GLUSvoid _glusThreadRun(GLUSvoid (*function)(GLUSvoid* data, GLUSuint index), GLUSvoid* data, GLUSuint numberTasks, GLUSuint numberThreads);
+extern GLUSuint _glusThreadGetNumberProcessors(GLUSvoid);
+
+/**
+ * Decoding or encoding of an image, which is split into bands of block rows.
+ */
+typedef struct _GLUSetcBands
+{
+    GLUSubyte* blocks;
+    GLUSubyte* pixels;
+
+    GLUSint width;
+    GLUSint height;
+
+    GLUSint numberChannels;
+
+    GLUSint blocksPerRow;
+    GLUSint blockRows;
+    GLUSint blockRowsPerBand;
+
+    GLUSint blockSize;
+
+    GLUSenum internalformat;
+
+    GLUSenum quality;
+
+} GLUSetcBands;
+
+/**
+ * Intensity modifiers of ETC1 and ETC2. The pixel indices select +a, +b, -a and -b.
+ */
+static const GLUSint g_etcModifierTable[8][2] = {
+    { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+};
+
+/**
+ * Distances of the ETC2 T and H modes.
+ */
+static const GLUSint g_etcDistanceTable[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+/**
+ * Modifiers of the EAC alpha, R11 and RG11 blocks.
+ */
+static const GLUSint g_eacModifierTable[16][8] = {
+    { -3, -6, -9, -15, 2, 5, 8, 14 },
+    { -3, -7, -10, -13, 2, 6, 9, 12 },
+    { -2, -5, -8, -13, 1, 4, 7, 12 },
+    { -2, -4, -6, -13, 1, 3, 5, 12 },
+    { -3, -6, -8, -12, 2, 5, 7, 11 },
+    { -3, -7, -9, -11, 2, 6, 8, 10 },
+    { -4, -7, -8, -11, 3, 6, 7, 10 },
+    { -3, -5, -8, -11, 2, 4, 7, 10 },
+    { -2, -6, -8, -10, 1, 5, 7, 9 },
+    { -2, -5, -8, -10, 1, 4, 7, 9 },
+    { -2, -4, -8, -10, 1, 3, 7, 9 },
+    { -2, -5, -7, -10, 1, 4, 6, 9 },
+    { -3, -4, -7, -10, 2, 3, 6, 9 },
+    { -1, -2, -3, -10, 0, 1, 2, 9 },
+    { -4, -6, -8, -9, 3, 5, 7, 8 },
+    { -3, -5, -7, -9, 2, 4, 6, 8 }
+};
+
+/**
+ * Pixels of the two sub blocks, without and with the flip bit. Pixels are numbered row by row.
+ */
+static const GLUSint g_etcSubblockPixels[2][2][8] = {
+    { { 0, 1, 4, 5, 8, 9, 12, 13 }, { 2, 3, 6, 7, 10, 11, 14, 15 } },
+    { { 0, 1, 2, 3, 4, 5, 6, 7 }, { 8, 9, 10, 11, 12, 13, 14, 15 } }
+};
+
+static GLUSint glusEtcClamp(GLUSint value, GLUSint min, GLUSint max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
+
+static GLUSint glusEtcExtend4(GLUSint value)
+{
+    return (value << 4) | value;
+}
+
+static GLUSint glusEtcExtend5(GLUSint value)
+{
+    return (value << 3) | (value >> 2);
+}
+
+static GLUSint glusEtcExtend6(GLUSint value)
+{
+    return (value << 2) | (value >> 4);
+}
+
+static GLUSint glusEtcExtend7(GLUSint value)
+{
+    return (value << 1) | (value >> 6);
+}
+
+/**
+ * Builds four RGBA colors, each of them being colors[i] + modifiers[i] clamped to 0 - 255.
+ */
+static GLUSvoid glusEtcBuildPalette(GLUSuint palette[4], const GLUSint colors[4][3], const GLUSint modifiers[4])
+{
+#if defined(GLUS_IMAGE_SSE2)
+    __m128i low  = _mm_set_epi16(255, (short)(colors[1][2] + modifiers[1]), (short)(colors[1][1] + modifiers[1]), (short)(colors[1][0] + modifiers[1]), 255, (short)(colors[0][2] + modifiers[0]), (short)(colors[0][1] + modifiers[0]), (short)(colors[0][0] + modifiers[0]));
+    __m128i high = _mm_set_epi16(255, (short)(colors[3][2] + modifiers[3]), (short)(colors[3][1] + modifiers[3]), (short)(colors[3][0] + modifiers[3]), 255, (short)(colors[2][2] + modifiers[2]), (short)(colors[2][1] + modifiers[2]), (short)(colors[2][0] + modifiers[2]));
+
+    // Saturation clamps all channels at once.
+    _mm_storeu_si128((__m128i*)palette, _mm_packus_epi16(low, high));
+#elif defined(GLUS_IMAGE_NEON)
+    int16_t values[16];
+    GLUSint i;
+
+    for (i = 0; i < 4; i++)
+    {
+        values[i * 4 + 0] = (int16_t)(colors[i][0] + modifiers[i]);
+        values[i * 4 + 1] = (int16_t)(colors[i][1] + modifiers[i]);
+        values[i * 4 + 2] = (int16_t)(colors[i][2] + modifiers[i]);
+        values[i * 4 + 3] = 255;
+    }
+
+    // Saturation clamps all channels at once.
+    vst1q_u8((uint8_t*)palette, vcombine_u8(vqmovun_s16(vld1q_s16(values)), vqmovun_s16(vld1q_s16(values + 8))));
+#else
+    GLUSubyte* bytes = (GLUSubyte*)palette;
+    GLUSint i;
+
+    for (i = 0; i < 4; i++)
+    {
+        bytes[i * 4 + 0] = (GLUSubyte)glusEtcClamp(colors[i][0] + modifiers[i], 0, 255);
+        bytes[i * 4 + 1] = (GLUSubyte)glusEtcClamp(colors[i][1] + modifiers[i], 0, 255);
+        bytes[i * 4 + 2] = (GLUSubyte)glusEtcClamp(colors[i][2] + modifiers[i], 0, 255);
+        bytes[i * 4 + 3] = 255;
+    }
+#endif
+}
+
+/**
+ * Decodes the planar mode. origin, horizontal and vertical are the extended RGB colors.
+ */
+static GLUSvoid glusEtcDecodePlanar(GLUSuint colors[16], const GLUSint origin[3], const GLUSint horizontal[3], const GLUSint vertical[3])
+{
+#if defined(GLUS_IMAGE_SSE2)
+    // Two pixels per register. The alpha lanes result in 255.
+    __m128i deltaH = _mm_set_epi16(0, (short)(horizontal[2] - origin[2]), (short)(horizontal[1] - origin[1]), (short)(horizontal[0] - origin[0]), 0, (short)(horizontal[2] - origin[2]), (short)(horizontal[1] - origin[1]), (short)(horizontal[0] - origin[0]));
+    __m128i deltaV = _mm_set_epi16(0, (short)(vertical[2] - origin[2]), (short)(vertical[1] - origin[1]), (short)(vertical[0] - origin[0]), 0, (short)(vertical[2] - origin[2]), (short)(vertical[1] - origin[1]), (short)(vertical[0] - origin[0]));
+    __m128i row    = _mm_set_epi16(1022, (short)(4 * origin[2] + 2), (short)(4 * origin[1] + 2), (short)(4 * origin[0] + 2), 1022, (short)(4 * origin[2] + 2), (short)(4 * origin[1] + 2), (short)(4 * origin[0] + 2));
+    __m128i left   = _mm_mullo_epi16(deltaH, _mm_set_epi16(1, 1, 1, 1, 0, 0, 0, 0));
+    __m128i right  = _mm_mullo_epi16(deltaH, _mm_set_epi16(3, 3, 3, 3, 2, 2, 2, 2));
+    GLUSint y;
+
+    for (y = 0; y < 4; y++)
+    {
+        _mm_storeu_si128((__m128i*)(colors + y * 4), _mm_packus_epi16(_mm_srai_epi16(_mm_add_epi16(row, left), 2), _mm_srai_epi16(_mm_add_epi16(row, right), 2)));
+
+        row = _mm_add_epi16(row, deltaV);
+    }
+#elif defined(GLUS_IMAGE_NEON)
+    int16_t values[8];
+    int16x8_t deltaH, deltaV, row, left, right;
+    GLUSint i, y;
+
+    // Two pixels per register. The alpha lanes result in 255.
+    for (i = 0; i < 8; i++)
+    {
+        values[i] = (i & 3) == 3 ? 0 : (int16_t)(horizontal[i & 3] - origin[i & 3]);
+    }
+    deltaH = vld1q_s16(values);
+
+    for (i = 0; i < 8; i++)
+    {
+        values[i] = (i & 3) == 3 ? 0 : (int16_t)(vertical[i & 3] - origin[i & 3]);
+    }
+    deltaV = vld1q_s16(values);
+
+    for (i = 0; i < 8; i++)
+    {
+        values[i] = (i & 3) == 3 ? 1022 : (int16_t)(4 * origin[i & 3] + 2);
+    }
+    row = vld1q_s16(values);
+
+    for (i = 0; i < 8; i++)
+    {
+        values[i] = (int16_t)(i >> 2);
+    }
+    left  = vmulq_s16(deltaH, vld1q_s16(values));
+    right = vaddq_s16(left, vaddq_s16(deltaH, deltaH));
+
+    for (y = 0; y < 4; y++)
+    {
+        vst1q_u8((uint8_t*)(colors + y * 4), vcombine_u8(vqmovun_s16(vshrq_n_s16(vaddq_s16(row, left), 2)), vqmovun_s16(vshrq_n_s16(vaddq_s16(row, right), 2))));
+
+        row = vaddq_s16(row, deltaV);
+    }
+#else
+    GLUSubyte* bytes = (GLUSubyte*)colors;
+    GLUSint x, y, c;
+
+    for (y = 0; y < 4; y++)
+    {
+        for (x = 0; x < 4; x++)
+        {
+            for (c = 0; c < 3; c++)
+            {
+                bytes[(y * 4 + x) * 4 + c] = (GLUSubyte)glusEtcClamp((x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c]) + 4 * origin[c] + 2) >> 2, 0, 255);
+            }
+            bytes[(y * 4 + x) * 4 + 3] = 255;
+        }
+    }
+#endif
+}
+
+static GLUSuint glusEtcReadWord(const GLUSubyte* bytes)
+{
+    return ((GLUSuint)bytes[0] << 24) | ((GLUSuint)bytes[1] << 16) | ((GLUSuint)bytes[2] << 8) | (GLUSuint)bytes[3];
+}
+
+/**
+ * Decodes an ETC1 or ETC2 RGB block into 16 RGBA colors, row by row.
+ * With punch through alpha, the differential bit is the opaque bit.
+ */
+static GLUSvoid glusEtcDecodeColorBlock(GLUSuint colors[16], const GLUSubyte* block, GLUSboolean punchThrough)
+{
+    GLUSuint high = glusEtcReadWord(block);
+    GLUSuint low  = glusEtcReadWord(block + 4);
+
+    GLUSuint palette[8];
+
+    GLUSint baseColors[4][3];
+    GLUSint modifiers[4];
+
+    GLUSint red, green, blue;
+    GLUSint distance;
+
+    GLUSint table, flip, index, subblock, x, y, i, c;
+
+    GLUSboolean differential = (high >> 1) & 1;
+    GLUSboolean opaque       = GLUS_TRUE;
+
+    if (punchThrough)
+    {
+        opaque       = differential;
+        differential = GLUS_TRUE;
+    }
+
+    if (!differential)
+    {
+        // Individual mode with two RGB444 colors.
+        for (subblock = 0; subblock < 2; subblock++)
+        {
+            for (c = 0; c < 3; c++)
+            {
+                baseColors[0][c] = glusEtcExtend4((high >> (28 - subblock * 4 - c * 8)) & 15);
+                baseColors[1][c] = baseColors[0][c];
+                baseColors[2][c] = baseColors[0][c];
+                baseColors[3][c] = baseColors[0][c];
+            }
+
+            table = (high >> (5 - subblock * 3)) & 7;
+
+            modifiers[0] = g_etcModifierTable[table][0];
+            modifiers[1] = g_etcModifierTable[table][1];
+            modifiers[2] = -g_etcModifierTable[table][0];
+            modifiers[3] = -g_etcModifierTable[table][1];
+
+            glusEtcBuildPalette(palette + subblock * 4, (const GLUSint(*)[3])baseColors, modifiers);
+        }
+    }
+    else
+    {
+        red   = (GLUSint)((high >> 27) & 31) + ((GLUSint)((high >> 24) & 7) ^ 4) - 4;
+        green = (GLUSint)((high >> 19) & 31) + ((GLUSint)((high >> 16) & 7) ^ 4) - 4;
+        blue  = (GLUSint)((high >> 11) & 31) + ((GLUSint)((high >> 8) & 7) ^ 4) - 4;
+
+        if (red < 0 || red > 31)
+        {
+            // T mode.
+            baseColors[0][0] = glusEtcExtend4((GLUSint)(((high >> 27) & 3) << 2 | ((high >> 24) & 3)));
+            baseColors[0][1] = glusEtcExtend4((GLUSint)((high >> 20) & 15));
+            baseColors[0][2] = glusEtcExtend4((GLUSint)((high >> 16) & 15));
+
+            for (c = 0; c < 3; c++)
+            {
+                baseColors[1][c] = glusEtcExtend4((GLUSint)((high >> (12 - c * 4)) & 15));
+                baseColors[2][c] = baseColors[1][c];
+                baseColors[3][c] = baseColors[1][c];
+            }
+
+            distance = g_etcDistanceTable[((high >> 1) & 6) | (high & 1)];
+
+            modifiers[0] = 0;
+            modifiers[1] = distance;
+            modifiers[2] = 0;
+            modifiers[3] = -distance;
+
+            glusEtcBuildPalette(palette, (const GLUSint(*)[3])baseColors, modifiers);
+        }
+        else if (green < 0 || green > 31)
+        {
+            // H mode.
+            baseColors[0][0] = glusEtcExtend4((GLUSint)((high >> 27) & 15));
+            baseColors[0][1] = glusEtcExtend4((GLUSint)(((high >> 24) & 7) << 1 | ((high >> 20) & 1)));
+            baseColors[0][2] = glusEtcExtend4((GLUSint)(((high >> 19) & 1) << 3 | ((high >> 15) & 7)));
+            baseColors[2][0] = glusEtcExtend4((GLUSint)((high >> 11) & 15));
+            baseColors[2][1] = glusEtcExtend4((GLUSint)((high >> 7) & 15));
+            baseColors[2][2] = glusEtcExtend4((GLUSint)((high >> 3) & 15));
+
+            index = (GLUSint)(((high >> 2) & 1) << 2 | (high & 1) << 1);
+            if (((baseColors[0][0] << 16) | (baseColors[0][1] << 8) | baseColors[0][2]) >= ((baseColors[2][0] << 16) | (baseColors[2][1] << 8) | baseColors[2][2]))
+            {
+                index |= 1;
+            }
+
+            distance = g_etcDistanceTable[index];
+
+            for (c = 0; c < 3; c++)
+            {
+                baseColors[1][c] = baseColors[0][c];
+                baseColors[3][c] = baseColors[2][c];
+            }
+
+            modifiers[0] = distance;
+            modifiers[1] = -distance;
+            modifiers[2] = distance;
+            modifiers[3] = -distance;
+
+            glusEtcBuildPalette(palette, (const GLUSint(*)[3])baseColors, modifiers);
+        }
+        else if (blue < 0 || blue > 31)
+        {
+            // Planar mode, always opaque.
+            GLUSint origin[3];
+            GLUSint horizontal[3];
+            GLUSint vertical[3];
+
+            origin[0] = glusEtcExtend6((GLUSint)((high >> 25) & 63));
+            origin[1] = glusEtcExtend7((GLUSint)(((high >> 24) & 1) << 6 | ((high >> 17) & 63)));
+            origin[2] = glusEtcExtend6((GLUSint)(((high >> 16) & 1) << 5 | ((high >> 11) & 3) << 3 | ((high >> 7) & 7)));
+
+            horizontal[0] = glusEtcExtend6((GLUSint)(((high >> 2) & 31) << 1 | (high & 1)));
+            horizontal[1] = glusEtcExtend7((GLUSint)((low >> 25) & 127));
+            horizontal[2] = glusEtcExtend6((GLUSint)((low >> 19) & 63));
+
+            vertical[0] = glusEtcExtend6((GLUSint)((low >> 13) & 63));
+            vertical[1] = glusEtcExtend7((GLUSint)((low >> 6) & 127));
+            vertical[2] = glusEtcExtend6((GLUSint)(low & 63));
+
+            glusEtcDecodePlanar(colors, origin, horizontal, vertical);
+
+            return;
+        }
+        else
+        {
+            // Differential mode with a RGB555 color and a RGB333 difference.
+            for (subblock = 0; subblock < 2; subblock++)
+            {
+                baseColors[0][0] = glusEtcExtend5(subblock ? red : (GLUSint)((high >> 27) & 31));
+                baseColors[0][1] = glusEtcExtend5(subblock ? green : (GLUSint)((high >> 19) & 31));
+                baseColors[0][2] = glusEtcExtend5(subblock ? blue : (GLUSint)((high >> 11) & 31));
+
+                for (c = 0; c < 3; c++)
+                {
+                    baseColors[1][c] = baseColors[0][c];
+                    baseColors[2][c] = baseColors[0][c];
+                    baseColors[3][c] = baseColors[0][c];
+                }
+
+                table = (high >> (5 - subblock * 3)) & 7;
+
+                // Without the opaque bit, the small modifiers are dropped.
+                modifiers[0] = opaque ? g_etcModifierTable[table][0] : 0;
+                modifiers[1] = g_etcModifierTable[table][1];
+                modifiers[2] = opaque ? -g_etcModifierTable[table][0] : 0;
+                modifiers[3] = -g_etcModifierTable[table][1];
+
+                glusEtcBuildPalette(palette + subblock * 4, (const GLUSint(*)[3])baseColors, modifiers);
+            }
+        }
+
+        if (red < 0 || red > 31 || green < 0 || green > 31)
+        {
+            // T and H mode use one palette for the whole block.
+            for (i = 0; i < 4; i++)
+            {
+                palette[4 + i] = palette[i];
+            }
+
+            if (!opaque)
+            {
+                palette[2] = 0;
+                palette[6] = 0;
+            }
+
+            for (x = 0; x < 4; x++)
+            {
+                for (y = 0; y < 4; y++)
+                {
+                    i = x * 4 + y;
+
+                    colors[y * 4 + x] = palette[((low >> (15 + i)) & 2) | ((low >> i) & 1)];
+                }
+            }
+
+            return;
+        }
+
+        if (!opaque)
+        {
+            palette[2] = 0;
+            palette[6] = 0;
+        }
+    }
+
+    flip = high & 1;
+
+    // Pixel indices are stored column by column.
+    for (x = 0; x < 4; x++)
+    {
+        for (y = 0; y < 4; y++)
+        {
+            i = x * 4 + y;
+
+            subblock = flip ? (y >> 1) : (x >> 1);
+
+            colors[y * 4 + x] = palette[subblock * 4 + (GLUSint)(((low >> (15 + i)) & 2) | ((low >> i) & 1))];
+        }
+    }
+}
+
+/**
+ * Decodes the 11 bit values of an EAC block, row by row. Signed values are in the range [-1023, 1023], unsigned ones in [0, 2047].
+ * The alpha block of ETC2 RGBA8 uses the 8 bit variant.
+ */
+static GLUSvoid glusEacDecodeBlock(GLUSint values[16], const GLUSubyte* block, GLUSint bits, GLUSboolean signedValues)
+{
+    GLUSint base       = signedValues ? (GLUSint)(signed char)block[0] : (GLUSint)block[0];
+    GLUSint multiplier = block[1] >> 4;
+    GLUSint table      = block[1] & 15;
+
+    GLUSint palette[8];
+
+    GLUSuint indicesHigh = ((GLUSuint)block[2] << 16) | ((GLUSuint)block[3] << 8) | (GLUSuint)block[4];
+    GLUSuint indicesLow  = ((GLUSuint)block[5] << 16) | ((GLUSuint)block[6] << 8) | (GLUSuint)block[7];
+
+    GLUSint x, y, i;
+
+    for (i = 0; i < 8; i++)
+    {
+        if (bits == 8)
+        {
+            palette[i] = glusEtcClamp(base + g_eacModifierTable[table][i] * multiplier, 0, 255);
+        }
+        else if (signedValues)
+        {
+            if (base == -128)
+            {
+                base = -127;
+            }
+
+            palette[i] = glusEtcClamp(base * 8 + g_eacModifierTable[table][i] * (multiplier ? multiplier * 8 : 1), -1023, 1023);
+        }
+        else
+        {
+            palette[i] = glusEtcClamp(base * 8 + 4 + g_eacModifierTable[table][i] * (multiplier ? multiplier * 8 : 1), 0, 2047);
+        }
+    }
+
+    // Pixel indices are stored column by column, 24 bits in each half.
+    for (x = 0; x < 4; x++)
+    {
+        for (y = 0; y < 4; y++)
+        {
+            i = x * 4 + y;
+
+            if (i < 8)
+            {
+                values[y * 4 + x] = palette[(indicesHigh >> (21 - i * 3)) & 7];
+            }
+            else
+            {
+                values[y * 4 + x] = palette[(indicesLow >> (21 - (i - 8) * 3)) & 7];
+            }
+        }
+    }
+}
+
+static GLUSubyte glusEacTo8(GLUSint value, GLUSboolean signedValues)
+{
+    if (signedValues)
+    {
+        return (GLUSubyte)(((value + 1023) * 255 + 1023) / 2046);
+    }
+
+    return (GLUSubyte)((value * 255 + 1023) / 2047);
+}
+
+static GLUSvoid glusEtcDecodeBlock(GLUSubyte pixels[16][4], const GLUSubyte* block, GLUSenum internalformat)
+{
+    GLUSint values[16];
+    GLUSint i;
+
+    GLUSboolean signedValues = internalformat == GLUS_COMPRESSED_SIGNED_R11_EAC || internalformat == GLUS_COMPRESSED_SIGNED_RG11_EAC;
+
+    switch (internalformat)
+    {
+    case GLUS_ETC1_RGB8_OES:
+    case GLUS_COMPRESSED_RGB8_ETC2:
+        glusEtcDecodeColorBlock((GLUSuint*)pixels, block, GLUS_FALSE);
+        break;
+    case GLUS_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        glusEtcDecodeColorBlock((GLUSuint*)pixels, block, GLUS_TRUE);
+        break;
+    case GLUS_COMPRESSED_RGBA8_ETC2_EAC:
+        glusEtcDecodeColorBlock((GLUSuint*)pixels, block + 8, GLUS_FALSE);
+
+        glusEacDecodeBlock(values, block, 8, GLUS_FALSE);
+
+        for (i = 0; i < 16; i++)
+        {
+            pixels[i][3] = (GLUSubyte)values[i];
+        }
+        break;
+    default:
+        // R11 and RG11, green and blue stay zero for a single channel.
+        memset(pixels, 0, 16 * 4);
+
+        glusEacDecodeBlock(values, block, 11, signedValues);
+
+        for (i = 0; i < 16; i++)
+        {
+            pixels[i][0] = glusEacTo8(values[i], signedValues);
+        }
+
+        if (internalformat == GLUS_COMPRESSED_RG11_EAC || internalformat == GLUS_COMPRESSED_SIGNED_RG11_EAC)
+        {
+            glusEacDecodeBlock(values, block + 8, 11, signedValues);
+
+            for (i = 0; i < 16; i++)
+            {
+                pixels[i][1] = glusEacTo8(values[i], signedValues);
+            }
+        }
+        break;
+    }
+}
+
+static GLUSvoid glusEtcDecodeBand(GLUSvoid* data, GLUSuint index)
+{
+    GLUSetcBands* bands = (GLUSetcBands*)data;
+
+    GLUSubyte pixels[16][4];
+
+    GLUSubyte* target;
+
+    GLUSint blockX, blockY, x, y, c, width, height;
+
+    GLUSint firstRow = (GLUSint)index * bands->blockRowsPerBand;
+    GLUSint lastRow  = firstRow + bands->blockRowsPerBand;
+
+    if (lastRow > bands->blockRows)
+    {
+        lastRow = bands->blockRows;
+    }
+
+    for (blockY = firstRow; blockY < lastRow; blockY++)
+    {
+        height = bands->height - blockY * 4 < 4 ? bands->height - blockY * 4 : 4;
+
+        for (blockX = 0; blockX < bands->blocksPerRow; blockX++)
+        {
+            glusEtcDecodeBlock(pixels, bands->blocks + ((size_t)blockY * bands->blocksPerRow + blockX) * bands->blockSize, bands->internalformat);
+
+            width = bands->width - blockX * 4 < 4 ? bands->width - blockX * 4 : 4;
+
+            for (y = 0; y < height; y++)
+            {
+                target = bands->pixels + (((size_t)blockY * 4 + y) * bands->width + blockX * 4) * bands->numberChannels;
+
+                if (bands->numberChannels == 4)
+                {
+                    memcpy(target, pixels[y * 4], width * 4);
+                }
+                else
+                {
+                    for (x = 0; x < width; x++)
+                    {
+                        for (c = 0; c < bands->numberChannels; c++)
+                        {
+                            target[x * bands->numberChannels + c] = pixels[y * 4 + x][c];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Selects the best pixel indices of a sub block for a table.
+ *
+ * @return The squared error.
+ */
+static GLUSint glusEtcSelectIndices(GLUSint indices[8], const GLUSint pixels[8][3], const GLUSint base[3], GLUSint table)
+{
+    GLUSint a = g_etcModifierTable[table][0];
+    GLUSint b = g_etcModifierTable[table][1];
+
+    GLUSint error = 0;
+    GLUSint pixelError, candidateError, value, m, i, k, c;
+
+    for (i = 0; i < 8; i++)
+    {
+        pixelError = 0x7FFFFFFF;
+
+        for (k = 0; k < 4; k++)
+        {
+            m = k & 1 ? b : a;
+            m = k & 2 ? -m : m;
+
+            candidateError = 0;
+            for (c = 0; c < 3; c++)
+            {
+                value = glusEtcClamp(base[c] + m, 0, 255) - pixels[i][c];
+
+                candidateError += value * value;
+            }
+
+            if (candidateError < pixelError)
+            {
+                pixelError = candidateError;
+                indices[i] = k;
+            }
+        }
+
+        error += pixelError;
+    }
+
+    return error;
+}
+
+/**
+ * Squared error of the pixels of a sub block for the best table and pixel indices. base is the extended base color.
+ *
+ * @return The error, which is not smaller than bestError, if no table is better.
+ */
+static GLUSint glusEtcEvaluateSubblock(GLUSint* bestTable, GLUSint bestIndices[8], const GLUSint pixels[8][3], const GLUSint base[3], GLUSint bestError)
+{
+    GLUSint difference[8];
+    GLUSint distance = 0;
+
+    GLUSint indices[8];
+
+    GLUSint minBase, maxBase;
+    GLUSint a, b, error, table, i;
+
+    GLUSint foundTable = -1;
+
+#if defined(GLUS_IMAGE_SSE2)
+    __m128i differences;
+    __m128i twiceDifferences;
+    __m128i threshold;
+    __m128i modifier;
+    __m128i sum;
+#else
+    GLUSint m;
+#endif
+
+    minBase = base[0] < base[1] ? base[0] : base[1];
+    minBase = minBase < base[2] ? minBase : base[2];
+    maxBase = base[0] > base[1] ? base[0] : base[1];
+    maxBase = maxBase > base[2] ? maxBase : base[2];
+
+    for (i = 0; i < 8; i++)
+    {
+        difference[i] = (pixels[i][0] - base[0]) + (pixels[i][1] - base[1]) + (pixels[i][2] - base[2]);
+        distance += (pixels[i][0] - base[0]) * (pixels[i][0] - base[0]) + (pixels[i][1] - base[1]) * (pixels[i][1] - base[1]) + (pixels[i][2] - base[2]) * (pixels[i][2] - base[2]);
+    }
+
+#if defined(GLUS_IMAGE_SSE2)
+    differences      = _mm_set_epi16((short)difference[7], (short)difference[6], (short)difference[5], (short)difference[4], (short)difference[3], (short)difference[2], (short)difference[1], (short)difference[0]);
+    twiceDifferences = _mm_add_epi16(differences, differences);
+#endif
+
+    for (table = 0; table < 8; table++)
+    {
+        a = g_etcModifierTable[table][0];
+        b = g_etcModifierTable[table][1];
+
+        if (minBase - b >= 0 && maxBase + b <= 255)
+        {
+            // Nothing is clamped, so the error of a modifier m is distance - m * (2 * difference - 3 * m).
+            // The best modifier is the one closest to difference / 3.
+#if defined(GLUS_IMAGE_SSE2)
+            threshold = _mm_set1_epi16((short)(3 * (a + b)));
+
+            modifier = _mm_set1_epi16((short)b);
+            modifier = _mm_or_si128(_mm_and_si128(_mm_cmplt_epi16(twiceDifferences, threshold), _mm_set1_epi16((short)a)), _mm_andnot_si128(_mm_cmplt_epi16(twiceDifferences, threshold), modifier));
+            modifier = _mm_or_si128(_mm_and_si128(_mm_cmplt_epi16(differences, _mm_setzero_si128()), _mm_set1_epi16((short)-a)), _mm_andnot_si128(_mm_cmplt_epi16(differences, _mm_setzero_si128()), modifier));
+            modifier = _mm_or_si128(_mm_and_si128(_mm_cmplt_epi16(twiceDifferences, _mm_sub_epi16(_mm_setzero_si128(), threshold)), _mm_set1_epi16((short)-b)), _mm_andnot_si128(_mm_cmplt_epi16(twiceDifferences, _mm_sub_epi16(_mm_setzero_si128(), threshold)), modifier));
+
+            sum = _mm_madd_epi16(modifier, _mm_sub_epi16(twiceDifferences, _mm_add_epi16(modifier, _mm_add_epi16(modifier, modifier))));
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+            error = distance - _mm_cvtsi128_si32(sum);
+#else
+            error = distance;
+
+            for (i = 0; i < 8; i++)
+            {
+                if (2 * difference[i] < -3 * (a + b))
+                {
+                    m = -b;
+                }
+                else if (difference[i] < 0)
+                {
+                    m = -a;
+                }
+                else if (2 * difference[i] < 3 * (a + b))
+                {
+                    m = a;
+                }
+                else
+                {
+                    m = b;
+                }
+
+                error -= m * (2 * difference[i] - 3 * m);
+            }
+#endif
+        }
+        else
+        {
+            error = glusEtcSelectIndices(indices, pixels, base, table);
+        }
+
+        if (error < bestError)
+        {
+            bestError = error;
+
+            foundTable = table;
+        }
+    }
+
+    if (foundTable < 0)
+    {
+        return bestError;
+    }
+
+    *bestTable = foundTable;
+
+    a = g_etcModifierTable[foundTable][0];
+    b = g_etcModifierTable[foundTable][1];
+
+    if (minBase - b >= 0 && maxBase + b <= 255)
+    {
+        for (i = 0; i < 8; i++)
+        {
+            if (2 * difference[i] < -3 * (a + b))
+            {
+                bestIndices[i] = 3;
+            }
+            else if (difference[i] < 0)
+            {
+                bestIndices[i] = 2;
+            }
+            else if (2 * difference[i] < 3 * (a + b))
+            {
+                bestIndices[i] = 0;
+            }
+            else
+            {
+                bestIndices[i] = 1;
+            }
+        }
+    }
+    else
+    {
+        glusEtcSelectIndices(bestIndices, pixels, base, foundTable);
+    }
+
+    return bestError;
+}
+
+/**
+ * Candidate base color of a sub block.
+ */
+typedef struct _GLUSetcCandidate
+{
+    GLUSint color[3];
+
+    GLUSint error;
+
+    GLUSint table;
+
+    GLUSint indices[8];
+
+} GLUSetcCandidate;
+
+/**
+ * Evaluates the base colors around the average color of a sub block, quantized to 4 or 5 bits per channel.
+ *
+ * @return The number of candidates.
+ */
+static GLUSint glusEtcEvaluateCandidates(GLUSetcCandidate* candidates, const GLUSint pixels[8][3], GLUSint bits, GLUSenum quality)
+{
+    GLUSint average[3];
+    GLUSint extended[3];
+
+    GLUSint maxValue         = (1 << bits) - 1;
+    GLUSint numberCandidates = 0;
+    GLUSint offset[3];
+    GLUSint i, c, step;
+
+    for (c = 0; c < 3; c++)
+    {
+        average[c] = 0;
+        for (i = 0; i < 8; i++)
+        {
+            average[c] += pixels[i][c];
+        }
+
+        // Rounded average of eight pixels, quantized.
+        average[c] = (average[c] * maxValue + 8 * 255 / 2) / (8 * 255);
+    }
+
+    // Fast: the quantized average. Normal: also one step darker and brighter. High: all neighbors.
+    for (step = 0; step < 27; step++)
+    {
+        offset[0] = step % 3 - 1;
+        offset[1] = (step / 3) % 3 - 1;
+        offset[2] = step / 9 - 1;
+
+        if (quality == GLUS_ETC1_FAST && step != 13)
+        {
+            continue;
+        }
+
+        if (quality == GLUS_ETC1_NORMAL && step != 0 && step != 13 && step != 26)
+        {
+            continue;
+        }
+
+        for (c = 0; c < 3; c++)
+        {
+            candidates[numberCandidates].color[c] = average[c] + offset[c];
+
+            if (candidates[numberCandidates].color[c] < 0 || candidates[numberCandidates].color[c] > maxValue)
+            {
+                break;
+            }
+
+            extended[c] = bits == 4 ? glusEtcExtend4(candidates[numberCandidates].color[c]) : glusEtcExtend5(candidates[numberCandidates].color[c]);
+        }
+
+        if (c < 3)
+        {
+            continue;
+        }
+
+        candidates[numberCandidates].error = glusEtcEvaluateSubblock(&candidates[numberCandidates].table, candidates[numberCandidates].indices, pixels, extended, 0x7FFFFFFF);
+
+        numberCandidates++;
+    }
+
+    return numberCandidates;
+}
+
+/**
+ * Encodes a block of 16 RGB pixels, row by row, as ETC1.
+ */
+static GLUSvoid glusEtcEncodeBlock(GLUSubyte* block, const GLUSint pixels[16][3], GLUSenum quality)
+{
+    GLUSetcCandidate candidates[2][27];
+    GLUSint numberCandidates[2];
+
+    GLUSetcCandidate best[2];
+
+    GLUSint subblockPixels[8][3];
+
+    GLUSint bestError            = 0x7FFFFFFF;
+    GLUSint bestFlip             = 0;
+    GLUSboolean bestDifferential = GLUS_FALSE;
+
+    GLUSboolean found;
+
+    const GLUSetcCandidate* first;
+    const GLUSetcCandidate* second;
+
+    GLUSuint high, low;
+
+    GLUSint flip, differential, subblock, i, k, c, error, pixel;
+
+    for (flip = 0; flip < 2 && bestError > 0; flip++)
+    {
+        found = GLUS_FALSE;
+
+        // The differential mode is tried first, as it has more precise colors.
+        for (differential = 1; differential >= 0 && !(found && quality == GLUS_ETC1_FAST); differential--)
+        {
+            for (subblock = 0; subblock < 2; subblock++)
+            {
+                for (i = 0; i < 8; i++)
+                {
+                    for (c = 0; c < 3; c++)
+                    {
+                        subblockPixels[i][c] = pixels[g_etcSubblockPixels[flip][subblock][i]][c];
+                    }
+                }
+
+                numberCandidates[subblock] = glusEtcEvaluateCandidates(candidates[subblock], (const GLUSint(*)[3])subblockPixels, differential ? 5 : 4, quality);
+            }
+
+            for (i = 0; i < numberCandidates[0]; i++)
+            {
+                first = &candidates[0][i];
+
+                for (k = 0; k < numberCandidates[1]; k++)
+                {
+                    second = &candidates[1][k];
+
+                    // The second color of the differential mode has to be within [-4, 3] of the first one.
+                    for (c = 0; c < 3 && differential; c++)
+                    {
+                        if (second->color[c] - first->color[c] < -4 || second->color[c] - first->color[c] > 3)
+                        {
+                            break;
+                        }
+                    }
+
+                    if (differential && c < 3)
+                    {
+                        continue;
+                    }
+
+                    found = GLUS_TRUE;
+
+                    error = first->error + second->error;
+
+                    if (error < bestError)
+                    {
+                        bestError        = error;
+                        bestFlip         = flip;
+                        bestDifferential = (GLUSboolean)differential;
+                        best[0]          = *first;
+                        best[1]          = *second;
+                    }
+                }
+            }
+        }
+    }
+
+    if (bestDifferential)
+    {
+        high = (GLUSuint)best[0].color[0] << 27 | (GLUSuint)((best[1].color[0] - best[0].color[0]) & 7) << 24;
+        high |= (GLUSuint)best[0].color[1] << 19 | (GLUSuint)((best[1].color[1] - best[0].color[1]) & 7) << 16;
+        high |= (GLUSuint)best[0].color[2] << 11 | (GLUSuint)((best[1].color[2] - best[0].color[2]) & 7) << 8;
+        high |= 2;
+    }
+    else
+    {
+        high = (GLUSuint)best[0].color[0] << 28 | (GLUSuint)best[1].color[0] << 24;
+        high |= (GLUSuint)best[0].color[1] << 20 | (GLUSuint)best[1].color[1] << 16;
+        high |= (GLUSuint)best[0].color[2] << 12 | (GLUSuint)best[1].color[2] << 8;
+    }
+
+    high |= (GLUSuint)best[0].table << 5 | (GLUSuint)best[1].table << 2 | (GLUSuint)bestFlip;
+
+    // Pixel indices are stored column by column, the high bits in the upper half.
+    low = 0;
+    for (subblock = 0; subblock < 2; subblock++)
+    {
+        for (i = 0; i < 8; i++)
+        {
+            pixel = g_etcSubblockPixels[bestFlip][subblock][i];
+
+            k = (pixel & 3) * 4 + (pixel >> 2);
+
+            low |= (GLUSuint)(best[subblock].indices[i] >> 1) << (16 + k) | (GLUSuint)(best[subblock].indices[i] & 1) << k;
+        }
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        block[i] = (GLUSubyte)(high >> (24 - i * 8));
+        block[4 + i] = (GLUSubyte)(low >> (24 - i * 8));
+    }
+}
+
+static GLUSvoid glusEtcEncodeBand(GLUSvoid* data, GLUSuint index)
+{
+    GLUSetcBands* bands = (GLUSetcBands*)data;
+
+    GLUSint pixels[16][3];
+
+    const GLUSubyte* source;
+
+    GLUSint blockX, blockY, x, y, c;
+
+    GLUSint firstRow = (GLUSint)index * bands->blockRowsPerBand;
+    GLUSint lastRow  = firstRow + bands->blockRowsPerBand;
+
+    if (lastRow > bands->blockRows)
+    {
+        lastRow = bands->blockRows;
+    }
+
+    for (blockY = firstRow; blockY < lastRow; blockY++)
+    {
+        for (blockX = 0; blockX < bands->blocksPerRow; blockX++)
+        {
+            // Blocks at the right and bottom border repeat the last pixel.
+            for (y = 0; y < 4; y++)
+            {
+                for (x = 0; x < 4; x++)
+                {
+                    source = bands->pixels + ((size_t)glusEtcClamp(blockY * 4 + y, 0, bands->height - 1) * bands->width + glusEtcClamp(blockX * 4 + x, 0, bands->width - 1)) * bands->numberChannels;
+
+                    for (c = 0; c < 3; c++)
+                    {
+                        pixels[y * 4 + x][c] = source[bands->numberChannels >= 3 ? c : 0];
+                    }
+                }
+            }
+
+            glusEtcEncodeBlock(bands->blocks + ((size_t)blockY * bands->blocksPerRow + blockX) * 8, (const GLUSint(*)[3])pixels, bands->quality);
+        }
+    }
+}
+
+/**
+ * Runs the band function on as many threads as useful.
+ */
+static GLUSvoid glusEtcRunBands(GLUSvoid (*function)(GLUSvoid* data, GLUSuint index), GLUSetcBands* bands)
+{
+    GLUSuint numberBands = 1;
+
+    if ((size_t)bands->blocksPerRow * bands->blockRows >= GLUS_ETC_PARALLEL_BLOCKS)
+    {
+        numberBands = _glusThreadGetNumberProcessors();
+    }
+
+    if (numberBands > (GLUSuint)bands->blockRows)
+    {
+        numberBands = (GLUSuint)bands->blockRows;
+    }
+
+    bands->blockRowsPerBand = (bands->blockRows + (GLUSint)numberBands - 1) / (GLUSint)numberBands;
+
+    numberBands = (GLUSuint)((bands->blockRows + bands->blockRowsPerBand - 1) / bands->blockRowsPerBand);
+
+    _glusThreadRun(function, bands, numberBands, numberBands);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageDecodePkm(GLUStgaimage* tgaimage, const GLUSpkmimage* pkmimage)
+{
+    GLUSetcBands bands;
+
+    if (!tgaimage || !pkmimage || !pkmimage->data)
+    {
+        return GLUS_FALSE;
+    }
+
+    tgaimage->width  = 0;
+    tgaimage->height = 0;
+    tgaimage->depth  = 0;
+    tgaimage->data   = 0;
+    tgaimage->format = 0;
+
+    if (pkmimage->width == 0 || pkmimage->height == 0)
+    {
+        return GLUS_FALSE;
+    }
+
+    switch (pkmimage->internalformat)
+    {
+    case GLUS_ETC1_RGB8_OES:
+    case GLUS_COMPRESSED_RGB8_ETC2:
+        tgaimage->format     = GLUS_RGB;
+        bands.numberChannels = 3;
+        bands.blockSize      = 8;
+        break;
+    case GLUS_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        tgaimage->format     = GLUS_RGBA;
+        bands.numberChannels = 4;
+        bands.blockSize      = 8;
+        break;
+    case GLUS_COMPRESSED_RGBA8_ETC2_EAC:
+        tgaimage->format     = GLUS_RGBA;
+        bands.numberChannels = 4;
+        bands.blockSize      = 16;
+        break;
+    case GLUS_COMPRESSED_R11_EAC:
+    case GLUS_COMPRESSED_SIGNED_R11_EAC:
+        tgaimage->format     = GLUS_LUMINANCE;
+        bands.numberChannels = 1;
+        bands.blockSize      = 8;
+        break;
+    case GLUS_COMPRESSED_RG11_EAC:
+    case GLUS_COMPRESSED_SIGNED_RG11_EAC:
+        tgaimage->format     = GLUS_RGB;
+        bands.numberChannels = 3;
+        bands.blockSize      = 16;
+        break;
+    default:
+        return GLUS_FALSE;
+    }
+
+    bands.width          = pkmimage->width;
+    bands.height         = pkmimage->height;
+    bands.blocksPerRow   = (bands.width + 3) / 4;
+    bands.blockRows      = (bands.height + 3) / 4;
+    bands.internalformat = pkmimage->internalformat;
+    bands.quality        = 0;
+
+    if (pkmimage->imageSize < 0 || (size_t)pkmimage->imageSize < (size_t)bands.blocksPerRow * bands.blockRows * bands.blockSize)
+    {
+        tgaimage->format = 0;
+
+        return GLUS_FALSE;
+    }
+
+    bands.blocks = pkmimage->data;
+    bands.pixels = (GLUSubyte*)glusMemoryMallocAligned((size_t)bands.width * bands.height * bands.numberChannels, GLUS_MEMORY_DATA_ALIGNMENT);
+
+    if (!bands.pixels)
+    {
+        tgaimage->format = 0;
+
+        return GLUS_FALSE;
+    }
+
+    glusEtcRunBands(glusEtcDecodeBand, &bands);
+
+    tgaimage->width       = pkmimage->width;
+    tgaimage->height      = pkmimage->height;
+    tgaimage->depth       = 1;
+    tgaimage->data        = bands.pixels;
+    tgaimage->alignedData = bands.pixels;
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageEncodePkm(GLUSpkmimage* pkmimage, const GLUStgaimage* tgaimage, const GLUSenum quality)
+{
+    GLUSetcBands bands;
+
+    size_t imageSize;
+
+    if (!pkmimage || !tgaimage || !tgaimage->data)
+    {
+        return GLUS_FALSE;
+    }
+
+    pkmimage->width          = 0;
+    pkmimage->height         = 0;
+    pkmimage->depth          = 0;
+    pkmimage->data           = 0;
+    pkmimage->imageSize      = 0;
+    pkmimage->internalformat = 0;
+
+    if (tgaimage->width == 0 || tgaimage->height == 0 || tgaimage->depth > 1 || (quality != GLUS_ETC1_FAST && quality != GLUS_ETC1_NORMAL && quality != GLUS_ETC1_HIGH))
+    {
+        return GLUS_FALSE;
+    }
+
+    bands.numberChannels = 1;
+    if (tgaimage->format == GLUS_RGB)
+    {
+        bands.numberChannels = 3;
+    }
+    else if (tgaimage->format == GLUS_RGBA)
+    {
+        bands.numberChannels = 4;
+    }
+
+    bands.width          = tgaimage->width;
+    bands.height         = tgaimage->height;
+    bands.blocksPerRow   = (bands.width + 3) / 4;
+    bands.blockRows      = (bands.height + 3) / 4;
+    bands.blockSize      = 8;
+    bands.internalformat = GLUS_ETC1_RGB8_OES;
+    bands.quality        = quality;
+
+    imageSize = (size_t)bands.blocksPerRow * bands.blockRows * bands.blockSize;
+
+    bands.pixels = tgaimage->data;
+    bands.blocks = (GLUSubyte*)glusMemoryMalloc(imageSize);
+
+    if (!bands.blocks)
+    {
+        return GLUS_FALSE;
+    }
+
+    glusEtcRunBands(glusEtcEncodeBand, &bands);
+
+    pkmimage->width          = tgaimage->width;
+    pkmimage->height         = tgaimage->height;
+    pkmimage->depth          = 1;
+    pkmimage->data           = bands.blocks;
+    pkmimage->imageSize      = (GLUSint)imageSize;
+    pkmimage->internalformat = GLUS_ETC1_RGB8_OES;
+
+    return GLUS_TRUE;
+}
@@ -20,94 +20,487 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+// Vector instructions are only used, if they are enabled for the compiler.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+#define GLUS_IMAGE_SSE2
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+#define GLUS_IMAGE_NEON
+
+#endif
+
 #include "GL/glus.h"
 
+/**
+ * Number of scanlines, in which a channel is not searched for runs after run length encoding did not reduce its size enough.
+ */
+#define GLUS_IMAGE_RLE_SKIP_SEARCH 15
+
+/**
+ * Run length encoding of a channel has to save at least 1 / GLUS_IMAGE_RLE_MIN_SAVING of the whole scanline, otherwise searching runs costs more time than writing the saved bytes.
+ */
+#define GLUS_IMAGE_RLE_MIN_SAVING 16
+
 extern GLUSvoid _glusImageGatherSamplePoints(GLUSint sampleIndex[4], GLUSfloat sampleWeight[2], const GLUSfloat st[2], GLUSint width, GLUSint height, GLUSint stride);
+extern GLUSboolean _glusImageSampleBatchf(GLUSfloat* result, const GLUSfloat* data, GLUSint width, GLUSint height, GLUSint stride, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT);
+extern GLUSboolean _glusImageSampleBatchPackedf(GLUSfloat* result, const GLUSubyte* data, GLUSenum type, size_t texelSize, GLUSint width, GLUSint height, GLUSint stride, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT);
+
+extern GLUSboolean _glusFileReadStream(const GLUSstream* stream, GLUSubyte** data, size_t* length);
 
-extern GLUSboolean _glusFileCheckRead(FILE* f, size_t actualRead, size_t expectedRead);
 extern GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrite);
 
-static GLUSvoid glusImageConvertRGBE(GLUSfloat* rgb, const GLUSubyte* rgbe)
+extern GLUSenum _glusImageHdrGetType(GLUSenum type);
+extern size_t _glusImageHdrGetTexelSize(GLUSenum format, GLUSenum type);
+extern GLUSvoid _glusImageHdrPack(GLUSvoid* target, GLUSenum type, const GLUSfloat* source, size_t numberPixels, GLUSint numberChannels);
+extern GLUSvoid _glusImageHdrUnpack(GLUSfloat* target, GLUSenum type, const GLUSvoid* source, size_t numberPixels, GLUSint numberChannels);
+
+extern GLUSvoid* _glusImageStreamOpen(const GLUSchar* filename);
+extern GLUSvoid _glusImageStreamClose(GLUSvoid* handle);
+extern GLUSboolean _glusImageStreamSeek(GLUSvoid* handle, GLUSuint64 offset);
+extern const GLUSubyte* _glusImageStreamPeek(GLUSvoid* handle, size_t length, size_t* available);
+extern GLUSboolean _glusImageStreamCreateCache(GLUSvoid* handle, size_t rowSize, GLUSint numberRows, size_t cacheSize, GLUSboolean (*decode)(GLUSvoid* userData, GLUSubyte* rows, GLUSint firstRow, GLUSint numberRows), GLUSvoid* userData);
+extern const GLUSubyte* _glusImageStreamGetRow(GLUSvoid* handle, GLUSint row);
+
+/**
+ * Returns 2 to the power of exponent. Normal numbers are assembled directly from the exponent bits.
+ */
+static GLUSfloat glusImagePowerOfTwo(GLUSint exponent)
+{
+    GLUSuint  bits;
+    GLUSfloat result;
+
+    if (exponent < -126 || exponent > 127)
+    {
+        return ldexpf(1.0f, exponent);
+    }
+
+    bits = (GLUSuint)(exponent + 127) << 23;
+
+    memcpy(&result, &bits, sizeof(GLUSfloat));
+
+    return result;
+}
+
+#if defined(GLUS_IMAGE_SSE2) || defined(GLUS_IMAGE_NEON)
+
+/**
+ * Stores four RGBE pixels, which are given channel by channel.
+ */
+static GLUSvoid glusImageScatterRGBE4(GLUSubyte* rgbe, size_t pixelStride, size_t channelStride, const GLUSubyte* channels)
+{
+    GLUSint i, k;
+
+    for (k = 0; k < 4; k++)
+    {
+        if (pixelStride == 1)
+        {
+            memcpy(rgbe + k * channelStride, channels + k * 4, 4);
+
+            continue;
+        }
+
+        for (i = 0; i < 4; i++)
+        {
+            rgbe[i * pixelStride + k * channelStride] = channels[k * 4 + i];
+        }
+    }
+}
+
+#endif
+
+#if defined(GLUS_IMAGE_SSE2)
+
+/**
+ * Converts four RGBE pixels to RGB. Returns GLUS_FALSE without converting, if an exponent below 10 would need a denormal scale.
+ */
+static GLUSboolean glusImageConvertRGBE4(GLUSfloat* rgb, const GLUSubyte* rgbe)
+{
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+
+    __m128i pixels = _mm_loadu_si128((const __m128i*)rgbe);
+    __m128i exponent = _mm_srli_epi32(pixels, 24);
+
+    __m128 scale;
+    __m128 red, green, blue;
+    __m128 redGreen, greenBlue, blueRed;
+
+    if (_mm_movemask_epi8(_mm_cmplt_epi32(exponent, _mm_set1_epi32(10))))
+    {
+        return GLUS_FALSE;
+    }
+
+    // The exponent bits of 2^(exponent - 128 - 8) are exponent - 9.
+    scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_sub_epi32(exponent, _mm_set1_epi32(9)), 23));
+
+    red = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(pixels, byteMask)), scale);
+    green = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 8), byteMask)), scale);
+    blue = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 16), byteMask)), scale);
+
+    redGreen = _mm_unpackhi_ps(red, green);
+    greenBlue = _mm_unpacklo_ps(green, blue);
+    blueRed = _mm_unpackhi_ps(blue, red);
+
+    _mm_storeu_ps(rgb, _mm_shuffle_ps(_mm_unpacklo_ps(red, green), _mm_unpacklo_ps(blue, red), _MM_SHUFFLE(3, 0, 1, 0)));
+    _mm_storeu_ps(rgb + 4, _mm_shuffle_ps(greenBlue, redGreen, _MM_SHUFFLE(1, 0, 3, 2)));
+    _mm_storeu_ps(rgb + 8, _mm_shuffle_ps(blueRed, _mm_unpackhi_ps(green, blue), _MM_SHUFFLE(3, 2, 3, 0)));
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Converts four RGB pixels to RGBE. Returns GLUS_FALSE without converting, if a pixel needs frexpf or ldexpf.
+ */
+static GLUSboolean glusImageConvertRGB4(GLUSubyte* rgbe, size_t pixelStride, size_t channelStride, const GLUSfloat* rgb)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+    const __m128i infinity = _mm_set1_epi32(0x7F7FFFFF);
+
+    __m128 first = _mm_loadu_ps(rgb);
+    __m128 second = _mm_loadu_ps(rgb + 4);
+    __m128 third = _mm_loadu_ps(rgb + 8);
+
+    __m128 red, green, blue;
+    __m128 absRed, absGreen, absBlue;
+    __m128 scale;
+
+    __m128i maxExponent;
+    __m128i special;
+    __m128i packed;
+
+    GLUSubyte channels[16];
+
+    red = _mm_shuffle_ps(first, _mm_shuffle_ps(second, third, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    green = _mm_shuffle_ps(_mm_shuffle_ps(first, second, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(second, third, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    blue = _mm_shuffle_ps(_mm_shuffle_ps(first, second, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(third, third, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+    absRed = _mm_andnot_ps(sign, red);
+    absGreen = _mm_andnot_ps(sign, green);
+    absBlue = _mm_andnot_ps(sign, blue);
+
+    // Infinity and NaN are left to the scalar code.
+    special = _mm_or_si128(_mm_cmpgt_epi32(_mm_castps_si128(absRed), infinity), _mm_or_si128(_mm_cmpgt_epi32(_mm_castps_si128(absGreen), infinity), _mm_cmpgt_epi32(_mm_castps_si128(absBlue), infinity)));
+
+    maxExponent = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(_mm_max_ps(absRed, _mm_max_ps(absGreen, absBlue))), 23), _mm_set1_epi32(126));
+
+    maxExponent = _mm_andnot_si128(_mm_and_si128(_mm_castps_si128(_mm_or_ps(_mm_cmpeq_ps(red, zero), _mm_or_ps(_mm_cmpeq_ps(green, zero), _mm_cmpeq_ps(blue, zero)))), _mm_cmplt_epi32(maxExponent, _mm_setzero_si128())), maxExponent);
+
+    special = _mm_or_si128(special, _mm_cmplt_epi32(maxExponent, _mm_set1_epi32(-118)));
+
+    if (_mm_movemask_epi8(special))
+    {
+        return GLUS_FALSE;
+    }
+
+    // The exponent bits of 2^(8 - maxExponent) are 135 - maxExponent.
+    scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_sub_epi32(_mm_set1_epi32(135), maxExponent), 23));
+
+    packed = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(red, scale)), byteMask);
+    packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(green, scale)), byteMask), 8));
+    packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(blue, scale)), byteMask), 16));
+    packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_add_epi32(maxExponent, _mm_set1_epi32(128)), 24));
+
+    if (pixelStride == 4 && channelStride == 1)
+    {
+        _mm_storeu_si128((__m128i*)rgbe, packed);
+
+        return GLUS_TRUE;
+    }
+
+    // Transpose to the channels of the four pixels.
+    packed = _mm_unpacklo_epi8(packed, _mm_srli_si128(packed, 8));
+    packed = _mm_unpacklo_epi8(packed, _mm_srli_si128(packed, 8));
+
+    _mm_storeu_si128((__m128i*)channels, packed);
+
+    glusImageScatterRGBE4(rgbe, pixelStride, channelStride, channels);
+
+    return GLUS_TRUE;
+}
+
+#elif defined(GLUS_IMAGE_NEON)
+
+static GLUSboolean glusImageAnyLane(uint32x4_t mask)
+{
+    uint32x2_t any = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+
+    return (vget_lane_u32(any, 0) | vget_lane_u32(any, 1)) != 0;
+}
+
+/**
+ * Converts four RGBE pixels to RGB. Returns GLUS_FALSE without converting, if an exponent below 10 would need a denormal scale.
+ */
+static GLUSboolean glusImageConvertRGBE4(GLUSfloat* rgb, const GLUSubyte* rgbe)
+{
+    const uint32x4_t byteMask = vdupq_n_u32(0xFF);
+
+    uint32x4_t pixels = vreinterpretq_u32_u8(vld1q_u8(rgbe));
+    uint32x4_t exponent = vshrq_n_u32(pixels, 24);
+
+    float32x4_t scale;
+    float32x4x3_t result;
+
+    if (glusImageAnyLane(vcltq_u32(exponent, vdupq_n_u32(10))))
+    {
+        return GLUS_FALSE;
+    }
+
+    // The exponent bits of 2^(exponent - 128 - 8) are exponent - 9.
+    scale = vreinterpretq_f32_u32(vshlq_n_u32(vsubq_u32(exponent, vdupq_n_u32(9)), 23));
+
+    result.val[0] = vmulq_f32(vcvtq_f32_u32(vandq_u32(pixels, byteMask)), scale);
+    result.val[1] = vmulq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(pixels, 8), byteMask)), scale);
+    result.val[2] = vmulq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(pixels, 16), byteMask)), scale);
+
+    vst3q_f32(rgb, result);
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Converts four RGB pixels to RGBE. Returns GLUS_FALSE without converting, if a pixel needs frexpf or ldexpf.
+ */
+static GLUSboolean glusImageConvertRGB4(GLUSubyte* rgbe, size_t pixelStride, size_t channelStride, const GLUSfloat* rgb)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const uint32x4_t infinity = vdupq_n_u32(0x7F7FFFFF);
+
+    float32x4x3_t pixels = vld3q_f32(rgb);
+
+    float32x4_t absRed = vabsq_f32(pixels.val[0]);
+    float32x4_t absGreen = vabsq_f32(pixels.val[1]);
+    float32x4_t absBlue = vabsq_f32(pixels.val[2]);
+    float32x4_t scale;
+
+    int32x4_t maxExponent;
+    uint32x4_t special;
+    uint32x4_t red, green, blue, exponent;
+
+    GLUSubyte channels[16];
+
+    // Infinity and NaN are left to the scalar code.
+    special = vorrq_u32(vcgtq_u32(vreinterpretq_u32_f32(absRed), infinity), vorrq_u32(vcgtq_u32(vreinterpretq_u32_f32(absGreen), infinity), vcgtq_u32(vreinterpretq_u32_f32(absBlue), infinity)));
+
+    maxExponent = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_f32(vmaxq_f32(absRed, vmaxq_f32(absGreen, absBlue))), 23)), vdupq_n_s32(126));
+
+    maxExponent = vbicq_s32(maxExponent, vreinterpretq_s32_u32(vandq_u32(vorrq_u32(vceqq_f32(pixels.val[0], zero), vorrq_u32(vceqq_f32(pixels.val[1], zero), vceqq_f32(pixels.val[2], zero))), vcltq_s32(maxExponent, vdupq_n_s32(0)))));
+
+    special = vorrq_u32(special, vcltq_s32(maxExponent, vdupq_n_s32(-118)));
+
+    if (glusImageAnyLane(special))
+    {
+        return GLUS_FALSE;
+    }
+
+    // The exponent bits of 2^(8 - maxExponent) are 135 - maxExponent.
+    scale = vreinterpretq_f32_s32(vshlq_n_s32(vsubq_s32(vdupq_n_s32(135), maxExponent), 23));
+
+    red = vcvtq_u32_f32(vmulq_f32(pixels.val[0], scale));
+    green = vcvtq_u32_f32(vmulq_f32(pixels.val[1], scale));
+    blue = vcvtq_u32_f32(vmulq_f32(pixels.val[2], scale));
+    exponent = vreinterpretq_u32_s32(vaddq_s32(maxExponent, vdupq_n_s32(128)));
+
+    vst1_u8(channels, vmovn_u16(vcombine_u16(vmovn_u32(red), vmovn_u32(green))));
+    vst1_u8(channels + 8, vmovn_u16(vcombine_u16(vmovn_u32(blue), vmovn_u32(exponent))));
+
+    glusImageScatterRGBE4(rgbe, pixelStride, channelStride, channels);
+
+    return GLUS_TRUE;
+}
+
+#endif
+
+static GLUSvoid glusImageConvertRGBEPixel(GLUSfloat* rgb, const GLUSubyte* rgbe)
+{
+    GLUSfloat scale = glusImagePowerOfTwo((GLUSint)rgbe[3] - 136);
+
+    rgb[0] = (GLUSfloat)rgbe[0] * scale;
+    rgb[1] = (GLUSfloat)rgbe[1] * scale;
+    rgb[2] = (GLUSfloat)rgbe[2] * scale;
+}
+
+/**
+ * Converts RGBE pixels to RGB. Scaling the mantissa by 2^(exponent - 128 - 8) is exact, so no division and no powf is needed.
+ */
+static GLUSvoid glusImageConvertRGBE(GLUSfloat* rgb, const GLUSubyte* rgbe, GLUSint numberPixels)
+{
+    GLUSint i = 0;
+    GLUSint k;
+
+#if defined(GLUS_IMAGE_SSE2) || defined(GLUS_IMAGE_NEON)
+    for (; i + 4 <= numberPixels; i += 4)
+    {
+        if (!glusImageConvertRGBE4(rgb + i * 3, rgbe + i * 4))
+        {
+            for (k = i; k < i + 4; k++)
+            {
+                glusImageConvertRGBEPixel(rgb + k * 3, rgbe + k * 4);
+            }
+        }
+    }
+#endif
+
+    for (k = i; k < numberPixels; k++)
+    {
+        glusImageConvertRGBEPixel(rgb + k * 3, rgbe + k * 4);
+    }
+}
+
+/**
+ * Converts RGBE pixels to the storage type of the image. Other types than GLUS_FLOAT are converted via the float scanline.
+ */
+static GLUSvoid glusImageStoreRGBE(GLUShdrimage* hdrimage, GLUSfloat* scanline, size_t texelSize, GLUSint x, GLUSint y, const GLUSubyte* rgbe, GLUSint numberPixels)
 {
-    GLUSfloat exponent = (GLUSfloat)(rgbe[3] - 128);
+    GLUSubyte* target = (GLUSubyte*)hdrimage->data + ((size_t)hdrimage->width * y + x) * texelSize;
+
+    if (hdrimage->type == GLUS_FLOAT)
+    {
+        glusImageConvertRGBE((GLUSfloat*)target, rgbe, numberPixels);
+
+        return;
+    }
+
+    glusImageConvertRGBE(scanline, rgbe, numberPixels);
 
-    rgb[0] = (GLUSfloat)rgbe[0] / 256.0f * powf(2.0f, exponent);
-    rgb[1] = (GLUSfloat)rgbe[1] / 256.0f * powf(2.0f, exponent);
-    rgb[2] = (GLUSfloat)rgbe[2] / 256.0f * powf(2.0f, exponent);
+    _glusImageHdrPack(target, hdrimage->type, scanline, numberPixels, 3);
 }
-static GLUSvoid glusImageConvertRGB(GLUSubyte* rgbe, const GLUSfloat* rgb)
+
+/**
+ * Converts a RGB pixel to RGBE. The shared exponent is the one of the largest channel, a channel being zero counts with exponent zero.
+ */
+static GLUSvoid glusImageConvertRGBPixel(GLUSubyte* rgbe, size_t channelStride, const GLUSfloat* rgb)
 {
-    GLUSfloat significant[3];
-    GLUSint   exponent[3];
+    GLUSfloat maxValue;
+    GLUSfloat scale;
+    GLUSuint  bits;
     GLUSint   maxExponent;
 
-    significant[0] = frexpf(rgb[0], &exponent[0]);
-    significant[1] = frexpf(rgb[1], &exponent[1]);
-    significant[2] = frexpf(rgb[2], &exponent[2]);
+    maxValue = fabsf(rgb[0]);
+    if (fabsf(rgb[1]) > maxValue)
+    {
+        maxValue = fabsf(rgb[1]);
+    }
+    if (fabsf(rgb[2]) > maxValue)
+    {
+        maxValue = fabsf(rgb[2]);
+    }
+
+    // Same as frexpf for normal numbers.
+    memcpy(&bits, &maxValue, sizeof(GLUSfloat));
+
+    maxExponent = (GLUSint)((bits >> 23) & 0xFF) - 126;
 
-    maxExponent = exponent[0];
-    if (exponent[1] > maxExponent)
+    if (maxExponent == -126 || maxExponent == 129)
     {
-        maxExponent = exponent[1];
+        frexpf(maxValue, &maxExponent);
     }
-    if (exponent[2] > maxExponent)
+
+    if (maxExponent < 0 && (rgb[0] == 0.0f || rgb[1] == 0.0f || rgb[2] == 0.0f))
     {
-        maxExponent = exponent[2];
+        maxExponent = 0;
     }
 
-    rgbe[0] = (GLUSubyte)(significant[0] * 256.0f * powf(2.0f, (GLUSfloat)(exponent[0] - maxExponent)));
-    rgbe[1] = (GLUSubyte)(significant[1] * 256.0f * powf(2.0f, (GLUSfloat)(exponent[1] - maxExponent)));
-    rgbe[2] = (GLUSubyte)(significant[2] * 256.0f * powf(2.0f, (GLUSfloat)(exponent[2] - maxExponent)));
-    rgbe[3] = (GLUSubyte)(maxExponent + 128);
+    // Scaling by a power of two is exact, as long as the scale itself can be represented.
+    if (maxExponent > -119)
+    {
+        scale = glusImagePowerOfTwo(8 - maxExponent);
+
+        rgbe[0]                 = (GLUSubyte)(rgb[0] * scale);
+        rgbe[channelStride]     = (GLUSubyte)(rgb[1] * scale);
+        rgbe[channelStride * 2] = (GLUSubyte)(rgb[2] * scale);
+    }
+    else
+    {
+        rgbe[0]                 = (GLUSubyte)ldexpf(rgb[0], 8 - maxExponent);
+        rgbe[channelStride]     = (GLUSubyte)ldexpf(rgb[1], 8 - maxExponent);
+        rgbe[channelStride * 2] = (GLUSubyte)ldexpf(rgb[2], 8 - maxExponent);
+    }
+    rgbe[channelStride * 3] = (GLUSubyte)(maxExponent + 128);
 }
 
-static GLUSint glusImageDecodeNewRLE(FILE* file, GLUSubyte* scanline, GLUSint width)
+/**
+ * Converts RGB pixels to RGBE.
+ * The strides allow to store the channels interleaved (4, 1) or separated (1, numberPixels).
+ */
+static GLUSvoid glusImageConvertRGB(GLUSubyte* rgbe, size_t pixelStride, size_t channelStride, const GLUSfloat* rgb, GLUSint numberPixels)
 {
-    GLUSint   channel, x, scanLength, maxScanLength;
-    GLUSubyte code, channelValue;
-    size_t    elementsRead;
+    GLUSint i = 0;
+    GLUSint k;
+
+#if defined(GLUS_IMAGE_SSE2) || defined(GLUS_IMAGE_NEON)
+    for (; i + 4 <= numberPixels; i += 4)
+    {
+        if (!glusImageConvertRGB4(rgbe + i * pixelStride, pixelStride, channelStride, rgb + i * 3))
+        {
+            for (k = i; k < i + 4; k++)
+            {
+                glusImageConvertRGBPixel(rgbe + k * pixelStride, channelStride, rgb + k * 3);
+            }
+        }
+    }
+#endif
+
+    for (k = i; k < numberPixels; k++)
+    {
+        glusImageConvertRGBPixel(rgbe + k * pixelStride, channelStride, rgb + k * 3);
+    }
+}
+
+static GLUSboolean glusImageIsNewRLE(const GLUSubyte* code, GLUSint width)
+{
+    return width < 32768 && code[0] == 2 && code[1] == 2 && code[2] == ((width >> 8) & 0xFF) && code[3] == (width & 0xFF);
+}
+
+static GLUSboolean glusImageIsOldRLE(const GLUSubyte* code)
+{
+    return code[0] == 1 && code[1] == 1 && code[2] == 1;
+}
 
-    maxScanLength = 0;
+/**
+ * Decodes one new style run length encoded scanline from memory. The four channels are stored one after another.
+ */
+static GLUSboolean glusImageDecodeNewRLE(const GLUSubyte** source, const GLUSubyte* end, GLUSubyte* scanline, GLUSint width)
+{
+    const GLUSubyte* current = *source;
+
+    GLUSint   channel, x, length;
+    GLUSubyte code, channelValue;
 
     // read each component
     for (channel = 0; channel < 4; channel++)
     {
         x = 0;
 
-        scanLength = 0;
-
         while (x < width)
         {
-            elementsRead = fread(&code, 1, 1, file);
-
-            if (!_glusFileCheckRead(file, elementsRead, 1))
+            if (current == end)
             {
-                return -1;
+                return GLUS_FALSE;
             }
 
+            code = *current++;
+
             if (code > 128)
             {
                 // Run
 
-                code &= 127;
+                length = code & 127;
 
-                scanLength += code;
-
-                if (scanLength > width)
+                if (x + length > width || current == end)
                 {
-                    glusFileClose(file);
-
-                    return -1;
+                    return GLUS_FALSE;
                 }
 
-                elementsRead = fread(&channelValue, 1, 1, file);
-
-                if (!_glusFileCheckRead(file, elementsRead, 1))
-                {
-                    return -1;
-                }
+                channelValue = *current++;
 
-                while (code--)
+                while (length--)
                 {
                     scanline[x++ * 4 + channel] = channelValue;
                 }
@@ -116,36 +509,24 @@ static GLUSint glusImageDecodeNewRLE(FILE* file, GLUSubyte* scanline, GLUSint wi
             {
                 // Non-run
 
-                scanLength += code;
+                length = code;
 
-                if (scanLength > width)
+                if (x + length > width || end - current < length)
                 {
-                    glusFileClose(file);
-
-                    return -1;
+                    return GLUS_FALSE;
                 }
 
-                while (code--)
+                while (length--)
                 {
-                    elementsRead = fread(&channelValue, 1, 1, file);
-
-                    if (!_glusFileCheckRead(file, elementsRead, 1))
-                    {
-                        return -1;
-                    }
-
-                    scanline[x++ * 4 + channel] = channelValue;
+                    scanline[x++ * 4 + channel] = *current++;
                 }
             }
         }
-
-        if (scanLength > maxScanLength)
-        {
-            maxScanLength = scanLength;
-        }
     }
 
-    return maxScanLength;
+    *source = current;
+
+    return GLUS_TRUE;
 }
 
 GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage* hdrimage, GLUSint width, GLUSint height, GLUSint depth, GLUSenum format)
@@ -174,7 +555,8 @@ GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage* hdrimage, GLUSint widt
         return GLUS_FALSE;
     }
 
-    hdrimage->data = (GLUSfloat*)glusMemoryMalloc(width * height * depth * stride * sizeof(GLUSfloat));
+    hdrimage->data        = (GLUSfloat*)glusMemoryMallocAligned(width * height * depth * stride * sizeof(GLUSfloat), GLUS_MEMORY_DATA_ALIGNMENT);
+    hdrimage->alignedData = hdrimage->data;
     if (!hdrimage->data)
     {
         return GLUS_FALSE;
@@ -183,6 +565,7 @@ GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage* hdrimage, GLUSint widt
     hdrimage->height = height;
     hdrimage->depth  = depth;
     hdrimage->format = format;
+    hdrimage->type   = GLUS_FLOAT;
 
     return GLUS_TRUE;
 }
@@ -195,25 +578,29 @@ GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage* hdrimage, GLUSint widt
 // see http://radiance-online.org/cgi-bin/viewcvs.cgi/ray/src/common/color.c?view=markup
 // see http://www.flipcode.com/archives/HDR_Image_Reader.shtml
 
-GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage* hdrimage)
+GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromMemoryWithType(const GLUSubyte* data, size_t size, GLUShdrimage* hdrimage, GLUSenum type)
 {
-    FILE* file;
+    const GLUSubyte* current;
+    const GLUSubyte* end;
 
     GLUSchar buffer[256];
-    GLUSchar currentChar, oldChar;
 
-    GLUSint width, height, x, y, repeat, factor, i;
+    GLUSint width, height, x, y, factor, i, length;
+
+    size_t repeat, remaining;
 
     GLUSubyte* scanline;
-    GLUSubyte  rgbe[4];
+    GLUSubyte  code[4];
     GLUSubyte  prevRgbe[4];
+    GLUSubyte  texel[12];
 
-    GLUSfloat rgb[3];
+    GLUSfloat  rgb[3];
+    GLUSfloat* converted;
 
-    size_t elementsRead;
+    size_t texelSize;
 
     // check, if we have a valid pointer
-    if (!filename || !hdrimage)
+    if (!data || !hdrimage)
     {
         return GLUS_FALSE;
     }
@@ -223,84 +610,63 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
     hdrimage->depth  = 0;
     hdrimage->data   = 0;
 
-    // open filename in "read binary" mode
-    file = glusFileOpen(filename, "rb");
+    texelSize = _glusImageHdrGetTexelSize(GLUS_RGB, type);
 
-    if (!file)
+    if (!texelSize)
     {
         return GLUS_FALSE;
     }
 
-    elementsRead = fread(buffer, 10, 1, file);
-
-    if (!_glusFileCheckRead(file, elementsRead, 1))
-    {
-        return GLUS_FALSE;
-    }
+    current = data;
+    end     = data + size;
 
     //
     // Information header
     //
 
     // Identifier
-    if (strncmp(buffer, "#?RADIANCE", 10))
+    if (size < 11 || strncmp((const GLUSchar*)current, "#?RADIANCE", 10))
     {
-        glusFileClose(file);
-
         return GLUS_FALSE;
     }
 
     // Go to variables
-    if (fseek(file, 1, SEEK_CUR))
-    {
-        glusFileClose(file);
-
-        return GLUS_FALSE;
-    }
+    current += 11;
 
-    // Variables
-    currentChar = 0;
+    // Variables, an empty line indicates end of header
     while (GLUS_TRUE)
     {
-        oldChar = currentChar;
-
-        elementsRead = fread(&currentChar, 1, 1, file);
-
-        if (!_glusFileCheckRead(file, elementsRead, 1))
+        if (end - current < 2)
         {
             return GLUS_FALSE;
         }
 
-        // Empty line indicates end of header
-        if (currentChar == '\n' && oldChar == '\n')
+        if (current[0] == '\n' && current[1] == '\n')
         {
+            current += 2;
+
             break;
         }
+
+        current++;
     }
 
     // Resolution
     i = 0;
-    while (GLUS_TRUE)
+    while (current < end && *current != '\n' && i < 255)
     {
-        elementsRead = fread(&currentChar, 1, 1, file);
-
-        if (!_glusFileCheckRead(file, elementsRead, 1))
-        {
-            return GLUS_FALSE;
-        }
-
-        buffer[i++] = currentChar;
-
-        if (currentChar == '\n')
-        {
-            break;
-        }
+        buffer[i++] = (GLUSchar)*current++;
     }
+    buffer[i] = '\0';
 
-    if (!sscanf(buffer, "-Y %d +X %d", &height, &width))
+    if (current == end || *current != '\n')
     {
-        glusFileClose(file);
+        return GLUS_FALSE;
+    }
+    current++;
 
+    if (sscanf(buffer, "-Y %d +X %d", &height, &width) != 2 || width < 1 || height < 1 || width > 65535 || height > 65535)
+    {
         glusImageDestroyHdr(hdrimage);
 
         return GLUS_FALSE;
@@ -310,32 +676,30 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
     hdrimage->height = (GLUSushort)height;
     hdrimage->depth  = 1;
     hdrimage->format = GLUS_RGB;
+    hdrimage->type   = type;
 
-    hdrimage->data = (GLUSfloat*)glusMemoryMalloc(width * height * 3 * sizeof(GLUSfloat));
+    hdrimage->data        = (GLUSfloat*)glusMemoryMallocAligned((size_t)width * height * texelSize, GLUS_MEMORY_DATA_ALIGNMENT);
+    hdrimage->alignedData = hdrimage->data;
 
     if (!hdrimage->data)
     {
-        glusFileClose(file);
-
         glusImageDestroyHdr(hdrimage);
 
         return GLUS_FALSE;
     }
 
-    // Scanlines
-    scanline = (GLUSubyte*)glusMemoryMalloc(width * 4 * sizeof(GLUSubyte));
+    // Scanlines, followed by the floats for converting to other types
+    scanline = (GLUSubyte*)glusMemoryMalloc(width * 4 * sizeof(GLUSubyte) + (type != GLUS_FLOAT ? width * 3 * sizeof(GLUSfloat) : 0));
 
     if (!scanline)
     {
-        glusMemoryFree(scanline);
-
-        glusFileClose(file);
-
         glusImageDestroyHdr(hdrimage);
 
         return GLUS_FALSE;
     }
 
+    converted = (GLUSfloat*)(scanline + width * 4);
+
     prevRgbe[0] = 0;
     prevRgbe[1] = 0;
     prevRgbe[2] = 0;
@@ -346,9 +710,7 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
     y      = height - 1;
     while (y >= 0)
     {
-        elementsRead = fread(buffer, 4, 1, file);
-
-        if (!_glusFileCheckRead(file, elementsRead, 1))
+        if (end - current < 4)
         {
             glusMemoryFree(scanline);
 
@@ -357,46 +719,46 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
             return GLUS_FALSE;
         }
 
-        repeat = 0;
+        memcpy(code, current, 4);
+        current += 4;
 
         // Examine value
-        if (width < 32768 && buffer[0] == 2 && buffer[1] == 2 && buffer[2] == ((width >> 8) & 0xFF) && buffer[3] == (width & 0xFF))
+        if (glusImageIsNewRLE(code, width))
         {
             // New RLE decoding
 
-            GLUSint scanlinePixels = glusImageDecodeNewRLE(file, scanline, width);
-
-            if (scanlinePixels < 0)
+            if (!glusImageDecodeNewRLE(&current, end, scanline, width))
             {
                 glusMemoryFree(scanline);
 
-                // File already closed
-
                 glusImageDestroyHdr(hdrimage);
 
                 return GLUS_FALSE;
             }
 
-            for (i = 0; i < scanlinePixels; i++)
+            // Convert the scanline, which may continue a partially filled row.
+            i = 0;
+            while (i < width)
             {
                 if (y < 0)
                 {
                     glusMemoryFree(scanline);
 
-                    glusFileClose(file);
-
                     glusImageDestroyHdr(hdrimage);
 
                     return GLUS_FALSE;
                 }
 
-                glusImageConvertRGBE(rgb, &scanline[i * 4]);
+                length = width - x;
+                if (length > width - i)
+                {
+                    length = width - i;
+                }
 
-                hdrimage->data[(width * y + x) * 3 + 0] = rgb[0];
-                hdrimage->data[(width * y + x) * 3 + 1] = rgb[1];
-                hdrimage->data[(width * y + x) * 3 + 2] = rgb[2];
+                glusImageStoreRGBE(hdrimage, converted, texelSize, x, y, &scanline[i * 4], length);
 
-                x++;
+                i += length;
+                x += length;
                 if (x >= width)
                 {
                     y--;
@@ -406,143 +768,1010 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 
             factor = 1;
 
-            prevRgbe[0] = scanline[(scanlinePixels - 1) * 4 + 0];
-            prevRgbe[1] = scanline[(scanlinePixels - 1) * 4 + 1];
-            prevRgbe[2] = scanline[(scanlinePixels - 1) * 4 + 2];
-            prevRgbe[3] = scanline[(scanlinePixels - 1) * 4 + 3];
+            memcpy(prevRgbe, &scanline[(width - 1) * 4], 4);
 
             continue;
         }
-        else if (buffer[0] == 1 && buffer[1] == 1 && buffer[2] == 1)
+
+        if (!glusImageIsOldRLE(code))
         {
-            // Old RLE decoding
+            // No RLE decoding, all following plain pixels of the row are converted at once.
 
-            repeat = buffer[3] * factor;
+            const GLUSubyte* pixels = current - 4;
 
-            rgbe[0] = prevRgbe[0];
-            rgbe[1] = prevRgbe[1];
-            rgbe[2] = prevRgbe[2];
-            rgbe[3] = prevRgbe[3];
+            length = 1;
+            while (x + length < width && end - current >= 4 && !glusImageIsNewRLE(current, width) && !glusImageIsOldRLE(current))
+            {
+                current += 4;
 
-            factor *= 256;
-        }
-        else
+                length++;
+            }
+
+            glusImageStoreRGBE(hdrimage, converted, texelSize, x, y, pixels, length);
+
+            x += length;
+            if (x >= width)
+            {
+                y--;
+                x = 0;
+            }
+
+            factor = 1;
+
+            memcpy(prevRgbe, current - 4, 4);
+
+            continue;
+        }
+
+        // Old RLE decoding, the previous pixel is repeated.
+
+        if (factor > 65536)
+        {
+            glusMemoryFree(scanline);
+
+            glusImageDestroyHdr(hdrimage);
+
+            return GLUS_FALSE;
+        }
+
+        repeat = (size_t)code[3] * factor;
+
+        factor *= 256;
+
+        remaining = (size_t)width * y + (width - x);
+
+        if (repeat > remaining)
+        {
+            glusMemoryFree(scanline);
+
+            glusImageDestroyHdr(hdrimage);
+
+            return GLUS_FALSE;
+        }
+
+        glusImageConvertRGBE(rgb, prevRgbe, 1);
+
+        _glusImageHdrPack(texel, type, rgb, 1, 3);
+
+        while (repeat)
+        {
+            memcpy((GLUSubyte*)hdrimage->data + ((size_t)width * y + x) * texelSize, texel, texelSize);
+
+            x++;
+            if (x >= width)
+            {
+                y--;
+                x = 0;
+            }
+
+            repeat--;
+        }
+    }
+
+    glusMemoryFree(scanline);
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromMemory(const GLUSubyte* data, size_t size, GLUShdrimage* hdrimage)
+{
+    return glusImageLoadHdrFromMemoryWithType(data, size, hdrimage, GLUS_FLOAT);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadHdrWithType(const GLUSchar* filename, GLUShdrimage* hdrimage, GLUSenum type)
+{
+    GLUSmappedfile mappedfile;
+
+    GLUSboolean result;
+
+    // check, if we have a valid pointer
+    if (!filename || !hdrimage)
+    {
+        return GLUS_FALSE;
+    }
+
+    hdrimage->width  = 0;
+    hdrimage->height = 0;
+    hdrimage->depth  = 0;
+    hdrimage->data   = 0;
+
+    // The whole file is decoded from memory.
+    if (!glusFileMap(filename, &mappedfile))
+    {
+        return GLUS_FALSE;
+    }
+
+    result = glusImageLoadHdrFromMemoryWithType(mappedfile.data, mappedfile.length, hdrimage, type);
+
+    glusFileUnmap(&mappedfile);
+
+    return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage* hdrimage)
+{
+    return glusImageLoadHdrWithType(filename, hdrimage, GLUS_FLOAT);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromStreamWithType(const GLUSstream* stream, GLUShdrimage* hdrimage, GLUSenum type)
+{
+    GLUSubyte* data;
+    size_t     size;
+
+    GLUSboolean result;
+
+    // check, if we have a valid pointer
+    if (!stream || !hdrimage)
+    {
+        return GLUS_FALSE;
+    }
+
+    hdrimage->width  = 0;
+    hdrimage->height = 0;
+    hdrimage->depth  = 0;
+    hdrimage->data   = 0;
+
+    if (!_glusFileReadStream(stream, &data, &size))
+    {
+        return GLUS_FALSE;
+    }
+
+    result = glusImageLoadHdrFromMemoryWithType(data, size, hdrimage, type);
+
+    glusMemoryFree(data);
+
+    return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadHdrFromStream(const GLUSstream* stream, GLUShdrimage* hdrimage)
+{
+    return glusImageLoadHdrFromStreamWithType(stream, hdrimage, GLUS_FLOAT);
+}
+
+/**
+ * Start of a row in the file. Old style runs can continue in the following rows.
+ */
+typedef struct _GLUSimagehdrrow
+{
+    GLUSuint64 offset;
+
+    GLUSuint64 repeat;
+
+    GLUSint factor;
+
+    GLUSubyte previous[4];
+
+} GLUSimagehdrrow;
+
+/**
+ * State of a HDR reader. The rows are indexed, when they are decoded the first time.
+ */
+typedef struct _GLUSimagehdrreader
+{
+    GLUSvoid* stream;
+
+    GLUSint width;
+    GLUSint height;
+
+    /**
+     * Maximum size of an encoded scanline.
+     */
+    size_t maxScanlineSize;
+
+    GLUSimagehdrrow* rows;
+    GLUSint          numberIndexedRows;
+
+    GLUSubyte* scanline;
+
+} GLUSimagehdrreader;
+
+static GLUSvoid glusImageHdrDestroyReader(GLUSimagehdrreader* reader)
+{
+    if (!reader)
+    {
+        return;
+    }
+
+    _glusImageStreamClose(reader->stream);
+
+    glusMemoryFree(reader->rows);
+    glusMemoryFree(reader->scanline);
+
+    glusMemoryFree(reader);
+}
+
+static GLUSvoid glusImageHdrRepeat(GLUSubyte* scanline, const GLUSubyte rgbe[4], GLUSint length)
+{
+    while (length--)
+    {
+        memcpy(scanline, rgbe, 4);
+
+        scanline += 4;
+    }
+}
+
+/**
+ * Decodes the row starting at the given state into the RGBE scanline and advances the state to the next row.
+ * The records are interpreted as by glusImageLoadHdrFromMemory, except that a new RLE scanline has to start at the beginning of a row.
+ */
+static GLUSboolean glusImageHdrDecodeRow(GLUSimagehdrreader* reader, GLUSimagehdrrow* state, GLUSint rowsAfter)
+{
+    GLUSubyte* scanline = reader->scanline;
+    GLUSint    width    = reader->width;
+
+    const GLUSubyte* begin;
+    const GLUSubyte* current;
+    const GLUSubyte* end;
+    size_t           available;
+
+    GLUSint    x = 0;
+    GLUSint    length;
+    GLUSuint64 repeat;
+
+    // Pixels of a run started in a previous row.
+    length = state->repeat > (GLUSuint64)width ? width : (GLUSint)state->repeat;
+
+    glusImageHdrRepeat(scanline, state->previous, length);
+
+    x += length;
+    state->repeat -= length;
+
+    if (x == width)
+    {
+        return GLUS_TRUE;
+    }
+
+    if (!_glusImageStreamSeek(reader->stream, state->offset))
+    {
+        return GLUS_FALSE;
+    }
+
+    begin = _glusImageStreamPeek(reader->stream, reader->maxScanlineSize, &available);
+
+    if (!begin)
+    {
+        return GLUS_FALSE;
+    }
+
+    current = begin;
+    end     = begin + available;
+
+    while (x < width)
+    {
+        if (end - current < 4)
+        {
+            // More records than buffered, e.g. many runs of length zero.
+
+            state->offset += (GLUSuint64)(current - begin);
+
+            if (!_glusImageStreamSeek(reader->stream, state->offset))
+            {
+                return GLUS_FALSE;
+            }
+
+            begin = _glusImageStreamPeek(reader->stream, reader->maxScanlineSize, &available);
+
+            if (!begin || available < 4)
+            {
+                return GLUS_FALSE;
+            }
+
+            current = begin;
+            end     = begin + available;
+        }
+
+        if (glusImageIsNewRLE(current, width))
+        {
+            // New RLE decoding
+
+            if (x != 0)
+            {
+                return GLUS_FALSE;
+            }
+
+            current += 4;
+
+            if (!glusImageDecodeNewRLE(&current, end, scanline, width))
+            {
+                return GLUS_FALSE;
+            }
+
+            x = width;
+
+            state->factor = 1;
+
+            memcpy(state->previous, &scanline[(width - 1) * 4], 4);
+        }
+        else if (!glusImageIsOldRLE(current))
         {
             // No RLE decoding
 
-            repeat = 1;
+            memcpy(&scanline[x * 4], current, 4);
+
+            x++;
+
+            state->factor = 1;
+
+            memcpy(state->previous, current, 4);
+
+            current += 4;
+        }
+        else
+        {
+            // Old RLE decoding, the previous pixel is repeated.
+
+            if (state->factor > 65536)
+            {
+                return GLUS_FALSE;
+            }
+
+            repeat = (GLUSuint64)current[3] * state->factor;
+
+            state->factor *= 256;
+
+            current += 4;
+
+            if (repeat > (GLUSuint64)(width - x) + (GLUSuint64)width * rowsAfter)
+            {
+                return GLUS_FALSE;
+            }
+
+            length = repeat > (GLUSuint64)(width - x) ? width - x : (GLUSint)repeat;
+
+            glusImageHdrRepeat(&scanline[x * 4], state->previous, length);
+
+            x += length;
+
+            state->repeat = repeat - length;
+        }
+    }
+
+    state->offset += (GLUSuint64)(current - begin);
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Decodes a tile of rows in file order, i.e. starting with the top row.
+ */
+static GLUSboolean glusImageHdrDecodeRows(GLUSvoid* userData, GLUSubyte* rows, GLUSint firstRow, GLUSint numberRows)
+{
+    GLUSimagehdrreader* reader = (GLUSimagehdrreader*)userData;
+
+    GLUSimagehdrrow state;
+    GLUSint         i;
+
+    // Rows before the tile are decoded once to find the start of the tile.
+    while (reader->numberIndexedRows <= firstRow)
+    {
+        state = reader->rows[reader->numberIndexedRows - 1];
+
+        if (!glusImageHdrDecodeRow(reader, &state, reader->height - reader->numberIndexedRows))
+        {
+            return GLUS_FALSE;
+        }
+
+        reader->rows[reader->numberIndexedRows++] = state;
+    }
+
+    state = reader->rows[firstRow];
+
+    for (i = 0; i < numberRows; i++)
+    {
+        if (!glusImageHdrDecodeRow(reader, &state, reader->height - 1 - (firstRow + i)))
+        {
+            return GLUS_FALSE;
+        }
+
+        glusImageConvertRGBE((GLUSfloat*)&rows[(size_t)reader->width * 3 * sizeof(GLUSfloat) * i], reader->scanline, reader->width);
+
+        if (firstRow + i + 1 == reader->numberIndexedRows && reader->numberIndexedRows < reader->height)
+        {
+            reader->rows[reader->numberIndexedRows++] = state;
+        }
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageOpenHdrReader(const GLUSchar* filename, GLUSimagereader* reader, size_t cacheSize)
+{
+    GLUSimagehdrreader* state;
+
+    const GLUSubyte* begin;
+    const GLUSubyte* current;
+    const GLUSubyte* end;
+    size_t           available;
+
+    GLUSchar buffer[256];
+
+    GLUSint width, height, i;
+
+    // check, if we have a valid pointer
+    if (!filename || !reader)
+    {
+        return GLUS_FALSE;
+    }
+
+    reader->width  = 0;
+    reader->height = 0;
+    reader->format = 0;
+    reader->handle = 0;
+
+    state = (GLUSimagehdrreader*)glusMemoryMalloc(sizeof(GLUSimagehdrreader));
+
+    if (!state)
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(state, 0, sizeof(GLUSimagehdrreader));
+
+    state->stream = _glusImageStreamOpen(filename);
+
+    if (!state->stream)
+    {
+        glusImageHdrDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+
+    // The header is parsed from the buffer, see glusImageLoadHdrFromMemory.
+    begin = _glusImageStreamPeek(state->stream, 65536, &available);
+
+    if (!begin || available < 11 || strncmp((const GLUSchar*)begin, "#?RADIANCE", 10))
+    {
+        glusImageHdrDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+
+    current = begin + 11;
+    end     = begin + available;
+
+    while (GLUS_TRUE)
+    {
+        if (end - current < 2)
+        {
+            glusImageHdrDestroyReader(state);
+
+            return GLUS_FALSE;
+        }
+
+        if (current[0] == '\n' && current[1] == '\n')
+        {
+            current += 2;
+
+            break;
+        }
+
+        current++;
+    }
+
+    i = 0;
+    while (current < end && *current != '\n' && i < 255)
+    {
+        buffer[i++] = (GLUSchar)*current++;
+    }
+    buffer[i] = '\0';
+
+    if (current == end || *current != '\n')
+    {
+        glusImageHdrDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+    current++;
+
+    if (sscanf(buffer, "-Y %d +X %d", &height, &width) != 2 || width < 1 || height < 1 || width > 65535 || height > 65535)
+    {
+        glusImageHdrDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+
+    state->width  = width;
+    state->height = height;
+
+    // A channel of a new RLE scanline takes at most two bytes per value.
+    state->maxScanlineSize = 4 + (size_t)width * 8;
+
+    state->rows     = (GLUSimagehdrrow*)glusMemoryMalloc(sizeof(GLUSimagehdrrow) * height);
+    state->scanline = (GLUSubyte*)glusMemoryMalloc((size_t)width * 4);
+
+    if (!state->rows || !state->scanline)
+    {
+        glusImageHdrDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+
+    memset(&state->rows[0], 0, sizeof(GLUSimagehdrrow));
+
+    state->rows[0].offset = (GLUSuint64)(current - begin);
+    state->rows[0].factor = 1;
+
+    state->numberIndexedRows = 1;
+
+    if (!_glusImageStreamCreateCache(state->stream, (size_t)width * 3 * sizeof(GLUSfloat), height, cacheSize, glusImageHdrDecodeRows, state))
+    {
+        glusImageHdrDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+
+    reader->width  = width;
+    reader->height = height;
+    reader->format = GLUS_RGB;
+    reader->handle = state;
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageReadHdrRows(GLUSimagereader* reader, GLUSfloat* rows, GLUSint firstRow, GLUSint numberRows)
+{
+    GLUSimagehdrreader* state;
+
+    const GLUSubyte* row;
+    GLUSint          i;
+
+    if (!reader || !reader->handle || !rows || firstRow < 0 || numberRows < 0 || firstRow > reader->height - numberRows)
+    {
+        return GLUS_FALSE;
+    }
+
+    state = (GLUSimagehdrreader*)reader->handle;
+
+    // The file starts with the top row.
+    for (i = 0; i < numberRows; i++)
+    {
+        row = _glusImageStreamGetRow(state->stream, state->height - 1 - (firstRow + i));
+
+        if (!row)
+        {
+            return GLUS_FALSE;
+        }
+
+        memcpy(&rows[(size_t)state->width * 3 * i], row, (size_t)state->width * 3 * sizeof(GLUSfloat));
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusImageCloseHdrReader(GLUSimagereader* reader)
+{
+    if (!reader)
+    {
+        return;
+    }
+
+    glusImageHdrDestroyReader((GLUSimagehdrreader*)reader->handle);
+
+    reader->width  = 0;
+    reader->height = 0;
+    reader->format = 0;
+    reader->handle = 0;
+}
+
+/**
+ * Run length encodes one channel of a scanline, see the new RLE format. Only runs of at least four values are stored as run, as shorter runs do not save space.
+ * Without searching runs, the values are just split into non-run packets.
+ *
+ * @return Number of bytes written to target, which has to hold width + width / 128 + 1 bytes.
+ */
+static size_t glusImageEncodeNewRLE(GLUSubyte* target, const GLUSubyte* values, GLUSint width, GLUSboolean searchRuns)
+{
+    GLUSubyte* start = target;
+
+    GLUSint x = 0;
+    GLUSint begin, length;
+
+    while (x < width)
+    {
+        // Search the next run. A difference at the end of the four values excludes all runs overlapping it.
+
+        length = 0;
+
+        begin = x;
+        while (searchRuns && begin + 3 < width)
+        {
+            if (values[begin + 3] != values[begin + 2])
+            {
+                begin += 3;
+            }
+            else if (values[begin + 2] != values[begin + 1])
+            {
+                begin += 2;
+            }
+            else if (values[begin + 1] != values[begin])
+            {
+                begin += 1;
+            }
+            else
+            {
+                length = 4;
+
+                break;
+            }
+        }
+
+        if (!length)
+        {
+            begin = width;
+        }
+
+        // Non-run, up to the run
+
+        while (x < begin)
+        {
+            GLUSint amount = begin - x;
+
+            if (amount > 128)
+            {
+                amount = 128;
+            }
+
+            *target++ = (GLUSubyte)amount;
+
+            memcpy(target, &values[x], amount);
+            target += amount;
+
+            x += amount;
+        }
+
+        if (length)
+        {
+            // Run, compared eight values at once as long as possible.
+
+            GLUSuint64 pattern = 0x0101010101010101ull * values[begin];
+            GLUSuint64 next;
+
+            while (begin + length + 8 <= width && length + 8 <= 127)
+            {
+                memcpy(&next, &values[begin + length], sizeof(GLUSuint64));
+
+                if (next != pattern)
+                {
+                    break;
+                }
+
+                length += 8;
+            }
+
+            while (begin + length < width && length < 127 && values[begin + length] == values[begin])
+            {
+                length++;
+            }
+
+            *target++ = (GLUSubyte)(128 + length);
+            *target++ = values[begin];
+
+            x = begin + length;
+        }
+    }
+
+    return (size_t)(target - start);
+}
+
+/**
+ * State of a HDR writer.
+ */
+typedef struct _GLUSimagehdrwriter
+{
+    FILE* file;
+
+    GLUSboolean compress;
 
-            rgbe[0] = buffer[0];
-            rgbe[1] = buffer[1];
-            rgbe[2] = buffer[2];
-            rgbe[3] = buffer[3];
+    GLUSubyte* scanline;
+    GLUSubyte* packets;
+    GLUSint    skipSearch[4];
 
-            factor = 1;
-        }
+    GLUSint numberWrittenRows;
 
-        glusImageConvertRGBE(rgb, rgbe);
+} GLUSimagehdrwriter;
 
-        while (repeat)
-        {
-            if (y < 0)
-            {
-                glusMemoryFree(scanline);
+static GLUSvoid glusImageHdrDestroyWriter(GLUSimagehdrwriter* writer)
+{
+    if (!writer)
+    {
+        return;
+    }
 
-                glusFileClose(file);
+    if (writer->file)
+    {
+        glusFileClose(writer->file);
+    }
 
-                glusImageDestroyHdr(hdrimage);
+    glusMemoryFree(writer->scanline);
 
-                return GLUS_FALSE;
-            }
+    glusMemoryFree(writer);
+}
 
-            hdrimage->data[(width * y + x) * 3 + 0] = rgb[0];
-            hdrimage->data[(width * y + x) * 3 + 1] = rgb[1];
-            hdrimage->data[(width * y + x) * 3 + 2] = rgb[2];
+GLUSboolean GLUSAPIENTRY glusImageOpenHdrWriter(const GLUSchar* filename, GLUSimagewriter* writer, GLUSint width, GLUSint height, GLUSboolean compress)
+{
+    GLUSimagehdrwriter* state;
 
-            x++;
-            if (x >= width)
-            {
-                y--;
-                x = 0;
-            }
+    size_t elementsWritten;
+    size_t length;
 
-            repeat--;
-        }
+    // check, if we have a valid pointer
+    if (!filename || !writer)
+    {
+        return GLUS_FALSE;
+    }
+
+    writer->width  = 0;
+    writer->height = 0;
+    writer->format = 0;
+    writer->handle = 0;
 
-        prevRgbe[0] = rgbe[0];
-        prevRgbe[1] = rgbe[1];
-        prevRgbe[2] = rgbe[2];
-        prevRgbe[3] = rgbe[3];
+    if (width < 1 || height < 1 || width > 65535 || height > 65535)
+    {
+        return GLUS_FALSE;
     }
 
-    glusMemoryFree(scanline);
+    state = (GLUSimagehdrwriter*)glusMemoryMalloc(sizeof(GLUSimagehdrwriter));
+
+    if (!state)
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(state, 0, sizeof(GLUSimagehdrwriter));
+
+    // The new RLE format only supports these widths.
+    state->compress = compress && width >= 8 && width <= 32767;
+
+    // One scanline is converted and written at once. For compression, the channels are stored separated and the encoded packets follow.
+    length = (size_t)width * 4;
+    if (state->compress)
+    {
+        length += 4 + 4 * ((size_t)width + width / 128 + 1);
+    }
+
+    state->scanline = (GLUSubyte*)glusMemoryMalloc(length);
+
+    if (!state->scanline)
+    {
+        glusImageHdrDestroyWriter(state);
+
+        return GLUS_FALSE;
+    }
+
+    state->packets = state->scanline + (size_t)width * 4;
+
+    // open filename in "write binary" mode
+    state->file = glusFileOpen(filename, "wb");
+
+    if (!state->file)
+    {
+        glusImageHdrDestroyWriter(state);
+
+        return GLUS_FALSE;
+    }
+
+    // Header
+    elementsWritten = fputs("#?RADIANCE\n#Saved with GLUS\nFORMAT=32-bit_rle_rgbe\n\n", state->file);
+
+    if (!_glusFileCheckWrite(state->file, elementsWritten, 52))
+    {
+        state->file = 0;
+
+        glusImageHdrDestroyWriter(state);
+
+        return GLUS_FALSE;
+    }
+
+    // Resolution
+    if (fprintf(state->file, "-Y %d +X %d\n", height, width) < 0)
+    {
+        glusImageHdrDestroyWriter(state);
+
+        return GLUS_FALSE;
+    }
 
-    glusFileClose(file);
+    writer->width  = width;
+    writer->height = height;
+    writer->format = GLUS_RGB;
+    writer->handle = state;
 
     return GLUS_TRUE;
 }
 
-GLUSboolean GLUSAPIENTRY glusImageSaveHdr(const GLUSchar* filename, const GLUShdrimage* hdrimage)
+GLUSboolean GLUSAPIENTRY glusImageWriteHdrRows(GLUSimagewriter* writer, const GLUSfloat* rows, GLUSint firstRow, GLUSint numberRows)
 {
-    FILE*     file;
-    size_t    elementsWritten;
-    GLUSubyte rgbe[4];
-    GLUSint   x, y;
+    GLUSimagehdrwriter* state;
 
-    // check, if we have a valid pointer
-    if (!filename || !hdrimage)
+    const GLUSfloat* row;
+    size_t           elementsWritten;
+    size_t           length;
+    GLUSint          width;
+    GLUSint          y, channel;
+
+    if (!writer || !writer->handle || !rows || numberRows < 0)
     {
         return GLUS_FALSE;
     }
 
-    if (hdrimage->format != GLUS_RGB)
+    state = (GLUSimagehdrwriter*)writer->handle;
+
+    width = writer->width;
+
+    // The file starts with the top row, so the rows have to be written from the top to the bottom.
+    if (!state->file || firstRow < 0 || firstRow + numberRows != writer->height - state->numberWrittenRows)
     {
         return GLUS_FALSE;
     }
 
-    // open filename in "write binary" mode
-    file = glusFileOpen(filename, "wb");
+    for (y = numberRows - 1; y >= 0; y--)
+    {
+        row = &rows[(size_t)y * width * 3];
+
+        if (state->compress)
+        {
+            glusImageConvertRGB(state->scanline, 1, width, row, width);
+
+            state->packets[0] = 2;
+            state->packets[1] = 2;
+            state->packets[2] = (GLUSubyte)((width >> 8) & 0xFF);
+            state->packets[3] = (GLUSubyte)(width & 0xFF);
+
+            length = 4;
+
+            // Channels with little or no gain, e.g. noisy mantissas and exponents, are not searched for runs in the next scanlines.
+            for (channel = 0; channel < 4; channel++)
+            {
+                size_t channelLength = glusImageEncodeNewRLE(&state->packets[length], &state->scanline[channel * width], width, state->skipSearch[channel] == 0);
+
+                if (state->skipSearch[channel] > 0)
+                {
+                    state->skipSearch[channel]--;
+                }
+                else if (channelLength + 4 * (size_t)width / GLUS_IMAGE_RLE_MIN_SAVING >= (size_t)width)
+                {
+                    state->skipSearch[channel] = GLUS_IMAGE_RLE_SKIP_SEARCH;
+                }
+
+                length += channelLength;
+            }
+
+            elementsWritten = fwrite(state->packets, 1, length, state->file);
+        }
+        else
+        {
+            glusImageConvertRGB(state->scanline, 4, 1, row, width);
+
+            length = (size_t)width * 4 * sizeof(GLUSubyte);
+
+            elementsWritten = fwrite(state->scanline, 1, length, state->file);
+        }
+
+        if (!_glusFileCheckWrite(state->file, elementsWritten, length))
+        {
+            state->file = 0;
+
+            return GLUS_FALSE;
+        }
+
+        state->numberWrittenRows++;
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageCloseHdrWriter(GLUSimagewriter* writer)
+{
+    GLUSimagehdrwriter* state;
+
+    GLUSboolean result;
 
-    if (!file)
+    if (!writer || !writer->handle)
     {
         return GLUS_FALSE;
     }
 
-    // Header
-    elementsWritten = fputs("#?RADIANCE\n#Saved with GLUS\nFORMAT=32-bit_rle_rgbe\n\n", file);
+    state = (GLUSimagehdrwriter*)writer->handle;
+
+    result = state->file && state->numberWrittenRows == writer->height;
+
+    if (state->file)
+    {
+        result = glusFileClose(state->file) == 0 && result;
+
+        state->file = 0;
+    }
 
-    if (!_glusFileCheckWrite(file, elementsWritten, 52))
+    glusImageHdrDestroyWriter(state);
+
+    writer->width  = 0;
+    writer->height = 0;
+    writer->format = 0;
+    writer->handle = 0;
+
+    return result;
+}
+
+static GLUSboolean glusImageSaveHdrData(const GLUSchar* filename, const GLUShdrimage* hdrimage, GLUSboolean compress)
+{
+    GLUSimagewriter writer;
+    GLUSenum        type;
+
+    // check, if we have a valid pointer
+    if (!filename || !hdrimage)
     {
         return GLUS_FALSE;
     }
 
-    // Resolution
-    if (fprintf(file, "-Y %d +X %d\n", hdrimage->height, hdrimage->width) < 0)
+    if (hdrimage->format != GLUS_RGB)
     {
-        glusFileClose(file);
+        return GLUS_FALSE;
+    }
 
+    type = _glusImageHdrGetType(hdrimage->type);
+
+    if (!glusImageOpenHdrWriter(filename, &writer, hdrimage->width, hdrimage->height, compress))
+    {
         return GLUS_FALSE;
     }
 
-    // Non compressed data
-    for (y = hdrimage->height - 1; y >= 0; y--)
+    if (type == GLUS_FLOAT)
+    {
+        if (!glusImageWriteHdrRows(&writer, hdrimage->data, 0, hdrimage->height))
+        {
+            glusImageCloseHdrWriter(&writer);
+
+            return GLUS_FALSE;
+        }
+    }
+    else
     {
-        for (x = 0; x < hdrimage->width; x++)
+        // Each row is converted back to float, starting with the top row.
+
+        GLUSfloat* row;
+        size_t     texelSize;
+        GLUSint    y;
+
+        texelSize = _glusImageHdrGetTexelSize(GLUS_RGB, type);
+
+        row = (GLUSfloat*)glusMemoryMalloc((size_t)hdrimage->width * 3 * sizeof(GLUSfloat));
+
+        if (!texelSize || !row)
         {
-            glusImageConvertRGB(rgbe, &hdrimage->data[(y * hdrimage->width + x) * 3]);
+            glusMemoryFree(row);
+
+            glusImageCloseHdrWriter(&writer);
+
+            return GLUS_FALSE;
+        }
 
-            elementsWritten = fwrite(rgbe, 1, 4 * sizeof(GLUSubyte), file);
+        for (y = hdrimage->height - 1; y >= 0; y--)
+        {
+            _glusImageHdrUnpack(row, type, (const GLUSubyte*)hdrimage->data + (size_t)y * hdrimage->width * texelSize, hdrimage->width, 3);
 
-            if (!_glusFileCheckWrite(file, elementsWritten, 4 * sizeof(GLUSubyte)))
+            if (!glusImageWriteHdrRows(&writer, row, y, 1))
             {
+                glusMemoryFree(row);
+
+                glusImageCloseHdrWriter(&writer);
+
                 return GLUS_FALSE;
             }
         }
+
+        glusMemoryFree(row);
     }
 
-    glusFileClose(file);
+    return glusImageCloseHdrWriter(&writer);
+}
 
-    return GLUS_TRUE;
+GLUSboolean GLUSAPIENTRY glusImageSaveHdr(const GLUSchar* filename, const GLUShdrimage* hdrimage)
+{
+    return glusImageSaveHdrData(filename, hdrimage, GLUS_FALSE);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageSaveHdrRle(const GLUSchar* filename, const GLUShdrimage* hdrimage)
+{
+    return glusImageSaveHdrData(filename, hdrimage, GLUS_TRUE);
 }
 
 GLUSvoid GLUSAPIENTRY glusImageDestroyHdr(GLUShdrimage* hdrimage)
@@ -554,11 +1783,20 @@ GLUSvoid GLUSAPIENTRY glusImageDestroyHdr(GLUShdrimage* hdrimage)
 
     if (hdrimage->data)
     {
-        glusMemoryFree(hdrimage->data);
+        if (hdrimage->data == hdrimage->alignedData)
+        {
+            glusMemoryFreeAligned(hdrimage->data);
+        }
+        else
+        {
+            glusMemoryFree(hdrimage->data);
+        }
 
         hdrimage->data = 0;
     }
 
+    hdrimage->alignedData = 0;
+
     hdrimage->width = 0;
 
     hdrimage->height = 0;
@@ -566,6 +1804,8 @@ GLUSvoid GLUSAPIENTRY glusImageDestroyHdr(GLUShdrimage* hdrimage)
     hdrimage->depth = 0;
 
     hdrimage->format = 0;
+
+    hdrimage->type = 0;
 }
 
 GLUSboolean GLUSAPIENTRY glusImageSampleHdr2D(GLUSfloat rgb[3], const GLUShdrimage* hdrimage, const GLUSfloat st[2])
@@ -573,6 +1813,11 @@ GLUSboolean GLUSAPIENTRY glusImageSampleHdr2D(GLUSfloat rgb[3], const GLUShdrima
     GLUSint   sampleIndex[4];
     GLUSfloat sampelWeight[2];
 
+    const GLUSfloat* texel[4];
+    GLUSfloat        unpacked[4 * 4];
+    size_t           texelSize;
+    GLUSenum         type;
+
     GLUSint i, stride;
 
     if (!rgb || !hdrimage || !st)
@@ -590,15 +1835,159 @@ GLUSboolean GLUSAPIENTRY glusImageSampleHdr2D(GLUSfloat rgb[3], const GLUShdrima
         stride = 4;
     }
 
+    type = _glusImageHdrGetType(hdrimage->type);
+
     _glusImageGatherSamplePoints(sampleIndex, sampelWeight, st, hdrimage->width, hdrimage->height, stride);
 
+    if (type == GLUS_FLOAT)
+    {
+        for (i = 0; i < 4; i++)
+        {
+            texel[i] = &hdrimage->data[sampleIndex[i]];
+        }
+    }
+    else
+    {
+        // The four texels are converted to float.
+
+        texelSize = _glusImageHdrGetTexelSize(hdrimage->format, type);
+
+        if (!texelSize)
+        {
+            return GLUS_FALSE;
+        }
+
+        for (i = 0; i < 4; i++)
+        {
+            _glusImageHdrUnpack(&unpacked[i * 4], type, (const GLUSubyte*)hdrimage->data + (size_t)(sampleIndex[i] / stride) * texelSize, 1, stride);
+
+            texel[i] = &unpacked[i * 4];
+        }
+    }
+
     for (i = 0; i < stride; i++)
     {
-        rgb[i] = hdrimage->data[sampleIndex[0] + i] * sampelWeight[0] * sampelWeight[1];
-        rgb[i] += hdrimage->data[sampleIndex[1] + i] * (1.0f - sampelWeight[0]) * sampelWeight[1];
-        rgb[i] += hdrimage->data[sampleIndex[2] + i] * sampelWeight[0] * (1.0f - sampelWeight[1]);
-        rgb[i] += hdrimage->data[sampleIndex[3] + i] * (1.0f - sampelWeight[0]) * (1.0f - sampelWeight[1]);
+        rgb[i] = texel[0][i] * sampelWeight[0] * sampelWeight[1];
+        rgb[i] += texel[1][i] * (1.0f - sampelWeight[0]) * sampelWeight[1];
+        rgb[i] += texel[2][i] * sampelWeight[0] * (1.0f - sampelWeight[1]);
+        rgb[i] += texel[3][i] * (1.0f - sampelWeight[0]) * (1.0f - sampelWeight[1]);
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageSampleHdr2DBatch(GLUSfloat* rgb, const GLUShdrimage* hdrimage, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT)
+{
+    GLUSint  stride;
+    GLUSenum type;
+
+    if (!hdrimage)
+    {
+        return GLUS_FALSE;
+    }
+
+    stride = 1;
+    if (hdrimage->format == GLUS_RGB)
+    {
+        stride = 3;
+    }
+    else if (hdrimage->format == GLUS_RGBA)
+    {
+        stride = 4;
+    }
+
+    type = _glusImageHdrGetType(hdrimage->type);
+
+    if (type != GLUS_FLOAT)
+    {
+        return _glusImageSampleBatchPackedf(rgb, (const GLUSubyte*)hdrimage->data, type, _glusImageHdrGetTexelSize(hdrimage->format, type), hdrimage->width, hdrimage->height, stride, st, numberSamples, wrapS, wrapT);
+    }
+
+    return _glusImageSampleBatchf(rgb, hdrimage->data, hdrimage->width, hdrimage->height, stride, st, numberSamples, wrapS, wrapT);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageConvertHdr(GLUShdrimage* targetImage, const GLUShdrimage* sourceImage, const GLUSenum targetType)
+{
+    GLUSfloat* row = 0;
+
+    size_t sourceTexelSize;
+    size_t targetTexelSize;
+
+    GLUSint numberChannels, y;
+
+    GLUSenum sourceType;
+    GLUSenum resultType;
+
+    if (!targetImage || !sourceImage || !sourceImage->data || targetImage == sourceImage)
+    {
+        return GLUS_FALSE;
+    }
+
+    sourceType = _glusImageHdrGetType(sourceImage->type);
+    resultType = _glusImageHdrGetType(targetType);
+
+    sourceTexelSize = _glusImageHdrGetTexelSize(sourceImage->format, sourceType);
+    targetTexelSize = _glusImageHdrGetTexelSize(sourceImage->format, resultType);
+
+    if (!sourceTexelSize || !targetTexelSize)
+    {
+        return GLUS_FALSE;
+    }
+
+    numberChannels = (GLUSint)(_glusImageHdrGetTexelSize(sourceImage->format, GLUS_FLOAT) / sizeof(GLUSfloat));
+
+    targetImage->data        = (GLUSfloat*)glusMemoryMallocAligned((size_t)sourceImage->width * sourceImage->height * sourceImage->depth * targetTexelSize, GLUS_MEMORY_DATA_ALIGNMENT);
+    targetImage->alignedData = targetImage->data;
+
+    if (!targetImage->data)
+    {
+        return GLUS_FALSE;
+    }
+
+    // Conversions between two packed types go through a float row.
+    if (sourceType != GLUS_FLOAT && resultType != GLUS_FLOAT)
+    {
+        row = (GLUSfloat*)glusMemoryMalloc((size_t)sourceImage->width * numberChannels * sizeof(GLUSfloat));
+
+        if (!row)
+        {
+            glusMemoryFreeAligned(targetImage->data);
+
+            targetImage->data        = 0;
+            targetImage->alignedData = 0;
+
+            return GLUS_FALSE;
+        }
+    }
+
+    for (y = 0; y < sourceImage->height * sourceImage->depth; y++)
+    {
+        const GLUSubyte* source = (const GLUSubyte*)sourceImage->data + (size_t)y * sourceImage->width * sourceTexelSize;
+        GLUSubyte*       target = (GLUSubyte*)targetImage->data + (size_t)y * sourceImage->width * targetTexelSize;
+
+        if (sourceType == GLUS_FLOAT)
+        {
+            _glusImageHdrPack(target, resultType, (const GLUSfloat*)source, sourceImage->width, numberChannels);
+        }
+        else if (resultType == GLUS_FLOAT)
+        {
+            _glusImageHdrUnpack((GLUSfloat*)target, sourceType, source, sourceImage->width, numberChannels);
+        }
+        else
+        {
+            _glusImageHdrUnpack(row, sourceType, source, sourceImage->width, numberChannels);
+
+            _glusImageHdrPack(target, resultType, row, sourceImage->width, numberChannels);
+        }
     }
 
+    glusMemoryFree(row);
+
+    targetImage->width  = sourceImage->width;
+    targetImage->height = sourceImage->height;
+    targetImage->depth  = sourceImage->depth;
+    targetImage->format = sourceImage->format;
+    targetImage->type   = resultType;
+
     return GLUS_TRUE;
 }
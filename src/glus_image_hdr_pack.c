@@ -0,0 +1,503 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// Vector instructions are only used, if they are enabled for the compiler.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+#define GLUS_IMAGE_SSE2
+
+#endif
+
+#include "GL/glus.h"
+
+/**
+ * Largest finite values of the packed formats. Larger values are clamped, as HDR images often exceed the range of the small floats.
+ */
+#define GLUS_IMAGE_HALF_MAX 65504.0f
+#define GLUS_IMAGE_FLOAT11_MAX 65024.0f
+#define GLUS_IMAGE_FLOAT10_MAX 64512.0f
+#define GLUS_IMAGE_RGB9E5_MAX 65408.0f
+
+static GLUSuint glusImageFloatBits(GLUSfloat value)
+{
+    GLUSuint bits;
+
+    memcpy(&bits, &value, sizeof(GLUSuint));
+
+    return bits;
+}
+
+static GLUSfloat glusImageBitsFloat(GLUSuint bits)
+{
+    GLUSfloat value;
+
+    memcpy(&value, &bits, sizeof(GLUSfloat));
+
+    return value;
+}
+
+/**
+ * Converts a float to an unsigned float with a five bit exponent and the given number of mantissa bits, rounding to nearest even.
+ * Negative values and NaN become zero.
+ */
+static GLUSuint glusImageFloatToSmall(GLUSfloat value, GLUSfloat maxValue, GLUSint mantissaBits)
+{
+    GLUSint  shift = 23 - mantissaBits;
+    GLUSuint bits;
+    GLUSfloat magic;
+
+    if (!(value > 0.0f))
+    {
+        return 0;
+    }
+
+    if (value > maxValue)
+    {
+        value = maxValue;
+    }
+
+    bits = glusImageFloatBits(value);
+
+    // Denormals are rounded by adding a number, whose unit in the last place is the smallest denormal.
+    if (bits < (113u << 23))
+    {
+        magic = glusImageBitsFloat((GLUSuint)((127 - 15) + shift + 1) << 23);
+
+        return glusImageFloatBits(value + magic) - glusImageFloatBits(magic);
+    }
+
+    return (bits - (112u << 23) + ((1u << (shift - 1)) - 1) + ((bits >> shift) & 1)) >> shift;
+}
+
+static GLUSfloat glusImageSmallToFloat(GLUSuint small, GLUSint mantissaBits)
+{
+    GLUSuint exponent = small >> mantissaBits;
+    GLUSuint mantissa = (small & ((1u << mantissaBits) - 1)) << (23 - mantissaBits);
+
+    if (exponent == 0)
+    {
+        return glusImageBitsFloat((113u << 23) | mantissa) - glusImageBitsFloat(113u << 23);
+    }
+    else if (exponent == 31)
+    {
+        return glusImageBitsFloat((255u << 23) | mantissa);
+    }
+
+    return glusImageBitsFloat(((exponent + 112) << 23) | mantissa);
+}
+
+static GLUSushort glusImageFloatToHalf(GLUSfloat value)
+{
+    GLUSuint sign = glusImageFloatBits(value) & 0x80000000u;
+
+    return (GLUSushort)(glusImageFloatToSmall(fabsf(value), GLUS_IMAGE_HALF_MAX, 10) | (sign >> 16));
+}
+
+static GLUSfloat glusImageHalfToFloat(GLUSushort half)
+{
+    GLUSfloat value = glusImageSmallToFloat(half & 0x7FFF, 10);
+
+    return (half & 0x8000) ? -value : value;
+}
+
+/**
+ * Converts a RGB value to the shared exponent format as specified by OpenGL.
+ */
+static GLUSuint glusImageFloatToRGB9E5(const GLUSfloat* rgb)
+{
+    GLUSfloat channel[3];
+    GLUSfloat maxValue;
+    GLUSfloat scale;
+    GLUSint   exponent, i;
+    GLUSuint  mantissa[3];
+
+    for (i = 0; i < 3; i++)
+    {
+        channel[i] = rgb[i] > 0.0f ? (rgb[i] < GLUS_IMAGE_RGB9E5_MAX ? rgb[i] : GLUS_IMAGE_RGB9E5_MAX) : 0.0f;
+    }
+
+    maxValue = channel[0] > channel[1] ? channel[0] : channel[1];
+    maxValue = maxValue > channel[2] ? maxValue : channel[2];
+
+    // floor(log2(maxValue)), taken from the exponent bits.
+    exponent = (GLUSint)(glusImageFloatBits(maxValue) >> 23) - 127;
+    if (exponent < -16)
+    {
+        exponent = -16;
+    }
+    exponent += 16;
+
+    scale = glusImageBitsFloat((GLUSuint)(151 - exponent) << 23);
+
+    if ((GLUSuint)(maxValue * scale + 0.5f) == 512)
+    {
+        exponent++;
+
+        scale *= 0.5f;
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        mantissa[i] = (GLUSuint)(channel[i] * scale + 0.5f);
+    }
+
+    return mantissa[0] | (mantissa[1] << 9) | (mantissa[2] << 18) | ((GLUSuint)exponent << 27);
+}
+
+static GLUSvoid glusImageRGB9E5ToFloat(GLUSfloat* rgb, GLUSuint packed)
+{
+    GLUSfloat scale = glusImageBitsFloat(((packed >> 27) + 103) << 23);
+
+    rgb[0] = (GLUSfloat)(packed & 0x1FF) * scale;
+    rgb[1] = (GLUSfloat)((packed >> 9) & 0x1FF) * scale;
+    rgb[2] = (GLUSfloat)((packed >> 18) & 0x1FF) * scale;
+}
+
+static GLUSuint glusImageFloatToR11G11B10(const GLUSfloat* rgb)
+{
+    return glusImageFloatToSmall(rgb[0], GLUS_IMAGE_FLOAT11_MAX, 6) | (glusImageFloatToSmall(rgb[1], GLUS_IMAGE_FLOAT11_MAX, 6) << 11) | (glusImageFloatToSmall(rgb[2], GLUS_IMAGE_FLOAT10_MAX, 5) << 22);
+}
+
+static GLUSvoid glusImageR11G11B10ToFloat(GLUSfloat* rgb, GLUSuint packed)
+{
+    rgb[0] = glusImageSmallToFloat(packed & 0x7FF, 6);
+    rgb[1] = glusImageSmallToFloat((packed >> 11) & 0x7FF, 6);
+    rgb[2] = glusImageSmallToFloat(packed >> 22, 5);
+}
+
+#if defined(GLUS_IMAGE_SSE2)
+
+static __m128i glusImageSelectSse2(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/**
+ * Four values of glusImageFloatToSmall.
+ */
+static __m128i glusImageFloatToSmallSse2(__m128 value, GLUSfloat maxValue, GLUSint mantissaBits)
+{
+    GLUSint shift = 23 - mantissaBits;
+
+    // The maximum returns the second operand for NaN.
+    __m128  clamped = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(maxValue));
+    __m128i bits    = _mm_castps_si128(clamped);
+    __m128  magic   = _mm_castsi128_ps(_mm_set1_epi32(((127 - 15) + shift + 1) << 23));
+
+    __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(clamped, magic)), _mm_castps_si128(magic));
+    __m128i odd      = _mm_and_si128(_mm_srl_epi32(bits, _mm_cvtsi32_si128(shift)), _mm_set1_epi32(1));
+    __m128i normal   = _mm_srl_epi32(_mm_add_epi32(_mm_add_epi32(bits, _mm_set1_epi32(-(112 << 23) + (1 << (shift - 1)) - 1)), odd), _mm_cvtsi32_si128(shift));
+
+    return glusImageSelectSse2(_mm_cmplt_epi32(bits, _mm_set1_epi32(113 << 23)), denormal, normal);
+}
+
+/**
+ * Four values of glusImageSmallToFloat.
+ */
+static __m128 glusImageSmallToFloatSse2(__m128i small, GLUSint mantissaBits)
+{
+    __m128i exponent = _mm_srl_epi32(small, _mm_cvtsi32_si128(mantissaBits));
+    __m128i mantissa = _mm_sll_epi32(_mm_and_si128(small, _mm_set1_epi32((1 << mantissaBits) - 1)), _mm_cvtsi32_si128(23 - mantissaBits));
+
+    __m128i normal   = _mm_or_si128(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(112)), 23), mantissa);
+    __m128i infinite = _mm_or_si128(_mm_set1_epi32(255 << 23), mantissa);
+    __m128i denormal = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_set1_epi32(113 << 23), mantissa)), _mm_castsi128_ps(_mm_set1_epi32(113 << 23))));
+
+    normal = glusImageSelectSse2(_mm_cmpeq_epi32(exponent, _mm_set1_epi32(31)), infinite, normal);
+
+    return _mm_castsi128_ps(glusImageSelectSse2(_mm_cmpeq_epi32(exponent, _mm_setzero_si128()), denormal, normal));
+}
+
+static __m128i glusImageFloatToHalfSse2(__m128 value)
+{
+    __m128i sign = _mm_and_si128(_mm_castps_si128(value), _mm_set1_epi32((GLUSint)0x80000000u));
+
+    __m128i half = glusImageFloatToSmallSse2(_mm_castsi128_ps(_mm_xor_si128(_mm_castps_si128(value), sign)), GLUS_IMAGE_HALF_MAX, 10);
+
+    // Sign extended, so packing does not saturate.
+    return _mm_srai_epi32(_mm_slli_epi32(_mm_or_si128(half, _mm_srli_epi32(sign, 16)), 16), 16);
+}
+
+static __m128 glusImageHalfToFloatSse2(__m128i half)
+{
+    __m128i sign = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x8000)), 16);
+
+    return _mm_or_ps(glusImageSmallToFloatSse2(_mm_and_si128(half, _mm_set1_epi32(0x7FFF)), 10), _mm_castsi128_ps(sign));
+}
+
+/**
+ * Loads four RGB pixels and separates the channels.
+ */
+static GLUSvoid glusImageLoadRgbSse2(__m128* red, __m128* green, __m128* blue, const GLUSfloat* rgb)
+{
+    __m128 a = _mm_loadu_ps(rgb);
+    __m128 b = _mm_loadu_ps(rgb + 4);
+    __m128 c = _mm_loadu_ps(rgb + 8);
+
+    *red   = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    *green = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 0, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 2, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    *blue  = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 1, 0, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+/**
+ * Interleaves the channels of four pixels and stores them as RGB.
+ */
+static GLUSvoid glusImageStoreRgbSse2(GLUSfloat* rgb, __m128 red, __m128 green, __m128 blue)
+{
+    _mm_storeu_ps(rgb, _mm_shuffle_ps(_mm_shuffle_ps(red, green, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(blue, red, _MM_SHUFFLE(0, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(rgb + 4, _mm_shuffle_ps(_mm_shuffle_ps(green, blue, _MM_SHUFFLE(0, 1, 0, 1)), _mm_shuffle_ps(red, green, _MM_SHUFFLE(0, 2, 0, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(rgb + 8, _mm_shuffle_ps(_mm_shuffle_ps(blue, red, _MM_SHUFFLE(0, 3, 0, 2)), _mm_shuffle_ps(green, blue, _MM_SHUFFLE(0, 3, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+static __m128i glusImageFloatToRGB9E5Sse2(__m128 red, __m128 green, __m128 blue)
+{
+    __m128 zero     = _mm_setzero_ps();
+    __m128 maxValue = _mm_set1_ps(GLUS_IMAGE_RGB9E5_MAX);
+    __m128 half     = _mm_set1_ps(0.5f);
+    __m128 largest, scale;
+
+    __m128i exponent, minExponent, overflow;
+
+    red   = _mm_min_ps(_mm_max_ps(red, zero), maxValue);
+    green = _mm_min_ps(_mm_max_ps(green, zero), maxValue);
+    blue  = _mm_min_ps(_mm_max_ps(blue, zero), maxValue);
+
+    largest = _mm_max_ps(_mm_max_ps(red, green), blue);
+
+    exponent    = _mm_sub_epi32(_mm_srli_epi32(_mm_castps_si128(largest), 23), _mm_set1_epi32(127));
+    minExponent = _mm_set1_epi32(-16);
+    exponent    = _mm_add_epi32(glusImageSelectSse2(_mm_cmplt_epi32(exponent, minExponent), minExponent, exponent), _mm_set1_epi32(16));
+
+    scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_sub_epi32(_mm_set1_epi32(151), exponent), 23));
+
+    overflow = _mm_cmpeq_epi32(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(largest, scale), half)), _mm_set1_epi32(512));
+
+    exponent = _mm_sub_epi32(exponent, overflow);
+    scale    = _mm_castsi128_ps(glusImageSelectSse2(overflow, _mm_castps_si128(_mm_mul_ps(scale, half)), _mm_castps_si128(scale)));
+
+    return _mm_or_si128(_mm_or_si128(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(red, scale), half)), _mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(green, scale), half)), 9)),
+                        _mm_or_si128(_mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(blue, scale), half)), 18), _mm_slli_epi32(exponent, 27)));
+}
+
+#endif
+
+/**
+ * Storage type of an image. Images filled by hand or zero initialized have the type 0, which means GLUS_FLOAT.
+ */
+GLUSenum _glusImageHdrGetType(GLUSenum type)
+{
+    return type ? type : GLUS_FLOAT;
+}
+
+/**
+ * Size of a texel in bytes.
+ *
+ * @return 0, if the format can not be stored with the type.
+ */
+size_t _glusImageHdrGetTexelSize(GLUSenum format, GLUSenum type)
+{
+    size_t numberChannels;
+
+    if (format == GLUS_RGB)
+    {
+        numberChannels = 3;
+    }
+    else if (format == GLUS_RGBA)
+    {
+        numberChannels = 4;
+    }
+    else if (format == GLUS_RED || format == GLUS_ALPHA || format == GLUS_LUMINANCE)
+    {
+        numberChannels = 1;
+    }
+    else
+    {
+        return 0;
+    }
+
+    switch (type)
+    {
+    case GLUS_FLOAT:
+        return numberChannels * sizeof(GLUSfloat);
+    case GLUS_HALF_FLOAT:
+        return numberChannels * sizeof(GLUSushort);
+    case GLUS_UNSIGNED_INT_5_9_9_9_REV:
+    case GLUS_UNSIGNED_INT_10F_11F_11F_REV:
+        return numberChannels == 3 ? sizeof(GLUSuint) : 0;
+    }
+
+    return 0;
+}
+
+/**
+ * Converts float pixels to the given type. Packed types require three channels.
+ */
+GLUSvoid _glusImageHdrPack(GLUSvoid* target, GLUSenum type, const GLUSfloat* source, size_t numberPixels, GLUSint numberChannels)
+{
+    size_t i = 0;
+
+    if (type == GLUS_FLOAT)
+    {
+        memcpy(target, source, numberPixels * numberChannels * sizeof(GLUSfloat));
+    }
+    else if (type == GLUS_HALF_FLOAT)
+    {
+        GLUSushort* half         = (GLUSushort*)target;
+        size_t      numberValues = numberPixels * numberChannels;
+
+#if defined(GLUS_IMAGE_SSE2)
+        for (; i + 8 <= numberValues; i += 8)
+        {
+            _mm_storeu_si128((__m128i*)&half[i], _mm_packs_epi32(glusImageFloatToHalfSse2(_mm_loadu_ps(&source[i])), glusImageFloatToHalfSse2(_mm_loadu_ps(&source[i + 4]))));
+        }
+#endif
+
+        for (; i < numberValues; i++)
+        {
+            half[i] = glusImageFloatToHalf(source[i]);
+        }
+    }
+    else if (type == GLUS_UNSIGNED_INT_5_9_9_9_REV)
+    {
+        GLUSuint* packed = (GLUSuint*)target;
+
+#if defined(GLUS_IMAGE_SSE2)
+        __m128 red, green, blue;
+
+        for (; i + 4 <= numberPixels; i += 4)
+        {
+            glusImageLoadRgbSse2(&red, &green, &blue, &source[i * 3]);
+
+            _mm_storeu_si128((__m128i*)&packed[i], glusImageFloatToRGB9E5Sse2(red, green, blue));
+        }
+#endif
+
+        for (; i < numberPixels; i++)
+        {
+            packed[i] = glusImageFloatToRGB9E5(&source[i * 3]);
+        }
+    }
+    else if (type == GLUS_UNSIGNED_INT_10F_11F_11F_REV)
+    {
+        GLUSuint* packed = (GLUSuint*)target;
+
+#if defined(GLUS_IMAGE_SSE2)
+        __m128 red, green, blue;
+
+        for (; i + 4 <= numberPixels; i += 4)
+        {
+            glusImageLoadRgbSse2(&red, &green, &blue, &source[i * 3]);
+
+            _mm_storeu_si128((__m128i*)&packed[i], _mm_or_si128(_mm_or_si128(glusImageFloatToSmallSse2(red, GLUS_IMAGE_FLOAT11_MAX, 6), _mm_slli_epi32(glusImageFloatToSmallSse2(green, GLUS_IMAGE_FLOAT11_MAX, 6), 11)), _mm_slli_epi32(glusImageFloatToSmallSse2(blue, GLUS_IMAGE_FLOAT10_MAX, 5), 22)));
+        }
+#endif
+
+        for (; i < numberPixels; i++)
+        {
+            packed[i] = glusImageFloatToR11G11B10(&source[i * 3]);
+        }
+    }
+}
+
+/**
+ * Converts pixels of the given type to float. Packed types require three channels.
+ */
+GLUSvoid _glusImageHdrUnpack(GLUSfloat* target, GLUSenum type, const GLUSvoid* source, size_t numberPixels, GLUSint numberChannels)
+{
+    size_t i = 0;
+
+    if (type == GLUS_FLOAT)
+    {
+        memcpy(target, source, numberPixels * numberChannels * sizeof(GLUSfloat));
+    }
+    else if (type == GLUS_HALF_FLOAT)
+    {
+        const GLUSushort* half         = (const GLUSushort*)source;
+        size_t            numberValues = numberPixels * numberChannels;
+
+#if defined(GLUS_IMAGE_SSE2)
+        __m128i values;
+
+        for (; i + 8 <= numberValues; i += 8)
+        {
+            values = _mm_loadu_si128((const __m128i*)&half[i]);
+
+            _mm_storeu_ps(&target[i], glusImageHalfToFloatSse2(_mm_unpacklo_epi16(values, _mm_setzero_si128())));
+            _mm_storeu_ps(&target[i + 4], glusImageHalfToFloatSse2(_mm_unpackhi_epi16(values, _mm_setzero_si128())));
+        }
+#endif
+
+        for (; i < numberValues; i++)
+        {
+            target[i] = glusImageHalfToFloat(half[i]);
+        }
+    }
+    else if (type == GLUS_UNSIGNED_INT_5_9_9_9_REV)
+    {
+        const GLUSuint* packed = (const GLUSuint*)source;
+
+#if defined(GLUS_IMAGE_SSE2)
+        __m128i values, mask;
+        __m128  scale;
+
+        mask = _mm_set1_epi32(0x1FF);
+
+        for (; i + 4 <= numberPixels; i += 4)
+        {
+            values = _mm_loadu_si128((const __m128i*)&packed[i]);
+
+            scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_srli_epi32(values, 27), _mm_set1_epi32(103)), 23));
+
+            glusImageStoreRgbSse2(&target[i * 3], _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(values, mask)), scale), _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(values, 9), mask)), scale), _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(values, 18), mask)), scale));
+        }
+#endif
+
+        for (; i < numberPixels; i++)
+        {
+            glusImageRGB9E5ToFloat(&target[i * 3], packed[i]);
+        }
+    }
+    else if (type == GLUS_UNSIGNED_INT_10F_11F_11F_REV)
+    {
+        const GLUSuint* packed = (const GLUSuint*)source;
+
+#if defined(GLUS_IMAGE_SSE2)
+        __m128i values, mask;
+
+        mask = _mm_set1_epi32(0x7FF);
+
+        for (; i + 4 <= numberPixels; i += 4)
+        {
+            values = _mm_loadu_si128((const __m128i*)&packed[i]);
+
+            glusImageStoreRgbSse2(&target[i * 3], glusImageSmallToFloatSse2(_mm_and_si128(values, mask), 6), glusImageSmallToFloatSse2(_mm_and_si128(_mm_srli_epi32(values, 11), mask), 6), glusImageSmallToFloatSse2(_mm_srli_epi32(values, 22), 5));
+        }
+#endif
+
+        for (; i < numberPixels; i++)
+        {
+            glusImageR11G11B10ToFloat(&target[i * 3], packed[i]);
+        }
+    }
+}
@@ -0,0 +1,223 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "GL/glus.h"
+
+/**
+ * Size of the identifier, header and index of a KTX 2.0 file and of one entry of the level index.
+ */
+#define GLUS_KTX_HEADER_SIZE 80
+#define GLUS_KTX_LEVEL_SIZE 24
+
+/**
+ * Size of the basic data format descriptor block without samples and of one sample.
+ */
+#define GLUS_KTX_DFD_BLOCK_SIZE 24
+#define GLUS_KTX_DFD_SAMPLE_SIZE 16
+
+/**
+ * Maximum size of everything in front of the levels, including padding.
+ */
+#define GLUS_KTX_MAX_PREFIX_SIZE (GLUS_KTX_HEADER_SIZE + GLUS_KTX_LEVEL_SIZE * GLUS_MAX_MIPMAP_LEVELS + 4 + GLUS_KTX_DFD_BLOCK_SIZE + 2 * GLUS_KTX_DFD_SAMPLE_SIZE + 16)
+
+extern GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrite);
+
+static const GLUSubyte g_ktxIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+static GLUSvoid glusKtxWriteUint(GLUSubyte* buffer, GLUSuint value)
+{
+    buffer[0] = (GLUSubyte)value;
+    buffer[1] = (GLUSubyte)(value >> 8);
+    buffer[2] = (GLUSubyte)(value >> 16);
+    buffer[3] = (GLUSubyte)(value >> 24);
+}
+
+static GLUSvoid glusKtxWriteUint64(GLUSubyte* buffer, GLUSuint64 value)
+{
+    glusKtxWriteUint(buffer, (GLUSuint)value);
+    glusKtxWriteUint(buffer + 4, (GLUSuint)(value >> 32));
+}
+
+/**
+ * Writes a sample of the data format descriptor, which covers 64 bits of a block.
+ */
+static GLUSvoid glusKtxWriteSample(GLUSubyte* buffer, GLUSuint bitOffset, GLUSuint channel)
+{
+    glusKtxWriteUint(buffer, bitOffset | 63 << 16 | channel << 24);
+    glusKtxWriteUint(buffer + 4, 0);
+    glusKtxWriteUint(buffer + 8, 0);
+    glusKtxWriteUint(buffer + 12, 0xFFFFFFFF);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageSaveKtx2(const GLUSchar* filename, const GLUSbcimage* bcimage)
+{
+    FILE*     file;
+    GLUSubyte buffer[GLUS_KTX_MAX_PREFIX_SIZE];
+    size_t    elementsWritten;
+    size_t    dfdOffset;
+    size_t    prefixSize;
+    GLUSuint  vkFormat;
+    GLUSuint  colorModel;
+    GLUSuint  transferFunction = 1;
+    GLUSuint  blockSize = 8;
+    GLUSuint  numberSamples = 1;
+    GLUSuint  dfdSize;
+    GLUSuint64 levelOffset;
+    GLUSint   level;
+
+    // check, if we have a valid pointer
+    if (!filename || !bcimage || !bcimage->data || bcimage->imageSize <= 0 || bcimage->numberLevels < 1 || bcimage->numberLevels > GLUS_MAX_MIPMAP_LEVELS)
+    {
+        return GLUS_FALSE;
+    }
+
+    // Vulkan formats and Khronos data format color models.
+    switch (bcimage->internalformat)
+    {
+    case GLUS_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        vkFormat = 131;
+        colorModel = 128;
+        break;
+    case GLUS_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+        vkFormat = 132;
+        colorModel = 128;
+        transferFunction = 2;
+        break;
+    case GLUS_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+        vkFormat = 137;
+        colorModel = 130;
+        blockSize = 16;
+        numberSamples = 2;
+        break;
+    case GLUS_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+        vkFormat = 138;
+        colorModel = 130;
+        transferFunction = 2;
+        blockSize = 16;
+        numberSamples = 2;
+        break;
+    case GLUS_COMPRESSED_RED_RGTC1:
+        vkFormat = 139;
+        colorModel = 131;
+        break;
+    case GLUS_COMPRESSED_RG_RGTC2:
+        vkFormat = 141;
+        colorModel = 132;
+        blockSize = 16;
+        numberSamples = 2;
+        break;
+    default:
+        return GLUS_FALSE;
+    }
+
+    memset(buffer, 0, sizeof(buffer));
+
+    dfdOffset = GLUS_KTX_HEADER_SIZE + GLUS_KTX_LEVEL_SIZE * (size_t)bcimage->numberLevels;
+    dfdSize = 4 + GLUS_KTX_DFD_BLOCK_SIZE + GLUS_KTX_DFD_SAMPLE_SIZE * numberSamples;
+
+    // The levels are aligned to the block size, which is a multiple of four.
+    prefixSize = (dfdOffset + dfdSize + blockSize - 1) & ~((size_t)blockSize - 1);
+
+    memcpy(buffer, g_ktxIdentifier, 12);
+
+    // Header: format, type size, size, no layers, one face, levels and no supercompression.
+    glusKtxWriteUint(buffer + 12, vkFormat);
+    glusKtxWriteUint(buffer + 16, 1);
+    glusKtxWriteUint(buffer + 20, bcimage->width);
+    glusKtxWriteUint(buffer + 24, bcimage->height);
+    glusKtxWriteUint(buffer + 36, 1);
+    glusKtxWriteUint(buffer + 40, (GLUSuint)bcimage->numberLevels);
+
+    // Index: data format descriptor, no key value and no supercompression global data.
+    glusKtxWriteUint(buffer + 48, (GLUSuint)dfdOffset);
+    glusKtxWriteUint(buffer + 52, dfdSize);
+
+    // The smallest level is stored first.
+    levelOffset = prefixSize;
+
+    for (level = bcimage->numberLevels - 1; level >= 0; level--)
+    {
+        glusKtxWriteUint64(buffer + GLUS_KTX_HEADER_SIZE + GLUS_KTX_LEVEL_SIZE * level, levelOffset);
+        glusKtxWriteUint64(buffer + GLUS_KTX_HEADER_SIZE + GLUS_KTX_LEVEL_SIZE * level + 8, (GLUSuint64)bcimage->levelSizes[level]);
+        glusKtxWriteUint64(buffer + GLUS_KTX_HEADER_SIZE + GLUS_KTX_LEVEL_SIZE * level + 16, (GLUSuint64)bcimage->levelSizes[level]);
+
+        levelOffset += (GLUSuint64)bcimage->levelSizes[level];
+    }
+
+    // Basic data format descriptor block with 4x4 texel blocks.
+    glusKtxWriteUint(buffer + dfdOffset, dfdSize);
+    glusKtxWriteUint(buffer + dfdOffset + 4, 0);
+    glusKtxWriteUint(buffer + dfdOffset + 8, 2 | (GLUS_KTX_DFD_BLOCK_SIZE + GLUS_KTX_DFD_SAMPLE_SIZE * numberSamples) << 16);
+    buffer[dfdOffset + 12] = (GLUSubyte)colorModel;
+    buffer[dfdOffset + 13] = 1;
+    buffer[dfdOffset + 14] = (GLUSubyte)transferFunction;
+    buffer[dfdOffset + 15] = 0;
+    buffer[dfdOffset + 16] = 3;
+    buffer[dfdOffset + 17] = 3;
+    buffer[dfdOffset + 20] = (GLUSubyte)blockSize;
+
+    switch (colorModel)
+    {
+    case 130:
+        // BC3: alpha, which is always linear, followed by color.
+        glusKtxWriteSample(buffer + dfdOffset + 4 + GLUS_KTX_DFD_BLOCK_SIZE, 0, transferFunction == 2 ? 15 | 0x10 : 15);
+        glusKtxWriteSample(buffer + dfdOffset + 4 + GLUS_KTX_DFD_BLOCK_SIZE + GLUS_KTX_DFD_SAMPLE_SIZE, 64, 0);
+        break;
+    case 132:
+        // BC5: red followed by green.
+        glusKtxWriteSample(buffer + dfdOffset + 4 + GLUS_KTX_DFD_BLOCK_SIZE, 0, 0);
+        glusKtxWriteSample(buffer + dfdOffset + 4 + GLUS_KTX_DFD_BLOCK_SIZE + GLUS_KTX_DFD_SAMPLE_SIZE, 64, 1);
+        break;
+    default:
+        // BC1 color or BC4 data.
+        glusKtxWriteSample(buffer + dfdOffset + 4 + GLUS_KTX_DFD_BLOCK_SIZE, 0, 0);
+        break;
+    }
+
+    file = glusFileOpen(filename, "wb");
+
+    if (!file)
+    {
+        return GLUS_FALSE;
+    }
+
+    elementsWritten = fwrite(buffer, 1, prefixSize, file);
+
+    if (!_glusFileCheckWrite(file, elementsWritten, prefixSize))
+    {
+        return GLUS_FALSE;
+    }
+
+    for (level = bcimage->numberLevels - 1; level >= 0; level--)
+    {
+        elementsWritten = fwrite(bcimage->data + bcimage->levelOffsets[level], 1, (size_t)bcimage->levelSizes[level], file);
+
+        if (!_glusFileCheckWrite(file, elementsWritten, (size_t)bcimage->levelSizes[level]))
+        {
+            return GLUS_FALSE;
+        }
+    }
+
+    glusFileClose(file);
+
+    return GLUS_TRUE;
+}
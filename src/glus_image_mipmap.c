@@ -0,0 +1,960 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// Vector instructions are only used, if they are enabled for the compiler.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+#define GLUS_IMAGE_SSE2
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+#define GLUS_IMAGE_NEON
+
+#endif
+
+#include "GL/glus.h"
+
+/**
+ * Number of source pixels of a level, from which the level is filtered on several threads.
+ */
+#define GLUS_MIPMAP_PARALLEL_PIXELS 262144
+
+/**
+ * Maximum number of source texels, which contribute to one target texel in one dimension.
+ * The Kaiser filter needs up to 19 texels, if three texels are reduced to one.
+ */
+#define GLUS_MIPMAP_MAX_TAPS 20
+
+/**
+ * Half width of the Kaiser filter in target texels and the shape parameter of its window.
+ */
+#define GLUS_MIPMAP_KAISER_WIDTH 3.0f
+#define GLUS_MIPMAP_KAISER_ALPHA 4.0f
+
+/**
+ * Number of intervals for looking up the sRGB encoding of a linear value.
+ */
+#define GLUS_MIPMAP_SRGB_TABLE_SIZE 4096
+
+extern GLUSvoid _glusThreadRun(GLUSvoid (*function)(GLUSvoid* data, GLUSuint index), GLUSvoid* data, GLUSuint numberTasks, GLUSuint numberThreads);
+extern GLUSuint _glusThreadGetNumberProcessors(GLUSvoid);
+
+extern GLUSenum _glusImageHdrGetType(GLUSenum type);
+extern size_t _glusImageHdrGetTexelSize(GLUSenum format, GLUSenum type);
+extern GLUSvoid _glusImageHdrUnpack(GLUSfloat* target, GLUSenum type, const GLUSvoid* source, size_t numberPixels, GLUSint numberChannels);
+
+/**
+ * Source texels and their weights for one target texel.
+ */
+typedef struct _GLUSmipmapTaps
+{
+    GLUSint numberTaps;
+
+    GLUSint indices[GLUS_MIPMAP_MAX_TAPS];
+
+    GLUSfloat weights[GLUS_MIPMAP_MAX_TAPS];
+
+} GLUSmipmapTaps;
+
+/**
+ * Filtering of one level from the previous level. Either the byte or the float data is used.
+ */
+typedef struct _GLUSmipmapLevel
+{
+    const GLUSubyte* sourceBytes;
+    const GLUSfloat* sourceFloats;
+
+    GLUSubyte* targetBytes;
+    GLUSfloat* targetFloats;
+
+    GLUSint sourceWidth;
+    GLUSint sourceHeight;
+
+    GLUSint targetWidth;
+    GLUSint targetHeight;
+
+    GLUSint numberChannels;
+
+    /**
+     * The color channels before this channel are weighted by it. -1, if the color is not weighted.
+     */
+    GLUSint alphaChannel;
+
+    /**
+     * Per channel table, converting a byte to a linear value.
+     */
+    const GLUSfloat* toLinear[4];
+
+    /**
+     * GLUS_TRUE for the channels, which are stored sRGB encoded.
+     */
+    GLUSboolean sRGB[4];
+
+    /**
+     * Linear value, from which on a sRGB byte is used, and the first sRGB byte of each interval of the table.
+     */
+    const GLUSfloat* sRGBThresholds;
+    const GLUSubyte* linearToSRGB;
+
+    const GLUSmipmapTaps* horizontalTaps;
+    const GLUSmipmapTaps* verticalTaps;
+
+    GLUSint rowsPerBand;
+
+    /**
+     * Per band the vertically filtered row, the filtered target row and a ring buffer of decoded source rows.
+     */
+    GLUSfloat* scratch;
+    size_t     scratchPerBand;
+
+} GLUSmipmapLevel;
+
+static GLUSfloat glusMipmapBesselI0(GLUSfloat x)
+{
+    GLUSfloat sum   = 1.0f;
+    GLUSfloat term  = 1.0f;
+    GLUSfloat halfX = x * 0.5f;
+
+    GLUSint k;
+
+    for (k = 1; k < 32; k++)
+    {
+        term *= (halfX / (GLUSfloat)k) * (halfX / (GLUSfloat)k);
+
+        sum += term;
+
+        if (term < sum * 1e-7f)
+        {
+            break;
+        }
+    }
+
+    return sum;
+}
+
+/**
+ * Kaiser windowed sinc. x is the distance in target texels.
+ */
+static GLUSfloat glusMipmapKaiser(GLUSfloat x)
+{
+    GLUSfloat ratio;
+    GLUSfloat sinc = 1.0f;
+
+    if (x <= -GLUS_MIPMAP_KAISER_WIDTH || x >= GLUS_MIPMAP_KAISER_WIDTH)
+    {
+        return 0.0f;
+    }
+
+    if (fabsf(x) > 1e-6f)
+    {
+        sinc = sinf(GLUS_PI * x) / (GLUS_PI * x);
+    }
+
+    ratio = x / GLUS_MIPMAP_KAISER_WIDTH;
+
+    return sinc * glusMipmapBesselI0(GLUS_MIPMAP_KAISER_ALPHA * sqrtf(1.0f - ratio * ratio)) / glusMipmapBesselI0(GLUS_MIPMAP_KAISER_ALPHA);
+}
+
+/**
+ * Calculates the source texels and weights for every target texel of one dimension. Texels outside the image are clamped to the edge.
+ */
+static GLUSvoid glusMipmapCreateTaps(GLUSmipmapTaps* taps, GLUSint sourceSize, GLUSint targetSize, GLUSenum filter)
+{
+    GLUSfloat ratio = (GLUSfloat)sourceSize / (GLUSfloat)targetSize;
+
+    GLUSfloat start, end, center, weight, sum;
+
+    GLUSint target, first, last, i, n;
+
+    for (target = 0; target < targetSize; target++)
+    {
+        start  = (GLUSfloat)target * ratio;
+        end    = (GLUSfloat)(target + 1) * ratio;
+        center = ((GLUSfloat)target + 0.5f) * ratio;
+
+        if (filter == GLUS_MIPMAP_KAISER)
+        {
+            first = (GLUSint)floorf(center - GLUS_MIPMAP_KAISER_WIDTH * ratio);
+            last  = (GLUSint)ceilf(center + GLUS_MIPMAP_KAISER_WIDTH * ratio);
+        }
+        else
+        {
+            first = (GLUSint)floorf(start);
+            last  = (GLUSint)ceilf(end) - 1;
+        }
+
+        n   = 0;
+        sum = 0.0f;
+
+        for (i = first; i <= last && n < GLUS_MIPMAP_MAX_TAPS; i++)
+        {
+            if (filter == GLUS_MIPMAP_KAISER)
+            {
+                weight = glusMipmapKaiser(((GLUSfloat)i + 0.5f - center) / ratio);
+            }
+            else
+            {
+                // Overlap of the source texel with the target texel.
+                weight = ((GLUSfloat)(i + 1) < end ? (GLUSfloat)(i + 1) : end) - ((GLUSfloat)i > start ? (GLUSfloat)i : start);
+            }
+
+            if (weight == 0.0f)
+            {
+                continue;
+            }
+
+            taps[target].indices[n] = i < 0 ? 0 : (i >= sourceSize ? sourceSize - 1 : i);
+            taps[target].weights[n] = weight;
+
+            sum += weight;
+
+            n++;
+        }
+
+        for (i = 0; i < n; i++)
+        {
+            taps[target].weights[i] /= sum;
+        }
+
+        taps[target].numberTaps = n;
+    }
+}
+
+/**
+ * Converts a source row to linear values. The color is weighted by alpha, if requested.
+ */
+static GLUSvoid glusMipmapDecodeRow(GLUSfloat* row, const GLUSmipmapLevel* level, GLUSint y)
+{
+    size_t numberValues = (size_t)level->sourceWidth * level->numberChannels;
+    size_t i;
+
+    GLUSint c;
+
+    if (level->sourceBytes)
+    {
+        const GLUSubyte* source = &level->sourceBytes[(size_t)y * numberValues];
+
+        // One channel after the other, as the table depends on the channel.
+        for (c = 0; c < level->numberChannels; c++)
+        {
+            const GLUSfloat* toLinear = level->toLinear[c];
+
+            for (i = c; i < numberValues; i += level->numberChannels)
+            {
+                row[i] = toLinear[source[i]];
+            }
+        }
+    }
+    else
+    {
+        memcpy(row, &level->sourceFloats[(size_t)y * numberValues], numberValues * sizeof(GLUSfloat));
+    }
+
+    // Alpha is the last of four channels.
+    if (level->alphaChannel >= 0)
+    {
+        for (i = 0; i < numberValues; i += 4)
+        {
+            row[i + 0] *= row[i + 3];
+            row[i + 1] *= row[i + 3];
+            row[i + 2] *= row[i + 3];
+        }
+    }
+}
+
+/**
+ * Stores a filtered row into the target level.
+ */
+static GLUSvoid glusMipmapEncodeRow(const GLUSmipmapLevel* level, GLUSfloat* row, GLUSint y)
+{
+    size_t numberValues = (size_t)level->targetWidth * level->numberChannels;
+    size_t i;
+
+    GLUSint c, b;
+
+    GLUSfloat value;
+
+    if (level->alphaChannel >= 0)
+    {
+        for (i = 0; i < numberValues; i += level->numberChannels)
+        {
+            value = row[i + level->alphaChannel];
+
+            for (c = 0; c < level->alphaChannel; c++)
+            {
+                row[i + c] = value > 0.0f ? row[i + c] / value : 0.0f;
+            }
+        }
+    }
+
+    if (level->targetBytes)
+    {
+        GLUSubyte* target = &level->targetBytes[(size_t)y * numberValues];
+
+        for (i = 0; i < numberValues; i += level->numberChannels)
+        {
+            for (c = 0; c < level->numberChannels; c++)
+            {
+                value = row[i + c] < 0.0f ? 0.0f : (row[i + c] > 1.0f ? 1.0f : row[i + c]);
+
+                if (level->sRGB[c])
+                {
+                    // The table gives the byte at the start of the interval, the thresholds the exact byte.
+                    b = level->linearToSRGB[(GLUSint)(value * (GLUSfloat)GLUS_MIPMAP_SRGB_TABLE_SIZE)];
+
+                    while (b < 255 && value >= level->sRGBThresholds[b + 1])
+                    {
+                        b++;
+                    }
+
+                    target[i + c] = (GLUSubyte)b;
+                }
+                else
+                {
+                    target[i + c] = (GLUSubyte)(value * 255.0f + 0.5f);
+                }
+            }
+        }
+    }
+    else
+    {
+        GLUSfloat* target = &level->targetFloats[(size_t)y * numberValues];
+
+        for (i = 0; i < numberValues; i += level->numberChannels)
+        {
+            for (c = 0; c < level->numberChannels; c++)
+            {
+                value = row[i + c] > 0.0f ? row[i + c] : 0.0f;
+
+                if (c == level->alphaChannel && value > 1.0f)
+                {
+                    value = 1.0f;
+                }
+
+                target[i + c] = value;
+            }
+        }
+    }
+}
+
+#if defined(GLUS_IMAGE_SSE2)
+
+/**
+ * Adds a weighted source row to the vertically filtered row. The first source row initializes it.
+ */
+static GLUSvoid glusMipmapWeightRow(GLUSfloat* accumulated, const GLUSfloat* decoded, GLUSfloat weight, size_t numberValues, GLUSboolean first)
+{
+    const __m128 weights = _mm_set1_ps(weight);
+
+    size_t i = 0;
+
+    if (first)
+    {
+        for (; i + 4 <= numberValues; i += 4)
+        {
+            _mm_storeu_ps(accumulated + i, _mm_mul_ps(weights, _mm_loadu_ps(decoded + i)));
+        }
+
+        for (; i < numberValues; i++)
+        {
+            accumulated[i] = weight * decoded[i];
+        }
+    }
+    else
+    {
+        for (; i + 4 <= numberValues; i += 4)
+        {
+            _mm_storeu_ps(accumulated + i, _mm_add_ps(_mm_loadu_ps(accumulated + i), _mm_mul_ps(weights, _mm_loadu_ps(decoded + i))));
+        }
+
+        for (; i < numberValues; i++)
+        {
+            accumulated[i] += weight * decoded[i];
+        }
+    }
+}
+
+/**
+ * Filters one target texel horizontally, all channels at once. Lanes after the last channel are not used.
+ * They are read from the following values, which are still inside the scratch buffer of the band.
+ */
+static GLUSvoid glusMipmapFilterTexel(GLUSfloat texel[4], const GLUSfloat* accumulated, const GLUSmipmapTaps* taps, GLUSint numberChannels)
+{
+    __m128 sum = _mm_setzero_ps();
+
+    GLUSint k;
+
+    for (k = 0; k < taps->numberTaps; k++)
+    {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(taps->weights[k]), _mm_loadu_ps(&accumulated[(size_t)taps->indices[k] * numberChannels])));
+    }
+
+    _mm_storeu_ps(texel, sum);
+}
+
+#elif defined(GLUS_IMAGE_NEON)
+
+/**
+ * Adds a weighted source row to the vertically filtered row. The first source row initializes it.
+ */
+static GLUSvoid glusMipmapWeightRow(GLUSfloat* accumulated, const GLUSfloat* decoded, GLUSfloat weight, size_t numberValues, GLUSboolean first)
+{
+    const float32x4_t weights = vdupq_n_f32(weight);
+
+    size_t i = 0;
+
+    if (first)
+    {
+        for (; i + 4 <= numberValues; i += 4)
+        {
+            vst1q_f32(accumulated + i, vmulq_f32(weights, vld1q_f32(decoded + i)));
+        }
+
+        for (; i < numberValues; i++)
+        {
+            accumulated[i] = weight * decoded[i];
+        }
+    }
+    else
+    {
+        for (; i + 4 <= numberValues; i += 4)
+        {
+            vst1q_f32(accumulated + i, vmlaq_f32(vld1q_f32(accumulated + i), weights, vld1q_f32(decoded + i)));
+        }
+
+        for (; i < numberValues; i++)
+        {
+            accumulated[i] += weight * decoded[i];
+        }
+    }
+}
+
+/**
+ * Filters one target texel horizontally, all channels at once. Lanes after the last channel are not used.
+ * They are read from the following values, which are still inside the scratch buffer of the band.
+ */
+static GLUSvoid glusMipmapFilterTexel(GLUSfloat texel[4], const GLUSfloat* accumulated, const GLUSmipmapTaps* taps, GLUSint numberChannels)
+{
+    float32x4_t sum = vdupq_n_f32(0.0f);
+
+    GLUSint k;
+
+    for (k = 0; k < taps->numberTaps; k++)
+    {
+        sum = vmlaq_f32(sum, vdupq_n_f32(taps->weights[k]), vld1q_f32(&accumulated[(size_t)taps->indices[k] * numberChannels]));
+    }
+
+    vst1q_f32(texel, sum);
+}
+
+#else
+
+/**
+ * Adds a weighted source row to the vertically filtered row. The first source row initializes it.
+ */
+static GLUSvoid glusMipmapWeightRow(GLUSfloat* accumulated, const GLUSfloat* decoded, GLUSfloat weight, size_t numberValues, GLUSboolean first)
+{
+    size_t i;
+
+    if (first)
+    {
+        for (i = 0; i < numberValues; i++)
+        {
+            accumulated[i] = weight * decoded[i];
+        }
+    }
+    else
+    {
+        for (i = 0; i < numberValues; i++)
+        {
+            accumulated[i] += weight * decoded[i];
+        }
+    }
+}
+
+/**
+ * Filters one target texel horizontally.
+ */
+static GLUSvoid glusMipmapFilterTexel(GLUSfloat texel[4], const GLUSfloat* accumulated, const GLUSmipmapTaps* taps, GLUSint numberChannels)
+{
+    const GLUSfloat* source;
+
+    GLUSfloat weight;
+
+    GLUSint k, c;
+
+    texel[0] = 0.0f;
+    texel[1] = 0.0f;
+    texel[2] = 0.0f;
+    texel[3] = 0.0f;
+
+    for (k = 0; k < taps->numberTaps; k++)
+    {
+        source = &accumulated[(size_t)taps->indices[k] * numberChannels];
+
+        weight = taps->weights[k];
+
+        for (c = 0; c < numberChannels; c++)
+        {
+            texel[c] += weight * source[c];
+        }
+    }
+}
+
+#endif
+
+/**
+ * Filters a band of target rows. First the source rows of a target row are filtered vertically, then the result horizontally.
+ * Neighboring target rows share most source rows, so the decoded source rows are kept in a ring buffer.
+ */
+static GLUSvoid glusMipmapFilterBand(GLUSvoid* data, GLUSuint index)
+{
+    const GLUSmipmapLevel* level = (const GLUSmipmapLevel*)data;
+
+    size_t sourceValues = (size_t)level->sourceWidth * level->numberChannels;
+
+    GLUSfloat* accumulated = level->scratch + index * level->scratchPerBand;
+    GLUSfloat* filtered    = accumulated + sourceValues;
+    GLUSfloat* decodedRows = filtered + (size_t)level->targetWidth * level->numberChannels;
+    GLUSfloat* decoded;
+
+    GLUSint decodedRowIndices[GLUS_MIPMAP_MAX_TAPS];
+
+    const GLUSmipmapTaps* taps;
+
+    GLUSfloat texel[4];
+
+    GLUSint first = (GLUSint)index * level->rowsPerBand;
+    GLUSint last  = first + level->rowsPerBand;
+    GLUSint x, y, c, k, row;
+
+    if (last > level->targetHeight)
+    {
+        last = level->targetHeight;
+    }
+
+    for (k = 0; k < GLUS_MIPMAP_MAX_TAPS; k++)
+    {
+        decodedRowIndices[k] = -1;
+    }
+
+    for (y = first; y < last; y++)
+    {
+        taps = &level->verticalTaps[y];
+
+        for (k = 0; k < taps->numberTaps; k++)
+        {
+            // The source rows of a target row are consecutive, so they never share a slot.
+            row = taps->indices[k];
+
+            decoded = decodedRows + (size_t)(row % GLUS_MIPMAP_MAX_TAPS) * sourceValues;
+
+            if (decodedRowIndices[row % GLUS_MIPMAP_MAX_TAPS] != row)
+            {
+                glusMipmapDecodeRow(decoded, level, row);
+
+                decodedRowIndices[row % GLUS_MIPMAP_MAX_TAPS] = row;
+            }
+
+            glusMipmapWeightRow(accumulated, decoded, taps->weights[k], sourceValues, k == 0);
+        }
+
+        for (x = 0; x < level->targetWidth; x++)
+        {
+            glusMipmapFilterTexel(texel, accumulated, &level->horizontalTaps[x], level->numberChannels);
+
+            for (c = 0; c < level->numberChannels; c++)
+            {
+                filtered[(size_t)x * level->numberChannels + c] = texel[c];
+            }
+        }
+
+        glusMipmapEncodeRow(level, filtered, y);
+    }
+}
+
+static GLUSboolean glusMipmapFilterLevel(GLUSmipmapLevel* level, GLUSenum filter)
+{
+    GLUSmipmapTaps* horizontalTaps;
+    GLUSmipmapTaps* verticalTaps;
+
+    GLUSuint numberBands = 1;
+
+    horizontalTaps = (GLUSmipmapTaps*)glusMemoryMalloc((size_t)level->targetWidth * sizeof(GLUSmipmapTaps));
+    verticalTaps   = (GLUSmipmapTaps*)glusMemoryMalloc((size_t)level->targetHeight * sizeof(GLUSmipmapTaps));
+
+    if (!horizontalTaps || !verticalTaps)
+    {
+        glusMemoryFree(horizontalTaps);
+        glusMemoryFree(verticalTaps);
+
+        return GLUS_FALSE;
+    }
+
+    glusMipmapCreateTaps(horizontalTaps, level->sourceWidth, level->targetWidth, filter);
+    glusMipmapCreateTaps(verticalTaps, level->sourceHeight, level->targetHeight, filter);
+
+    level->horizontalTaps = horizontalTaps;
+    level->verticalTaps   = verticalTaps;
+
+    if ((size_t)level->sourceWidth * level->sourceHeight >= GLUS_MIPMAP_PARALLEL_PIXELS)
+    {
+        numberBands = _glusThreadGetNumberProcessors();
+    }
+
+    if (numberBands > (GLUSuint)level->targetHeight)
+    {
+        numberBands = (GLUSuint)level->targetHeight;
+    }
+
+    level->rowsPerBand = (level->targetHeight + (GLUSint)numberBands - 1) / (GLUSint)numberBands;
+
+    numberBands = (GLUSuint)((level->targetHeight + level->rowsPerBand - 1) / level->rowsPerBand);
+
+    level->scratchPerBand = (size_t)((1 + GLUS_MIPMAP_MAX_TAPS) * level->sourceWidth + level->targetWidth) * level->numberChannels;
+
+    level->scratch = (GLUSfloat*)glusMemoryMalloc(numberBands * level->scratchPerBand * sizeof(GLUSfloat));
+
+    if (!level->scratch)
+    {
+        glusMemoryFree(horizontalTaps);
+        glusMemoryFree(verticalTaps);
+
+        return GLUS_FALSE;
+    }
+
+    _glusThreadRun(glusMipmapFilterBand, level, numberBands, numberBands);
+
+    glusMemoryFree(level->scratch);
+
+    level->scratch = 0;
+
+    glusMemoryFree(horizontalTaps);
+    glusMemoryFree(verticalTaps);
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Calculates the size of all levels and allocates them at once. Every level starts aligned to GLUS_MEMORY_DATA_ALIGNMENT.
+ */
+static GLUSubyte* glusMipmapAllocate(GLUSubyte* levelData[GLUS_MAX_MIPMAP_LEVELS], GLUSint levelWidth[GLUS_MAX_MIPMAP_LEVELS], GLUSint levelHeight[GLUS_MAX_MIPMAP_LEVELS], GLUSint* numberLevels, GLUSint width, GLUSint height, size_t texelSize)
+{
+    size_t offsets[GLUS_MAX_MIPMAP_LEVELS];
+    size_t size = 0;
+
+    GLUSubyte* data;
+
+    GLUSint i = 0;
+
+    while (GLUS_TRUE)
+    {
+        levelWidth[i]  = width;
+        levelHeight[i] = height;
+
+        offsets[i] = size;
+
+        size += ((size_t)width * height * texelSize + GLUS_MEMORY_DATA_ALIGNMENT - 1) & ~((size_t)GLUS_MEMORY_DATA_ALIGNMENT - 1);
+
+        i++;
+
+        if ((width == 1 && height == 1) || i == GLUS_MAX_MIPMAP_LEVELS)
+        {
+            break;
+        }
+
+        width  = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    *numberLevels = i;
+
+    data = (GLUSubyte*)glusMemoryMallocAligned(size, GLUS_MEMORY_DATA_ALIGNMENT);
+
+    if (!data)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < *numberLevels; i++)
+    {
+        levelData[i] = data + offsets[i];
+    }
+
+    return data;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageGenerateMipmapsTga(GLUStgamipmaps* mipmaps, const GLUStgaimage* tgaimage, const GLUSmipmapOptions* options)
+{
+    GLUSmipmapOptions defaultOptions = {GLUS_MIPMAP_BOX, GLUS_FALSE, GLUS_FALSE};
+
+    GLUSmipmapLevel level;
+
+    GLUSubyte* levelData[GLUS_MAX_MIPMAP_LEVELS];
+    GLUSint    levelWidth[GLUS_MAX_MIPMAP_LEVELS];
+    GLUSint    levelHeight[GLUS_MAX_MIPMAP_LEVELS];
+    GLUSint    numberLevels;
+
+    GLUSfloat linear[256];
+    GLUSfloat sRGBToLinear[256];
+    GLUSfloat sRGBThresholds[256];
+    GLUSubyte linearToSRGB[GLUS_MIPMAP_SRGB_TABLE_SIZE + 1];
+
+    GLUSfloat value;
+
+    GLUSint i, c;
+
+    if (!mipmaps || !tgaimage || !tgaimage->data || tgaimage->width < 1 || tgaimage->height < 1 || tgaimage->depth != 1)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!options)
+    {
+        options = &defaultOptions;
+    }
+
+    memset(mipmaps, 0, sizeof(GLUStgamipmaps));
+    memset(&level, 0, sizeof(GLUSmipmapLevel));
+
+    level.numberChannels = 1;
+    if (tgaimage->format == GLUS_RGB)
+    {
+        level.numberChannels = 3;
+    }
+    else if (tgaimage->format == GLUS_RGBA)
+    {
+        level.numberChannels = 4;
+    }
+    else if (tgaimage->format != GLUS_RED && tgaimage->format != GLUS_ALPHA && tgaimage->format != GLUS_LUMINANCE)
+    {
+        return GLUS_FALSE;
+    }
+
+    level.alphaChannel = (tgaimage->format == GLUS_RGBA && !options->premultipliedAlpha) ? 3 : -1;
+
+    for (i = 0; i < 256; i++)
+    {
+        value = (GLUSfloat)i / 255.0f;
+
+        linear[i]       = value;
+        sRGBToLinear[i] = value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    if (options->sRGB)
+    {
+        // Rounding happens in sRGB space, so a byte starts at the linear value of the byte minus one half.
+        sRGBThresholds[0] = 0.0f;
+        for (i = 1; i < 256; i++)
+        {
+            value = ((GLUSfloat)i - 0.5f) / 255.0f;
+
+            sRGBThresholds[i] = value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+        }
+
+        c = 0;
+        for (i = 0; i <= GLUS_MIPMAP_SRGB_TABLE_SIZE; i++)
+        {
+            value = (GLUSfloat)i / (GLUSfloat)GLUS_MIPMAP_SRGB_TABLE_SIZE;
+
+            while (c < 255 && value >= sRGBThresholds[c + 1])
+            {
+                c++;
+            }
+
+            linearToSRGB[i] = (GLUSubyte)c;
+        }
+
+        level.sRGBThresholds = sRGBThresholds;
+        level.linearToSRGB   = linearToSRGB;
+    }
+
+    // Alpha is always linear.
+    for (c = 0; c < level.numberChannels; c++)
+    {
+        level.sRGB[c] = options->sRGB && tgaimage->format != GLUS_ALPHA && c < 3;
+
+        level.toLinear[c] = level.sRGB[c] ? sRGBToLinear : linear;
+    }
+
+    if (!glusMipmapAllocate(levelData, levelWidth, levelHeight, &numberLevels, tgaimage->width, tgaimage->height, (size_t)level.numberChannels))
+    {
+        return GLUS_FALSE;
+    }
+
+    memcpy(levelData[0], tgaimage->data, (size_t)tgaimage->width * tgaimage->height * level.numberChannels);
+
+    for (i = 1; i < numberLevels; i++)
+    {
+        level.sourceBytes  = levelData[i - 1];
+        level.sourceWidth  = levelWidth[i - 1];
+        level.sourceHeight = levelHeight[i - 1];
+
+        level.targetBytes  = levelData[i];
+        level.targetWidth  = levelWidth[i];
+        level.targetHeight = levelHeight[i];
+
+        if (!glusMipmapFilterLevel(&level, options->filter))
+        {
+            glusMemoryFreeAligned(levelData[0]);
+
+            return GLUS_FALSE;
+        }
+    }
+
+    mipmaps->numberLevels = numberLevels;
+
+    for (i = 0; i < numberLevels; i++)
+    {
+        mipmaps->levels[i].width       = (GLUSushort)levelWidth[i];
+        mipmaps->levels[i].height      = (GLUSushort)levelHeight[i];
+        mipmaps->levels[i].depth       = 1;
+        mipmaps->levels[i].data        = levelData[i];
+        mipmaps->levels[i].alignedData = 0;
+        mipmaps->levels[i].format      = tgaimage->format;
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusImageDestroyMipmapsTga(GLUStgamipmaps* mipmaps)
+{
+    if (!mipmaps)
+    {
+        return;
+    }
+
+    if (mipmaps->numberLevels > 0)
+    {
+        glusMemoryFreeAligned(mipmaps->levels[0].data);
+    }
+
+    memset(mipmaps, 0, sizeof(GLUStgamipmaps));
+}
+
+GLUSboolean GLUSAPIENTRY glusImageGenerateMipmapsHdr(GLUShdrmipmaps* mipmaps, const GLUShdrimage* hdrimage, const GLUSmipmapOptions* options)
+{
+    GLUSmipmapOptions defaultOptions = {GLUS_MIPMAP_BOX, GLUS_FALSE, GLUS_FALSE};
+
+    GLUSmipmapLevel level;
+
+    GLUSubyte* levelData[GLUS_MAX_MIPMAP_LEVELS];
+    GLUSint    levelWidth[GLUS_MAX_MIPMAP_LEVELS];
+    GLUSint    levelHeight[GLUS_MAX_MIPMAP_LEVELS];
+    GLUSint    numberLevels;
+
+    GLUSint i;
+
+    if (!mipmaps || !hdrimage || !hdrimage->data || hdrimage->width < 1 || hdrimage->height < 1 || hdrimage->depth != 1)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!options)
+    {
+        options = &defaultOptions;
+    }
+
+    memset(mipmaps, 0, sizeof(GLUShdrmipmaps));
+    memset(&level, 0, sizeof(GLUSmipmapLevel));
+
+    level.numberChannels = 1;
+    if (hdrimage->format == GLUS_RGB)
+    {
+        level.numberChannels = 3;
+    }
+    else if (hdrimage->format == GLUS_RGBA)
+    {
+        level.numberChannels = 4;
+    }
+    else if (hdrimage->format != GLUS_RED && hdrimage->format != GLUS_ALPHA && hdrimage->format != GLUS_LUMINANCE)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!_glusImageHdrGetTexelSize(hdrimage->format, _glusImageHdrGetType(hdrimage->type)))
+    {
+        return GLUS_FALSE;
+    }
+
+    level.alphaChannel = (hdrimage->format == GLUS_RGBA && !options->premultipliedAlpha) ? 3 : -1;
+
+    if (!glusMipmapAllocate(levelData, levelWidth, levelHeight, &numberLevels, hdrimage->width, hdrimage->height, (size_t)level.numberChannels * sizeof(GLUSfloat)))
+    {
+        return GLUS_FALSE;
+    }
+
+    // Half and packed images are filtered as float.
+    _glusImageHdrUnpack((GLUSfloat*)levelData[0], _glusImageHdrGetType(hdrimage->type), hdrimage->data, (size_t)hdrimage->width * hdrimage->height, level.numberChannels);
+
+    for (i = 1; i < numberLevels; i++)
+    {
+        level.sourceFloats = (const GLUSfloat*)levelData[i - 1];
+        level.sourceWidth  = levelWidth[i - 1];
+        level.sourceHeight = levelHeight[i - 1];
+
+        level.targetFloats = (GLUSfloat*)levelData[i];
+        level.targetWidth  = levelWidth[i];
+        level.targetHeight = levelHeight[i];
+
+        if (!glusMipmapFilterLevel(&level, options->filter))
+        {
+            glusMemoryFreeAligned(levelData[0]);
+
+            return GLUS_FALSE;
+        }
+    }
+
+    mipmaps->numberLevels = numberLevels;
+
+    for (i = 0; i < numberLevels; i++)
+    {
+        mipmaps->levels[i].width       = (GLUSushort)levelWidth[i];
+        mipmaps->levels[i].height      = (GLUSushort)levelHeight[i];
+        mipmaps->levels[i].depth       = 1;
+        mipmaps->levels[i].data        = (GLUSfloat*)levelData[i];
+        mipmaps->levels[i].alignedData = 0;
+        mipmaps->levels[i].format      = hdrimage->format;
+        mipmaps->levels[i].type        = GLUS_FLOAT;
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusImageDestroyMipmapsHdr(GLUShdrmipmaps* mipmaps)
+{
+    if (!mipmaps)
+    {
+        return;
+    }
+
+    if (mipmaps->numberLevels > 0)
+    {
+        glusMemoryFreeAligned(mipmaps->levels[0].data);
+    }
+
+    memset(mipmaps, 0, sizeof(GLUShdrmipmaps));
+}
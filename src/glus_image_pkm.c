@@ -22,55 +22,54 @@
 
 #include "GL/glus.h"
 
-GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar* filename, GLUSpkmimage* pkmimage)
-{
-    GLUSbinaryfile binaryfile;
+#define GLUS_MAX_PKM_IMAGE_SIZE 2147483647
 
-    GLUSubyte* buffer;
+extern GLUSboolean _glusFileReadStream(const GLUSstream* stream, GLUSubyte** data, size_t* length);
+
+extern GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrite);
+
+GLUSboolean GLUSAPIENTRY glusImageLoadPkmFromMemory(const GLUSubyte* data, size_t size, GLUSpkmimage* pkmimage)
+{
+    const GLUSubyte* buffer;
 
     GLUSubyte type;
 
     // check, if we have a valid pointer
-    if (!filename || !pkmimage)
+    if (!data || !pkmimage)
     {
         return GLUS_FALSE;
     }
 
-    if (!glusFileLoadBinary(filename, &binaryfile))
+    pkmimage->width          = 0;
+    pkmimage->height         = 0;
+    pkmimage->depth          = 0;
+    pkmimage->data           = 0;
+    pkmimage->imageSize      = 0;
+    pkmimage->internalformat = 0;
+
+    // Header with magic, version, type, extended and original dimensions.
+    if (size <= 16 || size - 16 > GLUS_MAX_PKM_IMAGE_SIZE)
     {
         return GLUS_FALSE;
     }
 
-    buffer = binaryfile.binary;
+    buffer = data;
     if (!(buffer[0] == 'P' && buffer[1] == 'K' && buffer[2] == 'M' && buffer[3] == ' '))
     {
-        glusFileDestroyBinary(&binaryfile);
-
         return GLUS_FALSE;
     }
     buffer += 7;
 
     pkmimage->depth = 1;
 
-    pkmimage->imageSize = binaryfile.length - 16;
-    if (pkmimage->imageSize <= 0)
-    {
-        glusFileDestroyBinary(&binaryfile);
-
-        return GLUS_FALSE;
-    }
-
-    pkmimage->data = (GLUSubyte*)glusMemoryMalloc(pkmimage->imageSize * sizeof(GLUSubyte));
-    if (!pkmimage->data)
-    {
-        glusFileDestroyBinary(&binaryfile);
-
-        return GLUS_FALSE;
-    }
+    pkmimage->imageSize = (GLUSint)(size - 16);
 
     type = *buffer;
     switch (type)
     {
+    case 0:
+        pkmimage->internalformat = GLUS_ETC1_RGB8_OES;
+        break;
     case 1:
         pkmimage->internalformat = GLUS_COMPRESSED_RGB8_ETC2;
         break;
@@ -96,8 +95,6 @@ GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar* filename, GLUSpkmimage
     {
         glusImageDestroyPkm(pkmimage);
 
-        glusFileDestroyBinary(&binaryfile);
-
         return GLUS_FALSE;
     }
     break;
@@ -114,9 +111,171 @@ GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar* filename, GLUSpkmimage
     pkmimage->height += (GLUSushort)(*buffer);
     buffer += 1;
 
+    pkmimage->data = (GLUSubyte*)glusMemoryMalloc(pkmimage->imageSize * sizeof(GLUSubyte));
+    if (!pkmimage->data)
+    {
+        glusImageDestroyPkm(pkmimage);
+
+        return GLUS_FALSE;
+    }
+
     memcpy(pkmimage->data, buffer, pkmimage->imageSize);
 
-    glusFileDestroyBinary(&binaryfile);
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar* filename, GLUSpkmimage* pkmimage)
+{
+    GLUSmappedfile mappedfile;
+
+    GLUSboolean result;
+
+    // check, if we have a valid pointer
+    if (!filename || !pkmimage)
+    {
+        return GLUS_FALSE;
+    }
+
+    pkmimage->width          = 0;
+    pkmimage->height         = 0;
+    pkmimage->depth          = 0;
+    pkmimage->data           = 0;
+    pkmimage->imageSize      = 0;
+    pkmimage->internalformat = 0;
+
+    // The whole file is decoded from memory.
+    if (!glusFileMap(filename, &mappedfile))
+    {
+        return GLUS_FALSE;
+    }
+
+    result = glusImageLoadPkmFromMemory(mappedfile.data, mappedfile.length, pkmimage);
+
+    glusFileUnmap(&mappedfile);
+
+    return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadPkmFromStream(const GLUSstream* stream, GLUSpkmimage* pkmimage)
+{
+    GLUSubyte* data;
+    size_t     size;
+
+    GLUSboolean result;
+
+    // check, if we have a valid pointer
+    if (!stream || !pkmimage)
+    {
+        return GLUS_FALSE;
+    }
+
+    pkmimage->width          = 0;
+    pkmimage->height         = 0;
+    pkmimage->depth          = 0;
+    pkmimage->data           = 0;
+    pkmimage->imageSize      = 0;
+    pkmimage->internalformat = 0;
+
+    if (!_glusFileReadStream(stream, &data, &size))
+    {
+        return GLUS_FALSE;
+    }
+
+    result = glusImageLoadPkmFromMemory(data, size, pkmimage);
+
+    glusMemoryFree(data);
+
+    return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageSavePkm(const GLUSchar* filename, const GLUSpkmimage* pkmimage)
+{
+    FILE*     file;
+    GLUSubyte buffer[16];
+    size_t    elementsWritten;
+    GLUSint   extendedWidth;
+    GLUSint   extendedHeight;
+
+    // check, if we have a valid pointer
+    if (!filename || !pkmimage || !pkmimage->data || pkmimage->imageSize <= 0)
+    {
+        return GLUS_FALSE;
+    }
+
+    buffer[0] = 'P';
+    buffer[1] = 'K';
+    buffer[2] = 'M';
+    buffer[3] = ' ';
+    buffer[4] = '2';
+    buffer[5] = '0';
+    buffer[6] = 0;
+
+    switch (pkmimage->internalformat)
+    {
+    case GLUS_ETC1_RGB8_OES:
+        buffer[4] = '1';
+        buffer[7] = 0;
+        break;
+    case GLUS_COMPRESSED_RGB8_ETC2:
+        buffer[7] = 1;
+        break;
+    case GLUS_COMPRESSED_RGBA8_ETC2_EAC:
+        buffer[7] = 3;
+        break;
+    case GLUS_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+        buffer[7] = 4;
+        break;
+    case GLUS_COMPRESSED_R11_EAC:
+        buffer[7] = 5;
+        break;
+    case GLUS_COMPRESSED_RG11_EAC:
+        buffer[7] = 6;
+        break;
+    case GLUS_COMPRESSED_SIGNED_R11_EAC:
+        buffer[7] = 7;
+        break;
+    case GLUS_COMPRESSED_SIGNED_RG11_EAC:
+        buffer[7] = 8;
+        break;
+    default:
+        return GLUS_FALSE;
+    }
+
+    // Sizes are big endian, the extended ones are multiples of the block size.
+    extendedWidth  = (pkmimage->width + 3) & ~3;
+    extendedHeight = (pkmimage->height + 3) & ~3;
+
+    buffer[8]  = (GLUSubyte)(extendedWidth >> 8);
+    buffer[9]  = (GLUSubyte)extendedWidth;
+    buffer[10] = (GLUSubyte)(extendedHeight >> 8);
+    buffer[11] = (GLUSubyte)extendedHeight;
+    buffer[12] = (GLUSubyte)(pkmimage->width >> 8);
+    buffer[13] = (GLUSubyte)pkmimage->width;
+    buffer[14] = (GLUSubyte)(pkmimage->height >> 8);
+    buffer[15] = (GLUSubyte)pkmimage->height;
+
+    file = glusFileOpen(filename, "wb");
+
+    if (!file)
+    {
+        return GLUS_FALSE;
+    }
+
+    elementsWritten = fwrite(buffer, 1, 16, file);
+
+    if (!_glusFileCheckWrite(file, elementsWritten, 16))
+    {
+        return GLUS_FALSE;
+    }
+
+    elementsWritten = fwrite(pkmimage->data, 1, (size_t)pkmimage->imageSize, file);
+
+    if (!_glusFileCheckWrite(file, elementsWritten, (size_t)pkmimage->imageSize))
+    {
+        return GLUS_FALSE;
+    }
+
+    glusFileClose(file);
 
     return GLUS_TRUE;
 }
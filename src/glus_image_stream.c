@@ -0,0 +1,479 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// fseeko and ftello with 64 bit offsets, as streamed images may exceed 2 GB.
+#define _LARGEFILE_SOURCE
+#define _FILE_OFFSET_BITS 64
+
+#include <sys/types.h>
+
+#define GLUS_IMAGE_STREAM_POSIX
+
+#endif
+
+#include "GL/glus.h"
+
+/**
+ * Initial size of the buffer for reading headers and for indexing the rows of compressed images.
+ */
+#define GLUS_IMAGE_STREAM_BUFFER_SIZE 65536
+
+/**
+ * Approximate size of a tile in bytes. A tile holds as many complete rows as fit, but at least one.
+ */
+#define GLUS_IMAGE_STREAM_TILE_SIZE 1048576
+
+/**
+ * Cache size, if none is given.
+ */
+#define GLUS_IMAGE_STREAM_DEFAULT_CACHE_SIZE 33554432
+
+/**
+ * Buffered file, from which an image is decoded in tiles of rows. The tiles are kept in a cache with a fixed number of slots.
+ */
+typedef struct _GLUSimagestream
+{
+    FILE* file;
+
+    GLUSuint64 size;
+
+    GLUSubyte* buffer;
+    size_t     bufferCapacity;
+    size_t     bufferLength;
+    size_t     bufferPosition;
+    GLUSuint64 bufferOffset;
+
+    size_t  rowSize;
+    GLUSint numberRows;
+    GLUSint tileRows;
+    GLUSint numberTiles;
+
+    GLUSubyte* tiles;
+    GLUSint*   tileFirstRows;
+    GLUSuint*  tileUses;
+    GLUSuint   useCounter;
+    GLUSint    lastTile;
+
+    GLUSboolean (*decode)(GLUSvoid* userData, GLUSubyte* rows, GLUSint firstRow, GLUSint numberRows);
+    GLUSvoid* userData;
+
+} GLUSimagestream;
+
+static GLUSboolean glusImageStreamSeekFile(FILE* file, GLUSuint64 offset)
+{
+#if defined(_WIN32)
+    return _fseeki64(file, (__int64)offset, SEEK_SET) == 0;
+#elif defined(GLUS_IMAGE_STREAM_POSIX)
+    return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#else
+    if (offset > 0x7FFFFFFF)
+    {
+        return GLUS_FALSE;
+    }
+
+    return fseek(file, (long)offset, SEEK_SET) == 0;
+#endif
+}
+
+static GLUSboolean glusImageStreamGetFileSize(FILE* file, GLUSuint64* size)
+{
+#if defined(_WIN32)
+    __int64 position;
+
+    if (_fseeki64(file, 0, SEEK_END) != 0)
+    {
+        return GLUS_FALSE;
+    }
+
+    position = _ftelli64(file);
+#elif defined(GLUS_IMAGE_STREAM_POSIX)
+    off_t position;
+
+    if (fseeko(file, 0, SEEK_END) != 0)
+    {
+        return GLUS_FALSE;
+    }
+
+    position = ftello(file);
+#else
+    long position;
+
+    if (fseek(file, 0, SEEK_END) != 0)
+    {
+        return GLUS_FALSE;
+    }
+
+    position = ftell(file);
+#endif
+
+    if (position < 0)
+    {
+        return GLUS_FALSE;
+    }
+
+    *size = (GLUSuint64)position;
+
+    return glusImageStreamSeekFile(file, 0);
+}
+
+GLUSvoid _glusImageStreamClose(GLUSvoid* handle)
+{
+    GLUSimagestream* stream = (GLUSimagestream*)handle;
+
+    if (!stream)
+    {
+        return;
+    }
+
+    if (stream->file)
+    {
+        glusFileClose(stream->file);
+    }
+
+    glusMemoryFree(stream->buffer);
+    glusMemoryFreeAligned(stream->tiles);
+    glusMemoryFree(stream->tileFirstRows);
+    glusMemoryFree(stream->tileUses);
+
+    glusMemoryFree(stream);
+}
+
+GLUSvoid* _glusImageStreamOpen(const GLUSchar* filename)
+{
+    GLUSimagestream* stream;
+
+    if (!filename)
+    {
+        return 0;
+    }
+
+    stream = (GLUSimagestream*)glusMemoryMalloc(sizeof(GLUSimagestream));
+
+    if (!stream)
+    {
+        return 0;
+    }
+
+    memset(stream, 0, sizeof(GLUSimagestream));
+
+    stream->lastTile = -1;
+
+    stream->buffer         = (GLUSubyte*)glusMemoryMalloc(GLUS_IMAGE_STREAM_BUFFER_SIZE);
+    stream->bufferCapacity = GLUS_IMAGE_STREAM_BUFFER_SIZE;
+
+    if (!stream->buffer)
+    {
+        _glusImageStreamClose(stream);
+
+        return 0;
+    }
+
+    stream->file = glusFileOpen(filename, "rb");
+
+    if (!stream->file || !glusImageStreamGetFileSize(stream->file, &stream->size))
+    {
+        _glusImageStreamClose(stream);
+
+        return 0;
+    }
+
+    return stream;
+}
+
+GLUSuint64 _glusImageStreamGetSize(const GLUSvoid* handle)
+{
+    return ((const GLUSimagestream*)handle)->size;
+}
+
+/**
+ * Moves the read position. Positions inside the buffered data do not touch the file.
+ */
+GLUSboolean _glusImageStreamSeek(GLUSvoid* handle, GLUSuint64 offset)
+{
+    GLUSimagestream* stream = (GLUSimagestream*)handle;
+
+    if (offset >= stream->bufferOffset && offset <= stream->bufferOffset + stream->bufferLength)
+    {
+        stream->bufferPosition = (size_t)(offset - stream->bufferOffset);
+
+        return GLUS_TRUE;
+    }
+
+    if (offset > stream->size || !glusImageStreamSeekFile(stream->file, offset))
+    {
+        return GLUS_FALSE;
+    }
+
+    stream->bufferOffset   = offset;
+    stream->bufferLength   = 0;
+    stream->bufferPosition = 0;
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Reads from the current position. Large reads bypass the buffer.
+ *
+ * @return GLUS_FALSE, if the file ends before length bytes are read.
+ */
+GLUSboolean _glusImageStreamRead(GLUSvoid* handle, GLUSubyte* target, size_t length)
+{
+    GLUSimagestream* stream = (GLUSimagestream*)handle;
+
+    size_t available;
+
+    while (length > 0)
+    {
+        available = stream->bufferLength - stream->bufferPosition;
+
+        if (available == 0)
+        {
+            // The file position is always at the end of the buffered data.
+            stream->bufferOffset += stream->bufferLength;
+            stream->bufferLength   = 0;
+            stream->bufferPosition = 0;
+
+            if (length >= stream->bufferCapacity)
+            {
+                if (fread(target, 1, length, stream->file) != length)
+                {
+                    return GLUS_FALSE;
+                }
+
+                stream->bufferOffset += length;
+
+                return GLUS_TRUE;
+            }
+
+            stream->bufferLength = fread(stream->buffer, 1, stream->bufferCapacity, stream->file);
+
+            if (stream->bufferLength == 0)
+            {
+                return GLUS_FALSE;
+            }
+
+            continue;
+        }
+
+        if (available > length)
+        {
+            available = length;
+        }
+
+        memcpy(target, stream->buffer + stream->bufferPosition, available);
+
+        stream->bufferPosition += available;
+
+        target += available;
+        length -= available;
+    }
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Buffers at least length bytes from the current position, without moving it. Less bytes are only returned at the end of the file.
+ *
+ * @param available Number of bytes, which can be accessed. Can be more than length.
+ *
+ * @return Pointer to the data at the current position or 0, if the buffer could not be enlarged.
+ */
+const GLUSubyte* _glusImageStreamPeek(GLUSvoid* handle, size_t length, size_t* available)
+{
+    GLUSimagestream* stream = (GLUSimagestream*)handle;
+
+    GLUSubyte* buffer;
+    size_t     capacity;
+    size_t     elementsRead;
+
+    if (stream->bufferLength - stream->bufferPosition < length && stream->bufferOffset + stream->bufferLength < stream->size)
+    {
+        if (length > stream->bufferCapacity)
+        {
+            capacity = stream->bufferCapacity;
+            while (capacity < length)
+            {
+                capacity *= 2;
+            }
+
+            buffer = (GLUSubyte*)glusMemoryMalloc(capacity);
+
+            if (!buffer)
+            {
+                return 0;
+            }
+
+            memcpy(buffer, stream->buffer + stream->bufferPosition, stream->bufferLength - stream->bufferPosition);
+
+            glusMemoryFree(stream->buffer);
+
+            stream->buffer         = buffer;
+            stream->bufferCapacity = capacity;
+        }
+        else
+        {
+            memmove(stream->buffer, stream->buffer + stream->bufferPosition, stream->bufferLength - stream->bufferPosition);
+        }
+
+        stream->bufferOffset += stream->bufferPosition;
+        stream->bufferLength -= stream->bufferPosition;
+        stream->bufferPosition = 0;
+
+        while (stream->bufferLength < stream->bufferCapacity)
+        {
+            elementsRead = fread(stream->buffer + stream->bufferLength, 1, stream->bufferCapacity - stream->bufferLength, stream->file);
+
+            if (elementsRead == 0)
+            {
+                break;
+            }
+
+            stream->bufferLength += elementsRead;
+        }
+    }
+
+    *available = stream->bufferLength - stream->bufferPosition;
+
+    return stream->buffer + stream->bufferPosition;
+}
+
+/**
+ * Creates the tile cache. The decode function fills a tile with consecutive rows, each of rowSize bytes.
+ *
+ * @param cacheSize Maximum size of all tiles in bytes. 0 selects a default size. At least two tiles are used.
+ */
+GLUSboolean _glusImageStreamCreateCache(GLUSvoid* handle, size_t rowSize, GLUSint numberRows, size_t cacheSize, GLUSboolean (*decode)(GLUSvoid* userData, GLUSubyte* rows, GLUSint firstRow, GLUSint numberRows), GLUSvoid* userData)
+{
+    GLUSimagestream* stream = (GLUSimagestream*)handle;
+
+    size_t tileSize;
+
+    GLUSint i;
+
+    if (rowSize == 0 || numberRows < 1 || !decode)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (cacheSize == 0)
+    {
+        cacheSize = GLUS_IMAGE_STREAM_DEFAULT_CACHE_SIZE;
+    }
+
+    stream->rowSize    = rowSize;
+    stream->numberRows = numberRows;
+
+    stream->tileRows = rowSize < GLUS_IMAGE_STREAM_TILE_SIZE ? (GLUSint)(GLUS_IMAGE_STREAM_TILE_SIZE / rowSize) : 1;
+    if (stream->tileRows > numberRows)
+    {
+        stream->tileRows = numberRows;
+    }
+
+    tileSize = rowSize * stream->tileRows;
+
+    stream->numberTiles = cacheSize / tileSize > 2 ? (GLUSint)(cacheSize / tileSize < 65536 ? cacheSize / tileSize : 65536) : 2;
+    if (stream->numberTiles > (numberRows + stream->tileRows - 1) / stream->tileRows)
+    {
+        stream->numberTiles = (numberRows + stream->tileRows - 1) / stream->tileRows;
+    }
+
+    stream->tiles         = (GLUSubyte*)glusMemoryMallocAligned(tileSize * stream->numberTiles, GLUS_MEMORY_DATA_ALIGNMENT);
+    stream->tileFirstRows = (GLUSint*)glusMemoryMalloc(sizeof(GLUSint) * stream->numberTiles);
+    stream->tileUses      = (GLUSuint*)glusMemoryMalloc(sizeof(GLUSuint) * stream->numberTiles);
+
+    if (!stream->tiles || !stream->tileFirstRows || !stream->tileUses)
+    {
+        return GLUS_FALSE;
+    }
+
+    for (i = 0; i < stream->numberTiles; i++)
+    {
+        stream->tileFirstRows[i] = -1;
+        stream->tileUses[i]      = 0;
+    }
+
+    stream->decode   = decode;
+    stream->userData = userData;
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Returns a row from the cache. The least recently used tile is replaced, if the row is not cached.
+ *
+ * @return The row, which stays valid until the next call, or 0, if decoding failed.
+ */
+const GLUSubyte* _glusImageStreamGetRow(GLUSvoid* handle, GLUSint row)
+{
+    GLUSimagestream* stream = (GLUSimagestream*)handle;
+
+    GLUSint firstRow = row - row % stream->tileRows;
+    GLUSint tile     = stream->lastTile;
+    GLUSint i;
+
+    if (tile < 0 || stream->tileFirstRows[tile] != firstRow)
+    {
+        tile = -1;
+
+        for (i = 0; i < stream->numberTiles; i++)
+        {
+            if (stream->tileFirstRows[i] == firstRow)
+            {
+                tile = i;
+
+                break;
+            }
+        }
+
+        if (tile < 0)
+        {
+            tile = 0;
+
+            for (i = 1; i < stream->numberTiles; i++)
+            {
+                if (stream->tileUses[i] < stream->tileUses[tile])
+                {
+                    tile = i;
+                }
+            }
+
+            stream->tileFirstRows[tile] = -1;
+
+            if (!stream->decode(stream->userData, stream->tiles + stream->rowSize * stream->tileRows * tile, firstRow, stream->numberRows - firstRow < stream->tileRows ? stream->numberRows - firstRow : stream->tileRows))
+            {
+                stream->lastTile = -1;
+
+                return 0;
+            }
+
+            stream->tileFirstRows[tile] = firstRow;
+        }
+
+        stream->lastTile = tile;
+    }
+
+    stream->tileUses[tile] = ++stream->useCounter;
+
+    return stream->tiles + stream->rowSize * ((size_t)stream->tileRows * tile + (row - firstRow));
+}
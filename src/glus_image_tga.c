@@ -20,15 +20,56 @@
  * DEALINGS IN THE SOFTWARE.
  */
 
+// Vector instructions are only used, if they are enabled for the compiler.
+#if defined(__SSSE3__) || defined(__AVX__)
+
+#include <tmmintrin.h>
+
+#define GLUS_IMAGE_SSSE3
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+#define GLUS_IMAGE_NEON
+
+#endif
+
 #include "GL/glus.h"
 
 #define GLUS_MAX_DIMENSION 16384
 
+/**
+ * Number of rows, which are not searched for runs after run length encoding did not reduce the size.
+ */
+#define GLUS_IMAGE_RLE_SKIP_SEARCH 15
+
+/**
+ * Number of pixels, from which a conversion is split into bands for several threads.
+ */
+#define GLUS_IMAGE_CONVERT_PARALLEL_PIXELS 1048576
+
 extern GLUSvoid _glusImageGatherSamplePoints(GLUSint sampleIndex[4], GLUSfloat sampleWeight[2], const GLUSfloat st[2], GLUSint width, GLUSint height, GLUSint stride);
+extern GLUSboolean _glusImageSampleBatchub(GLUSubyte* rgba, const GLUSubyte* data, GLUSint width, GLUSint height, GLUSint stride, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT);
+
+extern GLUSboolean _glusFileReadStream(const GLUSstream* stream, GLUSubyte** data, size_t* length);
 
-extern GLUSboolean _glusFileCheckRead(FILE* f, size_t actualRead, size_t expectedRead);
 extern GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrite);
 
+extern GLUSvoid* _glusImageStreamOpen(const GLUSchar* filename);
+extern GLUSvoid _glusImageStreamClose(GLUSvoid* handle);
+extern GLUSuint64 _glusImageStreamGetSize(const GLUSvoid* handle);
+extern GLUSboolean _glusImageStreamSeek(GLUSvoid* handle, GLUSuint64 offset);
+extern GLUSboolean _glusImageStreamRead(GLUSvoid* handle, GLUSubyte* target, size_t length);
+extern const GLUSubyte* _glusImageStreamPeek(GLUSvoid* handle, size_t length, size_t* available);
+extern GLUSboolean _glusImageStreamCreateCache(GLUSvoid* handle, size_t rowSize, GLUSint numberRows, size_t cacheSize, GLUSboolean (*decode)(GLUSvoid* userData, GLUSubyte* rows, GLUSint firstRow, GLUSint numberRows), GLUSvoid* userData);
+extern const GLUSubyte* _glusImageStreamGetRow(GLUSvoid* handle, GLUSint row);
+
+extern GLUSvoid _glusThreadRun(GLUSvoid (*function)(GLUSvoid* data, GLUSuint index), GLUSvoid* data, GLUSuint numberTasks, GLUSuint numberThreads);
+extern GLUSuint _glusThreadGetNumberProcessors(GLUSvoid);
+extern GLUSvoid _glusThreadLock(GLUSvoid);
+extern GLUSvoid _glusThreadUnlock(GLUSvoid);
+
 static GLUSvoid glusImageSwapColorChannel(GLUSint width, GLUSint height, GLUSenum format, GLUSubyte* data)
 {
     GLUSint   i;
@@ -80,7 +121,8 @@ GLUSboolean GLUSAPIENTRY glusImageCreateTga(GLUStgaimage* tgaimage, GLUSint widt
         return GLUS_FALSE;
     }
 
-    tgaimage->data = (GLUSubyte*)glusMemoryMalloc(width * height * depth * stride * sizeof(GLUSubyte));
+    tgaimage->data        = (GLUSubyte*)glusMemoryMallocAligned(width * height * depth * stride * sizeof(GLUSubyte), GLUS_MEMORY_DATA_ALIGNMENT);
+    tgaimage->alignedData = tgaimage->data;
     if (!tgaimage->data)
     {
         return GLUS_FALSE;
@@ -93,230 +135,272 @@ GLUSboolean GLUSAPIENTRY glusImageCreateTga(GLUStgaimage* tgaimage, GLUSint widt
     return GLUS_TRUE;
 }
 
-GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage* tgaimage)
+static GLUSushort glusImageTgaReadShort(const GLUSubyte* data)
 {
-    FILE* file;
-
-    GLUSboolean hasColorMap = GLUS_FALSE;
-
-    GLUSubyte imageType;
-    GLUSubyte bitsPerPixel;
-
-    GLUSushort firstEntryIndex;
-    GLUSushort colorMapLength;
-    GLUSubyte  colorMapEntrySize;
-    GLUSubyte* colorMap = 0;
-
-    GLUSuint i, k;
+    return (GLUSushort)(data[0] | (data[1] << 8));
+}
 
-    size_t elementsRead;
+/**
+ * Repeats the first pixel of a run. Three and four byte pixels are stored as 12 and 4 byte patterns.
+ */
+static GLUSvoid glusImageTgaFillRun(GLUSubyte* run, size_t bytesPerPixel, size_t length)
+{
+    GLUSubyte pattern[12];
+    size_t    i;
 
-    // check, if we have a valid pointer
-    if (!filename || !tgaimage)
+    if (bytesPerPixel == 4)
     {
-        return GLUS_FALSE;
-    }
+        memcpy(pattern, run, 4);
 
-    tgaimage->width  = 0;
-    tgaimage->height = 0;
-    tgaimage->depth  = 0;
-    tgaimage->data   = 0;
-    tgaimage->format = 0;
+        for (i = 4; i < length; i += 4)
+        {
+            memcpy(run + i, pattern, 4);
+        }
+    }
+    else if (bytesPerPixel == 3)
+    {
+        memcpy(pattern, run, 3);
+        memcpy(pattern + 3, run, 3);
+        memcpy(pattern + 6, pattern, 6);
 
-    // open filename in "read binary" mode
-    file = glusFileOpen(filename, "rb");
+        for (i = 3; i + 12 <= length; i += 12)
+        {
+            memcpy(run + i, pattern, 12);
+        }
 
-    if (!file)
-    {
-        return GLUS_FALSE;
+        for (; i < length; i++)
+        {
+            run[i] = run[i - 3];
+        }
     }
-
-    // seek through the tga header, up to the type:
-    if (fseek(file, 2, SEEK_CUR))
+    else
     {
-        glusFileClose(file);
-
-        return GLUS_FALSE;
+        memset(run + 1, run[0], length - 1);
     }
+}
 
-    // read the image type
-    elementsRead = fread(&imageType, 1, 1, file);
+/**
+ * Decodes run length encoded pixels from memory. Packets exceeding the image are clipped.
+ */
+static GLUSboolean glusImageTgaDecodeRle(GLUSubyte* target, size_t targetLength, size_t bytesPerPixel, const GLUSubyte* source, size_t sourceLength)
+{
+    const GLUSubyte* sourceEnd = source + sourceLength;
+    GLUSubyte*       targetEnd = target + targetLength;
 
-    if (!_glusFileCheckRead(file, elementsRead, 1))
-    {
-        return GLUS_FALSE;
-    }
+    GLUSubyte packet;
+    size_t    length;
 
-    // check the type
-    if (imageType != 1 && imageType != 2 && imageType != 3 && imageType != 9 && imageType != 10 && imageType != 11)
+    while (target < targetEnd)
     {
-        glusFileClose(file);
+        if (source == sourceEnd)
+        {
+            return GLUS_FALSE;
+        }
 
-        return GLUS_FALSE;
-    }
+        packet = *source++;
 
-    if (imageType == 1 || imageType == 9)
-    {
-        hasColorMap = GLUS_TRUE;
-    }
+        length = ((size_t)(packet & 0x7F) + 1) * bytesPerPixel;
 
-    if (!hasColorMap)
-    {
-        // seek through the tga header, up to the width/height:
-        if (fseek(file, 9, SEEK_CUR))
+        if (length > (size_t)(targetEnd - target))
         {
-            glusFileClose(file);
-
-            return GLUS_FALSE;
+            length = (size_t)(targetEnd - target);
         }
-    }
-    else
-    {
-        elementsRead = fread(&firstEntryIndex, 2, 1, file);
 
-        if (!_glusFileCheckRead(file, elementsRead, 1))
+        if (packet & 0x80)
         {
-            glusImageDestroyTga(tgaimage);
+            // One pixel, which is repeated.
 
-            return GLUS_FALSE;
-        }
+            if ((size_t)(sourceEnd - source) < bytesPerPixel)
+            {
+                return GLUS_FALSE;
+            }
 
-        elementsRead = fread(&colorMapLength, 2, 1, file);
+            memcpy(target, source, bytesPerPixel);
+            source += bytesPerPixel;
 
-        if (!_glusFileCheckRead(file, elementsRead, 1))
+            glusImageTgaFillRun(target, bytesPerPixel, length);
+        }
+        else
         {
-            glusImageDestroyTga(tgaimage);
+            // Raw pixels.
 
-            return GLUS_FALSE;
+            if ((size_t)(sourceEnd - source) < length)
+            {
+                return GLUS_FALSE;
+            }
+
+            memcpy(target, source, length);
+            source += length;
         }
 
-        elementsRead = fread(&colorMapEntrySize, 1, 1, file);
+        target += length;
+    }
 
-        if (!_glusFileCheckRead(file, elementsRead, 1))
-        {
-            glusImageDestroyTga(tgaimage);
+    return GLUS_TRUE;
+}
+
+/**
+ * Replaces the color map indices by the colors. Fails, if an index is outside of the color map.
+ */
+static GLUSboolean glusImageTgaExpandColorMap(GLUSubyte* target, const GLUSubyte* indices, size_t numberPixels, const GLUSubyte* colorMap, size_t numberEntries, size_t bytesPerPixel)
+{
+    const GLUSubyte* entry;
+    size_t           i;
 
+    for (i = 0; i < numberPixels; i++)
+    {
+        if (indices[i] >= numberEntries)
+        {
             return GLUS_FALSE;
         }
 
-        // seek through the tga header, up to the width/height:
-        if (fseek(file, 4, SEEK_CUR))
-        {
-            glusFileClose(file);
+        entry = &colorMap[indices[i] * bytesPerPixel];
 
-            return GLUS_FALSE;
+        // Constant sizes let the compiler copy with single loads and stores.
+        if (bytesPerPixel == 4)
+        {
+            memcpy(target, entry, 4);
+        }
+        else if (bytesPerPixel == 3)
+        {
+            memcpy(target, entry, 3);
+        }
+        else
+        {
+            memcpy(target, entry, bytesPerPixel);
         }
+
+        target += bytesPerPixel;
     }
 
-    // read the width
-    elementsRead = fread(&tgaimage->width, 2, 1, file);
+    return GLUS_TRUE;
+}
 
-    if (!_glusFileCheckRead(file, elementsRead, 1))
-    {
-        glusImageDestroyTga(tgaimage);
+GLUSboolean GLUSAPIENTRY glusImageLoadTgaFromMemory(const GLUSubyte* data, size_t size, GLUStgaimage* tgaimage)
+{
+    const GLUSubyte* header;
+    const GLUSubyte* pixels;
+    size_t           pixelsLength;
+
+    GLUSboolean hasColorMap = GLUS_FALSE;
 
+    GLUSubyte imageType;
+    GLUSubyte bitsPerPixel;
+
+    GLUSushort firstEntryIndex   = 0;
+    GLUSushort colorMapLength    = 0;
+    GLUSubyte  colorMapEntrySize = 0;
+    GLUSubyte* colorMap          = 0;
+
+    size_t colorMapSize = 0;
+    size_t numberPixels;
+    size_t dataSize;
+
+    // check, if we have a valid pointer
+    if (!data || !tgaimage)
+    {
         return GLUS_FALSE;
     }
 
-    if (tgaimage->width > GLUS_MAX_DIMENSION)
-    {
-        glusImageDestroyTga(tgaimage);
+    tgaimage->width  = 0;
+    tgaimage->height = 0;
+    tgaimage->depth  = 0;
+    tgaimage->data   = 0;
+    tgaimage->format = 0;
 
+    header = data;
+
+    if (size < 18)
+    {
         return GLUS_FALSE;
     }
 
-    // read the height
-    elementsRead = fread(&tgaimage->height, 2, 1, file);
+    imageType = header[2];
 
-    if (!_glusFileCheckRead(file, elementsRead, 1))
+    // check the type
+    if (imageType != 1 && imageType != 2 && imageType != 3 && imageType != 9 && imageType != 10 && imageType != 11)
     {
-        glusImageDestroyTga(tgaimage);
-
         return GLUS_FALSE;
     }
 
-    if (tgaimage->height > GLUS_MAX_DIMENSION)
+    if (imageType == 1 || imageType == 9)
     {
-        glusImageDestroyTga(tgaimage);
+        hasColorMap = GLUS_TRUE;
 
-        return GLUS_FALSE;
+        firstEntryIndex   = glusImageTgaReadShort(&header[3]);
+        colorMapLength    = glusImageTgaReadShort(&header[5]);
+        colorMapEntrySize = header[7];
     }
 
-    tgaimage->depth = 1;
+    tgaimage->width  = glusImageTgaReadShort(&header[12]);
+    tgaimage->height = glusImageTgaReadShort(&header[14]);
+    tgaimage->depth  = 1;
 
-    // read the bits per pixel
-    elementsRead = fread(&bitsPerPixel, 1, 1, file);
-
-    if (!_glusFileCheckRead(file, elementsRead, 1))
+    if (tgaimage->width > GLUS_MAX_DIMENSION || tgaimage->height > GLUS_MAX_DIMENSION)
     {
         glusImageDestroyTga(tgaimage);
 
         return GLUS_FALSE;
     }
 
+    bitsPerPixel = header[16];
+
     // check the pixel depth
     if (bitsPerPixel != 8 && bitsPerPixel != 24 && bitsPerPixel != 32)
     {
-        glusFileClose(file);
-
         glusImageDestroyTga(tgaimage);
 
         return GLUS_FALSE;
     }
-    else
+
+    tgaimage->format = GLUS_SINGLE_CHANNEL;
+    if (bitsPerPixel == 24)
     {
-        tgaimage->format = GLUS_SINGLE_CHANNEL;
-        if (bitsPerPixel == 24)
-        {
-            tgaimage->format = GLUS_RGB;
-        }
-        else if (bitsPerPixel == 32)
-        {
-            tgaimage->format = GLUS_RGBA;
-        }
+        tgaimage->format = GLUS_RGB;
     }
-
-    // move file pointer to beginning of targa data
-    if (fseek(file, 1, SEEK_CUR))
+    else if (bitsPerPixel == 32)
     {
-        glusFileClose(file);
+        tgaimage->format = GLUS_RGBA;
+    }
 
+    // The color map follows the header and the image identification field.
+    if (size < (size_t)18 + header[0])
+    {
         glusImageDestroyTga(tgaimage);
 
         return GLUS_FALSE;
     }
 
+    pixels       = header + 18 + header[0];
+    pixelsLength = size - 18 - header[0];
+
     if (hasColorMap)
     {
-        // Create color map space.
+        // Copy the color map, as the color channels are swapped.
 
-        GLUSint bytesPerPixel = colorMapEntrySize / 8;
+        colorMapSize = (size_t)colorMapLength * (colorMapEntrySize / 8);
 
-        colorMap = (GLUSubyte*)glusMemoryMalloc((size_t)colorMapLength * bytesPerPixel * sizeof(GLUSubyte));
-
-        if (!colorMap)
+        if (pixelsLength < colorMapSize)
         {
-            glusFileClose(file);
-
             glusImageDestroyTga(tgaimage);
 
             return GLUS_FALSE;
         }
 
-        // Read in the color map.
-
-        elementsRead = fread(colorMap, 1, (size_t)colorMapLength * bytesPerPixel * sizeof(GLUSubyte), file);
+        colorMap = (GLUSubyte*)glusMemoryMalloc(colorMapSize);
 
-        if (!_glusFileCheckRead(file, elementsRead, (size_t)colorMapLength * bytesPerPixel * sizeof(GLUSubyte)))
+        if (!colorMap)
         {
             glusImageDestroyTga(tgaimage);
 
-            glusMemoryFree(colorMap);
-            colorMap = 0;
-
             return GLUS_FALSE;
         }
 
+        memcpy(colorMap, pixels, colorMapSize);
+
+        pixels += colorMapSize;
+        pixelsLength -= colorMapSize;
+
         // swap the color if necessary
         if (colorMapEntrySize == 24 || colorMapEntrySize == 32)
         {
@@ -324,125 +408,51 @@ GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage
         }
     }
 
-    // allocate enough memory for the targa  data
-    tgaimage->data = (GLUSubyte*)glusMemoryMalloc((size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8);
+    numberPixels = (size_t)tgaimage->width * tgaimage->height;
+    dataSize     = numberPixels * (bitsPerPixel / 8);
 
-    // verify memory allocation
-    if (!tgaimage->data)
+    if (imageType == 1 || imageType == 2 || imageType == 3)
     {
-        glusFileClose(file);
-
-        glusImageDestroyTga(tgaimage);
-
-        if (hasColorMap)
+        if (pixelsLength < dataSize)
         {
+            glusImageDestroyTga(tgaimage);
+
             glusMemoryFree(colorMap);
-            colorMap = 0;
-        }
 
-        return GLUS_FALSE;
+            return GLUS_FALSE;
+        }
     }
 
-    if (imageType == 1 || imageType == 2 || imageType == 3)
+    // Uncompressed color map indices are used directly from the mapped file.
+    if (imageType != 1)
     {
-        // read in the raw data
-        elementsRead = fread(tgaimage->data, 1, (size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8, file);
+        // allocate enough memory for the targa data
+        tgaimage->data        = (GLUSubyte*)glusMemoryMallocAligned(dataSize, GLUS_MEMORY_DATA_ALIGNMENT);
+        tgaimage->alignedData = tgaimage->data;
 
-        if (!_glusFileCheckRead(file, elementsRead, (size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8))
+        if (!tgaimage->data)
         {
             glusImageDestroyTga(tgaimage);
 
-            if (hasColorMap)
-            {
-                glusMemoryFree(colorMap);
-                colorMap = 0;
-            }
+            glusMemoryFree(colorMap);
 
             return GLUS_FALSE;
         }
-    }
-    else
-    {
-        // RLE encoded
-        GLUSint pixelsRead = 0;
 
-        while (pixelsRead < tgaimage->width * tgaimage->height)
+        if (imageType == 2 || imageType == 3)
         {
-            GLUSubyte amount;
-
-            elementsRead = fread(&amount, 1, 1, file);
-
-            if (!_glusFileCheckRead(file, elementsRead, 1))
-            {
-                glusImageDestroyTga(tgaimage);
-
-                if (hasColorMap)
-                {
-                    glusMemoryFree(colorMap);
-                    colorMap = 0;
-                }
-
-                return GLUS_FALSE;
-            }
-
-            if (amount & 0x80)
-            {
-                GLUSint i;
-                GLUSint k;
-
-                amount &= 0x7F;
-
-                amount++;
-
-                // read in the rle data
-                elementsRead = fread(&tgaimage->data[pixelsRead * bitsPerPixel / 8], 1, bitsPerPixel / 8, file);
-
-                if (!_glusFileCheckRead(file, elementsRead, bitsPerPixel / 8))
-                {
-                    glusImageDestroyTga(tgaimage);
-
-                    if (hasColorMap)
-                    {
-                        glusMemoryFree(colorMap);
-                        colorMap = 0;
-                    }
-
-                    return GLUS_FALSE;
-                }
-
-                for (i = 1; i < amount; i++)
-                {
-                    for (k = 0; k < bitsPerPixel / 8; k++)
-                    {
-                        tgaimage->data[(pixelsRead + i) * bitsPerPixel / 8 + k] = tgaimage->data[pixelsRead * bitsPerPixel / 8 + k];
-                    }
-                }
-            }
-            else
-            {
-                amount &= 0x7F;
-
-                amount++;
-
-                // read in the raw data
-                elementsRead = fread(&tgaimage->data[pixelsRead * bitsPerPixel / 8], 1, (size_t)amount * bitsPerPixel / 8, file);
-
-                if (!_glusFileCheckRead(file, elementsRead, (size_t)amount * bitsPerPixel / 8))
-                {
-                    glusImageDestroyTga(tgaimage);
-
-                    if (hasColorMap)
-                    {
-                        glusMemoryFree(colorMap);
-                        colorMap = 0;
-                    }
+            memcpy(tgaimage->data, pixels, dataSize);
+        }
+        else if (!glusImageTgaDecodeRle(tgaimage->data, dataSize, bitsPerPixel / 8, pixels, pixelsLength))
+        {
+            glusImageDestroyTga(tgaimage);
 
-                    return GLUS_FALSE;
-                }
-            }
+            glusMemoryFree(colorMap);
 
-            pixelsRead += amount;
+            return GLUS_FALSE;
         }
+
+        pixels = tgaimage->data;
     }
 
     // swap the color if necessary
@@ -451,30 +461,25 @@ GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage
         glusImageSwapColorChannel(tgaimage->width, tgaimage->height, tgaimage->format, tgaimage->data);
     }
 
-    // close the file
-    glusFileClose(file);
-
     if (hasColorMap)
     {
-        GLUSubyte* data = tgaimage->data;
+        GLUSubyte* indexData = tgaimage->data;
 
-        GLUSint bytesPerPixel;
+        size_t bytesPerPixel = colorMapEntrySize / 8;
+        size_t numberEntries = colorMapLength > firstEntryIndex ? (size_t)(colorMapLength - firstEntryIndex) : 0;
 
         // Allocating new memory, as current memory is a look up table index and not a color.
 
-        bytesPerPixel = colorMapEntrySize / 8;
-
-        tgaimage->data = (GLUSubyte*)glusMemoryMalloc((size_t)tgaimage->width * tgaimage->height * bytesPerPixel);
+        tgaimage->data        = (GLUSubyte*)glusMemoryMallocAligned(numberPixels * bytesPerPixel, GLUS_MEMORY_DATA_ALIGNMENT);
+        tgaimage->alignedData = tgaimage->data;
 
         if (!tgaimage->data)
         {
             glusImageDestroyTga(tgaimage);
 
-            glusMemoryFree(data);
-            data = 0;
+            glusMemoryFreeAligned(indexData);
 
             glusMemoryFree(colorMap);
-            colorMap = 0;
 
             return GLUS_FALSE;
         }
@@ -491,33 +496,32 @@ GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage
 
         // Copy color values from the color map into the image data.
 
-        for (i = 0; i < (GLUSuint)tgaimage->width * (GLUSuint)tgaimage->height; i++)
+        if (!glusImageTgaExpandColorMap(tgaimage->data, pixels, numberPixels, &colorMap[(size_t)firstEntryIndex * bytesPerPixel], numberEntries, bytesPerPixel))
         {
-            for (k = 0; k < (GLUSuint)bytesPerPixel; k++)
-            {
-                tgaimage->data[i * bytesPerPixel + k] = colorMap[(firstEntryIndex + data[i]) * bytesPerPixel + k];
-            }
+            glusImageDestroyTga(tgaimage);
+
+            glusMemoryFreeAligned(indexData);
+
+            glusMemoryFree(colorMap);
+
+            return GLUS_FALSE;
         }
 
         // Freeing data.
 
-        glusMemoryFree(data);
-        data = 0;
+        glusMemoryFreeAligned(indexData);
 
         glusMemoryFree(colorMap);
-        colorMap = 0;
     }
 
     return GLUS_TRUE;
 }
 
-GLUSboolean GLUSAPIENTRY glusImageSaveTga(const GLUSchar* filename, const GLUStgaimage* tgaimage)
+GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage* tgaimage)
 {
-    FILE*      file;
-    GLUSubyte  buffer[12];
-    GLUSubyte  bitsPerPixel;
-    size_t     elementsWritten;
-    GLUSubyte* data;
+    GLUSmappedfile mappedfile;
+
+    GLUSboolean result;
 
     // check, if we have a valid pointer
     if (!filename || !tgaimage)
@@ -525,210 +529,1316 @@ GLUSboolean GLUSAPIENTRY glusImageSaveTga(const GLUSchar* filename, const GLUStg
         return GLUS_FALSE;
     }
 
-    // open filename in "write binary" mode
-    file = glusFileOpen(filename, "wb");
+    tgaimage->width  = 0;
+    tgaimage->height = 0;
+    tgaimage->depth  = 0;
+    tgaimage->data   = 0;
+    tgaimage->format = 0;
 
-    if (!file)
+    // The whole file is decoded from memory.
+    if (!glusFileMap(filename, &mappedfile))
     {
         return GLUS_FALSE;
     }
 
-    switch (tgaimage->format)
-    {
-    case GLUS_ALPHA:
-    case GLUS_RED:
-    case GLUS_LUMINANCE:
-        bitsPerPixel = 8;
-        break;
-    case GLUS_RGB:
-        bitsPerPixel = 24;
-        break;
-    case GLUS_RGBA:
-        bitsPerPixel = 32;
-        break;
-    default:
-        glusFileClose(file);
-        return GLUS_FALSE;
-    }
+    result = glusImageLoadTgaFromMemory(mappedfile.data, mappedfile.length, tgaimage);
 
-    if (bitsPerPixel == 8)
-    {
-        buffer[2] = 3;
-    }
-    else
-    {
-        buffer[2] = 2;
-    }
+    glusFileUnmap(&mappedfile);
 
-    // TGA header
-    buffer[0] = 0;
-    buffer[1] = 0;
+    return result;
+}
 
-    buffer[3]  = 0;
-    buffer[4]  = 0;
-    buffer[5]  = 0;
-    buffer[6]  = 0;
-    buffer[7]  = 0;
-    buffer[8]  = 0;
-    buffer[9]  = 0;
-    buffer[10] = 0;
-    buffer[11] = 0;
+GLUSboolean GLUSAPIENTRY glusImageLoadTgaFromStream(const GLUSstream* stream, GLUStgaimage* tgaimage)
+{
+    GLUSubyte* data;
+    size_t     size;
 
-    elementsWritten = fwrite(buffer, 1, 12, file);
+    GLUSboolean result;
 
-    if (!_glusFileCheckWrite(file, elementsWritten, 12))
+    // check, if we have a valid pointer
+    if (!stream || !tgaimage)
     {
         return GLUS_FALSE;
     }
 
-    elementsWritten = fwrite(&tgaimage->width, sizeof(tgaimage->width), 1, file);
+    tgaimage->width  = 0;
+    tgaimage->height = 0;
+    tgaimage->depth  = 0;
+    tgaimage->data   = 0;
+    tgaimage->format = 0;
+
+    if (!_glusFileReadStream(stream, &data, &size))
+    {
+        return GLUS_FALSE;
+    }
+
+    result = glusImageLoadTgaFromMemory(data, size, tgaimage);
+
+    glusMemoryFree(data);
+
+    return result;
+}
+
+/**
+ * State of a TGA reader. The rows of run length encoded images are indexed, when they are needed the first time.
+ */
+typedef struct _GLUSimagetgareader
+{
+    GLUSvoid* stream;
+
+    GLUSint  width;
+    GLUSenum format;
+
+    GLUSboolean compressed;
+    size_t      bytesPerPixel;
+    size_t      rowSize;
+
+    GLUSuint64 dataOffset;
+
+    /**
+     * Offset of the packet containing the first pixel of each row and the number of its pixels belonging to the previous rows.
+     * One more entry marks the end of the last row.
+     */
+    GLUSuint64* rowOffsets;
+    GLUSubyte*  rowSkips;
+    GLUSint     numberIndexedRows;
+
+    GLUSubyte* packets;
+    size_t     packetsCapacity;
+
+} GLUSimagetgareader;
+
+static GLUSvoid glusImageTgaDestroyReader(GLUSimagetgareader* reader)
+{
+    if (!reader)
+    {
+        return;
+    }
+
+    _glusImageStreamClose(reader->stream);
+
+    glusMemoryFree(reader->rowOffsets);
+    glusMemoryFree(reader->rowSkips);
+    glusMemoryFree(reader->packets);
+
+    glusMemoryFree(reader);
+}
+
+static size_t glusImageTgaPacketSize(GLUSubyte packet, size_t bytesPerPixel)
+{
+    if (packet & 0x80)
+    {
+        return 1 + bytesPerPixel;
+    }
+
+    return 1 + ((size_t)(packet & 0x7F) + 1) * bytesPerPixel;
+}
+
+/**
+ * Indexes the row after the last indexed row. Only the packet headers are read.
+ */
+static GLUSboolean glusImageTgaIndexRow(GLUSimagetgareader* reader)
+{
+    GLUSint    row       = reader->numberIndexedRows - 1;
+    GLUSuint64 offset    = reader->rowOffsets[row];
+    GLUSint    skip      = reader->rowSkips[row];
+    GLUSint    remaining = reader->width;
+    GLUSint    count;
+
+    const GLUSubyte* packet;
+    size_t           available;
+    size_t           packetSize;
+
+    while (remaining > 0)
+    {
+        if (!_glusImageStreamSeek(reader->stream, offset))
+        {
+            return GLUS_FALSE;
+        }
+
+        packet = _glusImageStreamPeek(reader->stream, 1, &available);
+
+        if (!packet || available == 0)
+        {
+            return GLUS_FALSE;
+        }
+
+        packetSize = glusImageTgaPacketSize(packet[0], reader->bytesPerPixel);
+
+        if (offset + packetSize > _glusImageStreamGetSize(reader->stream))
+        {
+            return GLUS_FALSE;
+        }
+
+        count = (packet[0] & 0x7F) + 1 - skip;
+
+        // The packet continues in the next row.
+        if (count > remaining)
+        {
+            skip += remaining;
+
+            break;
+        }
+
+        remaining -= count;
+
+        skip = 0;
+
+        offset += packetSize;
+    }
+
+    reader->rowOffsets[row + 1] = offset;
+    reader->rowSkips[row + 1]   = (GLUSubyte)skip;
+
+    reader->numberIndexedRows++;
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Decodes a tile of rows. Compressed rows are read at once from the first packet to the last packet of the tile.
+ */
+static GLUSboolean glusImageTgaDecodeRows(GLUSvoid* userData, GLUSubyte* rows, GLUSint firstRow, GLUSint numberRows)
+{
+    GLUSimagetgareader* reader = (GLUSimagetgareader*)userData;
+
+    size_t length = reader->rowSize * numberRows;
+
+    if (!reader->compressed)
+    {
+        if (!_glusImageStreamSeek(reader->stream, reader->dataOffset + (GLUSuint64)reader->rowSize * firstRow) || !_glusImageStreamRead(reader->stream, rows, length))
+        {
+            return GLUS_FALSE;
+        }
+    }
+    else
+    {
+        const GLUSubyte* source;
+        size_t           sourceLength;
+
+        GLUSuint64 begin, end;
+        GLUSubyte  packet;
+        size_t     skip, count;
+        size_t     done = 0;
+
+        while (reader->numberIndexedRows <= firstRow + numberRows)
+        {
+            if (!glusImageTgaIndexRow(reader))
+            {
+                return GLUS_FALSE;
+            }
+        }
+
+        begin = reader->rowOffsets[firstRow];
+        end   = reader->rowOffsets[firstRow + numberRows];
+
+        // The last row ends inside of a packet.
+        if (reader->rowSkips[firstRow + numberRows] > 0)
+        {
+            if (!_glusImageStreamSeek(reader->stream, end) || !_glusImageStreamRead(reader->stream, &packet, 1))
+            {
+                return GLUS_FALSE;
+            }
+
+            end += glusImageTgaPacketSize(packet, reader->bytesPerPixel);
+        }
+
+        sourceLength = (size_t)(end - begin);
+
+        if (sourceLength > reader->packetsCapacity)
+        {
+            glusMemoryFree(reader->packets);
+
+            reader->packets = (GLUSubyte*)glusMemoryMalloc(sourceLength);
+
+            if (!reader->packets)
+            {
+                reader->packetsCapacity = 0;
+
+                return GLUS_FALSE;
+            }
+
+            reader->packetsCapacity = sourceLength;
+        }
+
+        if (!_glusImageStreamSeek(reader->stream, begin) || !_glusImageStreamRead(reader->stream, reader->packets, sourceLength))
+        {
+            return GLUS_FALSE;
+        }
+
+        source = reader->packets;
+
+        // The first row starts inside of a packet, so the pixels of the previous rows are skipped.
+        skip = reader->rowSkips[firstRow];
+        if (skip > 0)
+        {
+            packet = source[0];
+
+            count = ((size_t)(packet & 0x7F) + 1 - skip) * reader->bytesPerPixel;
+            if (count > length)
+            {
+                count = length;
+            }
+
+            if (packet & 0x80)
+            {
+                memcpy(rows, source + 1, reader->bytesPerPixel);
+
+                glusImageTgaFillRun(rows, reader->bytesPerPixel, count);
+            }
+            else
+            {
+                memcpy(rows, source + 1 + skip * reader->bytesPerPixel, count);
+            }
+
+            done = count;
+
+            count = glusImageTgaPacketSize(packet, reader->bytesPerPixel);
+
+            source += count;
+            sourceLength -= count;
+        }
+
+        if (!glusImageTgaDecodeRle(rows + done, length - done, reader->bytesPerPixel, source, sourceLength))
+        {
+            return GLUS_FALSE;
+        }
+    }
+
+    if (reader->bytesPerPixel >= 3)
+    {
+        glusImageSwapColorChannel(reader->width, numberRows, reader->format, rows);
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageOpenTgaReader(const GLUSchar* filename, GLUSimagereader* reader, size_t cacheSize)
+{
+    GLUSimagetgareader* state;
+
+    GLUSubyte header[18];
+
+    GLUSint height;
+
+    // check, if we have a valid pointer
+    if (!filename || !reader)
+    {
+        return GLUS_FALSE;
+    }
+
+    reader->width  = 0;
+    reader->height = 0;
+    reader->format = 0;
+    reader->handle = 0;
+
+    state = (GLUSimagetgareader*)glusMemoryMalloc(sizeof(GLUSimagetgareader));
+
+    if (!state)
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(state, 0, sizeof(GLUSimagetgareader));
+
+    state->stream = _glusImageStreamOpen(filename);
+
+    if (!state->stream || !_glusImageStreamRead(state->stream, header, 18))
+    {
+        glusImageTgaDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+
+    // Color mapped images are not supported.
+    if (header[2] != 2 && header[2] != 3 && header[2] != 10 && header[2] != 11)
+    {
+        glusImageTgaDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+
+    state->width = glusImageTgaReadShort(&header[12]);
+    height       = glusImageTgaReadShort(&header[14]);
+
+    if (state->width == 0 || height == 0 || (header[16] != 8 && header[16] != 24 && header[16] != 32))
+    {
+        glusImageTgaDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+
+    state->format = GLUS_SINGLE_CHANNEL;
+    if (header[16] == 24)
+    {
+        state->format = GLUS_RGB;
+    }
+    else if (header[16] == 32)
+    {
+        state->format = GLUS_RGBA;
+    }
+
+    state->compressed    = header[2] >= 10;
+    state->bytesPerPixel = header[16] / 8;
+    state->rowSize       = (size_t)state->width * state->bytesPerPixel;
+    state->dataOffset    = 18 + header[0];
+
+    if (state->compressed)
+    {
+        state->rowOffsets = (GLUSuint64*)glusMemoryMalloc(sizeof(GLUSuint64) * (height + 1));
+        state->rowSkips   = (GLUSubyte*)glusMemoryMalloc(height + 1);
+
+        if (!state->rowOffsets || !state->rowSkips)
+        {
+            glusImageTgaDestroyReader(state);
+
+            return GLUS_FALSE;
+        }
+
+        state->rowOffsets[0]     = state->dataOffset;
+        state->rowSkips[0]       = 0;
+        state->numberIndexedRows = 1;
+    }
+    else if (_glusImageStreamGetSize(state->stream) < state->dataOffset + (GLUSuint64)state->rowSize * height)
+    {
+        glusImageTgaDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+
+    if (!_glusImageStreamCreateCache(state->stream, state->rowSize, height, cacheSize, glusImageTgaDecodeRows, state))
+    {
+        glusImageTgaDestroyReader(state);
+
+        return GLUS_FALSE;
+    }
+
+    reader->width  = state->width;
+    reader->height = height;
+    reader->format = state->format;
+    reader->handle = state;
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageReadTgaRows(GLUSimagereader* reader, GLUSubyte* rows, GLUSint firstRow, GLUSint numberRows)
+{
+    GLUSimagetgareader* state;
+
+    const GLUSubyte* row;
+    GLUSint          i;
+
+    if (!reader || !reader->handle || !rows || firstRow < 0 || numberRows < 0 || firstRow > reader->height - numberRows)
+    {
+        return GLUS_FALSE;
+    }
+
+    state = (GLUSimagetgareader*)reader->handle;
+
+    for (i = 0; i < numberRows; i++)
+    {
+        row = _glusImageStreamGetRow(state->stream, firstRow + i);
+
+        if (!row)
+        {
+            return GLUS_FALSE;
+        }
+
+        memcpy(&rows[state->rowSize * i], row, state->rowSize);
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusImageCloseTgaReader(GLUSimagereader* reader)
+{
+    if (!reader)
+    {
+        return;
+    }
+
+    glusImageTgaDestroyReader((GLUSimagetgareader*)reader->handle);
+
+    reader->width  = 0;
+    reader->height = 0;
+    reader->format = 0;
+    reader->handle = 0;
+}
+
+static GLUSboolean glusImageTgaEqualPixels(const GLUSubyte* a, const GLUSubyte* b, size_t bytesPerPixel)
+{
+    if (bytesPerPixel == 4)
+    {
+        return memcmp(a, b, 4) == 0;
+    }
+    else if (bytesPerPixel == 3)
+    {
+        return memcmp(a, b, 3) == 0;
+    }
+
+    return a[0] == b[0];
+}
+
+/**
+ * Run length encodes one row. Repeated pixels become run packets, all other pixels are collected in raw packets.
+ * Without searching runs, the row is just split into raw packets.
+ *
+ * @return Number of bytes written to target, which has to hold width * (bytesPerPixel + 1) bytes.
+ */
+static size_t glusImageTgaEncodeRle(GLUSubyte* target, const GLUSubyte* row, GLUSint width, size_t bytesPerPixel, GLUSboolean searchRuns)
+{
+    GLUSubyte* start = target;
+
+    GLUSint x = 0;
+    GLUSint length;
+
+    while (x < width)
+    {
+        if (!searchRuns)
+        {
+            length = width - x;
+            if (length > 128)
+            {
+                length = 128;
+            }
+
+            *target++ = (GLUSubyte)(length - 1);
+
+            memcpy(target, &row[x * bytesPerPixel], length * bytesPerPixel);
+            target += length * bytesPerPixel;
+
+            x += length;
+
+            continue;
+        }
+
+        length = 1;
+        while (x + length < width && length < 128 && glusImageTgaEqualPixels(&row[(x + length) * bytesPerPixel], &row[x * bytesPerPixel], bytesPerPixel))
+        {
+            length++;
+        }
+
+        if (length > 1)
+        {
+            *target++ = (GLUSubyte)(0x80 | (length - 1));
+
+            memcpy(target, &row[x * bytesPerPixel], bytesPerPixel);
+            target += bytesPerPixel;
+        }
+        else
+        {
+            // Raw packet up to the next two equal pixels.
+
+            while (x + length < width && length < 128 && (x + length + 1 >= width || !glusImageTgaEqualPixels(&row[(x + length) * bytesPerPixel], &row[(x + length + 1) * bytesPerPixel], bytesPerPixel)))
+            {
+                length++;
+            }
+
+            *target++ = (GLUSubyte)(length - 1);
+
+            memcpy(target, &row[x * bytesPerPixel], length * bytesPerPixel);
+            target += length * bytesPerPixel;
+        }
+
+        x += length;
+    }
+
+    return (size_t)(target - start);
+}
+
+/**
+ * State of a TGA writer.
+ */
+typedef struct _GLUSimagetgawriter
+{
+    FILE* file;
+
+    GLUSboolean compress;
+    size_t      bytesPerPixel;
+
+    GLUSubyte* row;
+    GLUSubyte* packets;
+    GLUSint    skipSearch;
+
+    GLUSint numberWrittenRows;
+
+} GLUSimagetgawriter;
+
+static GLUSvoid glusImageTgaDestroyWriter(GLUSimagetgawriter* writer)
+{
+    if (!writer)
+    {
+        return;
+    }
+
+    if (writer->file)
+    {
+        glusFileClose(writer->file);
+    }
+
+    glusMemoryFree(writer->row);
+
+    glusMemoryFree(writer);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageOpenTgaWriter(const GLUSchar* filename, GLUSimagewriter* writer, GLUSint width, GLUSint height, GLUSenum format, GLUSboolean compress)
+{
+    GLUSimagetgawriter* state;
+
+    GLUSubyte header[18];
+    GLUSubyte bitsPerPixel;
+    size_t    elementsWritten;
+
+    // check, if we have a valid pointer
+    if (!filename || !writer)
+    {
+        return GLUS_FALSE;
+    }
+
+    writer->width  = 0;
+    writer->height = 0;
+    writer->format = 0;
+    writer->handle = 0;
+
+    if (width < 1 || height < 1 || width > 65535 || height > 65535)
+    {
+        return GLUS_FALSE;
+    }
+
+    switch (format)
+    {
+    case GLUS_ALPHA:
+    case GLUS_RED:
+    case GLUS_LUMINANCE:
+        bitsPerPixel = 8;
+        break;
+    case GLUS_RGB:
+        bitsPerPixel = 24;
+        break;
+    case GLUS_RGBA:
+        bitsPerPixel = 32;
+        break;
+    default:
+        return GLUS_FALSE;
+    }
+
+    state = (GLUSimagetgawriter*)glusMemoryMalloc(sizeof(GLUSimagetgawriter));
+
+    if (!state)
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(state, 0, sizeof(GLUSimagetgawriter));
+
+    state->compress      = compress;
+    state->bytesPerPixel = bitsPerPixel / 8;
+
+    // One row with swapped color channels, followed by its packets.
+    state->row = (GLUSubyte*)glusMemoryMalloc((size_t)width * state->bytesPerPixel + (compress ? (size_t)width * (state->bytesPerPixel + 1) : 0));
+
+    if (!state->row)
+    {
+        glusImageTgaDestroyWriter(state);
+
+        return GLUS_FALSE;
+    }
+
+    state->packets = state->row + (size_t)width * state->bytesPerPixel;
+
+    // open filename in "write binary" mode
+    state->file = glusFileOpen(filename, "wb");
+
+    if (!state->file)
+    {
+        glusImageTgaDestroyWriter(state);
+
+        return GLUS_FALSE;
+    }
+
+    // TGA header
+    memset(header, 0, 18);
+
+    if (bitsPerPixel == 8)
+    {
+        header[2] = compress ? 11 : 3;
+    }
+    else
+    {
+        header[2] = compress ? 10 : 2;
+    }
+
+    header[12] = (GLUSubyte)(width & 0xFF);
+    header[13] = (GLUSubyte)((width >> 8) & 0xFF);
+    header[14] = (GLUSubyte)(height & 0xFF);
+    header[15] = (GLUSubyte)((height >> 8) & 0xFF);
+    header[16] = bitsPerPixel;
+
+    elementsWritten = fwrite(header, 1, 18, state->file);
+
+    if (!_glusFileCheckWrite(state->file, elementsWritten, 18))
+    {
+        state->file = 0;
+
+        glusImageTgaDestroyWriter(state);
+
+        return GLUS_FALSE;
+    }
+
+    writer->width  = width;
+    writer->height = height;
+    writer->format = format;
+    writer->handle = state;
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageWriteTgaRows(GLUSimagewriter* writer, const GLUSubyte* rows, GLUSint firstRow, GLUSint numberRows)
+{
+    GLUSimagetgawriter* state;
+
+    const GLUSubyte* row;
+    size_t           rowSize;
+    size_t           length;
+    size_t           elementsWritten;
+    GLUSint          y;
+
+    if (!writer || !writer->handle || !rows || numberRows < 0)
+    {
+        return GLUS_FALSE;
+    }
+
+    state = (GLUSimagetgawriter*)writer->handle;
+
+    // Rows have to be written in order.
+    if (!state->file || firstRow != state->numberWrittenRows || firstRow > writer->height - numberRows)
+    {
+        return GLUS_FALSE;
+    }
+
+    rowSize = (size_t)writer->width * state->bytesPerPixel;
+
+    for (y = 0; y < numberRows; y++)
+    {
+        row = &rows[rowSize * y];
+
+        if (state->bytesPerPixel >= 3)
+        {
+            memcpy(state->row, row, rowSize);
+
+            glusImageSwapColorChannel(writer->width, 1, writer->format, state->row);
+
+            row = state->row;
+        }
+
+        if (state->compress)
+        {
+            // Packets do not cross rows, so each row is encoded and written at once.
+
+            length = glusImageTgaEncodeRle(state->packets, row, writer->width, state->bytesPerPixel, state->skipSearch == 0);
+
+            // Rows without any gain, e.g. noise, are followed by rows not searched for runs.
+            if (state->skipSearch > 0)
+            {
+                state->skipSearch--;
+            }
+            else if (length >= rowSize)
+            {
+                state->skipSearch = GLUS_IMAGE_RLE_SKIP_SEARCH;
+            }
+
+            row = state->packets;
+        }
+        else
+        {
+            length = rowSize;
+        }
+
+        elementsWritten = fwrite(row, 1, length, state->file);
+
+        if (!_glusFileCheckWrite(state->file, elementsWritten, length))
+        {
+            state->file = 0;
+
+            return GLUS_FALSE;
+        }
+
+        state->numberWrittenRows++;
+    }
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageCloseTgaWriter(GLUSimagewriter* writer)
+{
+    GLUSimagetgawriter* state;
+
+    GLUSboolean result;
+
+    if (!writer || !writer->handle)
+    {
+        return GLUS_FALSE;
+    }
+
+    state = (GLUSimagetgawriter*)writer->handle;
+
+    result = state->file && state->numberWrittenRows == writer->height;
+
+    if (state->file)
+    {
+        result = glusFileClose(state->file) == 0 && result;
+
+        state->file = 0;
+    }
+
+    glusImageTgaDestroyWriter(state);
+
+    writer->width  = 0;
+    writer->height = 0;
+    writer->format = 0;
+    writer->handle = 0;
+
+    return result;
+}
+
+static GLUSboolean glusImageSaveTgaData(const GLUSchar* filename, const GLUStgaimage* tgaimage, const GLUSboolean compress)
+{
+    GLUSimagewriter writer;
+
+    // check, if we have a valid pointer
+    if (!filename || !tgaimage)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!glusImageOpenTgaWriter(filename, &writer, tgaimage->width, tgaimage->height, tgaimage->format, compress))
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!glusImageWriteTgaRows(&writer, tgaimage->data, 0, tgaimage->height))
+    {
+        glusImageCloseTgaWriter(&writer);
+
+        return GLUS_FALSE;
+    }
+
+    return glusImageCloseTgaWriter(&writer);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageSaveTga(const GLUSchar* filename, const GLUStgaimage* tgaimage)
+{
+    return glusImageSaveTgaData(filename, tgaimage, GLUS_FALSE);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageSaveTgaRle(const GLUSchar* filename, const GLUStgaimage* tgaimage)
+{
+    return glusImageSaveTgaData(filename, tgaimage, GLUS_TRUE);
+}
+
+GLUSvoid GLUSAPIENTRY glusImageDestroyTga(GLUStgaimage* tgaimage)
+{
+    if (!tgaimage)
+    {
+        return;
+    }
+
+    if (tgaimage->data)
+    {
+        if (tgaimage->data == tgaimage->alignedData)
+        {
+            glusMemoryFreeAligned(tgaimage->data);
+        }
+        else
+        {
+            glusMemoryFree(tgaimage->data);
+        }
+
+        tgaimage->data = 0;
+    }
+
+    tgaimage->alignedData = 0;
+
+    tgaimage->width = 0;
+
+    tgaimage->height = 0;
+
+    tgaimage->depth = 0;
+
+    tgaimage->format = 0;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageSampleTga2D(GLUSubyte rgba[4], const GLUStgaimage* tgaimage, const GLUSfloat st[2])
+{
+    GLUSfloat tempRGBA[4];
+
+    GLUSint   sampleIndex[4];
+    GLUSfloat sampleWeight[2];
+
+    GLUSint i, stride;
+
+    if (!rgba || !tgaimage || !st)
+    {
+        return GLUS_FALSE;
+    }
+
+    stride = 1;
+    if (tgaimage->format == GLUS_RGB)
+    {
+        stride = 3;
+    }
+    else if (tgaimage->format == GLUS_RGBA)
+    {
+        stride = 4;
+    }
 
-    if (!_glusFileCheckWrite(file, elementsWritten, 1))
+    _glusImageGatherSamplePoints(sampleIndex, sampleWeight, st, tgaimage->width, tgaimage->height, stride);
+
+    for (i = 0; i < stride; i++)
     {
-        return GLUS_FALSE;
+        tempRGBA[i] = (GLUSfloat)tgaimage->data[sampleIndex[0] + i] * sampleWeight[0] * sampleWeight[1];
+        tempRGBA[i] += (GLUSfloat)tgaimage->data[sampleIndex[1] + i] * (1.0f - sampleWeight[0]) * sampleWeight[1];
+        tempRGBA[i] += (GLUSfloat)tgaimage->data[sampleIndex[2] + i] * sampleWeight[0] * (1.0f - sampleWeight[1]);
+        tempRGBA[i] += (GLUSfloat)tgaimage->data[sampleIndex[3] + i] * (1.0f - sampleWeight[0]) * (1.0f - sampleWeight[1]);
     }
 
-    elementsWritten = fwrite(&tgaimage->height, sizeof(tgaimage->height), 1, file);
+    // Resolve
 
-    if (!_glusFileCheckWrite(file, elementsWritten, 1))
+    for (i = 0; i < 4; i++)
     {
-        return GLUS_FALSE;
+        if (i < stride)
+        {
+            rgba[i] = (GLUSubyte)tempRGBA[i];
+        }
+        else if (i < 3)
+        {
+            rgba[i] = rgba[0];
+        }
+        else
+        {
+            rgba[3] = 255;
+        }
     }
 
-    elementsWritten = fwrite(&bitsPerPixel, sizeof(bitsPerPixel), 1, file);
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageSampleTga2DBatch(GLUSubyte* rgba, const GLUStgaimage* tgaimage, const GLUSfloat* st, GLUSint numberSamples, GLUSenum wrapS, GLUSenum wrapT)
+{
+    GLUSint stride;
 
-    if (!_glusFileCheckWrite(file, elementsWritten, 1))
+    if (!tgaimage)
     {
         return GLUS_FALSE;
     }
 
-    buffer[0] = 0;
+    stride = 1;
+    if (tgaimage->format == GLUS_RGB)
+    {
+        stride = 3;
+    }
+    else if (tgaimage->format == GLUS_RGBA)
+    {
+        stride = 4;
+    }
+
+    return _glusImageSampleBatchub(rgba, tgaimage->data, tgaimage->width, tgaimage->height, stride, st, numberSamples, wrapS, wrapT);
+}
+
+/**
+ * Converts a span of pixels. The table depends on the conversion.
+ */
+typedef GLUSvoid (*GLUSimageConvertFunction)(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table);
+
+/**
+ * Conversion of an image, which is split into bands of pixels.
+ */
+typedef struct _GLUSimageConvertBands
+{
+    GLUSimageConvertFunction function;
+
+    GLUSubyte*       target;
+    const GLUSubyte* source;
+
+    size_t targetPixelSize;
+    size_t sourcePixelSize;
+
+    size_t numberPixels;
+    size_t bandSize;
 
-    elementsWritten = fwrite(buffer, 1, 1, file);
+    const GLUSvoid* table;
 
-    if (!_glusFileCheckWrite(file, elementsWritten, 1))
+} GLUSimageConvertBands;
+
+static GLUSubyte   g_premultiplyTable[256 * 256];
+static GLUSboolean g_premultiplyTableCreated = GLUS_FALSE;
+
+static GLUSvoid glusImageConvertCopy(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    (void)table;
+
+    memcpy(target, source, numberPixels);
+}
+
+static GLUSvoid glusImageConvertFill(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    (void)source;
+
+    memset(target, *(const GLUSubyte*)table, numberPixels);
+}
+
+/**
+ * Single channel to single channel. The table contains four channels per source value.
+ */
+static GLUSvoid glusImageConvertLookup(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    const GLUSubyte* channels = (const GLUSubyte*)table;
+
+    size_t i;
+
+    for (i = 0; i < numberPixels; i++)
     {
-        return GLUS_FALSE;
+        target[i] = channels[4 * source[i]];
+    }
+}
+
+static GLUSvoid glusImageConvertExpandRgb(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    const GLUSubyte* channels = (const GLUSubyte*)table;
+
+    size_t i;
+
+    if (!numberPixels)
+    {
+        return;
+    }
+
+    // Four bytes are stored, the last one is overwritten by the next pixel.
+    for (i = 0; i < numberPixels - 1; i++)
+    {
+        memcpy(&target[3 * i], &channels[4 * source[i]], 4);
     }
 
-    data = glusMemoryMalloc(tgaimage->width * tgaimage->height * bitsPerPixel / 8);
+    memcpy(&target[3 * i], &channels[4 * source[i]], 3);
+}
 
-    if (!data)
+static GLUSvoid glusImageConvertExpandRgba(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    const GLUSubyte* channels = (const GLUSubyte*)table;
+
+    size_t i;
+
+    for (i = 0; i < numberPixels; i++)
     {
-        glusFileClose(file);
+        memcpy(&target[4 * i], &channels[4 * source[i]], 4);
+    }
+}
 
-        return GLUS_FALSE;
+static GLUSvoid glusImageConvertRgbToRed(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    size_t i;
+
+    (void)table;
+
+    for (i = 0; i < numberPixels; i++)
+    {
+        target[i] = source[3 * i];
     }
+}
+
+static GLUSvoid glusImageConvertRgbaToRed(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    size_t i;
 
-    memcpy(data, tgaimage->data, tgaimage->width * tgaimage->height * bitsPerPixel / 8);
+    (void)table;
 
-    if (bitsPerPixel >= 24)
+    for (i = 0; i < numberPixels; i++)
     {
-        glusImageSwapColorChannel(tgaimage->width, tgaimage->height, tgaimage->format, data);
+        target[i] = source[4 * i];
     }
+}
 
-    elementsWritten = fwrite(data, 1, tgaimage->width * tgaimage->height * bitsPerPixel / 8, file);
+static GLUSvoid glusImageConvertRgbaToAlpha(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    size_t i;
 
-    glusMemoryFree(data);
+    (void)table;
 
-    if (!_glusFileCheckWrite(file, elementsWritten, tgaimage->width * tgaimage->height * bitsPerPixel / 8))
+    for (i = 0; i < numberPixels; i++)
     {
-        return GLUS_FALSE;
+        target[i] = source[4 * i + 3];
     }
+}
+
+/**
+ * The table contains the weighted red, green and blue values, so the sum is the same as of the products.
+ */
+static GLUSvoid glusImageConvertRgbToLuminance(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    const GLUSfloat* weighted = (const GLUSfloat*)table;
 
-    glusFileClose(file);
+    size_t i;
 
-    return GLUS_TRUE;
+    for (i = 0; i < numberPixels; i++)
+    {
+        target[i] = (GLUSubyte)(weighted[source[3 * i]] + weighted[256 + source[3 * i + 1]] + weighted[512 + source[3 * i + 2]]);
+    }
 }
 
-GLUSvoid GLUSAPIENTRY glusImageDestroyTga(GLUStgaimage* tgaimage)
+static GLUSvoid glusImageConvertRgbaToLuminance(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
 {
-    if (!tgaimage)
+    const GLUSfloat* weighted = (const GLUSfloat*)table;
+
+    size_t i;
+
+    for (i = 0; i < numberPixels; i++)
     {
-        return;
+        target[i] = (GLUSubyte)(weighted[source[4 * i]] + weighted[256 + source[4 * i + 1]] + weighted[512 + source[4 * i + 2]]);
     }
+}
 
-    if (tgaimage->data)
+static GLUSvoid glusImageConvertRgbToRgba(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    size_t i = 0;
+
+#if defined(GLUS_IMAGE_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha   = _mm_set1_epi32((int)0xFF000000);
+
+    // Sixteen bytes are loaded for four pixels, so two more pixels have to follow.
+    for (; i + 6 <= numberPixels; i += 4)
     {
-        glusMemoryFree(tgaimage->data);
+        __m128i rgb = _mm_loadu_si128((const __m128i*)&source[3 * i]);
 
-        tgaimage->data = 0;
+        _mm_storeu_si128((__m128i*)&target[4 * i], _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha));
+    }
+#elif defined(GLUS_IMAGE_NEON)
+    for (; i + 16 <= numberPixels; i += 16)
+    {
+        uint8x16x3_t rgb = vld3q_u8(&source[3 * i]);
+        uint8x16x4_t rgba;
+
+        rgba.val[0] = rgb.val[0];
+        rgba.val[1] = rgb.val[1];
+        rgba.val[2] = rgb.val[2];
+        rgba.val[3] = vdupq_n_u8(255);
+
+        vst4q_u8(&target[4 * i], rgba);
     }
+#endif
 
-    tgaimage->width = 0;
+    (void)table;
 
-    tgaimage->height = 0;
+    // Four bytes are loaded, the last one belongs to the next pixel.
+    for (; i + 1 < numberPixels; i++)
+    {
+        memcpy(&target[4 * i], &source[3 * i], 4);
 
-    tgaimage->depth = 0;
+        target[4 * i + 3] = 255;
+    }
 
-    tgaimage->format = 0;
+    for (; i < numberPixels; i++)
+    {
+        memcpy(&target[4 * i], &source[3 * i], 3);
+
+        target[4 * i + 3] = 255;
+    }
 }
 
-GLUSboolean GLUSAPIENTRY glusImageSampleTga2D(GLUSubyte rgba[4], const GLUStgaimage* tgaimage, const GLUSfloat st[2])
+static GLUSvoid glusImageConvertRgbaToRgb(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
 {
-    GLUSfloat tempRGBA[4];
+    size_t i = 0;
 
-    GLUSint   sampleIndex[4];
-    GLUSfloat sampleWeight[2];
+#if defined(GLUS_IMAGE_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
 
-    GLUSint i, stride;
+    // Sixteen bytes are stored for four pixels, the last four are overwritten by the next pixels.
+    for (; i + 6 <= numberPixels; i += 4)
+    {
+        __m128i rgba = _mm_loadu_si128((const __m128i*)&source[4 * i]);
 
-    if (!rgba || !tgaimage || !st)
+        _mm_storeu_si128((__m128i*)&target[3 * i], _mm_shuffle_epi8(rgba, shuffle));
+    }
+#elif defined(GLUS_IMAGE_NEON)
+    for (; i + 16 <= numberPixels; i += 16)
     {
-        return GLUS_FALSE;
+        uint8x16x4_t rgba = vld4q_u8(&source[4 * i]);
+        uint8x16x3_t rgb;
+
+        rgb.val[0] = rgba.val[0];
+        rgb.val[1] = rgba.val[1];
+        rgb.val[2] = rgba.val[2];
+
+        vst3q_u8(&target[3 * i], rgb);
     }
+#endif
 
-    stride = 1;
-    if (tgaimage->format == GLUS_RGB)
+    (void)table;
+
+    // Four bytes are stored, the last one is overwritten by the next pixel.
+    for (; i + 1 < numberPixels; i++)
     {
-        stride = 3;
+        memcpy(&target[3 * i], &source[4 * i], 4);
     }
-    else if (tgaimage->format == GLUS_RGBA)
+
+    for (; i < numberPixels; i++)
     {
-        stride = 4;
+        memcpy(&target[3 * i], &source[4 * i], 3);
     }
+}
 
-    _glusImageGatherSamplePoints(sampleIndex, sampleWeight, st, tgaimage->width, tgaimage->height, stride);
+/**
+ * The table contains the premultiplied color values, indexed by alpha * 256 + color.
+ */
+static GLUSvoid glusImageConvertPremultiply(GLUSubyte* target, const GLUSubyte* source, size_t numberPixels, const GLUSvoid* table)
+{
+    const GLUSubyte* premultiplied;
 
-    for (i = 0; i < stride; i++)
+    size_t i;
+
+    for (i = 0; i < numberPixels; i++)
     {
-        tempRGBA[i] = (GLUSfloat)tgaimage->data[sampleIndex[0] + i] * sampleWeight[0] * sampleWeight[1];
-        tempRGBA[i] += (GLUSfloat)tgaimage->data[sampleIndex[1] + i] * (1.0f - sampleWeight[0]) * sampleWeight[1];
-        tempRGBA[i] += (GLUSfloat)tgaimage->data[sampleIndex[2] + i] * sampleWeight[0] * (1.0f - sampleWeight[1]);
-        tempRGBA[i] += (GLUSfloat)tgaimage->data[sampleIndex[3] + i] * (1.0f - sampleWeight[0]) * (1.0f - sampleWeight[1]);
+        premultiplied = &((const GLUSubyte*)table)[256 * source[4 * i + 3]];
+
+        target[4 * i + 0] = premultiplied[source[4 * i + 0]];
+        target[4 * i + 1] = premultiplied[source[4 * i + 1]];
+        target[4 * i + 2] = premultiplied[source[4 * i + 2]];
+        target[4 * i + 3] = source[4 * i + 3];
     }
+}
 
-    // Resolve
+static GLUSvoid glusImageConvertBand(GLUSvoid* data, GLUSuint index)
+{
+    const GLUSimageConvertBands* bands = (const GLUSimageConvertBands*)data;
 
-    for (i = 0; i < 4; i++)
+    size_t first = bands->bandSize * index;
+    size_t numberPixels;
+
+    if (first >= bands->numberPixels)
     {
-        if (i < stride)
+        return;
+    }
+
+    numberPixels = bands->numberPixels - first;
+    if (numberPixels > bands->bandSize)
+    {
+        numberPixels = bands->bandSize;
+    }
+
+    bands->function(bands->target + first * bands->targetPixelSize, bands->source + first * bands->sourcePixelSize, numberPixels, bands->table);
+}
+
+/**
+ * Converts the pixels. Large images are split into one band per processor.
+ */
+static GLUSvoid glusImageConvertPixels(GLUSimageConvertFunction function, GLUSubyte* target, size_t targetPixelSize, const GLUSubyte* source, size_t sourcePixelSize, size_t numberPixels, const GLUSvoid* table)
+{
+    GLUSimageConvertBands bands;
+
+    GLUSuint numberThreads = 1;
+
+    if (numberPixels >= GLUS_IMAGE_CONVERT_PARALLEL_PIXELS)
+    {
+        numberThreads = _glusThreadGetNumberProcessors();
+    }
+
+    if (numberThreads < 2)
+    {
+        function(target, source, numberPixels, table);
+
+        return;
+    }
+
+    bands.function        = function;
+    bands.target          = target;
+    bands.source          = source;
+    bands.targetPixelSize = targetPixelSize;
+    bands.sourcePixelSize = sourcePixelSize;
+    bands.numberPixels    = numberPixels;
+    bands.table           = table;
+
+    // Bands start at a multiple of 64 pixels, so threads do not write to the same cache line.
+    bands.bandSize = ((numberPixels + numberThreads - 1) / numberThreads + 63) & ~(size_t)63;
+
+    _glusThreadRun(glusImageConvertBand, &bands, numberThreads, numberThreads);
+}
+
+/**
+ * Converts a single channel value to the four target channels.
+ */
+static GLUSvoid glusImageConvertSingleChannel(GLUSubyte channels[4], GLUSenum sourceFormat, GLUSenum targetFormat, GLUSubyte value)
+{
+    GLUSfloat toLuminace[3] = {0.299f, 0.587f, 0.114f};
+
+    channels[0] = 0;
+    channels[1] = 0;
+    channels[2] = 0;
+    channels[3] = 255;
+
+    if (sourceFormat == GLUS_RED)
+    {
+        if (targetFormat == GLUS_RED || targetFormat == GLUS_RGB || targetFormat == GLUS_RGBA)
         {
-            rgba[i] = (GLUSubyte)tempRGBA[i];
+            channels[0] = value;
         }
-        else if (i < 3)
+        else if (targetFormat == GLUS_ALPHA)
         {
-            rgba[i] = rgba[0];
+            channels[0] = 255;
         }
-        else
+        else if (targetFormat == GLUS_LUMINANCE)
         {
-            rgba[3] = 255;
+            channels[0] = (GLUSubyte)(value * toLuminace[0]);
+        }
+    }
+    else if (sourceFormat == GLUS_ALPHA)
+    {
+        if (targetFormat == GLUS_RGBA)
+        {
+            channels[3] = value;
+        }
+        else if (targetFormat == GLUS_ALPHA)
+        {
+            channels[0] = value;
+        }
+    }
+    else if (sourceFormat == GLUS_LUMINANCE)
+    {
+        if (targetFormat == GLUS_RED)
+        {
+            channels[0] = (GLUSubyte)glusMathClampf(value / toLuminace[0], 0.0f, 1.0f);
+        }
+        else if (targetFormat == GLUS_RGB || targetFormat == GLUS_RGBA)
+        {
+            channels[0] = value;
+            channels[1] = value;
+            channels[2] = value;
+        }
+        else if (targetFormat == GLUS_ALPHA)
+        {
+            channels[0] = 255;
+        }
+        else if (targetFormat == GLUS_LUMINANCE)
+        {
+            channels[0] = value;
         }
     }
-
-    return GLUS_TRUE;
 }
 
 GLUSboolean GLUSAPIENTRY glusImageConvertTga(GLUStgaimage* targetImage, const GLUStgaimage* sourceImage, const GLUSenum targetFormat)
 {
     GLUSint targetNumberChannels = 1;
     GLUSint sourceNumberChannels = 1;
-    GLUSint x, y, z, c;
+    GLUSint i;
 
-    GLUSubyte channels[4] = {0, 0, 0, 255};
+    GLUSubyte channels[256 * 4];
+    GLUSubyte fill = 255;
+
+    GLUSfloat weighted[3 * 256];
 
     GLUSfloat toLuminace[3] = {0.299f, 0.587f, 0.114f};
 
+    size_t numberPixels;
+
     if (!targetImage || !sourceImage)
     {
         return GLUS_FALSE;
@@ -762,7 +1872,10 @@ GLUSboolean GLUSAPIENTRY glusImageConvertTga(GLUStgaimage* targetImage, const GL
         targetNumberChannels = 4;
     }
 
-    targetImage->data = (GLUSubyte*)glusMemoryMalloc(targetNumberChannels * sourceImage->width * sourceImage->height * sourceImage->depth * sizeof(GLUSubyte));
+    numberPixels = (size_t)sourceImage->width * sourceImage->height * sourceImage->depth;
+
+    targetImage->data        = (GLUSubyte*)glusMemoryMallocAligned(targetNumberChannels * numberPixels * sizeof(GLUSubyte), GLUS_MEMORY_DATA_ALIGNMENT);
+    targetImage->alignedData = targetImage->data;
 
     if (!targetImage->data)
     {
@@ -773,141 +1886,65 @@ GLUSboolean GLUSAPIENTRY glusImageConvertTga(GLUStgaimage* targetImage, const GL
     targetImage->depth  = sourceImage->depth;
     targetImage->format = targetFormat;
 
-    for (z = 0; z < targetImage->depth; z++)
+    // Each pair of formats has its own conversion.
+
+    if (sourceImage->format == targetFormat)
     {
-        for (y = 0; y < targetImage->height; y++)
+        glusImageConvertPixels(glusImageConvertCopy, targetImage->data, 1, sourceImage->data, 1, numberPixels * targetNumberChannels, 0);
+    }
+    else if (sourceNumberChannels == 1)
+    {
+        for (i = 0; i < 256; i++)
         {
-            for (x = 0; x < targetImage->width; x++)
-            {
-                if (sourceImage->format == GLUS_RED)
-                {
-                    if (targetImage->format == GLUS_RED || targetImage->format == GLUS_RGB || targetImage->format == GLUS_RGBA)
-                    {
-                        channels[0] = sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + 0];
-
-                        if (targetImage->format == GLUS_RGB || targetImage->format == GLUS_RGBA)
-                        {
-                            channels[1] = 0;
-                            channels[2] = 0;
-
-                            if (targetImage->format == GLUS_RGBA)
-                            {
-                                channels[3] = 255;
-                            }
-                        }
-                    }
-                    else if (targetImage->format == GLUS_ALPHA)
-                    {
-                        channels[0] = 255;
-                    }
-                    else if (targetImage->format == GLUS_LUMINANCE)
-                    {
-                        channels[0] = (GLUSubyte)(sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + 0] * toLuminace[0]);
-                    }
-                }
-                else if (sourceImage->format == GLUS_ALPHA)
-                {
-                    if (targetImage->format == GLUS_LUMINANCE || targetImage->format == GLUS_RED || targetImage->format == GLUS_RGB || targetImage->format == GLUS_RGBA)
-                    {
-                        channels[0] = 0;
-
-                        if (targetImage->format == GLUS_RGB || targetImage->format == GLUS_RGBA)
-                        {
-                            channels[1] = 0;
-                            channels[2] = 0;
-
-                            if (targetImage->format == GLUS_RGBA)
-                            {
-                                channels[3] = sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + 0];
-                            }
-                        }
-                    }
-                    else if (targetImage->format == GLUS_ALPHA)
-                    {
-                        channels[0] = sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + 0];
-                    }
-                }
-                else if (sourceImage->format == GLUS_LUMINANCE)
-                {
-                    if (targetImage->format == GLUS_RED)
-                    {
-                        channels[0] = (GLUSubyte)glusMathClampf(sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + 0] / toLuminace[0], 0.0f, 1.0f);
-                    }
-                    else if (targetImage->format == GLUS_RGB || targetImage->format == GLUS_RGBA)
-                    {
-                        channels[0] = sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + 0];
-                        channels[1] = channels[0];
-                        channels[2] = channels[0];
-
-                        if (targetImage->format == GLUS_RGBA)
-                        {
-                            channels[3] = 255;
-                        }
-                    }
-                    else if (targetImage->format == GLUS_ALPHA)
-                    {
-                        channels[0] = 255;
-                    }
-                    else if (targetImage->format == GLUS_LUMINANCE)
-                    {
-                        channels[0] = sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + 0];
-                    }
-                }
-                if (sourceImage->format == GLUS_RGB || sourceImage->format == GLUS_RGBA)
-                {
-                    if (targetImage->format == GLUS_RED)
-                    {
-                        channels[0] = sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + 0];
-                    }
-                    else if (targetImage->format == GLUS_ALPHA)
-                    {
-                        if (sourceImage->format == GLUS_RGB)
-                        {
-                            channels[0] = 255;
-                        }
-                        else if (sourceImage->format == GLUS_RGBA)
-                        {
-                            channels[0] = sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + 3];
-                        }
-                    }
-                    else if (targetImage->format == GLUS_LUMINANCE)
-                    {
-                        GLUSfloat luminance = 0.0f;
-
-                        for (c = 0; c < 3; c++)
-                        {
-                            luminance += sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + c] * toLuminace[c];
-                        }
-
-                        channels[0] = (GLUSubyte)luminance;
-                    }
-                    else if (targetImage->format == GLUS_RGB || targetImage->format == GLUS_RGBA)
-                    {
-                        for (c = 0; c < 3; c++)
-                        {
-                            channels[c] = sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + c];
-                        }
-
-                        if (targetImage->format == GLUS_RGBA)
-                        {
-                            if (sourceImage->format == GLUS_RGBA)
-                            {
-                                channels[3] = sourceImage->data[sourceNumberChannels * z * sourceImage->height * sourceImage->width + sourceNumberChannels * y * sourceImage->width + sourceNumberChannels * x + 3];
-                            }
-                            else
-                            {
-                                channels[3] = 255;
-                            }
-                        }
-                    }
-                }
-
-                for (c = 0; c < targetNumberChannels; c++)
-                {
-                    targetImage->data[targetNumberChannels * z * targetImage->height * targetImage->width + targetNumberChannels * y * targetImage->width + targetNumberChannels * x + c] = channels[c];
-                }
-            }
+            glusImageConvertSingleChannel(&channels[4 * i], sourceImage->format, targetFormat, (GLUSubyte)i);
+        }
+
+        if (targetNumberChannels == 1)
+        {
+            glusImageConvertPixels(glusImageConvertLookup, targetImage->data, 1, sourceImage->data, 1, numberPixels, channels);
+        }
+        else if (targetNumberChannels == 3)
+        {
+            glusImageConvertPixels(glusImageConvertExpandRgb, targetImage->data, 3, sourceImage->data, 1, numberPixels, channels);
+        }
+        else
+        {
+            glusImageConvertPixels(glusImageConvertExpandRgba, targetImage->data, 4, sourceImage->data, 1, numberPixels, channels);
+        }
+    }
+    else if (targetFormat == GLUS_RED)
+    {
+        glusImageConvertPixels(sourceNumberChannels == 3 ? glusImageConvertRgbToRed : glusImageConvertRgbaToRed, targetImage->data, 1, sourceImage->data, sourceNumberChannels, numberPixels, 0);
+    }
+    else if (targetFormat == GLUS_ALPHA)
+    {
+        if (sourceNumberChannels == 3)
+        {
+            glusImageConvertPixels(glusImageConvertFill, targetImage->data, 1, sourceImage->data, 3, numberPixels, &fill);
+        }
+        else
+        {
+            glusImageConvertPixels(glusImageConvertRgbaToAlpha, targetImage->data, 1, sourceImage->data, 4, numberPixels, 0);
+        }
+    }
+    else if (targetFormat == GLUS_LUMINANCE)
+    {
+        for (i = 0; i < 256; i++)
+        {
+            weighted[i]       = i * toLuminace[0];
+            weighted[256 + i] = i * toLuminace[1];
+            weighted[512 + i] = i * toLuminace[2];
         }
+
+        glusImageConvertPixels(sourceNumberChannels == 3 ? glusImageConvertRgbToLuminance : glusImageConvertRgbaToLuminance, targetImage->data, 1, sourceImage->data, sourceNumberChannels, numberPixels, weighted);
+    }
+    else if (targetFormat == GLUS_RGBA)
+    {
+        glusImageConvertPixels(glusImageConvertRgbToRgba, targetImage->data, 4, sourceImage->data, 3, numberPixels, 0);
+    }
+    else
+    {
+        glusImageConvertPixels(glusImageConvertRgbaToRgb, targetImage->data, 3, sourceImage->data, 4, numberPixels, 0);
     }
 
     return GLUS_TRUE;
@@ -915,10 +1952,9 @@ GLUSboolean GLUSAPIENTRY glusImageConvertTga(GLUStgaimage* targetImage, const GL
 
 GLUSboolean GLUSAPIENTRY glusImageToPremultiplyTga(GLUStgaimage* targetImage, const GLUStgaimage* sourceImage)
 {
-    GLUSint x, y, z, c;
+    GLUSint alpha, color;
 
-    GLUSfloat alpha;
-    GLUSfloat channel;
+    size_t numberPixels;
 
     if (!targetImage || !sourceImage)
     {
@@ -930,7 +1966,10 @@ GLUSboolean GLUSAPIENTRY glusImageToPremultiplyTga(GLUStgaimage* targetImage, co
         return GLUS_FALSE;
     }
 
-    targetImage->data = (GLUSubyte*)glusMemoryMalloc(4 * sourceImage->width * sourceImage->height * sourceImage->depth * sizeof(GLUSubyte));
+    numberPixels = (size_t)sourceImage->width * sourceImage->height * sourceImage->depth;
+
+    targetImage->data        = (GLUSubyte*)glusMemoryMallocAligned(4 * numberPixels * sizeof(GLUSubyte), GLUS_MEMORY_DATA_ALIGNMENT);
+    targetImage->alignedData = targetImage->data;
 
     if (!targetImage->data)
     {
@@ -941,23 +1980,26 @@ GLUSboolean GLUSAPIENTRY glusImageToPremultiplyTga(GLUStgaimage* targetImage, co
     targetImage->depth  = sourceImage->depth;
     targetImage->format = sourceImage->format;
 
-    for (z = 0; z < targetImage->depth; z++)
+    // All combinations of alpha and color are calculated once.
+
+    _glusThreadLock();
+
+    if (!g_premultiplyTableCreated)
     {
-        for (y = 0; y < targetImage->height; y++)
+        for (alpha = 0; alpha < 256; alpha++)
         {
-            for (x = 0; x < targetImage->width; x++)
+            for (color = 0; color < 256; color++)
             {
-                alpha = (GLUSfloat)sourceImage->data[4 * z * targetImage->height * targetImage->width + 4 * y * targetImage->width + 4 * x + 3] / 255.0f;
-
-                for (c = 0; c < 3; c++)
-                {
-                    channel = (GLUSfloat)sourceImage->data[4 * z * targetImage->height * targetImage->width + 4 * y * targetImage->width + 4 * x + c] / 255.0f;
-
-                    targetImage->data[4 * z * targetImage->height * targetImage->width + 4 * y * targetImage->width + 4 * x + c] = (GLUSubyte)glusMathClampf(channel * alpha * 255.0f, 0.0f, 255.0f);
-                }
+                g_premultiplyTable[256 * alpha + color] = (GLUSubyte)glusMathClampf((GLUSfloat)color / 255.0f * ((GLUSfloat)alpha / 255.0f) * 255.0f, 0.0f, 255.0f);
             }
         }
+
+        g_premultiplyTableCreated = GLUS_TRUE;
     }
 
+    _glusThreadUnlock();
+
+    glusImageConvertPixels(glusImageConvertPremultiply, targetImage->data, 4, sourceImage->data, 4, numberPixels, g_premultiplyTable);
+
     return GLUS_TRUE;
 }
@@ -22,12 +22,22 @@
 
 #include "GL/glus.h"
 
+// With statistics, the allocations are tracked by glus_memory_statistics.c on top of these functions.
+
+#if defined(GLUS_MEMORY_STATISTICS)
+GLUSvoid* _glusMemoryMallocUntracked(size_t size)
+#else
 void* GLUSAPIENTRY glusMemoryMalloc(size_t size)
+#endif
 {
     return malloc(size);
 }
 
+#if defined(GLUS_MEMORY_STATISTICS)
+GLUSvoid _glusMemoryFreeUntracked(GLUSvoid* pointer)
+#else
 void GLUSAPIENTRY glusMemoryFree(void* pointer)
+#endif
 {
     free(pointer);
 }
@@ -0,0 +1,79 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "GL/glus.h"
+
+// The function is defined in this file.
+#undef glusMemoryMallocAligned
+
+/**
+ * Aligned memory is taken from a larger block of the current allocator. The pointer to the block is stored directly in front of the aligned memory.
+ */
+GLUSvoid* GLUSAPIENTRY glusMemoryMallocAlignedTagged(size_t size, size_t alignment, const GLUSchar* tag, const GLUSint line)
+{
+    GLUSubyte* block;
+    GLUSubyte* result;
+
+    if (alignment < sizeof(GLUSvoid*))
+    {
+        alignment = sizeof(GLUSvoid*);
+    }
+
+    if ((alignment & (alignment - 1)) != 0 || size > ((size_t)-1) - alignment - sizeof(GLUSvoid*))
+    {
+        return 0;
+    }
+
+    block = (GLUSubyte*)glusMemoryMallocTagged(size + alignment - 1 + sizeof(GLUSvoid*), tag, line);
+
+    if (!block)
+    {
+        return 0;
+    }
+
+    result = block + sizeof(GLUSvoid*);
+
+    result += (alignment - ((size_t)result & (alignment - 1))) & (alignment - 1);
+
+    memcpy(result - sizeof(GLUSvoid*), &block, sizeof(GLUSvoid*));
+
+    return result;
+}
+
+GLUSvoid* GLUSAPIENTRY glusMemoryMallocAligned(size_t size, size_t alignment)
+{
+    return glusMemoryMallocAlignedTagged(size, alignment, "unknown", 0);
+}
+
+GLUSvoid GLUSAPIENTRY glusMemoryFreeAligned(GLUSvoid* pointer)
+{
+    GLUSubyte* block;
+
+    if (!pointer)
+    {
+        return;
+    }
+
+    memcpy(&block, (GLUSubyte*)pointer - sizeof(GLUSvoid*), sizeof(GLUSvoid*));
+
+    glusMemoryFree(block);
+}
@@ -0,0 +1,215 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "GL/glus.h"
+
+/**
+ * Header in front of every arena block.
+ */
+typedef struct _GLUSmemoryArenaBlock
+{
+    struct _GLUSmemoryArenaBlock* next;
+
+    /**
+     * Usable size of the block in bytes.
+     */
+    size_t size;
+
+} GLUSmemoryArenaBlock;
+
+// Header padded to the alignment.
+#define GLUS_MEMORY_ARENA_HEADER_SIZE ((sizeof(GLUSmemoryArenaBlock) + GLUS_MEMORY_ARENA_ALIGNMENT - 1) & ~((size_t)GLUS_MEMORY_ARENA_ALIGNMENT - 1))
+
+static GLUSubyte* glusMemoryArenaAlign(GLUSubyte* pointer)
+{
+    return pointer + ((GLUS_MEMORY_ARENA_ALIGNMENT - ((size_t)pointer & (GLUS_MEMORY_ARENA_ALIGNMENT - 1))) & (GLUS_MEMORY_ARENA_ALIGNMENT - 1));
+}
+
+static GLUSubyte* glusMemoryArenaGetData(GLUSmemoryArenaBlock* block)
+{
+    return glusMemoryArenaAlign((GLUSubyte*)block + GLUS_MEMORY_ARENA_HEADER_SIZE);
+}
+
+static GLUSmemoryArenaBlock* glusMemoryArenaCreateBlock(const size_t size)
+{
+    GLUSmemoryArenaBlock* block;
+
+    if (size > ((size_t)-1) - GLUS_MEMORY_ARENA_HEADER_SIZE - GLUS_MEMORY_ARENA_ALIGNMENT)
+    {
+        return 0;
+    }
+
+    // The system allocator may align less strictly, so there is room for aligning the data.
+    block = (GLUSmemoryArenaBlock*)glusMemoryMalloc(GLUS_MEMORY_ARENA_HEADER_SIZE + size + GLUS_MEMORY_ARENA_ALIGNMENT);
+
+    if (!block)
+    {
+        return 0;
+    }
+
+    block->next = 0;
+    block->size = size;
+
+    return block;
+}
+
+static GLUSvoid glusMemoryArenaFreeBlocks(GLUSmemoryArena* arena)
+{
+    GLUSmemoryArenaBlock* block = (GLUSmemoryArenaBlock*)arena->blocks;
+    GLUSmemoryArenaBlock* toDelete;
+
+    while (block)
+    {
+        toDelete = block;
+
+        block = block->next;
+
+        glusMemoryFree(toDelete);
+    }
+
+    arena->blocks  = 0;
+    arena->current = 0;
+    arena->end     = 0;
+}
+
+GLUSvoid GLUSAPIENTRY glusMemoryArenaBegin(GLUSmemoryArena* arena, size_t blockSize)
+{
+    if (!arena)
+    {
+        return;
+    }
+
+    arena->blocks    = 0;
+    arena->current   = 0;
+    arena->end       = 0;
+    arena->blockSize = blockSize ? blockSize : GLUS_MEMORY_ARENA_BLOCK_SIZE;
+}
+
+GLUSvoid* GLUSAPIENTRY glusMemoryArenaAlloc(GLUSmemoryArena* arena, size_t size)
+{
+    GLUSmemoryArenaBlock* block;
+
+    GLUSubyte* result;
+
+    if (!arena || size > ((size_t)-1) - GLUS_MEMORY_ARENA_ALIGNMENT)
+    {
+        return 0;
+    }
+
+    // Every allocation gets its own address and the next one stays aligned.
+    size = size ? (size + GLUS_MEMORY_ARENA_ALIGNMENT - 1) & ~((size_t)GLUS_MEMORY_ARENA_ALIGNMENT - 1) : GLUS_MEMORY_ARENA_ALIGNMENT;
+
+    if ((size_t)(arena->end - arena->current) < size)
+    {
+        if (size > arena->blockSize)
+        {
+            block = glusMemoryArenaCreateBlock(size);
+
+            if (!block)
+            {
+                return 0;
+            }
+
+            // Insert behind the current block, so the rest of the current block can still be used.
+            if (arena->blocks)
+            {
+                block->next = ((GLUSmemoryArenaBlock*)arena->blocks)->next;
+
+                ((GLUSmemoryArenaBlock*)arena->blocks)->next = block;
+            }
+            else
+            {
+                arena->blocks = block;
+            }
+
+            return glusMemoryArenaGetData(block);
+        }
+
+        block = glusMemoryArenaCreateBlock(arena->blockSize);
+
+        if (!block)
+        {
+            return 0;
+        }
+
+        block->next = (GLUSmemoryArenaBlock*)arena->blocks;
+
+        arena->blocks  = block;
+        arena->current = glusMemoryArenaGetData(block);
+        arena->end     = arena->current + block->size;
+    }
+
+    result = arena->current;
+
+    arena->current += size;
+
+    return result;
+}
+
+GLUSvoid GLUSAPIENTRY glusMemoryArenaReset(GLUSmemoryArena* arena)
+{
+    GLUSmemoryArenaBlock* block;
+
+    size_t totalSize = 0;
+
+    if (!arena || !arena->blocks)
+    {
+        return;
+    }
+
+    block = (GLUSmemoryArenaBlock*)arena->blocks;
+
+    // One regular block is reused as it is.
+    if (!block->next && block->size == arena->blockSize)
+    {
+        arena->current = glusMemoryArenaGetData(block);
+
+        return;
+    }
+
+    while (block)
+    {
+        if (totalSize <= ((size_t)-1) - block->size)
+        {
+            totalSize += block->size;
+        }
+
+        block = block->next;
+    }
+
+    glusMemoryArenaFreeBlocks(arena);
+
+    if (totalSize > arena->blockSize)
+    {
+        arena->blockSize = totalSize;
+    }
+}
+
+GLUSvoid GLUSAPIENTRY glusMemoryArenaEnd(GLUSmemoryArena* arena)
+{
+    if (!arena)
+    {
+        return;
+    }
+
+    glusMemoryArenaFreeBlocks(arena);
+}
@@ -22,248 +22,439 @@
 
 #include "GL/glus.h"
 
-// Data type used for the memory array.
-#define GLUS_MEMORY_DATA_TYPE uint32_t
+/*
+ * Two level segregated fit (TLSF) allocator on a static heap.
+ *
+ * Free blocks are kept in size class lists. The first level splits the sizes by powers of two, the second level splits every power of two linearly.
+ * Two bitmaps mark the non empty lists, so finding and freeing a block is done in constant time. Neighbouring free blocks are merged on free.
+ *
+ * As the previous table based allocator, the allocator is not thread safe.
+ */
+
+// Size of the heap in bytes. Can be set from the build system. Has to be smaller than 2 GB.
+#ifndef GLUS_MEMORY_HEAP_SIZE
+#define GLUS_MEMORY_HEAP_SIZE (128 * 1024 * 1024)
+#endif
 
-// Data size of the data type.
-#define GLUS_MEMORY_DATA_SIZE sizeof(GLUS_MEMORY_DATA_TYPE)
+#if GLUS_MEMORY_HEAP_SIZE >= 2147483648
+#error "GLUS_MEMORY_HEAP_SIZE has to be smaller than 2 GB"
+#endif
 
-// Alignment in memory.
-#define GLUS_MEMORY_DATA_ALIGNMENT_SIZE (GLUS_MEMORY_DATA_SIZE * 2)
+// Alignment of the returned memory and of the block sizes.
+#define GLUS_MEMORY_ALIGNMENT_LOG2 4
+#define GLUS_MEMORY_ALIGNMENT (1 << GLUS_MEMORY_ALIGNMENT_LOG2)
 
-// Factor to get the right alignment.
-#define GLUS_MEMORY_DATAT_ALIGNMENT_FACTOR (GLUS_MEMORY_DATA_ALIGNMENT_SIZE / GLUS_MEMORY_DATA_SIZE)
+// Block header, padded to the alignment.
+#define GLUS_MEMORY_HEADER_SIZE GLUS_MEMORY_ALIGNMENT
 
-// 128 MB of memory. Change only here, if more or less is needed.
-#define GLUS_MEMORY_SIZE (128 * 1024 * 1024 / GLUS_MEMORY_DATA_SIZE)
+// Number of second level lists per first level as power of two.
+#define GLUS_MEMORY_SL_INDEX_COUNT_LOG2 4
+#define GLUS_MEMORY_SL_INDEX_COUNT (1 << GLUS_MEMORY_SL_INDEX_COUNT_LOG2)
 
-// Number of memory table entries.
-#define GLUS_MEMORY_TABLE_ENTRIES 2048
+// Blocks below this size are all in the first first level list.
+#define GLUS_MEMORY_FL_INDEX_SHIFT (GLUS_MEMORY_SL_INDEX_COUNT_LOG2 + GLUS_MEMORY_ALIGNMENT_LOG2)
+#define GLUS_MEMORY_SMALL_BLOCK_SIZE (1 << GLUS_MEMORY_FL_INDEX_SHIFT)
 
-// States of a memory block entry.
-#define GLUS_VALID_AND_FREE 1
-#define GLUS_VALID_AND_LOCKED 2
-#define GLUS_INVALID 3
+// Block sizes, also after rounding up, are smaller than 2^32.
+#define GLUS_MEMORY_FL_INDEX_MAX 31
+#define GLUS_MEMORY_FL_INDEX_COUNT (GLUS_MEMORY_FL_INDEX_MAX - GLUS_MEMORY_FL_INDEX_SHIFT + 2)
+
+// Flags stored in the lower bits of the block size.
+#define GLUS_MEMORY_BLOCK_FREE 0x1
+#define GLUS_MEMORY_BLOCK_PREVIOUS_FREE 0x2
+#define GLUS_MEMORY_BLOCK_FLAGS (GLUS_MEMORY_BLOCK_FREE | GLUS_MEMORY_BLOCK_PREVIOUS_FREE)
 
 /**
- * Structure for the memory table entry.
+ * Header in front of every block.
  */
-typedef struct _GLUSmemoryTable
+typedef struct _GLUSmemoryBlock
 {
-
     /**
-     * Flag, if entry is valid and/or free.
+     * Physically previous block. Only valid, if the previous block is free.
      */
-    GLUSubyte status;
+    struct _GLUSmemoryBlock* previousPhysical;
 
     /**
-     * Start index into the memory.
+     * Size of the usable memory in bytes, including the flags in the lower bits.
      */
-    size_t startIndex;
+    size_t size;
 
-    /**
-     * Length of the indices from the allocated memory.
-     */
-    size_t lengthIndices;
+} GLUSmemoryBlock;
 
-} GLUSmemoryTable;
+/**
+ * Links of a free block. Stored in the usable memory of the block.
+ */
+typedef struct _GLUSmemoryFreeLinks
+{
+    GLUSmemoryBlock* next;
+
+    GLUSmemoryBlock* previous;
+
+} GLUSmemoryFreeLinks;
 
 /**
- * Available memory with given data type.
+ * Available memory. Aligned at runtime.
  */
-static GLUS_MEMORY_DATA_TYPE g_memory[GLUS_MEMORY_SIZE];
+static GLUSuint64 g_memory[(GLUS_MEMORY_HEAP_SIZE + GLUS_MEMORY_ALIGNMENT) / sizeof(GLUSuint64)];
+
+static GLUSubyte* g_memoryStart = 0;
+static GLUSubyte* g_memoryEnd   = 0;
 
 /**
- * Memory table used to manage the memory array.
+ * Bitmaps of the non empty free lists.
  */
-static GLUSmemoryTable g_memoryTable[GLUS_MEMORY_TABLE_ENTRIES] = {{GLUS_VALID_AND_FREE, 0, GLUS_MEMORY_SIZE}};
+static GLUSuint g_memoryFirstLevelBitmap = 0;
+static GLUSuint g_memorySecondLevelBitmap[GLUS_MEMORY_FL_INDEX_COUNT];
 
 /**
- * Current amount of initialized memory table entries.
+ * Heads of the free lists.
  */
-static size_t g_memoryTableEntries = 1;
+static GLUSmemoryBlock* g_memoryFreeLists[GLUS_MEMORY_FL_INDEX_COUNT][GLUS_MEMORY_SL_INDEX_COUNT];
 
-static GLUSboolean glusMemoryInitTableEntry(size_t startIndex, size_t lengthIndices)
+static GLUSint glusMemoryFindLastSet(GLUSuint value)
 {
-    size_t tableIndex = 0;
-
-    //
+    GLUSint bit = 0;
 
-    while (tableIndex < g_memoryTableEntries)
+    if (!value)
     {
-        // If not valid, the table entry can be reused.
-        if (g_memoryTable[tableIndex].status == GLUS_INVALID)
-        {
-            break;
-        }
-
-        tableIndex++;
+        return -1;
     }
 
-    if (tableIndex >= GLUS_MEMORY_TABLE_ENTRIES)
+    if (value & 0xFFFF0000)
+    {
+        value >>= 16;
+        bit += 16;
+    }
+    if (value & 0xFF00)
+    {
+        value >>= 8;
+        bit += 8;
+    }
+    if (value & 0xF0)
+    {
+        value >>= 4;
+        bit += 4;
+    }
+    if (value & 0xC)
+    {
+        value >>= 2;
+        bit += 2;
+    }
+    if (value & 0x2)
     {
-        return GLUS_FALSE;
+        bit += 1;
     }
 
-    //
+    return bit;
+}
 
-    g_memoryTable[tableIndex].status        = GLUS_VALID_AND_FREE;
-    g_memoryTable[tableIndex].startIndex    = startIndex;
-    g_memoryTable[tableIndex].lengthIndices = lengthIndices;
+static GLUSint glusMemoryFindFirstSet(GLUSuint value)
+{
+    return glusMemoryFindLastSet(value & (~value + 1));
+}
+
+static size_t glusMemoryGetSize(const GLUSmemoryBlock* block)
+{
+    return block->size & ~(size_t)GLUS_MEMORY_BLOCK_FLAGS;
+}
+
+static GLUSvoid* glusMemoryGetPointer(const GLUSmemoryBlock* block)
+{
+    return (GLUSvoid*)((GLUSubyte*)block + GLUS_MEMORY_HEADER_SIZE);
+}
 
-    if (tableIndex == g_memoryTableEntries)
+static GLUSmemoryBlock* glusMemoryGetBlock(const GLUSvoid* pointer)
+{
+    return (GLUSmemoryBlock*)((GLUSubyte*)pointer - GLUS_MEMORY_HEADER_SIZE);
+}
+
+static GLUSmemoryFreeLinks* glusMemoryGetLinks(const GLUSmemoryBlock* block)
+{
+    return (GLUSmemoryFreeLinks*)glusMemoryGetPointer(block);
+}
+
+static GLUSmemoryBlock* glusMemoryGetNextPhysical(const GLUSmemoryBlock* block)
+{
+    return (GLUSmemoryBlock*)((GLUSubyte*)glusMemoryGetPointer(block) + glusMemoryGetSize(block));
+}
+
+/**
+ * Calculates the first and second level index of a block size.
+ */
+static GLUSvoid glusMemoryMapping(size_t size, GLUSint* firstLevel, GLUSint* secondLevel)
+{
+    if (size < GLUS_MEMORY_SMALL_BLOCK_SIZE)
     {
-        g_memoryTableEntries++;
+        *firstLevel  = 0;
+        *secondLevel = (GLUSint)(size / (GLUS_MEMORY_SMALL_BLOCK_SIZE / GLUS_MEMORY_SL_INDEX_COUNT));
     }
+    else
+    {
+        GLUSint lastSet = glusMemoryFindLastSet((GLUSuint)size);
 
-    return GLUS_TRUE;
+        *secondLevel = (GLUSint)(size >> (lastSet - GLUS_MEMORY_SL_INDEX_COUNT_LOG2)) ^ GLUS_MEMORY_SL_INDEX_COUNT;
+        *firstLevel  = lastSet - (GLUS_MEMORY_FL_INDEX_SHIFT - 1);
+    }
 }
 
-static GLUSvoid glusMemoryGarbageCollect()
+static GLUSvoid glusMemoryInsertFreeBlock(GLUSmemoryBlock* block)
 {
-    GLUSboolean continueGC = GLUS_TRUE;
+    GLUSint firstLevel, secondLevel;
 
-    // Do garbage collection, until no memory has been merged.
-    while (continueGC)
+    GLUSmemoryFreeLinks* links = glusMemoryGetLinks(block);
+
+    glusMemoryMapping(glusMemoryGetSize(block), &firstLevel, &secondLevel);
+
+    links->next     = g_memoryFreeLists[firstLevel][secondLevel];
+    links->previous = 0;
+
+    if (links->next)
     {
-        GLUSuint tableIndex = 0;
+        glusMemoryGetLinks(links->next)->previous = block;
+    }
 
-        continueGC = GLUS_FALSE;
+    g_memoryFreeLists[firstLevel][secondLevel] = block;
 
-        while (tableIndex < g_memoryTableEntries)
-        {
-            if (g_memoryTable[tableIndex].status == GLUS_VALID_AND_FREE)
-            {
-                GLUSuint otherTableIndex = 0;
+    g_memoryFirstLevelBitmap |= 1u << firstLevel;
+    g_memorySecondLevelBitmap[firstLevel] |= 1u << secondLevel;
+}
 
-                while (otherTableIndex < g_memoryTableEntries)
-                {
-                    if (otherTableIndex == tableIndex)
-                    {
-                        otherTableIndex++;
+static GLUSvoid glusMemoryRemoveFreeBlock(GLUSmemoryBlock* block)
+{
+    GLUSint firstLevel, secondLevel;
 
-                        continue;
-                    }
+    GLUSmemoryFreeLinks* links = glusMemoryGetLinks(block);
 
-                    if (g_memoryTable[otherTableIndex].status == GLUS_VALID_AND_FREE)
-                    {
-                        // Check, if two entries are adjacent.
-                        if (g_memoryTable[tableIndex].startIndex + g_memoryTable[tableIndex].lengthIndices == g_memoryTable[otherTableIndex].startIndex)
-                        {
-                            g_memoryTable[tableIndex].lengthIndices += g_memoryTable[otherTableIndex].lengthIndices;
+    glusMemoryMapping(glusMemoryGetSize(block), &firstLevel, &secondLevel);
 
-                            g_memoryTable[otherTableIndex].status = GLUS_INVALID;
+    if (links->next)
+    {
+        glusMemoryGetLinks(links->next)->previous = links->previous;
+    }
 
-                            // Continue to try to merge.
-                            continueGC = GLUS_TRUE;
-                        }
-                    }
+    if (links->previous)
+    {
+        glusMemoryGetLinks(links->previous)->next = links->next;
+    }
+    else
+    {
+        g_memoryFreeLists[firstLevel][secondLevel] = links->next;
 
-                    otherTableIndex++;
-                }
-            }
+        if (!links->next)
+        {
+            g_memorySecondLevelBitmap[firstLevel] &= ~(1u << secondLevel);
 
-            tableIndex++;
+            if (!g_memorySecondLevelBitmap[firstLevel])
+            {
+                g_memoryFirstLevelBitmap &= ~(1u << firstLevel);
+            }
         }
     }
 }
 
-static void* glusMemoryInternalMalloc(size_t size)
+/**
+ * Marks a block as free or used, also in the flags of the following block.
+ */
+static GLUSvoid glusMemorySetFree(GLUSmemoryBlock* block, const GLUSboolean isFree)
 {
-    GLUSuint tableIndex = 0;
+    GLUSmemoryBlock* next = glusMemoryGetNextPhysical(block);
 
-    // Calculate needed indecies.
-    size_t lengthIndices = size % GLUS_MEMORY_DATA_SIZE == 0 ? (size / GLUS_MEMORY_DATA_SIZE) : (size / GLUS_MEMORY_DATA_SIZE + 1);
-
-    size_t alignmentIndicesRest = lengthIndices % GLUS_MEMORY_DATAT_ALIGNMENT_FACTOR;
+    if (isFree)
+    {
+        block->size |= GLUS_MEMORY_BLOCK_FREE;
 
-    // Needed for overflow of lengthIndices.
-    if (lengthIndices * GLUS_MEMORY_DATA_SIZE < size)
+        next->size |= GLUS_MEMORY_BLOCK_PREVIOUS_FREE;
+        next->previousPhysical = block;
+    }
+    else
     {
-        return 0;
+        block->size &= ~(size_t)GLUS_MEMORY_BLOCK_FREE;
+
+        next->size &= ~(size_t)GLUS_MEMORY_BLOCK_PREVIOUS_FREE;
     }
+}
+
+static GLUSvoid glusMemoryInit(GLUSvoid)
+{
+    GLUSmemoryBlock* block;
+    GLUSmemoryBlock* sentinel;
+
+    g_memoryStart = (GLUSubyte*)(((uintptr_t)g_memory + GLUS_MEMORY_ALIGNMENT - 1) & ~(uintptr_t)(GLUS_MEMORY_ALIGNMENT - 1));
+    g_memoryEnd   = g_memoryStart + (GLUS_MEMORY_HEAP_SIZE & ~(GLUS_MEMORY_ALIGNMENT - 1));
+
+    // One free block covering the heap, followed by a used sentinel block of size zero, which stops merging.
+
+    block = (GLUSmemoryBlock*)g_memoryStart;
+
+    block->previousPhysical = 0;
+    block->size             = (size_t)(g_memoryEnd - g_memoryStart) - 2 * GLUS_MEMORY_HEADER_SIZE;
+
+    sentinel = glusMemoryGetNextPhysical(block);
+
+    sentinel->previousPhysical = 0;
+    sentinel->size             = 0;
+
+    glusMemorySetFree(block, GLUS_TRUE);
+
+    glusMemoryInsertFreeBlock(block);
+}
+
+/**
+ * Finds a free block with at least the given size. The size is rounded up to the next list, so every block in the found list fits.
+ */
+static GLUSmemoryBlock* glusMemoryFindFreeBlock(size_t size)
+{
+    GLUSint firstLevel, secondLevel;
+
+    GLUSuint secondLevelMap;
 
-    // Test an adjust alignment.
-    if (alignmentIndicesRest != 0)
+    if (size >= GLUS_MEMORY_SMALL_BLOCK_SIZE)
     {
-        lengthIndices += GLUS_MEMORY_DATAT_ALIGNMENT_FACTOR - alignmentIndicesRest;
+        size += ((size_t)1 << (glusMemoryFindLastSet((GLUSuint)size) - GLUS_MEMORY_SL_INDEX_COUNT_LOG2)) - 1;
     }
 
-    while (tableIndex < g_memoryTableEntries)
+    glusMemoryMapping(size, &firstLevel, &secondLevel);
+
+    if (firstLevel >= GLUS_MEMORY_FL_INDEX_COUNT)
     {
-        // Search for a memory table entry, where the size fits in.
-        if (g_memoryTable[tableIndex].status == GLUS_VALID_AND_FREE && g_memoryTable[tableIndex].lengthIndices >= lengthIndices)
-        {
-            // Is a split needed?
-            if (lengthIndices < g_memoryTable[tableIndex].lengthIndices)
-            {
-                // Assign the rest of the available memory to another table entry.
-                if (!glusMemoryInitTableEntry(g_memoryTable[tableIndex].startIndex + lengthIndices, g_memoryTable[tableIndex].lengthIndices - lengthIndices))
-                {
-                    // No empty entry could be found, so do not split and use all memory.
-                    lengthIndices = g_memoryTable[tableIndex].lengthIndices;
-                }
-            }
+        return 0;
+    }
+
+    secondLevelMap = g_memorySecondLevelBitmap[firstLevel] & (~0u << secondLevel);
 
-            // Entry now manages the requested memory.
-            g_memoryTable[tableIndex].status        = GLUS_VALID_AND_LOCKED;
-            g_memoryTable[tableIndex].lengthIndices = lengthIndices;
+    if (!secondLevelMap)
+    {
+        GLUSuint firstLevelMap = (firstLevel + 1 < 32) ? g_memoryFirstLevelBitmap & (~0u << (firstLevel + 1)) : 0;
 
-            return (void*)&g_memory[g_memoryTable[tableIndex].startIndex];
+        if (!firstLevelMap)
+        {
+            return 0;
         }
 
-        tableIndex++;
+        firstLevel = glusMemoryFindFirstSet(firstLevelMap);
+
+        secondLevelMap = g_memorySecondLevelBitmap[firstLevel];
     }
 
-    return 0;
+    secondLevel = glusMemoryFindFirstSet(secondLevelMap);
+
+    return g_memoryFreeLists[firstLevel][secondLevel];
 }
 
 //
 
+// With statistics, the allocations are tracked by glus_memory_statistics.c on top of these functions.
+
+#if defined(GLUS_MEMORY_STATISTICS)
+GLUSvoid* _glusMemoryMallocUntracked(size_t size)
+#else
 void* GLUSAPIENTRY glusMemoryMalloc(size_t size)
+#endif
 {
-    void* pointer = 0;
+    GLUSmemoryBlock* block;
+
+    size_t remainder;
 
     if (size == 0)
     {
-        return pointer;
+        return 0;
     }
 
-    pointer = glusMemoryInternalMalloc(size);
+    if (!g_memoryStart)
+    {
+        glusMemoryInit();
+    }
 
-    // If no memory was allocated ...
-    if (!pointer)
+    if (size > (size_t)(g_memoryEnd - g_memoryStart))
     {
-        // ... do garbage collection ...
-        glusMemoryGarbageCollect();
+        return 0;
+    }
+
+    // The usable memory has to hold the free list links.
+    size = (size + GLUS_MEMORY_ALIGNMENT - 1) & ~(size_t)(GLUS_MEMORY_ALIGNMENT - 1);
 
-        // ... and try to allocate again.
-        pointer = glusMemoryInternalMalloc(size);
+    if (size < sizeof(GLUSmemoryFreeLinks))
+    {
+        size = sizeof(GLUSmemoryFreeLinks);
+    }
+
+    block = glusMemoryFindFreeBlock(size);
+
+    if (!block)
+    {
+        return 0;
     }
 
-    return pointer;
+    glusMemoryRemoveFreeBlock(block);
+
+    // Split, if the rest can be a block on its own.
+    remainder = glusMemoryGetSize(block) - size;
+
+    if (remainder >= GLUS_MEMORY_HEADER_SIZE + GLUS_MEMORY_ALIGNMENT)
+    {
+        GLUSmemoryBlock* rest;
+
+        block->size = size | (block->size & GLUS_MEMORY_BLOCK_FLAGS);
+
+        rest = glusMemoryGetNextPhysical(block);
+
+        rest->size = remainder - GLUS_MEMORY_HEADER_SIZE;
+
+        glusMemorySetFree(rest, GLUS_TRUE);
+
+        glusMemoryInsertFreeBlock(rest);
+    }
+
+    glusMemorySetFree(block, GLUS_FALSE);
+
+    return glusMemoryGetPointer(block);
 }
 
+#if defined(GLUS_MEMORY_STATISTICS)
+GLUSvoid _glusMemoryFreeUntracked(GLUSvoid* pointer)
+#else
 void GLUSAPIENTRY glusMemoryFree(void* pointer)
+#endif
 {
-    GLUSuint tableIndex = 0;
+    GLUSmemoryBlock* block;
+    GLUSmemoryBlock* next;
 
-    if (!pointer)
+    // Only memory of the heap can be freed.
+    if (!pointer || (GLUSubyte*)pointer < g_memoryStart + GLUS_MEMORY_HEADER_SIZE || (GLUSubyte*)pointer >= g_memoryEnd)
     {
         return;
     }
 
-    // Search pointer ...
-    while (tableIndex < g_memoryTableEntries)
+    block = glusMemoryGetBlock(pointer);
+
+    if (block->size & GLUS_MEMORY_BLOCK_FREE)
     {
-        // ... and free memory by setting flag in table entry.
-        if (g_memoryTable[tableIndex].status == GLUS_VALID_AND_LOCKED && (void*)&g_memory[g_memoryTable[tableIndex].startIndex] == pointer)
-        {
-            g_memoryTable[tableIndex].status = GLUS_VALID_AND_FREE;
+        return;
+    }
 
-            return;
-        }
+    // Merge with the previous block.
+    if (block->size & GLUS_MEMORY_BLOCK_PREVIOUS_FREE)
+    {
+        GLUSmemoryBlock* previous = block->previousPhysical;
+
+        glusMemoryRemoveFreeBlock(previous);
 
-        tableIndex++;
+        previous->size += glusMemoryGetSize(block) + GLUS_MEMORY_HEADER_SIZE;
+
+        block = previous;
+    }
+
+    // Merge with the next block. The sentinel is never free.
+    next = glusMemoryGetNextPhysical(block);
+
+    if (next->size & GLUS_MEMORY_BLOCK_FREE)
+    {
+        glusMemoryRemoveFreeBlock(next);
+
+        block->size += glusMemoryGetSize(next) + GLUS_MEMORY_HEADER_SIZE;
     }
+
+    glusMemorySetFree(block, GLUS_TRUE);
+
+    glusMemoryInsertFreeBlock(block);
 }
@@ -0,0 +1,396 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "GL/glus.h"
+
+#if defined(GLUS_MEMORY_STATISTICS)
+
+// The tracked functions are defined in this file.
+#undef glusMemoryMalloc
+
+extern GLUSvoid* _glusMemoryMallocUntracked(size_t size);
+extern GLUSvoid _glusMemoryFreeUntracked(GLUSvoid* pointer);
+
+extern GLUSvoid _glusThreadLock(GLUSvoid);
+extern GLUSvoid _glusThreadUnlock(GLUSvoid);
+
+#define GLUS_MEMORY_MAX_TAGS 256
+
+// Number of allocations, which are listed one by one in the leak report.
+#define GLUS_MEMORY_MAX_REPORTED_LEAKS 64
+
+/**
+ * Header in front of every tracked allocation. All live allocations are linked, so they can be reported.
+ */
+typedef struct _GLUSmemoryHeader
+{
+    struct _GLUSmemoryHeader* next;
+
+    struct _GLUSmemoryHeader* previous;
+
+    size_t size;
+
+    GLUSuint tagIndex;
+
+    GLUSint line;
+
+} GLUSmemoryHeader;
+
+// Header padded, so the returned memory keeps the alignment of the allocator.
+#define GLUS_MEMORY_STATISTICS_HEADER_SIZE ((sizeof(GLUSmemoryHeader) + 15) & ~((size_t)15))
+
+typedef struct _GLUSmemoryTag
+{
+    const GLUSchar* name;
+
+    GLUSmemorystatistics statistics;
+
+} GLUSmemoryTag;
+
+static GLUSmemorystatistics g_memoryStatistics;
+
+static GLUSmemoryTag g_memoryTags[GLUS_MEMORY_MAX_TAGS];
+
+static GLUSuint g_memoryNumberTags = 0;
+
+static GLUSmemoryHeader* g_memoryLiveAllocations = 0;
+
+static GLUSboolean g_memoryReportRegistered = GLUS_FALSE;
+
+static GLUSuint glusMemoryGetHistogramIndex(size_t size)
+{
+    GLUSuint index = 0;
+
+    while (size > 1 && index < GLUS_MEMORY_HISTOGRAM_SIZE - 1)
+    {
+        size >>= 1;
+
+        index++;
+    }
+
+    return index;
+}
+
+static GLUSvoid glusMemoryAddAllocation(GLUSmemorystatistics* statistics, const size_t size, const GLUSuint histogramIndex)
+{
+    statistics->liveBytes += size;
+
+    if (statistics->liveBytes > statistics->peakBytes)
+    {
+        statistics->peakBytes = statistics->liveBytes;
+    }
+
+    statistics->liveAllocations++;
+    statistics->totalAllocations++;
+
+    statistics->histogram[histogramIndex]++;
+}
+
+static GLUSvoid glusMemoryRemoveAllocation(GLUSmemorystatistics* statistics, const size_t size)
+{
+    statistics->liveBytes -= size;
+
+    statistics->liveAllocations--;
+}
+
+/**
+ * Finds or adds the tag. Only the file name of a path is used. If there are too many tags, the last one collects the rest.
+ */
+static GLUSuint glusMemoryFindTag(const GLUSchar* tag)
+{
+    const GLUSchar* walker;
+
+    GLUSuint i;
+
+    if (!tag)
+    {
+        tag = "unknown";
+    }
+
+    for (walker = tag; *walker; walker++)
+    {
+        if (*walker == '/' || *walker == '\\')
+        {
+            tag = walker + 1;
+        }
+    }
+
+    for (i = 0; i < g_memoryNumberTags; i++)
+    {
+        if (g_memoryTags[i].name == tag || strcmp(g_memoryTags[i].name, tag) == 0)
+        {
+            return i;
+        }
+    }
+
+    if (g_memoryNumberTags == GLUS_MEMORY_MAX_TAGS)
+    {
+        return GLUS_MEMORY_MAX_TAGS - 1;
+    }
+
+    if (g_memoryNumberTags == GLUS_MEMORY_MAX_TAGS - 1)
+    {
+        tag = "other";
+    }
+
+    g_memoryTags[g_memoryNumberTags].name = tag;
+
+    g_memoryNumberTags++;
+
+    return g_memoryNumberTags - 1;
+}
+
+static GLUSvoid glusMemoryReportLeaksAtExit(GLUSvoid)
+{
+    glusMemoryReportLeaks();
+}
+
+GLUSvoid* GLUSAPIENTRY glusMemoryMallocTagged(size_t size, const GLUSchar* tag, const GLUSint line)
+{
+    GLUSmemoryHeader* header;
+
+    GLUSuint histogramIndex;
+
+    if (size > ((size_t)-1) - GLUS_MEMORY_STATISTICS_HEADER_SIZE)
+    {
+        return 0;
+    }
+
+    header = (GLUSmemoryHeader*)_glusMemoryMallocUntracked(GLUS_MEMORY_STATISTICS_HEADER_SIZE + size);
+
+    if (!header)
+    {
+        return 0;
+    }
+
+    header->previous = 0;
+    header->size     = size;
+    header->line     = line;
+
+    histogramIndex = glusMemoryGetHistogramIndex(size);
+
+    _glusThreadLock();
+
+    header->tagIndex = glusMemoryFindTag(tag);
+
+    header->next = g_memoryLiveAllocations;
+
+    if (g_memoryLiveAllocations)
+    {
+        g_memoryLiveAllocations->previous = header;
+    }
+
+    g_memoryLiveAllocations = header;
+
+    glusMemoryAddAllocation(&g_memoryStatistics, size, histogramIndex);
+    glusMemoryAddAllocation(&g_memoryTags[header->tagIndex].statistics, size, histogramIndex);
+
+    if (!g_memoryReportRegistered)
+    {
+        g_memoryReportRegistered = GLUS_TRUE;
+
+        atexit(glusMemoryReportLeaksAtExit);
+    }
+
+    _glusThreadUnlock();
+
+    return (GLUSubyte*)header + GLUS_MEMORY_STATISTICS_HEADER_SIZE;
+}
+
+void* GLUSAPIENTRY glusMemoryMalloc(size_t size)
+{
+    return glusMemoryMallocTagged(size, "unknown", 0);
+}
+
+void GLUSAPIENTRY glusMemoryFree(void* pointer)
+{
+    GLUSmemoryHeader* header;
+
+    if (!pointer)
+    {
+        return;
+    }
+
+    header = (GLUSmemoryHeader*)((GLUSubyte*)pointer - GLUS_MEMORY_STATISTICS_HEADER_SIZE);
+
+    _glusThreadLock();
+
+    if (header->previous)
+    {
+        header->previous->next = header->next;
+    }
+    else
+    {
+        g_memoryLiveAllocations = header->next;
+    }
+
+    if (header->next)
+    {
+        header->next->previous = header->previous;
+    }
+
+    glusMemoryRemoveAllocation(&g_memoryStatistics, header->size);
+    glusMemoryRemoveAllocation(&g_memoryTags[header->tagIndex].statistics, header->size);
+
+    _glusThreadUnlock();
+
+    _glusMemoryFreeUntracked(header);
+}
+
+GLUSboolean GLUSAPIENTRY glusMemoryGetStatistics(GLUSmemorystatistics* statistics)
+{
+    if (!statistics)
+    {
+        return GLUS_FALSE;
+    }
+
+    _glusThreadLock();
+
+    *statistics = g_memoryStatistics;
+
+    _glusThreadUnlock();
+
+    return GLUS_TRUE;
+}
+
+GLUSuint GLUSAPIENTRY glusMemoryGetNumberTags(GLUSvoid)
+{
+    GLUSuint numberTags;
+
+    _glusThreadLock();
+
+    numberTags = g_memoryNumberTags;
+
+    _glusThreadUnlock();
+
+    return numberTags;
+}
+
+GLUSboolean GLUSAPIENTRY glusMemoryGetTagStatistics(const GLUSuint index, const GLUSchar** tag, GLUSmemorystatistics* statistics)
+{
+    GLUSboolean result = GLUS_FALSE;
+
+    _glusThreadLock();
+
+    if (index < g_memoryNumberTags)
+    {
+        if (tag)
+        {
+            *tag = g_memoryTags[index].name;
+        }
+
+        if (statistics)
+        {
+            *statistics = g_memoryTags[index].statistics;
+        }
+
+        result = GLUS_TRUE;
+    }
+
+    _glusThreadUnlock();
+
+    return result;
+}
+
+GLUSuint GLUSAPIENTRY glusMemoryReportLeaks(GLUSvoid)
+{
+    GLUSmemoryHeader* walker;
+
+    GLUSuint numberLeaks;
+    GLUSuint i;
+
+    _glusThreadLock();
+
+    numberLeaks = (GLUSuint)g_memoryStatistics.liveAllocations;
+
+    if (numberLeaks > 0)
+    {
+        glusLogPrint(GLUS_LOG_WARNING, "Memory: %u allocations with %lu bytes not freed", numberLeaks, (unsigned long)g_memoryStatistics.liveBytes);
+
+        for (i = 0; i < g_memoryNumberTags; i++)
+        {
+            if (g_memoryTags[i].statistics.liveAllocations > 0)
+            {
+                glusLogPrint(GLUS_LOG_WARNING, "  %s: %lu allocations with %lu bytes", g_memoryTags[i].name, (unsigned long)g_memoryTags[i].statistics.liveAllocations, (unsigned long)g_memoryTags[i].statistics.liveBytes);
+            }
+        }
+
+        walker = g_memoryLiveAllocations;
+
+        for (i = 0; walker && i < GLUS_MEMORY_MAX_REPORTED_LEAKS; i++)
+        {
+            glusLogPrint(GLUS_LOG_WARNING, "  %s:%d: %lu bytes", g_memoryTags[walker->tagIndex].name, walker->line, (unsigned long)walker->size);
+
+            walker = walker->next;
+        }
+
+        if (walker)
+        {
+            glusLogPrint(GLUS_LOG_WARNING, "  ... and %u more", numberLeaks - GLUS_MEMORY_MAX_REPORTED_LEAKS);
+        }
+    }
+
+    _glusThreadUnlock();
+
+    return numberLeaks;
+}
+
+#else
+
+GLUSvoid* GLUSAPIENTRY glusMemoryMallocTagged(size_t size, const GLUSchar* tag, const GLUSint line)
+{
+    (void)tag;
+    (void)line;
+
+    return glusMemoryMalloc(size);
+}
+
+GLUSboolean GLUSAPIENTRY glusMemoryGetStatistics(GLUSmemorystatistics* statistics)
+{
+    if (statistics)
+    {
+        memset(statistics, 0, sizeof(GLUSmemorystatistics));
+    }
+
+    return GLUS_FALSE;
+}
+
+GLUSuint GLUSAPIENTRY glusMemoryGetNumberTags(GLUSvoid)
+{
+    return 0;
+}
+
+GLUSboolean GLUSAPIENTRY glusMemoryGetTagStatistics(const GLUSuint index, const GLUSchar** tag, GLUSmemorystatistics* statistics)
+{
+    (void)index;
+    (void)tag;
+    (void)statistics;
+
+    return GLUS_FALSE;
+}
+
+GLUSuint GLUSAPIENTRY glusMemoryReportLeaks(GLUSvoid)
+{
+    return 0;
+}
+
+#endif
@@ -104,6 +104,8 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise1D(GLUStgaimage* image, const GLUS
     GLUSfloat* data;
     GLUSint*   data1D;
 
+    GLUSmemoryArena scratch;
+
     GLUSfloat frequencyFactor;
     GLUSfloat amplitudeFactor;
 
@@ -117,11 +119,12 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise1D(GLUStgaimage* image, const GLUS
         return GLUS_FALSE;
     }
 
-    image->width  = (GLUSushort)width;
-    image->height = 1;
-    image->depth  = 1;
-    image->format = GLUS_SINGLE_CHANNEL;
-    image->data   = glusMemoryMalloc(width * sizeof(GLUSubyte));
+    image->width       = (GLUSushort)width;
+    image->height      = 1;
+    image->depth       = 1;
+    image->format      = GLUS_SINGLE_CHANNEL;
+    image->data        = glusMemoryMallocAligned(width * sizeof(GLUSubyte), GLUS_MEMORY_DATA_ALIGNMENT);
+    image->alignedData = image->data;
 
     if (!image->data)
     {
@@ -130,12 +133,17 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise1D(GLUStgaimage* image, const GLUS
         return GLUS_FALSE;
     }
 
-    data = glusMemoryMalloc(width * sizeof(GLUSfloat));
+    // Both scratch arrays are taken from one memory block.
+    glusMemoryArenaBegin(&scratch, width * (sizeof(GLUSfloat) + sizeof(GLUSint)) + 2 * GLUS_MEMORY_ARENA_ALIGNMENT);
+
+    data = (GLUSfloat*)glusMemoryArenaAlloc(&scratch, width * sizeof(GLUSfloat));
 
     if (!data)
     {
         glusImageDestroyTga(image);
 
+        glusMemoryArenaEnd(&scratch);
+
         return GLUS_FALSE;
     }
 
@@ -146,13 +154,13 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise1D(GLUStgaimage* image, const GLUS
 
     //
 
-    data1D = glusMemoryMalloc(width * sizeof(GLUSint));
+    data1D = (GLUSint*)glusMemoryArenaAlloc(&scratch, width * sizeof(GLUSint));
 
     if (!data1D)
     {
         glusImageDestroyTga(image);
 
-        glusMemoryFree(data);
+        glusMemoryArenaEnd(&scratch);
 
         return GLUS_FALSE;
     }
@@ -215,14 +223,12 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise1D(GLUStgaimage* image, const GLUS
         amplitudeFactor *= 1.0f / persistence;
     }
 
-    glusMemoryFree(data1D);
-
     for (i = 0; i < width; i++)
     {
         image->data[i] = (GLUSubyte)data[i];
     }
 
-    glusMemoryFree(data);
+    glusMemoryArenaEnd(&scratch);
 
     return GLUS_TRUE;
 }
@@ -234,6 +240,8 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise2D(GLUStgaimage* image, const GLUS
     GLUSfloat* data;
     GLUSint*   data2D;
 
+    GLUSmemoryArena scratch;
+
     GLUSfloat frequencyFactor;
     GLUSfloat amplitudeFactor;
 
@@ -247,11 +255,12 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise2D(GLUStgaimage* image, const GLUS
         return GLUS_FALSE;
     }
 
-    image->width  = (GLUSushort)width;
-    image->height = (GLUSushort)height;
-    image->depth  = 1;
-    image->format = GLUS_SINGLE_CHANNEL;
-    image->data   = glusMemoryMalloc(width * height * sizeof(GLUSubyte));
+    image->width       = (GLUSushort)width;
+    image->height      = (GLUSushort)height;
+    image->depth       = 1;
+    image->format      = GLUS_SINGLE_CHANNEL;
+    image->data        = glusMemoryMallocAligned(width * height * sizeof(GLUSubyte), GLUS_MEMORY_DATA_ALIGNMENT);
+    image->alignedData = image->data;
 
     if (!image->data)
     {
@@ -260,12 +269,17 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise2D(GLUStgaimage* image, const GLUS
         return GLUS_FALSE;
     }
 
-    data = glusMemoryMalloc(width * height * sizeof(GLUSfloat));
+    // Both scratch arrays are taken from one memory block.
+    glusMemoryArenaBegin(&scratch, width * height * (sizeof(GLUSfloat) + sizeof(GLUSint)) + 2 * GLUS_MEMORY_ARENA_ALIGNMENT);
+
+    data = (GLUSfloat*)glusMemoryArenaAlloc(&scratch, width * height * sizeof(GLUSfloat));
 
     if (!data)
     {
         glusImageDestroyTga(image);
 
+        glusMemoryArenaEnd(&scratch);
+
         return GLUS_FALSE;
     }
 
@@ -276,13 +290,13 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise2D(GLUStgaimage* image, const GLUS
 
     //
 
-    data2D = glusMemoryMalloc(width * height * sizeof(GLUSint));
+    data2D = (GLUSint*)glusMemoryArenaAlloc(&scratch, width * height * sizeof(GLUSint));
 
     if (!data2D)
     {
         glusImageDestroyTga(image);
 
-        glusMemoryFree(data);
+        glusMemoryArenaEnd(&scratch);
 
         return GLUS_FALSE;
     }
@@ -363,14 +377,12 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise2D(GLUStgaimage* image, const GLUS
         amplitudeFactor *= 1.0f / persistence;
     }
 
-    glusMemoryFree(data2D);
-
     for (i = 0; i < width * height; i++)
     {
         image->data[i] = (GLUSubyte)data[i];
     }
 
-    glusMemoryFree(data);
+    glusMemoryArenaEnd(&scratch);
 
     return GLUS_TRUE;
 }
@@ -382,6 +394,8 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise3D(GLUStgaimage* image, const GLUS
     GLUSfloat* data;
     GLUSint*   data3D;
 
+    GLUSmemoryArena scratch;
+
     GLUSfloat frequencyFactor;
     GLUSfloat amplitudeFactor;
 
@@ -395,11 +409,12 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise3D(GLUStgaimage* image, const GLUS
         return GLUS_FALSE;
     }
 
-    image->width  = (GLUSushort)width;
-    image->height = (GLUSushort)height;
-    image->depth  = (GLUSushort)depth;
-    image->format = GLUS_SINGLE_CHANNEL;
-    image->data   = glusMemoryMalloc(width * height * depth * sizeof(GLUSubyte));
+    image->width       = (GLUSushort)width;
+    image->height      = (GLUSushort)height;
+    image->depth       = (GLUSushort)depth;
+    image->format      = GLUS_SINGLE_CHANNEL;
+    image->data        = glusMemoryMallocAligned(width * height * depth * sizeof(GLUSubyte), GLUS_MEMORY_DATA_ALIGNMENT);
+    image->alignedData = image->data;
 
     if (!image->data)
     {
@@ -408,12 +423,17 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise3D(GLUStgaimage* image, const GLUS
         return GLUS_FALSE;
     }
 
-    data = glusMemoryMalloc(width * height * depth * sizeof(GLUSfloat));
+    // Both scratch arrays are taken from one memory block.
+    glusMemoryArenaBegin(&scratch, width * height * depth * (sizeof(GLUSfloat) + sizeof(GLUSint)) + 2 * GLUS_MEMORY_ARENA_ALIGNMENT);
+
+    data = (GLUSfloat*)glusMemoryArenaAlloc(&scratch, width * height * depth * sizeof(GLUSfloat));
 
     if (!data)
     {
         glusImageDestroyTga(image);
 
+        glusMemoryArenaEnd(&scratch);
+
         return GLUS_FALSE;
     }
 
@@ -424,13 +444,13 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise3D(GLUStgaimage* image, const GLUS
 
     //
 
-    data3D = glusMemoryMalloc(width * height * depth * sizeof(GLUSint));
+    data3D = (GLUSint*)glusMemoryArenaAlloc(&scratch, width * height * depth * sizeof(GLUSint));
 
     if (!data3D)
     {
         glusImageDestroyTga(image);
 
-        glusMemoryFree(data);
+        glusMemoryArenaEnd(&scratch);
 
         return GLUS_FALSE;
     }
@@ -534,14 +554,12 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise3D(GLUStgaimage* image, const GLUS
         amplitudeFactor *= 1.0f / persistence;
     }
 
-    glusMemoryFree(data3D);
-
     for (i = 0; i < width * height * depth; i++)
     {
         image->data[i] = (GLUSubyte)data[i];
     }
 
-    glusMemoryFree(data);
+    glusMemoryArenaEnd(&scratch);
 
     return GLUS_TRUE;
 }
@@ -22,6 +22,21 @@
 
 #include "GL/glus.h"
 
+GLUSfloat* GLUSAPIENTRY glusRaytraceCreateBufferf(const GLUSint numberComponents, const GLUSint width, const GLUSint height)
+{
+    if (numberComponents <= 0 || width <= 0 || height <= 0)
+    {
+        return 0;
+    }
+
+    return (GLUSfloat*)glusMemoryMallocAligned((size_t)numberComponents * width * height * sizeof(GLUSfloat), GLUS_MEMORY_DATA_ALIGNMENT);
+}
+
+GLUSvoid GLUSAPIENTRY glusRaytraceDestroyBufferf(GLUSfloat* buffer)
+{
+    glusMemoryFreeAligned(buffer);
+}
+
 GLUSboolean GLUSAPIENTRY glusRaytracePerspectivef(GLUSfloat* directionBuffer, const GLUSubyte padding, const GLUSfloat fovy, const GLUSint width, const GLUSint height)
 {
     GLUSint i, k;
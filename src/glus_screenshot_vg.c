@@ -48,7 +48,8 @@ GLUSboolean GLUSAPIENTRY glusScreenshotCreateTga(GLUSint x, GLUSint y, GLUSsizei
         return GLUS_FALSE;
     }
 
-    screenshot->data = (GLUSubyte*)glusMemoryMalloc(width * height * 4);
+    screenshot->data        = (GLUSubyte*)glusMemoryMallocAligned(width * height * 4, GLUS_MEMORY_DATA_ALIGNMENT);
+    screenshot->alignedData = screenshot->data;
     if (!screenshot->data)
     {
         return GLUS_FALSE;
@@ -71,7 +71,8 @@ static GLUSboolean glusShapeFinalizef(GLUSshape* shape)
 
     //
 
-    shape->allAttributes = (GLUSfloat*)glusMemoryMalloc(stride * shape->numberVertices * sizeof(GLUSfloat));
+    shape->allAttributes     = (GLUSfloat*)glusMemoryMallocAligned(stride * shape->numberVertices * sizeof(GLUSfloat), GLUS_MEMORY_DATA_ALIGNMENT);
+    shape->alignedAttributes = shape->allAttributes;
 
     if (!shape->allAttributes)
     {
@@ -1537,7 +1538,8 @@ GLUSboolean GLUSAPIENTRY glusShapeCopyf(GLUSshape* shape, const GLUSshape* sourc
     }
     if (source->allAttributes)
     {
-        shape->allAttributes = (GLUSfloat*)glusMemoryMalloc(stride * source->numberVertices * sizeof(GLUSfloat));
+        shape->allAttributes     = (GLUSfloat*)glusMemoryMallocAligned(stride * source->numberVertices * sizeof(GLUSfloat), GLUS_MEMORY_DATA_ALIGNMENT);
+        shape->alignedAttributes = shape->allAttributes;
         if (!shape->allAttributes)
         {
             glusShapeDestroyf(shape);
@@ -1605,11 +1607,20 @@ GLUSvoid GLUSAPIENTRY glusShapeDestroyf(GLUSshape* shape)
 
     if (shape->allAttributes)
     {
-        glusMemoryFree(shape->allAttributes);
+        if (shape->allAttributes == shape->alignedAttributes)
+        {
+            glusMemoryFreeAligned(shape->allAttributes);
+        }
+        else
+        {
+            glusMemoryFree(shape->allAttributes);
+        }
 
         shape->allAttributes = 0;
     }
 
+    shape->alignedAttributes = 0;
+
     if (shape->indices)
     {
         glusMemoryFree(shape->indices);
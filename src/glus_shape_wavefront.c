@@ -22,9 +22,14 @@
 
 #include "GL/glus.h"
 
-extern GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUSwavefront* wavefront, GLUSscene* scene);
+extern GLUSboolean _glusWavefrontParse(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSshape* shape, GLUSwavefront* wavefront, GLUSscene* scene);
 
 GLUSboolean GLUSAPIENTRY glusShapeLoadWavefront(const GLUSchar* filename, GLUSshape* shape)
 {
-    return _glusWavefrontParse(filename, shape, 0, 0);
+    return _glusWavefrontParse(filename, 0, shape, 0, 0);
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeLoadWavefrontWith(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSshape* shape)
+{
+    return _glusWavefrontParse(filename, options, shape, 0, 0);
 }
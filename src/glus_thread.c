@@ -0,0 +1,387 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+// The static heap allocator is not thread safe, so all tasks are executed on the calling thread.
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+
+#elif defined(_WIN32)
+
+#define WIN32_LEAN_AND_MEAN
+
+#include <windows.h>
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GLUS_THREAD_POSIX
+
+#endif
+
+#include "GL/glus.h"
+
+#define GLUS_MAX_THREADS 64
+
+typedef GLUSvoid (*GLUSthreadfunction)(GLUSvoid* data, GLUSuint index);
+
+/**
+ * Work of one thread. The tasks are distributed round robin, so no synchronization is needed.
+ */
+typedef struct _GLUSthreadWork
+{
+    GLUSthreadfunction function;
+
+    GLUSvoid* data;
+
+    GLUSuint firstTask;
+
+    GLUSuint numberTasks;
+
+    GLUSuint stride;
+
+} GLUSthreadWork;
+
+static GLUSvoid glusThreadExecute(const GLUSthreadWork* work)
+{
+    GLUSuint i;
+
+    for (i = work->firstTask; i < work->numberTasks; i += work->stride)
+    {
+        work->function(work->data, i);
+    }
+}
+
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+
+#elif defined(_WIN32)
+
+static DWORD WINAPI glusThreadMain(LPVOID parameter)
+{
+    glusThreadExecute((const GLUSthreadWork*)parameter);
+
+    return 0;
+}
+
+#elif defined(GLUS_THREAD_POSIX)
+
+static GLUSvoid* glusThreadMain(GLUSvoid* parameter)
+{
+    glusThreadExecute((const GLUSthreadWork*)parameter);
+
+    return 0;
+}
+
+#endif
+
+/**
+ * Executes function(data, index) for every index in [0, numberTasks). Up to numberThreads threads are used, including the calling thread.
+ * If a thread can not be created, its tasks are executed on the calling thread. The function returns after all tasks are finished.
+ */
+GLUSvoid _glusThreadRun(GLUSthreadfunction function, GLUSvoid* data, GLUSuint numberTasks, GLUSuint numberThreads)
+{
+    GLUSthreadWork work[GLUS_MAX_THREADS];
+
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+#elif defined(_WIN32)
+    HANDLE threads[GLUS_MAX_THREADS];
+#elif defined(GLUS_THREAD_POSIX)
+    pthread_t   threads[GLUS_MAX_THREADS];
+    GLUSboolean created[GLUS_MAX_THREADS];
+#endif
+
+    GLUSuint i;
+
+    if (!function || numberTasks == 0)
+    {
+        return;
+    }
+
+    if (numberThreads > numberTasks)
+    {
+        numberThreads = numberTasks;
+    }
+
+    if (numberThreads > GLUS_MAX_THREADS)
+    {
+        numberThreads = GLUS_MAX_THREADS;
+    }
+
+    if (numberThreads < 1)
+    {
+        numberThreads = 1;
+    }
+
+    for (i = 0; i < numberThreads; i++)
+    {
+        work[i].function    = function;
+        work[i].data        = data;
+        work[i].firstTask   = i;
+        work[i].numberTasks = numberTasks;
+        work[i].stride      = numberThreads;
+    }
+
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+
+    for (i = 0; i < numberThreads; i++)
+    {
+        glusThreadExecute(&work[i]);
+    }
+
+#elif defined(_WIN32)
+
+    for (i = 1; i < numberThreads; i++)
+    {
+        threads[i] = CreateThread(0, 0, glusThreadMain, &work[i], 0, 0);
+    }
+
+    glusThreadExecute(&work[0]);
+
+    for (i = 1; i < numberThreads; i++)
+    {
+        if (threads[i])
+        {
+            WaitForSingleObject(threads[i], INFINITE);
+
+            CloseHandle(threads[i]);
+        }
+        else
+        {
+            glusThreadExecute(&work[i]);
+        }
+    }
+
+#elif defined(GLUS_THREAD_POSIX)
+
+    for (i = 1; i < numberThreads; i++)
+    {
+        created[i] = (pthread_create(&threads[i], 0, glusThreadMain, &work[i]) == 0);
+    }
+
+    glusThreadExecute(&work[0]);
+
+    for (i = 1; i < numberThreads; i++)
+    {
+        if (created[i])
+        {
+            pthread_join(threads[i], 0);
+        }
+        else
+        {
+            glusThreadExecute(&work[i]);
+        }
+    }
+
+#else
+
+    for (i = 0; i < numberThreads; i++)
+    {
+        glusThreadExecute(&work[i]);
+    }
+
+#endif
+}
+
+/**
+ * Thread running in the background, started by _glusThreadStart.
+ */
+typedef struct _GLUSthread
+{
+    GLUSthreadWork work;
+
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+#elif defined(_WIN32)
+    HANDLE thread;
+#elif defined(GLUS_THREAD_POSIX)
+    pthread_t thread;
+#endif
+
+} GLUSthread;
+
+/**
+ * Starts function(data, 0) on a new thread and returns immediately. The returned thread has to be passed to _glusThreadJoin.
+ * If no thread can be created, 0 is returned and the caller has to execute the function itself.
+ */
+GLUSvoid* _glusThreadStart(GLUSthreadfunction function, GLUSvoid* data)
+{
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+    (void)function;
+    (void)data;
+
+    return 0;
+#elif defined(_WIN32) || defined(GLUS_THREAD_POSIX)
+    GLUSthread* thread;
+
+    if (!function)
+    {
+        return 0;
+    }
+
+    thread = (GLUSthread*)glusMemoryMalloc(sizeof(GLUSthread));
+
+    if (!thread)
+    {
+        return 0;
+    }
+
+    thread->work.function    = function;
+    thread->work.data        = data;
+    thread->work.firstTask   = 0;
+    thread->work.numberTasks = 1;
+    thread->work.stride      = 1;
+
+#if defined(_WIN32)
+    thread->thread = CreateThread(0, 0, glusThreadMain, &thread->work, 0, 0);
+
+    if (!thread->thread)
+    {
+        glusMemoryFree(thread);
+
+        return 0;
+    }
+#else
+    if (pthread_create(&thread->thread, 0, glusThreadMain, &thread->work) != 0)
+    {
+        glusMemoryFree(thread);
+
+        return 0;
+    }
+#endif
+
+    return thread;
+#else
+    (void)function;
+    (void)data;
+
+    return 0;
+#endif
+}
+
+/**
+ * Waits until a thread started by _glusThreadStart is finished and frees it.
+ */
+GLUSvoid _glusThreadJoin(GLUSvoid* thread)
+{
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+    (void)thread;
+#elif defined(_WIN32)
+    if (thread)
+    {
+        WaitForSingleObject(((GLUSthread*)thread)->thread, INFINITE);
+
+        CloseHandle(((GLUSthread*)thread)->thread);
+
+        glusMemoryFree(thread);
+    }
+#elif defined(GLUS_THREAD_POSIX)
+    if (thread)
+    {
+        pthread_join(((GLUSthread*)thread)->thread, 0);
+
+        glusMemoryFree(thread);
+    }
+#else
+    (void)thread;
+#endif
+}
+
+/**
+ * Suspends the calling thread, e.g. while waiting for another thread to catch up.
+ */
+GLUSvoid _glusThreadSleep(GLUSuint milliseconds)
+{
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+    (void)milliseconds;
+#elif defined(_WIN32)
+    Sleep(milliseconds);
+#elif defined(GLUS_THREAD_POSIX)
+    struct timespec duration;
+
+    duration.tv_sec  = (time_t)(milliseconds / 1000);
+    duration.tv_nsec = (long)(milliseconds % 1000) * 1000000L;
+
+    nanosleep(&duration, 0);
+#else
+    (void)milliseconds;
+#endif
+}
+
+/**
+ * Returns the number of processors, which are available for _glusThreadRun. At least one is returned.
+ */
+GLUSuint _glusThreadGetNumberProcessors(GLUSvoid)
+{
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+    return 1;
+#elif defined(_WIN32)
+    SYSTEM_INFO systemInfo;
+
+    GetSystemInfo(&systemInfo);
+
+    return systemInfo.dwNumberOfProcessors > 1 ? (GLUSuint)systemInfo.dwNumberOfProcessors : 1;
+#elif defined(GLUS_THREAD_POSIX) && defined(_SC_NPROCESSORS_ONLN)
+    long numberProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return numberProcessors > 1 ? (GLUSuint)numberProcessors : 1;
+#else
+    return 1;
+#endif
+}
+
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+
+#elif defined(_WIN32)
+
+static SRWLOCK g_lock = SRWLOCK_INIT;
+
+#elif defined(GLUS_THREAD_POSIX)
+
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#endif
+
+/**
+ * Acquires the global lock of the library. Used for internal state, which is shared by all threads, e.g. the memory statistics.
+ */
+GLUSvoid _glusThreadLock(GLUSvoid)
+{
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+#elif defined(_WIN32)
+    AcquireSRWLockExclusive(&g_lock);
+#elif defined(GLUS_THREAD_POSIX)
+    pthread_mutex_lock(&g_lock);
+#endif
+}
+
+/**
+ * Releases the global lock of the library.
+ */
+GLUSvoid _glusThreadUnlock(GLUSvoid)
+{
+#if defined(GLUS_NO_DYNAMIC_MEMORY)
+#elif defined(_WIN32)
+    ReleaseSRWLockExclusive(&g_lock);
+#elif defined(GLUS_THREAD_POSIX)
+    pthread_mutex_unlock(&g_lock);
+#endif
+}
@@ -22,140 +22,226 @@
 
 #include "GL/glus.h"
 
+extern GLUSboolean _glusWavefrontCacheLoad(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSwavefront* wavefront);
+extern GLUSboolean _glusWavefrontCacheLoadScene(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSscene* scene);
+extern GLUSboolean _glusWavefrontCacheSave(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSwavefront* wavefront);
+extern GLUSboolean _glusWavefrontCacheSaveScene(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, const GLUSscene* scene);
+
+extern GLUSvoid _glusThreadRun(GLUSvoid (*function)(GLUSvoid* data, GLUSuint index), GLUSvoid* data, GLUSuint numberTasks, GLUSuint numberThreads);
+
 #define GLUS_MAX_OBJECTS 1
-#define GLUS_MAX_ATTRIBUTES (GLUS_MAX_VERTICES / GLUS_VERTICES_DIVISOR)
-#define GLUS_MAX_TRIANGLE_ATTRIBUTES GLUS_MAX_VERTICES
-#define GLUS_MAX_LINE_ATTRIBUTES GLUS_MAX_VERTICES
 #define GLUS_BUFFERSIZE 1024
+#define GLUS_MIN_SCRATCH_CAPACITY 4096
+#define GLUS_MIN_CHUNK_SIZE 262144
+
+#define GLUS_WAVEFRONT_EVENT_MTLLIB 0
+#define GLUS_WAVEFRONT_EVENT_USEMTL 1
+#define GLUS_WAVEFRONT_EVENT_GROUP 2
+#define GLUS_WAVEFRONT_EVENT_OBJECT 3
+
+#define GLUS_MAX_NUMBER_LENGTH 128
+#define GLUS_MAX_MANTISSA_DIGITS 19
+#define GLUS_MAX_EXACT_MANTISSA 9007199254740992ULL
+#define GLUS_MAX_EXACT_POWER_OF_TEN 22
+#define GLUS_MIN_NORMALIZED_FLOAT 1.17549435082228750797e-38
+#define GLUS_DOUBLE_TO_FLOAT_ROUNDING_MASK 0x1FFFFFFFULL
+#define GLUS_DOUBLE_TO_FLOAT_ROUNDING_HALF 0x10000000ULL
+
+/**
+ * Current and peak amount of scratch memory.
+ */
+typedef struct _GLUSwavefrontScratch
+{
+    size_t current;
 
-static GLUSboolean glusWavefrontMallocTempMemoryLine(GLUSfloat** vertices, GLUSindex** indices)
+    size_t peak;
+
+} GLUSwavefrontScratch;
+
+/**
+ * Growable scratch memory, used while parsing. The capacity is doubled on demand, so the scratch memory scales with the size of the mesh.
+ */
+typedef struct _GLUSwavefrontBuffer
 {
-    if (!vertices || !indices)
-    {
-        return GLUS_FALSE;
-    }
+    GLUSubyte* data;
 
-    *vertices = (GLUSfloat*)glusMemoryMalloc(4 * GLUS_MAX_ATTRIBUTES * sizeof(GLUSfloat));
-    if (!*vertices)
-    {
-        return GLUS_FALSE;
-    }
+    size_t size;
 
-    *indices = (GLUSindex*)glusMemoryMalloc(GLUS_MAX_LINE_ATTRIBUTES * sizeof(GLUSindex));
-    if (!*indices)
-    {
-        return GLUS_FALSE;
-    }
+    size_t capacity;
 
-    return GLUS_TRUE;
-}
+    GLUSwavefrontScratch* scratch;
 
-static GLUSvoid glusWavefrontFreeTempMemoryLine(GLUSfloat** vertices, GLUSindex** indices)
+} GLUSwavefrontBuffer;
+
+/**
+ * Zero based vertex, texture coordinate and normal index of a triangle corner. Absent indices are -1.
+ */
+typedef struct _GLUSwavefrontCorner
 {
-    if (vertices && *vertices)
-    {
-        glusMemoryFree(*vertices);
+    GLUSint vertex;
 
-        *vertices = 0;
-    }
+    GLUSint texCoord;
 
-    if (indices && *indices)
-    {
-        glusMemoryFree(*indices);
+    GLUSint normal;
 
-        *indices = 0;
-    }
-}
+} GLUSwavefrontCorner;
 
-static GLUSboolean glusWavefrontMallocTempMemory(GLUSfloat** vertices, GLUSfloat** normals, GLUSfloat** texCoords, GLUSfloat** triangleVertices, GLUSfloat** triangleNormals, GLUSfloat** triangleTexCoords)
+/**
+ * Material, group or object statement. The events are replayed in file order after parsing, so these statements resolve across chunks.
+ */
+typedef struct _GLUSwavefrontEvent
 {
-    if (!vertices || !normals || !texCoords || !triangleVertices || !triangleNormals || !triangleTexCoords)
-    {
-        return GLUS_FALSE;
-    }
+    GLUSuint type;
 
-    *vertices = (GLUSfloat*)glusMemoryMalloc(4 * GLUS_MAX_ATTRIBUTES * sizeof(GLUSfloat));
-    if (!*vertices)
-    {
-        return GLUS_FALSE;
-    }
+    // Number of corners of the chunk before the statement.
+    GLUSuint corner;
 
-    *normals = (GLUSfloat*)glusMemoryMalloc(3 * GLUS_MAX_ATTRIBUTES * sizeof(GLUSfloat));
-    if (!*normals)
-    {
-        return GLUS_FALSE;
-    }
+    // Arguments of the statement.
+    const GLUSchar* begin;
+    const GLUSchar* end;
 
-    *texCoords = (GLUSfloat*)glusMemoryMalloc(2 * GLUS_MAX_ATTRIBUTES * sizeof(GLUSfloat));
-    if (!*texCoords)
-    {
-        return GLUS_FALSE;
-    }
+} GLUSwavefrontEvent;
 
-    *triangleVertices = (GLUSfloat*)glusMemoryMalloc(4 * GLUS_MAX_TRIANGLE_ATTRIBUTES * sizeof(GLUSfloat));
-    if (!*triangleVertices)
-    {
-        return GLUS_FALSE;
-    }
+/**
+ * Part of the file, which starts and ends at a line boundary.
+ */
+typedef struct _GLUSwavefrontChunk
+{
+    const GLUSchar* begin;
+    const GLUSchar* end;
 
-    *triangleNormals = (GLUSfloat*)glusMemoryMalloc(3 * GLUS_MAX_TRIANGLE_ATTRIBUTES * sizeof(GLUSfloat));
-    if (!*triangleNormals)
-    {
-        return GLUS_FALSE;
-    }
+    GLUSboolean recordGroups;
 
-    *triangleTexCoords = (GLUSfloat*)glusMemoryMalloc(2 * GLUS_MAX_TRIANGLE_ATTRIBUTES * sizeof(GLUSfloat));
-    if (!*triangleTexCoords)
-    {
-        return GLUS_FALSE;
-    }
+    // Elements of the chunk as counted in the first pass.
+    GLUSuint numberVertices;
+    GLUSuint numberNormals;
+    GLUSuint numberTexCoords;
 
-    return GLUS_TRUE;
-}
+    // Elements of all previous chunks.
+    GLUSuint offsetVertices;
+    GLUSuint offsetNormals;
+    GLUSuint offsetTexCoords;
+    GLUSuint offsetCorners;
+
+    GLUSwavefrontBuffer vertices;
+    GLUSwavefrontBuffer normals;
+    GLUSwavefrontBuffer texCoords;
+    GLUSwavefrontBuffer corners;
+    GLUSwavefrontBuffer events;
+
+    GLUSwavefrontScratch scratch;
+
+    GLUSboolean result;
+
+} GLUSwavefrontChunk;
 
-static GLUSvoid glusWavefrontFreeTempMemory(GLUSfloat** vertices, GLUSfloat** normals, GLUSfloat** texCoords, GLUSfloat** triangleVertices, GLUSfloat** triangleNormals, GLUSfloat** triangleTexCoords)
+static GLUSwavefrontScratch g_wavefrontScratch = { 0, 0 };
+
+static GLUSvoid* glusWavefrontBufferAppend(GLUSwavefrontBuffer* buffer, const size_t size)
 {
-    if (vertices && *vertices)
+    GLUSvoid* result;
+
+    if (buffer->size + size > buffer->capacity)
     {
-        glusMemoryFree(*vertices);
+        GLUSubyte* data;
+        size_t     capacity = buffer->capacity ? buffer->capacity : GLUS_MIN_SCRATCH_CAPACITY;
 
-        *vertices = 0;
-    }
+        while (buffer->size + size > capacity)
+        {
+            if (capacity > ((size_t)-1) / 2)
+            {
+                return 0;
+            }
 
-    if (normals && *normals)
-    {
-        glusMemoryFree(*normals);
+            capacity *= 2;
+        }
 
-        *normals = 0;
-    }
+        data = (GLUSubyte*)glusMemoryMalloc(capacity);
 
-    if (texCoords && *texCoords)
-    {
-        glusMemoryFree(*texCoords);
+        if (!data)
+        {
+            return 0;
+        }
 
-        *texCoords = 0;
-    }
+        // Old and new block are alive at the same time.
+        buffer->scratch->current += capacity;
 
-    if (triangleVertices && *triangleVertices)
-    {
-        glusMemoryFree(*triangleVertices);
+        if (buffer->scratch->current > buffer->scratch->peak)
+        {
+            buffer->scratch->peak = buffer->scratch->current;
+        }
 
-        *triangleVertices = 0;
-    }
+        if (buffer->data)
+        {
+            memcpy(data, buffer->data, buffer->size);
 
-    if (triangleNormals && *triangleNormals)
-    {
-        glusMemoryFree(*triangleNormals);
+            glusMemoryFree(buffer->data);
+
+            buffer->scratch->current -= buffer->capacity;
+        }
 
-        *triangleNormals = 0;
+        buffer->data     = data;
+        buffer->capacity = capacity;
     }
 
-    if (triangleTexCoords && *triangleTexCoords)
+    result = buffer->data + buffer->size;
+
+    buffer->size += size;
+
+    return result;
+}
+
+static GLUSvoid glusWavefrontBufferInit(GLUSwavefrontBuffer* buffer, GLUSwavefrontScratch* scratch)
+{
+    memset(buffer, 0, sizeof(GLUSwavefrontBuffer));
+
+    buffer->scratch = scratch;
+}
+
+static GLUSvoid glusWavefrontBufferFree(GLUSwavefrontBuffer* buffer)
+{
+    if (buffer->data)
     {
-        glusMemoryFree(*triangleTexCoords);
+        glusMemoryFree(buffer->data);
 
-        *triangleTexCoords = 0;
+        buffer->scratch->current -= buffer->capacity;
     }
+
+    glusWavefrontBufferInit(buffer, buffer->scratch);
+}
+
+static GLUSvoid glusWavefrontInitTempMemoryLine(GLUSwavefrontBuffer* vertices, GLUSwavefrontBuffer* indices)
+{
+    glusWavefrontBufferInit(vertices, &g_wavefrontScratch);
+    glusWavefrontBufferInit(indices, &g_wavefrontScratch);
+
+    g_wavefrontScratch.current = 0;
+    g_wavefrontScratch.peak    = 0;
+}
+
+static GLUSvoid glusWavefrontFreeTempMemoryLine(GLUSwavefrontBuffer* vertices, GLUSwavefrontBuffer* indices)
+{
+    glusWavefrontBufferFree(vertices);
+    glusWavefrontBufferFree(indices);
+}
+
+static GLUSvoid glusWavefrontInitTempMemory(GLUSwavefrontBuffer* vertices, GLUSwavefrontBuffer* normals, GLUSwavefrontBuffer* texCoords, GLUSwavefrontBuffer* corners)
+{
+    glusWavefrontBufferInit(vertices, &g_wavefrontScratch);
+    glusWavefrontBufferInit(normals, &g_wavefrontScratch);
+    glusWavefrontBufferInit(texCoords, &g_wavefrontScratch);
+    glusWavefrontBufferInit(corners, &g_wavefrontScratch);
+
+    g_wavefrontScratch.current = 0;
+    g_wavefrontScratch.peak    = 0;
+}
+
+static GLUSvoid glusWavefrontFreeTempMemory(GLUSwavefrontBuffer* vertices, GLUSwavefrontBuffer* normals, GLUSwavefrontBuffer* texCoords, GLUSwavefrontBuffer* corners)
+{
+    glusWavefrontBufferFree(vertices);
+    glusWavefrontBufferFree(normals);
+    glusWavefrontBufferFree(texCoords);
+    glusWavefrontBufferFree(corners);
 }
 
 static GLUSvoid glusWavefrontInitMaterial(GLUSmaterial* material)
@@ -504,6 +590,12 @@ static GLUSboolean glusWavefrontCopyDataLine(GLUSline* line, GLUSuint totalNumbe
 
     memset(line, 0, sizeof(GLUSline));
 
+    // Every vertex has to be addressable by the index type.
+    if (totalNumberVertices > 0 && (GLUSuint)(GLUSindex)(totalNumberVertices - 1) != totalNumberVertices - 1)
+    {
+        return GLUS_FALSE;
+    }
+
     line->numberVertices = totalNumberVertices;
     line->numberIndices  = totalNumberIndices;
 
@@ -539,757 +631,1555 @@ static GLUSboolean glusWavefrontCopyDataLine(GLUSline* line, GLUSuint totalNumbe
     return GLUS_TRUE;
 }
 
-static GLUSboolean glusWavefrontCopyData(GLUSshape* shape, GLUSuint totalNumberVertices, GLUSfloat* triangleVertices, GLUSuint totalNumberNormals, GLUSfloat* triangleNormals, GLUSuint totalNumberTexCoords, GLUSfloat* triangleTexCoords)
+static GLUSuint glusWavefrontHashCorner(const GLUSwavefrontCorner* corner)
 {
-    GLUSuint indicesCounter = 0;
-
-    if (!shape || !triangleVertices || !triangleNormals || !triangleTexCoords)
-    {
-        return GLUS_FALSE;
-    }
+    GLUSuint hash = (GLUSuint)corner->vertex * 0x9E3779B1u ^ (GLUSuint)corner->texCoord * 0x85EBCA77u ^ (GLUSuint)corner->normal * 0xC2B2AE3Du;
 
-    memset(shape, 0, sizeof(GLUSshape));
+    return hash ^ (hash >> 15);
+}
 
-    shape->numberVertices = totalNumberVertices;
+/**
+ * Number of hash table slots for welding the corners, so the load factor is at most one half. Returns 0, if there are too many corners.
+ */
+static GLUSuint glusWavefrontGetNumberSlots(const GLUSuint numberCorners)
+{
+    GLUSuint numberSlots = 1;
 
-    if (totalNumberVertices > 0)
+    // The hash table and the unique corners have to fit into one memory block. The product can not overflow in 64 bit.
+    if (numberCorners > 0x40000000u || (GLUSuint64)numberCorners * (5 * sizeof(GLUSuint)) > (GLUSuint64)(((size_t)-1) - 2 * GLUS_MEMORY_ARENA_ALIGNMENT))
     {
-        shape->vertices = (GLUSfloat*)glusMemoryMalloc(totalNumberVertices * 4 * sizeof(GLUSfloat));
-
-        if (shape->vertices == 0)
-        {
-            glusShapeDestroyf(shape);
-
-            return GLUS_FALSE;
-        }
-
-        memcpy(shape->vertices, triangleVertices, totalNumberVertices * 4 * sizeof(GLUSfloat));
+        return 0;
     }
-    if (totalNumberNormals > 0)
+
+    while (numberSlots < 2 * numberCorners)
     {
-        shape->normals = (GLUSfloat*)glusMemoryMalloc(totalNumberNormals * 3 * sizeof(GLUSfloat));
+        numberSlots *= 2;
+    }
 
-        if (shape->normals == 0)
-        {
-            glusShapeDestroyf(shape);
+    return numberSlots;
+}
 
-            return GLUS_FALSE;
-        }
+/**
+ * Scratch memory taken from an arena. The size is added to the scratch statistics.
+ */
+static GLUSvoid glusWavefrontBeginArena(GLUSmemoryArena* arena, const size_t size)
+{
+    glusMemoryArenaBegin(arena, size);
 
-        memcpy(shape->normals, triangleNormals, totalNumberNormals * 3 * sizeof(GLUSfloat));
-    }
-    if (totalNumberTexCoords > 0)
+    g_wavefrontScratch.current += size;
+
+    if (g_wavefrontScratch.current > g_wavefrontScratch.peak)
     {
-        shape->texCoords = (GLUSfloat*)glusMemoryMalloc(totalNumberTexCoords * 2 * sizeof(GLUSfloat));
+        g_wavefrontScratch.peak = g_wavefrontScratch.current;
+    }
+}
 
-        if (shape->texCoords == 0)
-        {
-            glusShapeDestroyf(shape);
+static GLUSvoid glusWavefrontEndArena(GLUSmemoryArena* arena, const size_t size)
+{
+    glusMemoryArenaEnd(arena);
 
-            return GLUS_FALSE;
-        }
+    g_wavefrontScratch.current -= size;
+}
 
-        memcpy(shape->texCoords, triangleTexCoords, totalNumberTexCoords * 2 * sizeof(GLUSfloat));
-    }
+/**
+ * Merges corners with the same vertex, texture coordinate and normal index. For each unique vertex, the first corner using it is stored.
+ * The hash table has numberSlots entries, which has to be a power of two, and the unique corners array has room for numberCorners entries.
+ */
+static GLUSboolean glusWavefrontWeldCorners(GLUSindex* indices, GLUSuint* uniqueCorners, GLUSuint* numberUniqueCorners, const GLUSwavefrontCorner* corners, const GLUSuint numberCorners, GLUSuint* slots, const GLUSuint numberSlots)
+{
+    GLUSuint mask = numberSlots - 1;
+    GLUSuint slot;
+    GLUSuint i;
 
-    // Just create the indices from the list of vertices.
+    // Zero marks an empty slot, otherwise the slot contains the unique vertex index plus one.
+    memset(slots, 0, numberSlots * sizeof(GLUSuint));
 
-    shape->numberIndices = totalNumberVertices;
+    *numberUniqueCorners = 0;
 
-    if (totalNumberVertices > 0)
+    for (i = 0; i < numberCorners; i++)
     {
-        shape->indices = (GLUSindex*)glusMemoryMalloc(totalNumberVertices * sizeof(GLUSindex));
+        const GLUSwavefrontCorner* corner = &corners[i];
 
-        if (shape->indices == 0)
+        slot = glusWavefrontHashCorner(corner) & mask;
+
+        while (slots[slot])
         {
-            glusShapeDestroyf(shape);
+            const GLUSwavefrontCorner* uniqueCorner = &corners[uniqueCorners[slots[slot] - 1]];
 
-            return GLUS_FALSE;
+            if (uniqueCorner->vertex == corner->vertex && uniqueCorner->texCoord == corner->texCoord && uniqueCorner->normal == corner->normal)
+            {
+                break;
+            }
+
+            slot = (slot + 1) & mask;
         }
 
-        for (indicesCounter = 0; indicesCounter < totalNumberVertices; indicesCounter++)
+        if (!slots[slot])
         {
-            shape->indices[indicesCounter] = indicesCounter;
+            // Every vertex has to be addressable by the index type.
+            if ((GLUSuint)(GLUSindex)*numberUniqueCorners != *numberUniqueCorners)
+            {
+                return GLUS_FALSE;
+            }
+
+            uniqueCorners[*numberUniqueCorners] = i;
+
+            (*numberUniqueCorners)++;
+
+            slots[slot] = *numberUniqueCorners;
         }
-    }
 
-    shape->mode = GLUS_TRIANGLES;
+        indices[i] = (GLUSindex)(slots[slot] - 1);
+    }
 
     return GLUS_TRUE;
 }
 
-GLUSboolean _glusWavefrontMove(GLUSwavefront* wavefront, GLUSshape* shape)
+static GLUSboolean glusWavefrontCopyData(GLUSshape* shape, const GLUSwavefrontCorner* corners, const GLUSuint numberCorners, const GLUSwavefrontBuffer* vertices, const GLUSwavefrontBuffer* normals, const GLUSwavefrontBuffer* texCoords, const GLUSboolean expandVertices)
 {
-    GLUSmaterialList* materialWalker;
-    GLUSgroupList*    groupWalker;
+    GLUSmemoryArena scratch;
+
+    GLUSuint* uniqueCorners = 0;
+    GLUSuint* slots         = 0;
+
+    GLUSuint numberSlots = 0;
+    size_t   scratchSize = 0;
+
+    const GLUSfloat* vertexData   = (const GLUSfloat*)vertices->data;
+    const GLUSfloat* normalData   = (const GLUSfloat*)normals->data;
+    const GLUSfloat* texCoordData = (const GLUSfloat*)texCoords->data;
+
+    GLUSboolean hasNormals   = GLUS_FALSE;
+    GLUSboolean hasTexCoords = GLUS_FALSE;
 
     GLUSuint i;
-    GLUSuint counter = 0;
 
-    if (!wavefront || !shape)
+    if (!shape || (numberCorners > 0 && !corners))
     {
         return GLUS_FALSE;
     }
 
-    // No clear of wavefront by purpose.
+    memset(shape, 0, sizeof(GLUSshape));
 
-    wavefront->vertices       = shape->vertices;
-    wavefront->normals        = shape->normals;
-    wavefront->texCoords      = shape->texCoords;
-    wavefront->tangents       = shape->tangents;
-    wavefront->bitangents     = shape->bitangents;
-    wavefront->numberVertices = shape->numberVertices;
+    for (i = 0; i < numberCorners; i++)
+    {
+        hasNormals |= corners[i].normal >= 0;
+        hasTexCoords |= corners[i].texCoord >= 0;
+    }
 
-    groupWalker = wavefront->groups;
-    while (groupWalker)
+    // The hash table and the unique corners for welding are taken from one memory block.
+    if (!expandVertices && numberCorners > 0)
     {
-        groupWalker->group.indices = (GLUSindex*)glusMemoryMalloc(groupWalker->group.numberIndices * sizeof(GLUSindex));
+        numberSlots = glusWavefrontGetNumberSlots(numberCorners);
 
-        if (!groupWalker->group.indices)
+        scratchSize = ((size_t)numberSlots + numberCorners) * sizeof(GLUSuint) + 2 * GLUS_MEMORY_ARENA_ALIGNMENT;
+    }
+
+    glusWavefrontBeginArena(&scratch, scratchSize);
+
+    shape->numberIndices = numberCorners;
+
+    if (numberCorners > 0)
+    {
+        shape->indices = (GLUSindex*)glusMemoryMalloc(numberCorners * sizeof(GLUSindex));
+
+        if (shape->indices == 0)
         {
-            memset(wavefront, 0, sizeof(GLUSwavefront));
+            glusWavefrontEndArena(&scratch, scratchSize);
+
+            glusShapeDestroyf(shape);
 
             return GLUS_FALSE;
         }
 
-        for (i = 0; i < groupWalker->group.numberIndices; i++)
+        if (expandVertices)
         {
-            groupWalker->group.indices[i] = counter++;
-        }
+            // Every vertex has to be addressable by the index type.
+            if ((GLUSuint)(GLUSindex)(numberCorners - 1) != numberCorners - 1)
+            {
+                glusWavefrontEndArena(&scratch, scratchSize);
 
-        materialWalker = wavefront->materials;
+                glusShapeDestroyf(shape);
 
-        while (materialWalker)
-        {
-            if (strcmp(materialWalker->material.name, groupWalker->group.materialName) == 0)
-            {
-                groupWalker->group.material = &materialWalker->material;
+                return GLUS_FALSE;
+            }
 
-                break;
+            // Just create the indices from the list of vertices.
+
+            for (i = 0; i < numberCorners; i++)
+            {
+                shape->indices[i] = (GLUSindex)i;
             }
 
-            materialWalker = materialWalker->next;
+            shape->numberVertices = numberCorners;
         }
+        else
+        {
+            if (numberSlots > 0)
+            {
+                slots         = (GLUSuint*)glusMemoryArenaAlloc(&scratch, numberSlots * sizeof(GLUSuint));
+                uniqueCorners = (GLUSuint*)glusMemoryArenaAlloc(&scratch, numberCorners * sizeof(GLUSuint));
+            }
 
-        groupWalker = groupWalker->next;
-    }
+            if (!slots || !uniqueCorners || !glusWavefrontWeldCorners(shape->indices, uniqueCorners, &shape->numberVertices, corners, numberCorners, slots, numberSlots))
+            {
+                glusWavefrontEndArena(&scratch, scratchSize);
 
-    glusMemoryFree(shape->indices);
-    shape->indices = 0;
+                glusShapeDestroyf(shape);
 
-    memset(shape, 0, sizeof(GLUSshape));
+                return GLUS_FALSE;
+            }
+        }
 
-    return GLUS_TRUE;
-}
+        shape->vertices = (GLUSfloat*)glusMemoryMalloc(shape->numberVertices * 4 * sizeof(GLUSfloat));
 
-GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUSwavefront* wavefront, GLUSscene* scene)
-{
-    GLUSboolean result;
+        if (shape->vertices == 0)
+        {
+            glusWavefrontEndArena(&scratch, scratchSize);
 
-    FILE* f;
+            glusShapeDestroyf(shape);
 
-    GLUSchar buffer[GLUS_BUFFERSIZE];
-    GLUSchar identifier[32];
+            return GLUS_FALSE;
+        }
 
-    GLUSfloat x, y, z;
-    GLUSfloat s, t;
+        if (hasNormals)
+        {
+            shape->normals = (GLUSfloat*)glusMemoryMalloc(shape->numberVertices * 3 * sizeof(GLUSfloat));
 
-    GLUSfloat* vertices  = 0;
-    GLUSfloat* normals   = 0;
-    GLUSfloat* texCoords = 0;
+            if (shape->normals == 0)
+            {
+                glusWavefrontEndArena(&scratch, scratchSize);
 
-    GLUSuint numberVertices  = 0;
-    GLUSuint numberNormals   = 0;
-    GLUSuint numberTexCoords = 0;
+                glusShapeDestroyf(shape);
 
-    GLUSfloat* triangleVertices  = 0;
-    GLUSfloat* triangleNormals   = 0;
-    GLUSfloat* triangleTexCoords = 0;
+                return GLUS_FALSE;
+            }
+        }
 
-    GLUSuint offsetNumberVertices  = 0;
-    GLUSuint offsetNumberNormals   = 0;
-    GLUSuint offsetNumberTexCoords = 0;
+        if (hasTexCoords)
+        {
+            shape->texCoords = (GLUSfloat*)glusMemoryMalloc(shape->numberVertices * 2 * sizeof(GLUSfloat));
 
-    GLUSuint totalNumberVertices  = 0;
-    GLUSuint totalNumberNormals   = 0;
-    GLUSuint totalNumberTexCoords = 0;
+            if (shape->texCoords == 0)
+            {
+                glusWavefrontEndArena(&scratch, scratchSize);
 
-    GLUSuint facesEncoding = 0;
+                glusShapeDestroyf(shape);
 
-    // Material and groups
+                return GLUS_FALSE;
+            }
+        }
 
-    GLUSchar name[GLUS_MAX_STRING];
+        for (i = 0; i < shape->numberVertices; i++)
+        {
+            const GLUSwavefrontCorner* corner = &corners[expandVertices ? i : uniqueCorners[i]];
 
-    GLUSuint numberIndicesGroup = 0;
-    GLUSuint numberMaterials    = 0;
-    GLUSuint numberGroups       = 0;
+            memcpy(&shape->vertices[4 * i], &vertexData[4 * corner->vertex], 4 * sizeof(GLUSfloat));
 
-    GLUSgroupList*  currentGroupList  = 0;
-    GLUSobjectList* currentObjectList = 0;
+            // Missing normals and texture coordinates are set to zero.
 
-    // Objects
-
-    GLUSuint numberObjects = 0;
+            if (hasNormals)
+            {
+                if (corner->normal >= 0)
+                {
+                    memcpy(&shape->normals[3 * i], &normalData[3 * corner->normal], 3 * sizeof(GLUSfloat));
+                }
+                else
+                {
+                    memset(&shape->normals[3 * i], 0, 3 * sizeof(GLUSfloat));
+                }
+            }
 
-    if (scene)
-    {
-        memset(scene, 0, sizeof(GLUSscene));
+            if (hasTexCoords)
+            {
+                if (corner->texCoord >= 0)
+                {
+                    memcpy(&shape->texCoords[2 * i], &texCoordData[2 * corner->texCoord], 2 * sizeof(GLUSfloat));
+                }
+                else
+                {
+                    memset(&shape->texCoords[2 * i], 0, 2 * sizeof(GLUSfloat));
+                }
+            }
+        }
     }
 
-    if (wavefront)
-    {
-        memset(wavefront, 0, sizeof(GLUSwavefront));
-    }
+    glusWavefrontEndArena(&scratch, scratchSize);
 
-    if (shape)
+    shape->mode = GLUS_TRIANGLES;
+
+    return GLUS_TRUE;
+}
+
+//
+// Tokenizer working directly on the mapped file content. All functions are bounded by the end of the current line.
+//
+
+static const GLUSdouble g_wavefrontPowersOfTen[GLUS_MAX_EXACT_POWER_OF_TEN + 1] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+static GLUSboolean glusWavefrontIsSpace(const GLUSchar c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static GLUSboolean glusWavefrontIsDigit(const GLUSchar c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static const GLUSchar* glusWavefrontSkipSpaces(const GLUSchar* current, const GLUSchar* end)
+{
+    while (current < end && glusWavefrontIsSpace(*current))
     {
-        memset(shape, 0, sizeof(GLUSshape));
+        current++;
     }
 
-    if (!filename || !shape)
+    return current;
+}
+
+static const GLUSchar* glusWavefrontFindLineEnd(const GLUSchar* current, const GLUSchar* end)
+{
+    const GLUSchar* lineEnd = (const GLUSchar*)memchr(current, '\n', (size_t)(end - current));
+
+    return lineEnd ? lineEnd : end;
+}
+
+static GLUSboolean glusWavefrontIsKeyword(const GLUSchar* current, const GLUSchar* end, const GLUSchar* keyword, const size_t length)
+{
+    if ((size_t)(end - current) < length || memcmp(current, keyword, length) != 0)
     {
         return GLUS_FALSE;
     }
 
-    f = glusFileOpen(filename, "r");
+    return current + length == end || glusWavefrontIsSpace(current[length]);
+}
 
-    if (!f)
+/**
+ * Reads the next whitespace separated token. As with the previous sscanf based parser, the name is not modified, if there is no token.
+ */
+static const GLUSchar* glusWavefrontParseName(const GLUSchar* current, const GLUSchar* end, GLUSchar name[GLUS_MAX_STRING])
+{
+    GLUSint length = 0;
+
+    current = glusWavefrontSkipSpaces(current, end);
+
+    if (current == end)
     {
-        return GLUS_FALSE;
+        return current;
     }
 
-    if (!glusWavefrontMallocTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords))
+    while (current < end && !glusWavefrontIsSpace(*current))
     {
-        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+        if (length < GLUS_MAX_STRING - 1)
+        {
+            name[length++] = *current;
+        }
+
+        current++;
+    }
 
-        glusFileClose(f);
+    name[length] = '\0';
 
-        return GLUS_FALSE;
+    return current;
+}
+
+/**
+ * Parses a decimal floating point number. Numbers, which can be exactly calculated in double precision, are converted without any library call.
+ * All other numbers are passed to strtof, so the result is always the correctly rounded value.
+ *
+ * @return Pointer after the number or 0, if no number could be parsed.
+ */
+static const GLUSchar* glusWavefrontParseFloat(const GLUSchar* current, const GLUSchar* end, GLUSfloat* value)
+{
+    const GLUSchar* start;
+
+    GLUSchar  buffer[GLUS_MAX_NUMBER_LENGTH];
+    GLUSchar* bufferEnd;
+
+    GLUSuint64 mantissa = 0;
+    GLUSint    digits   = 0;
+    GLUSint    exponent = 0;
+
+    GLUSboolean negative  = GLUS_FALSE;
+    GLUSboolean truncated = GLUS_FALSE;
+    GLUSboolean anyDigits = GLUS_FALSE;
+
+    GLUSdouble result;
+    GLUSuint64 bits;
+
+    current = glusWavefrontSkipSpaces(current, end);
+
+    start = current;
+
+    if (current < end && (*current == '-' || *current == '+'))
+    {
+        negative = (*current == '-');
+
+        current++;
     }
 
-    while (!feof(f))
+    while (current < end && glusWavefrontIsDigit(*current))
     {
-        buffer[0] = 0;
+        anyDigits = GLUS_TRUE;
 
-        if (fgets(buffer, GLUS_BUFFERSIZE, f) == 0)
+        if (digits < GLUS_MAX_MANTISSA_DIGITS)
         {
-            if (ferror(f))
-            {
-                glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+            mantissa = mantissa * 10 + (GLUSuint64)(*current - '0');
 
-                glusFileClose(f);
+            if (mantissa)
+            {
+                digits++;
+            }
+        }
+        else
+        {
+            exponent++;
 
-                return GLUS_FALSE;
+            if (*current != '0')
+            {
+                truncated = GLUS_TRUE;
             }
         }
 
-        if (wavefront)
+        current++;
+    }
+
+    if (current < end && *current == '.')
+    {
+        current++;
+
+        while (current < end && glusWavefrontIsDigit(*current))
         {
-            if (strncmp(buffer, "mtllib", 6) == 0)
+            anyDigits = GLUS_TRUE;
+
+            if (digits < GLUS_MAX_MANTISSA_DIGITS)
             {
-                sscanf(buffer, "%s %s", identifier, name);
+                mantissa = mantissa * 10 + (GLUSuint64)(*current - '0');
 
-                if (numberMaterials == 0)
+                if (mantissa)
                 {
-                    wavefront->materials = 0;
+                    digits++;
                 }
 
-                if (!glusWavefrontLoadMaterial(name, &wavefront->materials))
-                {
-                    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+                exponent--;
+            }
+            else if (*current != '0')
+            {
+                truncated = GLUS_TRUE;
+            }
+
+            current++;
+        }
+    }
 
-                    glusFileClose(f);
+    if (anyDigits)
+    {
+        if (current < end && (*current == 'e' || *current == 'E'))
+        {
+            const GLUSchar* exponentStart = current;
 
-                    return GLUS_FALSE;
-                }
+            GLUSboolean negativeExponent = GLUS_FALSE;
+            GLUSint     exponentValue    = 0;
 
-                numberMaterials++;
-            }
-            else if (strncmp(buffer, "usemtl", 6) == 0)
+            current++;
+
+            if (current < end && (*current == '-' || *current == '+'))
             {
-                if (!currentGroupList || currentGroupList->group.materialName[0] != '\0')
-                {
-                    GLUSgroupList* newGroupList;
+                negativeExponent = (*current == '-');
 
-                    newGroupList = (GLUSgroupList*)glusMemoryMalloc(sizeof(GLUSgroupList));
+                current++;
+            }
 
-                    if (!newGroupList)
+            if (current < end && glusWavefrontIsDigit(*current))
+            {
+                while (current < end && glusWavefrontIsDigit(*current))
+                {
+                    if (exponentValue < 100000)
                     {
-                        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+                        exponentValue = exponentValue * 10 + (*current - '0');
+                    }
 
-                        glusFileClose(f);
+                    current++;
+                }
 
-                        return GLUS_FALSE;
-                    }
+                exponent += negativeExponent ? -exponentValue : exponentValue;
+            }
+            else
+            {
+                // Not an exponent, e.g. "1e".
+                current = exponentStart;
+            }
+        }
 
-                    memset(newGroupList, 0, sizeof(GLUSgroupList));
+        if (mantissa == 0)
+        {
+            *value = negative ? -0.0f : 0.0f;
 
-                    strcpy(newGroupList->group.name, name);
+            return current;
+        }
 
-                    if (numberGroups == 0)
-                    {
-                        wavefront->groups = newGroupList;
-                    }
-                    else
-                    {
-                        if (!currentGroupList)
-                        {
-                            glusMemoryFree(newGroupList);
+        // Both mantissa and power of ten are exact, so the division or multiplication is correctly rounded.
+        if (!truncated && mantissa <= GLUS_MAX_EXACT_MANTISSA && exponent >= -GLUS_MAX_EXACT_POWER_OF_TEN && exponent <= GLUS_MAX_EXACT_POWER_OF_TEN)
+        {
+            result = (GLUSdouble)mantissa;
 
-                            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+            if (exponent < 0)
+            {
+                result /= g_wavefrontPowersOfTen[-exponent];
+            }
+            else
+            {
+                result *= g_wavefrontPowersOfTen[exponent];
+            }
 
-                            glusFileClose(f);
+            memcpy(&bits, &result, sizeof(GLUSdouble));
 
-                            return GLUS_FALSE;
-                        }
+            // Rounding to float is only ambiguous, if the double lies exactly halfway between two floats or the result is denormalized.
+            if (result >= GLUS_MIN_NORMALIZED_FLOAT && (bits & GLUS_DOUBLE_TO_FLOAT_ROUNDING_MASK) != GLUS_DOUBLE_TO_FLOAT_ROUNDING_HALF)
+            {
+                *value = negative ? -(GLUSfloat)result : (GLUSfloat)result;
 
-                        currentGroupList->next = newGroupList;
+                return current;
+            }
+        }
+    }
+    else
+    {
+        // Could be e.g. "inf" or "nan", so let strtof decide.
+        while (current < end && !glusWavefrontIsSpace(*current) && *current != '/')
+        {
+            current++;
+        }
+    }
 
-                        currentGroupList->group.numberIndices = numberIndicesGroup;
-                        numberIndicesGroup                    = 0;
-                    }
+    if (current - start >= GLUS_MAX_NUMBER_LENGTH || current == start)
+    {
+        return 0;
+    }
 
-                    currentGroupList = newGroupList;
+    memcpy(buffer, start, (size_t)(current - start));
+    buffer[current - start] = '\0';
 
-                    numberGroups++;
-                }
+    *value = strtof(buffer, &bufferEnd);
 
-                //
+    if (bufferEnd == buffer)
+    {
+        return 0;
+    }
 
-                sscanf(buffer, "%s %s", identifier, name);
+    return start + (bufferEnd - buffer);
+}
 
-                strcpy(currentGroupList->group.materialName, name);
-            }
-            else if (strncmp(buffer, "g", 1) == 0)
-            {
-                GLUSgroupList* newGroupList;
+/**
+ * Parses a decimal integer.
+ *
+ * @return Pointer after the number or 0, if no number could be parsed.
+ */
+static const GLUSchar* glusWavefrontParseInt(const GLUSchar* current, const GLUSchar* end, GLUSint* value)
+{
+    GLUSint64   result   = 0;
+    GLUSboolean negative = GLUS_FALSE;
 
-                sscanf(buffer, "%s %s", identifier, name);
+    current = glusWavefrontSkipSpaces(current, end);
 
-                newGroupList = (GLUSgroupList*)glusMemoryMalloc(sizeof(GLUSgroupList));
+    if (current < end && (*current == '-' || *current == '+'))
+    {
+        negative = (*current == '-');
 
-                if (!newGroupList)
-                {
-                    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+        current++;
+    }
 
-                    glusFileClose(f);
+    if (current == end || !glusWavefrontIsDigit(*current))
+    {
+        return 0;
+    }
 
-                    return GLUS_FALSE;
-                }
+    while (current < end && glusWavefrontIsDigit(*current))
+    {
+        result = result * 10 + (*current - '0');
 
-                memset(newGroupList, 0, sizeof(GLUSgroupList));
+        if (result > 2147483647)
+        {
+            return 0;
+        }
 
-                strcpy(newGroupList->group.name, name);
+        current++;
+    }
 
-                if (numberGroups == 0)
-                {
-                    wavefront->groups = newGroupList;
-                }
-                else
-                {
-                    if (!currentGroupList)
-                    {
-                        glusMemoryFree(newGroupList);
+    *value = negative ? -(GLUSint)result : (GLUSint)result;
 
-                        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+    return current;
+}
 
-                        glusFileClose(f);
+/**
+ * Parses one v, v/vt, v//vn or v/vt/vn face vertex. Absent indices are returned as 0. Relative indices are resolved.
+ *
+ * @return Pointer after the face vertex or 0, if the face vertex is invalid.
+ */
+static const GLUSchar* glusWavefrontParseFaceVertex(const GLUSchar* current, const GLUSchar* end, GLUSint* vIndex, GLUSint* vtIndex, GLUSint* vnIndex, const GLUSuint numberVertices, const GLUSuint numberTexCoords, const GLUSuint numberNormals)
+{
+    *vIndex  = 0;
+    *vtIndex = 0;
+    *vnIndex = 0;
 
-                        return GLUS_FALSE;
-                    }
+    current = glusWavefrontParseInt(current, end, vIndex);
 
-                    currentGroupList->next = newGroupList;
+    if (!current)
+    {
+        return 0;
+    }
 
-                    currentGroupList->group.numberIndices = numberIndicesGroup;
-                    numberIndicesGroup                    = 0;
-                }
+    if (current < end && *current == '/')
+    {
+        current++;
 
-                currentGroupList = newGroupList;
+        if (current < end && *current != '/')
+        {
+            current = glusWavefrontParseInt(current, end, vtIndex);
 
-                numberGroups++;
+            if (!current)
+            {
+                return 0;
             }
         }
 
-        if (strncmp(buffer, "o", 1) == 0)
+        if (current < end && *current == '/')
         {
-            if (scene)
+            current++;
+
+            current = glusWavefrontParseInt(current, end, vnIndex);
+
+            if (!current)
             {
-                GLUSobjectList* newObjectList;
+                return 0;
+            }
+        }
+    }
 
-                if (currentObjectList)
-                {
-                    if (wavefront && currentGroupList)
-                    {
-                        currentGroupList->group.numberIndices = numberIndicesGroup;
-                        numberIndicesGroup                    = 0;
-                    }
+    if (*vIndex < 0)
+    {
+        *vIndex += (GLUSint)numberVertices + 1;
+    }
+    if (*vtIndex < 0)
+    {
+        *vtIndex += (GLUSint)numberTexCoords + 1;
+    }
+    if (*vnIndex < 0)
+    {
+        *vnIndex += (GLUSint)numberNormals + 1;
+    }
 
-                    result = glusWavefrontCopyData(shape, totalNumberVertices - offsetNumberVertices, &triangleVertices[4 * offsetNumberVertices], totalNumberNormals - offsetNumberNormals, &triangleNormals[3 * offsetNumberNormals], totalNumberTexCoords - offsetNumberTexCoords, &triangleTexCoords[2 * offsetNumberTexCoords]);
+    if (*vIndex <= 0 || *vIndex > (GLUSint)numberVertices || *vtIndex < 0 || *vtIndex > (GLUSint)numberTexCoords || *vnIndex < 0 || *vnIndex > (GLUSint)numberNormals)
+    {
+        return 0;
+    }
 
-                    if (result)
-                    {
-                        glusShapeCalculateTangentBitangentf(shape);
-                    }
+    return current;
+}
 
-                    if (!_glusWavefrontMove(wavefront, shape))
-                    {
-                        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+GLUSboolean _glusWavefrontMove(GLUSwavefront* wavefront, GLUSshape* shape)
+{
+    GLUSmaterialList* materialWalker;
+    GLUSgroupList*    groupWalker;
 
-                        glusFileClose(f);
+    GLUSuint i;
+    GLUSuint counter = 0;
 
-                        return GLUS_FALSE;
-                    }
+    if (!wavefront || !shape)
+    {
+        return GLUS_FALSE;
+    }
 
-                    memcpy(&currentObjectList->object, wavefront, sizeof(GLUSwavefront));
-                }
+    // No clear of wavefront by purpose.
 
-                sscanf(buffer, "%s %s", identifier, name);
+    wavefront->vertices       = shape->vertices;
+    wavefront->normals        = shape->normals;
+    wavefront->texCoords      = shape->texCoords;
+    wavefront->tangents       = shape->tangents;
+    wavefront->bitangents     = shape->bitangents;
+    wavefront->numberVertices = shape->numberVertices;
+
+    groupWalker = wavefront->groups;
+    while (groupWalker)
+    {
+        // Group indices are taken from the shape, as vertices might have been welded.
+        if (groupWalker->group.numberIndices > 0 && (!shape->indices || counter + groupWalker->group.numberIndices > shape->numberIndices))
+        {
+            memset(wavefront, 0, sizeof(GLUSwavefront));
+
+            return GLUS_FALSE;
+        }
+
+        groupWalker->group.indices = (GLUSindex*)glusMemoryMalloc(groupWalker->group.numberIndices * sizeof(GLUSindex));
+
+        if (!groupWalker->group.indices)
+        {
+            memset(wavefront, 0, sizeof(GLUSwavefront));
+
+            return GLUS_FALSE;
+        }
 
-                strcpy(wavefront->name, name);
+        for (i = 0; i < groupWalker->group.numberIndices; i++)
+        {
+            groupWalker->group.indices[i] = shape->indices[counter++];
+        }
+
+        materialWalker = wavefront->materials;
+
+        while (materialWalker)
+        {
+            if (strcmp(materialWalker->material.name, groupWalker->group.materialName) == 0)
+            {
+                groupWalker->group.material = &materialWalker->material;
+
+                break;
+            }
+
+            materialWalker = materialWalker->next;
+        }
+
+        groupWalker = groupWalker->next;
+    }
+
+    glusMemoryFree(shape->indices);
+    shape->indices = 0;
+
+    memset(shape, 0, sizeof(GLUSshape));
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Appends a polygon corner. From the fourth corner on, a new triangle of the fan is emitted.
+ */
+static GLUSboolean glusWavefrontAppendCorner(GLUSwavefrontBuffer* corners, const GLUSuint firstCorner, const GLUSwavefrontCorner* corner, const GLUSuint edgeCount)
+{
+    GLUSwavefrontCorner* triangle;
+
+    if (edgeCount < 3)
+    {
+        triangle = (GLUSwavefrontCorner*)glusWavefrontBufferAppend(corners, sizeof(GLUSwavefrontCorner));
+
+        if (!triangle)
+        {
+            return GLUS_FALSE;
+        }
+
+        triangle[0] = *corner;
+    }
+    else
+    {
+        triangle = (GLUSwavefrontCorner*)glusWavefrontBufferAppend(corners, 3 * sizeof(GLUSwavefrontCorner));
+
+        if (!triangle)
+        {
+            return GLUS_FALSE;
+        }
+
+        triangle[0] = ((GLUSwavefrontCorner*)corners->data)[firstCorner];
+        triangle[1] = triangle[-1];
+        triangle[2] = *corner;
+    }
+
+    return GLUS_TRUE;
+}
+
+static GLUSboolean glusWavefrontAppendGroup(const GLUSchar* name, GLUSwavefront* wavefront, GLUSgroupList** currentGroupList, GLUSuint* numberGroups, GLUSuint* numberIndicesGroup)
+{
+    GLUSgroupList* newGroupList;
+
+    newGroupList = (GLUSgroupList*)glusMemoryMalloc(sizeof(GLUSgroupList));
+
+    if (!newGroupList)
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(newGroupList, 0, sizeof(GLUSgroupList));
+
+    strcpy(newGroupList->group.name, name);
+
+    if (*numberGroups == 0)
+    {
+        wavefront->groups = newGroupList;
+    }
+    else
+    {
+        if (!*currentGroupList)
+        {
+            glusMemoryFree(newGroupList);
+
+            return GLUS_FALSE;
+        }
+
+        (*currentGroupList)->next = newGroupList;
+
+        (*currentGroupList)->group.numberIndices = *numberIndicesGroup;
+        *numberIndicesGroup                      = 0;
+    }
+
+    *currentGroupList = newGroupList;
+
+    (*numberGroups)++;
+
+    return GLUS_TRUE;
+}
+
+static GLUSboolean glusWavefrontAppendEvent(GLUSwavefrontBuffer* events, const GLUSuint type, const GLUSuint corner, const GLUSchar* begin, const GLUSchar* end)
+{
+    GLUSwavefrontEvent* event;
+
+    event = (GLUSwavefrontEvent*)glusWavefrontBufferAppend(events, sizeof(GLUSwavefrontEvent));
+
+    if (!event)
+    {
+        return GLUS_FALSE;
+    }
+
+    event->type   = type;
+    event->corner = corner;
+    event->begin  = begin;
+    event->end    = end;
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Counts the vertices, normals and texture coordinates of a chunk. Needed to resolve the indices of the following chunks.
+ */
+static GLUSvoid glusWavefrontCountChunk(GLUSvoid* data, GLUSuint index)
+{
+    GLUSwavefrontChunk* chunk = (GLUSwavefrontChunk*)data + index;
+
+    const GLUSchar* current;
+    const GLUSchar* lineEnd;
+
+    for (current = chunk->begin; current < chunk->end; current = (lineEnd < chunk->end) ? lineEnd + 1 : chunk->end)
+    {
+        lineEnd = glusWavefrontFindLineEnd(current, chunk->end);
+
+        if (*current != 'v')
+        {
+            continue;
+        }
+
+        if (glusWavefrontIsKeyword(current, lineEnd, "vt", 2))
+        {
+            chunk->numberTexCoords++;
+        }
+        else if (glusWavefrontIsKeyword(current, lineEnd, "vn", 2))
+        {
+            chunk->numberNormals++;
+        }
+        else if (glusWavefrontIsKeyword(current, lineEnd, "v", 1))
+        {
+            chunk->numberVertices++;
+        }
+    }
+}
+
+/**
+ * Parses the geometry of a chunk. Material, group and object statements are recorded as events.
+ */
+static GLUSvoid glusWavefrontParseChunk(GLUSvoid* data, GLUSuint index)
+{
+    GLUSwavefrontChunk* chunk = (GLUSwavefrontChunk*)data + index;
+
+    const GLUSchar* current;
+    const GLUSchar* lineEnd;
+    const GLUSchar* end = chunk->end;
+
+    // Counts include the previous chunks, so relative and absolute indices are resolved as in one pass.
+    GLUSuint numberVertices  = chunk->offsetVertices;
+    GLUSuint numberNormals   = chunk->offsetNormals;
+    GLUSuint numberTexCoords = chunk->offsetTexCoords;
+
+    GLUSuint numberCorners = 0;
+
+    chunk->result = GLUS_FALSE;
+
+    for (current = chunk->begin; current < end; current = (lineEnd < end) ? lineEnd + 1 : end)
+    {
+        lineEnd = glusWavefrontFindLineEnd(current, end);
+
+        if (chunk->recordGroups)
+        {
+            if (glusWavefrontIsKeyword(current, lineEnd, "mtllib", 6))
+            {
+                if (!glusWavefrontAppendEvent(&chunk->events, GLUS_WAVEFRONT_EVENT_MTLLIB, numberCorners, current + 6, lineEnd))
+                {
+                    return;
+                }
+
+                continue;
+            }
+            else if (glusWavefrontIsKeyword(current, lineEnd, "usemtl", 6))
+            {
+                if (!glusWavefrontAppendEvent(&chunk->events, GLUS_WAVEFRONT_EVENT_USEMTL, numberCorners, current + 6, lineEnd))
+                {
+                    return;
+                }
+
+                continue;
+            }
+            else if (glusWavefrontIsKeyword(current, lineEnd, "g", 1))
+            {
+                if (!glusWavefrontAppendEvent(&chunk->events, GLUS_WAVEFRONT_EVENT_GROUP, numberCorners, current + 1, lineEnd))
+                {
+                    return;
+                }
+
+                continue;
+            }
+        }
+
+        if (glusWavefrontIsKeyword(current, lineEnd, "o", 1))
+        {
+            if (!glusWavefrontAppendEvent(&chunk->events, GLUS_WAVEFRONT_EVENT_OBJECT, numberCorners, current + 1, lineEnd))
+            {
+                return;
+            }
+        }
+        else if (glusWavefrontIsKeyword(current, lineEnd, "vt", 2))
+        {
+            GLUSfloat* texCoord;
+
+            texCoord = (GLUSfloat*)glusWavefrontBufferAppend(&chunk->texCoords, 2 * sizeof(GLUSfloat));
+
+            if (!texCoord)
+            {
+                return;
+            }
+
+            texCoord[0] = 0.0f;
+            texCoord[1] = 0.0f;
+
+            current += 2;
+
+            if ((current = glusWavefrontParseFloat(current, lineEnd, &texCoord[0])) != 0)
+            {
+                glusWavefrontParseFloat(current, lineEnd, &texCoord[1]);
+            }
+
+            numberTexCoords++;
+        }
+        else if (glusWavefrontIsKeyword(current, lineEnd, "vn", 2))
+        {
+            GLUSfloat* normal;
+
+            normal = (GLUSfloat*)glusWavefrontBufferAppend(&chunk->normals, 3 * sizeof(GLUSfloat));
+
+            if (!normal)
+            {
+                return;
+            }
+
+            normal[0] = 0.0f;
+            normal[1] = 0.0f;
+            normal[2] = 0.0f;
+
+            current += 2;
+
+            if ((current = glusWavefrontParseFloat(current, lineEnd, &normal[0])) != 0 && (current = glusWavefrontParseFloat(current, lineEnd, &normal[1])) != 0)
+            {
+                glusWavefrontParseFloat(current, lineEnd, &normal[2]);
+            }
+
+            numberNormals++;
+        }
+        else if (glusWavefrontIsKeyword(current, lineEnd, "v", 1))
+        {
+            GLUSfloat* vertex;
+
+            vertex = (GLUSfloat*)glusWavefrontBufferAppend(&chunk->vertices, 4 * sizeof(GLUSfloat));
+
+            if (!vertex)
+            {
+                return;
+            }
+
+            vertex[0] = 0.0f;
+            vertex[1] = 0.0f;
+            vertex[2] = 0.0f;
+            vertex[3] = 1.0f;
+
+            current += 1;
+
+            if ((current = glusWavefrontParseFloat(current, lineEnd, &vertex[0])) != 0 && (current = glusWavefrontParseFloat(current, lineEnd, &vertex[1])) != 0)
+            {
+                glusWavefrontParseFloat(current, lineEnd, &vertex[2]);
+            }
+
+            numberVertices++;
+        }
+        else if (glusWavefrontIsKeyword(current, lineEnd, "f", 1))
+        {
+            GLUSint vIndex, vtIndex, vnIndex;
+
+            GLUSwavefrontCorner corner;
+
+            GLUSuint edgeCount = 0;
+
+            // First corner of the polygon, as the polygon is triangulated as a fan.
+            GLUSuint firstCorner = numberCorners;
+
+            current += 1;
+
+            while ((current = glusWavefrontSkipSpaces(current, lineEnd)) < lineEnd && *current != '#')
+            {
+                current = glusWavefrontParseFaceVertex(current, lineEnd, &vIndex, &vtIndex, &vnIndex, numberVertices, numberTexCoords, numberNormals);
+
+                if (!current)
+                {
+                    return;
+                }
+
+                // Indices are one based.
+
+                corner.vertex   = vIndex - 1;
+                corner.texCoord = vtIndex - 1;
+                corner.normal   = vnIndex - 1;
+
+                if (!glusWavefrontAppendCorner(&chunk->corners, firstCorner, &corner, edgeCount))
+                {
+                    return;
+                }
+
+                numberCorners += (edgeCount < 3) ? 1 : 3;
+
+                edgeCount++;
+            }
+        }
+    }
+
+    chunk->result = GLUS_TRUE;
+}
+
+/**
+ * Splits the file at line boundaries into chunks of roughly the same size.
+ */
+static GLUSwavefrontChunk* glusWavefrontCreateChunks(const GLUSchar* begin, const GLUSchar* end, GLUSuint numberChunks, const GLUSboolean recordGroups)
+{
+    GLUSwavefrontChunk* chunks;
+
+    size_t chunkSize = (size_t)(end - begin) / numberChunks;
+
+    GLUSuint i;
+
+    chunks = (GLUSwavefrontChunk*)glusMemoryMalloc(numberChunks * sizeof(GLUSwavefrontChunk));
+
+    if (!chunks)
+    {
+        return 0;
+    }
+
+    memset(chunks, 0, numberChunks * sizeof(GLUSwavefrontChunk));
+
+    for (i = 0; i < numberChunks; i++)
+    {
+        // A single chunk uses the global scratch statistic directly.
+        GLUSwavefrontScratch* scratch = (numberChunks == 1) ? &g_wavefrontScratch : &chunks[i].scratch;
+
+        chunks[i].begin = (i == 0) ? begin : chunks[i - 1].end;
+
+        if (i == numberChunks - 1 || (size_t)(end - chunks[i].begin) <= chunkSize)
+        {
+            chunks[i].end = end;
+        }
+        else
+        {
+            chunks[i].end = glusWavefrontFindLineEnd(chunks[i].begin + chunkSize, end);
+
+            if (chunks[i].end < end)
+            {
+                chunks[i].end++;
+            }
+        }
+
+        chunks[i].recordGroups = recordGroups;
+
+        glusWavefrontBufferInit(&chunks[i].vertices, scratch);
+        glusWavefrontBufferInit(&chunks[i].normals, scratch);
+        glusWavefrontBufferInit(&chunks[i].texCoords, scratch);
+        glusWavefrontBufferInit(&chunks[i].corners, scratch);
+        glusWavefrontBufferInit(&chunks[i].events, scratch);
+    }
+
+    return chunks;
+}
+
+static GLUSvoid glusWavefrontDestroyChunks(GLUSwavefrontChunk* chunks, const GLUSuint numberChunks)
+{
+    GLUSuint i;
+
+    if (!chunks)
+    {
+        return;
+    }
+
+    for (i = 0; i < numberChunks; i++)
+    {
+        glusWavefrontBufferFree(&chunks[i].vertices);
+        glusWavefrontBufferFree(&chunks[i].normals);
+        glusWavefrontBufferFree(&chunks[i].texCoords);
+        glusWavefrontBufferFree(&chunks[i].corners);
+        glusWavefrontBufferFree(&chunks[i].events);
+    }
+
+    glusMemoryFree(chunks);
+}
+
+/**
+ * Appends the content of a chunk buffer to the final buffer and frees the chunk buffer.
+ */
+static GLUSboolean glusWavefrontMergeBuffer(GLUSwavefrontBuffer* buffer, GLUSwavefrontBuffer* chunkBuffer)
+{
+    GLUSvoid* data;
+
+    if (!chunkBuffer->data)
+    {
+        return GLUS_TRUE;
+    }
+
+    if (!buffer->data)
+    {
+        // Take over the memory of the first chunk.
+        *buffer = *chunkBuffer;
+
+        glusWavefrontBufferInit(chunkBuffer, buffer->scratch);
+
+        return GLUS_TRUE;
+    }
+
+    data = glusWavefrontBufferAppend(buffer, chunkBuffer->size);
+
+    if (!data)
+    {
+        return GLUS_FALSE;
+    }
+
+    memcpy(data, chunkBuffer->data, chunkBuffer->size);
+
+    glusWavefrontBufferFree(chunkBuffer);
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Parses all chunks, in parallel if more than one thread is requested, and merges the geometry in file order.
+ */
+static GLUSboolean glusWavefrontParseChunks(GLUSwavefrontChunk* chunks, const GLUSuint numberChunks, const GLUSuint numberThreads, GLUSwavefrontBuffer* vertices, GLUSwavefrontBuffer* normals, GLUSwavefrontBuffer* texCoords, GLUSwavefrontBuffer* corners)
+{
+    GLUSuint i;
+
+    if (numberChunks == 1)
+    {
+        glusWavefrontParseChunk(chunks, 0);
+    }
+    else
+    {
+        _glusThreadRun(glusWavefrontCountChunk, chunks, numberChunks, numberThreads);
+
+        // Prefix sum of the counts.
+        for (i = 1; i < numberChunks; i++)
+        {
+            chunks[i].offsetVertices  = chunks[i - 1].offsetVertices + chunks[i - 1].numberVertices;
+            chunks[i].offsetNormals   = chunks[i - 1].offsetNormals + chunks[i - 1].numberNormals;
+            chunks[i].offsetTexCoords = chunks[i - 1].offsetTexCoords + chunks[i - 1].numberTexCoords;
+        }
+
+        _glusThreadRun(glusWavefrontParseChunk, chunks, numberChunks, numberThreads);
+
+        // The chunks were running at the same time, so the sum of the chunk peaks is the worst case.
+        for (i = 0; i < numberChunks; i++)
+        {
+            g_wavefrontScratch.current += chunks[i].scratch.current;
+            g_wavefrontScratch.peak += chunks[i].scratch.peak;
+
+            chunks[i].vertices.scratch  = &g_wavefrontScratch;
+            chunks[i].normals.scratch   = &g_wavefrontScratch;
+            chunks[i].texCoords.scratch = &g_wavefrontScratch;
+            chunks[i].corners.scratch   = &g_wavefrontScratch;
+            chunks[i].events.scratch    = &g_wavefrontScratch;
+        }
+    }
+
+    for (i = 0; i < numberChunks; i++)
+    {
+        if (!chunks[i].result)
+        {
+            return GLUS_FALSE;
+        }
+    }
+
+    for (i = 0; i < numberChunks; i++)
+    {
+        chunks[i].offsetCorners = (GLUSuint)(corners->size / sizeof(GLUSwavefrontCorner));
+
+        if (!glusWavefrontMergeBuffer(vertices, &chunks[i].vertices) || !glusWavefrontMergeBuffer(normals, &chunks[i].normals) || !glusWavefrontMergeBuffer(texCoords, &chunks[i].texCoords) || !glusWavefrontMergeBuffer(corners, &chunks[i].corners))
+        {
+            return GLUS_FALSE;
+        }
+    }
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Collects the material libraries of an OBJ file in the same way as the parser, so the cache can check them.
+ *
+ * @return GLUS_FALSE, if the file can not be mapped or has more than maxNumberNames material libraries.
+ */
+GLUSboolean _glusWavefrontGetMaterialLibraries(const GLUSchar* filename, GLUSchar (*names)[GLUS_MAX_STRING], const GLUSuint maxNumberNames, GLUSuint* numberNames)
+{
+    GLUSmappedfile mappedFile;
+
+    const GLUSchar* current;
+    const GLUSchar* end;
+    const GLUSchar* lineEnd;
+
+    *numberNames = 0;
+
+    if (!glusFileMap(filename, &mappedFile))
+    {
+        return GLUS_FALSE;
+    }
+
+    end = (const GLUSchar*)mappedFile.data + mappedFile.length;
+
+    for (current = (const GLUSchar*)mappedFile.data; current < end; current = (lineEnd < end) ? lineEnd + 1 : end)
+    {
+        lineEnd = glusWavefrontFindLineEnd(current, end);
+
+        if (!glusWavefrontIsKeyword(current, lineEnd, "mtllib", 6))
+        {
+            continue;
+        }
+
+        if (*numberNames == maxNumberNames)
+        {
+            glusFileUnmap(&mappedFile);
+
+            return GLUS_FALSE;
+        }
+
+        names[*numberNames][0] = '\0';
+
+        glusWavefrontParseName(current + 6, lineEnd, names[*numberNames]);
+
+        (*numberNames)++;
+    }
+
+    glusFileUnmap(&mappedFile);
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean _glusWavefrontParse(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSshape* shape, GLUSwavefront* wavefront, GLUSscene* scene)
+{
+    GLUSboolean result;
+
+    GLUSmappedfile mappedFile;
+
+    GLUSwavefrontBuffer vertices;
+    GLUSwavefrontBuffer normals;
+    GLUSwavefrontBuffer texCoords;
+
+    GLUSwavefrontBuffer corners;
+
+    GLUSuint offsetNumberCorners = 0;
+
+    GLUSuint totalNumberCorners = 0;
+
+    GLUSboolean expandVertices = options ? options->expandVertices : GLUS_FALSE;
+
+    // Chunks
+
+    GLUSwavefrontChunk* chunks;
+
+    GLUSuint numberChunks = 1;
+
+    GLUSuint numberThreads = options ? options->numberThreads : 0;
+
+    GLUSuint chunkIndex;
+    GLUSuint eventIndex;
+
+    // Material and groups
+
+    GLUSchar name[GLUS_MAX_STRING];
+
+    GLUSuint numberIndicesGroup = 0;
+    GLUSuint numberMaterials    = 0;
+    GLUSuint numberGroups       = 0;
+
+    GLUSgroupList*  currentGroupList  = 0;
+    GLUSobjectList* currentObjectList = 0;
+
+    // Objects
+
+    GLUSuint numberObjects = 0;
+
+    if (scene)
+    {
+        memset(scene, 0, sizeof(GLUSscene));
+    }
+
+    if (wavefront)
+    {
+        memset(wavefront, 0, sizeof(GLUSwavefront));
+    }
+
+    if (shape)
+    {
+        memset(shape, 0, sizeof(GLUSshape));
+    }
 
-                // Always create a new object.
+    if (!filename || !shape)
+    {
+        return GLUS_FALSE;
+    }
 
-                newObjectList = (GLUSobjectList*)glusMemoryMalloc(sizeof(GLUSobjectList));
-                if (!newObjectList)
-                {
-                    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+    if (!glusFileMap(filename, &mappedFile))
+    {
+        return GLUS_FALSE;
+    }
 
-                    glusFileClose(f);
+    glusWavefrontInitTempMemory(&vertices, &normals, &texCoords, &corners);
 
-                    return GLUS_FALSE;
-                }
-                newObjectList->next = 0;
+    if (numberThreads > 1)
+    {
+        numberChunks = (GLUSuint)(mappedFile.length / GLUS_MIN_CHUNK_SIZE);
 
-                // Link together.
-                if (currentObjectList)
-                {
-                    currentObjectList->next = newObjectList;
-                }
-                currentObjectList = newObjectList;
+        if (numberChunks > numberThreads)
+        {
+            numberChunks = numberThreads;
+        }
 
-                // Set as root, if needed.
-                if (scene->objectList == 0)
-                {
-                    scene->objectList = currentObjectList;
-                }
+        if (numberChunks < 1)
+        {
+            numberChunks = 1;
+        }
+    }
 
-                // Remember offset and reset values.
+    chunks = glusWavefrontCreateChunks((const GLUSchar*)mappedFile.data, (const GLUSchar*)mappedFile.data + mappedFile.length, numberChunks, wavefront != 0);
 
-                offsetNumberVertices  = totalNumberVertices;
-                offsetNumberNormals   = totalNumberNormals;
-                offsetNumberTexCoords = totalNumberTexCoords;
+    if (!chunks)
+    {
+        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &corners);
 
-                numberGroups = 0;
+        glusFileUnmap(&mappedFile);
 
-                currentGroupList = 0;
-            }
-            else if (wavefront)
-            {
-                GLUSgroupList* newGroupList;
+        return GLUS_FALSE;
+    }
 
-                sscanf(buffer, "%s %s", identifier, name);
+    if (!glusWavefrontParseChunks(chunks, numberChunks, numberThreads, &vertices, &normals, &texCoords, &corners))
+    {
+        glusWavefrontDestroyChunks(chunks, numberChunks);
 
-                newGroupList = (GLUSgroupList*)glusMemoryMalloc(sizeof(GLUSgroupList));
+        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &corners);
 
-                if (!newGroupList)
-                {
-                    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+        glusFileUnmap(&mappedFile);
 
-                    glusFileClose(f);
+        return GLUS_FALSE;
+    }
 
-                    return GLUS_FALSE;
-                }
+    name[0] = '\0';
 
-                memset(newGroupList, 0, sizeof(GLUSgroupList));
+    // Replay the events in file order. The names are still referenced in the mapped file.
 
-                strcpy(newGroupList->group.name, name);
+    for (chunkIndex = 0; chunkIndex < numberChunks; chunkIndex++)
+    {
+        const GLUSwavefrontEvent* events = (const GLUSwavefrontEvent*)chunks[chunkIndex].events.data;
 
-                if (numberGroups == 0)
-                {
-                    wavefront->groups = newGroupList;
-                }
-                else
-                {
-                    if (!currentGroupList)
-                    {
-                        glusMemoryFree(newGroupList);
+        GLUSuint numberEvents = (GLUSuint)(chunks[chunkIndex].events.size / sizeof(GLUSwavefrontEvent));
 
-                        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+        for (eventIndex = 0; eventIndex < numberEvents; eventIndex++)
+        {
+            const GLUSwavefrontEvent* event = &events[eventIndex];
 
-                        glusFileClose(f);
+            GLUSuint eventCorner = chunks[chunkIndex].offsetCorners + event->corner;
 
-                        return GLUS_FALSE;
-                    }
+            // Faces since the previous event.
+            numberIndicesGroup += eventCorner - totalNumberCorners;
+            totalNumberCorners = eventCorner;
 
-                    currentGroupList->next = newGroupList;
+            if (event->type == GLUS_WAVEFRONT_EVENT_MTLLIB)
+            {
+                glusWavefrontParseName(event->begin, event->end, name);
 
-                    currentGroupList->group.numberIndices = numberIndicesGroup;
-                    numberIndicesGroup                    = 0;
+                if (numberMaterials == 0)
+                {
+                    wavefront->materials = 0;
                 }
 
-                currentGroupList = newGroupList;
-
-                numberGroups++;
-            }
-            else
-            {
-                if (numberObjects == GLUS_MAX_OBJECTS)
+                if (!glusWavefrontLoadMaterial(name, &wavefront->materials))
                 {
-                    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+                    glusWavefrontDestroyChunks(chunks, numberChunks);
+
+                    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &corners);
 
-                    glusFileClose(f);
+                    glusFileUnmap(&mappedFile);
 
                     return GLUS_FALSE;
                 }
-            }
-
-            numberObjects++;
-        }
-        else if (strncmp(buffer, "vt", 2) == 0)
-        {
-            if (numberTexCoords == GLUS_MAX_ATTRIBUTES)
-            {
-                glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-                glusFileClose(f);
-
-                return GLUS_FALSE;
+                numberMaterials++;
             }
-
-            sscanf(buffer, "%s %f %f", identifier, &s, &t);
-
-            texCoords[2 * numberTexCoords + 0] = s;
-            texCoords[2 * numberTexCoords + 1] = t;
-
-            numberTexCoords++;
-        }
-        else if (strncmp(buffer, "vn", 2) == 0)
-        {
-            if (numberNormals == GLUS_MAX_ATTRIBUTES)
+            else if (event->type == GLUS_WAVEFRONT_EVENT_USEMTL)
             {
-                glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
-
-                glusFileClose(f);
+                if (!currentGroupList || currentGroupList->group.materialName[0] != '\0')
+                {
+                    if (!glusWavefrontAppendGroup(name, wavefront, &currentGroupList, &numberGroups, &numberIndicesGroup))
+                    {
+                        glusWavefrontDestroyChunks(chunks, numberChunks);
 
-                return GLUS_FALSE;
-            }
+                        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &corners);
 
-            sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
+                        glusFileUnmap(&mappedFile);
 
-            normals[3 * numberNormals + 0] = x;
-            normals[3 * numberNormals + 1] = y;
-            normals[3 * numberNormals + 2] = z;
+                        return GLUS_FALSE;
+                    }
+                }
 
-            numberNormals++;
-        }
-        else if (strncmp(buffer, "v", 1) == 0)
-        {
-            if (numberVertices == GLUS_MAX_ATTRIBUTES)
-            {
-                glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+                //
 
-                glusFileClose(f);
+                glusWavefrontParseName(event->begin, event->end, name);
 
-                return GLUS_FALSE;
+                strcpy(currentGroupList->group.materialName, name);
             }
-
-            sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
-
-            vertices[4 * numberVertices + 0] = x;
-            vertices[4 * numberVertices + 1] = y;
-            vertices[4 * numberVertices + 2] = z;
-            vertices[4 * numberVertices + 3] = 1.0f;
-
-            numberVertices++;
-        }
-        else if (strncmp(buffer, "f", 1) == 0)
-        {
-            GLUSchar* token;
-
-            GLUSint vIndex, vtIndex, vnIndex;
-
-            GLUSuint edgeCount = 0;
-
-            token = strtok(buffer, " \t");
-            token = strtok(0, " \n");
-
-            if (!token)
+            else if (event->type == GLUS_WAVEFRONT_EVENT_GROUP)
             {
-                continue;
-            }
+                glusWavefrontParseName(event->begin, event->end, name);
 
-            // Check faces
-            if (strstr(token, "//") != 0)
-            {
-                facesEncoding = 2;
-            }
-            else if (strstr(token, "/") == 0)
-            {
-                facesEncoding = 0;
-            }
-            else if (strstr(token, "/") != 0)
-            {
-                GLUSchar* c = strstr(token, "/");
+                if (!glusWavefrontAppendGroup(name, wavefront, &currentGroupList, &numberGroups, &numberIndicesGroup))
+                {
+                    glusWavefrontDestroyChunks(chunks, numberChunks);
 
-                c++;
+                    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &corners);
 
-                if (!c)
-                {
-                    continue;
-                }
+                    glusFileUnmap(&mappedFile);
 
-                if (strstr(c, "/") == 0)
-                {
-                    facesEncoding = 1;
-                }
-                else
-                {
-                    facesEncoding = 3;
+                    return GLUS_FALSE;
                 }
             }
-
-            while (token != 0)
+            else if (event->type == GLUS_WAVEFRONT_EVENT_OBJECT)
             {
-                vIndex  = -1;
-                vtIndex = -1;
-                vnIndex = -1;
-
-                switch (facesEncoding)
+                if (scene)
                 {
-                case 0:
-                    sscanf(token, "%d", &vIndex);
-                    break;
-                case 1:
-                    sscanf(token, "%d/%d", &vIndex, &vtIndex);
-                    break;
-                case 2:
-                    sscanf(token, "%d//%d", &vIndex, &vnIndex);
-                    break;
-                case 3:
-                    sscanf(token, "%d/%d/%d", &vIndex, &vtIndex, &vnIndex);
-                    break;
-                }
+                    GLUSobjectList* newObjectList;
 
-                vIndex--;
-                vtIndex--;
-                vnIndex--;
-
-                if (vIndex >= 0)
-                {
-                    if (edgeCount < 3)
+                    if (currentObjectList)
                     {
-                        if (totalNumberVertices >= GLUS_MAX_TRIANGLE_ATTRIBUTES)
+                        if (wavefront && currentGroupList)
                         {
-                            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+                            currentGroupList->group.numberIndices = numberIndicesGroup;
+                            numberIndicesGroup                    = 0;
+                        }
 
-                            glusFileClose(f);
+                        result = glusWavefrontCopyData(shape, (GLUSwavefrontCorner*)corners.data + offsetNumberCorners, totalNumberCorners - offsetNumberCorners, &vertices, &normals, &texCoords, expandVertices);
 
-                            return GLUS_FALSE;
+                        if (result)
+                        {
+                            glusShapeCalculateTangentBitangentf(shape);
                         }
 
-                        memcpy(&triangleVertices[4 * totalNumberVertices], &vertices[4 * vIndex], 4 * sizeof(GLUSfloat));
-
-                        totalNumberVertices++;
-                        numberIndicesGroup++;
-                    }
-                    else
-                    {
-                        if (totalNumberVertices >= GLUS_MAX_TRIANGLE_ATTRIBUTES - 2)
+                        if (!result || !_glusWavefrontMove(wavefront, shape))
                         {
-                            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+                            glusShapeDestroyf(shape);
+
+                            glusWavefrontDestroyChunks(chunks, numberChunks);
+
+                            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &corners);
 
-                            glusFileClose(f);
+                            glusFileUnmap(&mappedFile);
 
                             return GLUS_FALSE;
                         }
 
-                        memcpy(&triangleVertices[4 * (totalNumberVertices)], &triangleVertices[4 * (totalNumberVertices - edgeCount)], 4 * sizeof(GLUSfloat));
-                        memcpy(&triangleVertices[4 * (totalNumberVertices + 1)], &triangleVertices[4 * (totalNumberVertices - 1)], 4 * sizeof(GLUSfloat));
-                        memcpy(&triangleVertices[4 * (totalNumberVertices + 2)], &vertices[4 * vIndex], 4 * sizeof(GLUSfloat));
-
-                        totalNumberVertices += 3;
-                        numberIndicesGroup += 3;
+                        memcpy(&currentObjectList->object, wavefront, sizeof(GLUSwavefront));
                     }
-                }
-                if (vnIndex >= 0)
-                {
-                    if (edgeCount < 3)
+
+                    glusWavefrontParseName(event->begin, event->end, name);
+
+                    strcpy(wavefront->name, name);
+
+                    // Always create a new object.
+
+                    newObjectList = (GLUSobjectList*)glusMemoryMalloc(sizeof(GLUSobjectList));
+                    if (!newObjectList)
                     {
-                        if (totalNumberNormals >= GLUS_MAX_TRIANGLE_ATTRIBUTES)
-                        {
-                            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+                        glusWavefrontDestroyChunks(chunks, numberChunks);
 
-                            glusFileClose(f);
+                        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &corners);
 
-                            return GLUS_FALSE;
-                        }
+                        glusFileUnmap(&mappedFile);
 
-                        memcpy(&triangleNormals[3 * totalNumberNormals], &normals[3 * vnIndex], 3 * sizeof(GLUSfloat));
+                        return GLUS_FALSE;
+                    }
+                    newObjectList->next = 0;
 
-                        totalNumberNormals++;
+                    // Link together.
+                    if (currentObjectList)
+                    {
+                        currentObjectList->next = newObjectList;
                     }
-                    else
+                    currentObjectList = newObjectList;
+
+                    // Set as root, if needed.
+                    if (scene->objectList == 0)
                     {
-                        if (totalNumberNormals >= GLUS_MAX_TRIANGLE_ATTRIBUTES - 2)
-                        {
-                            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+                        scene->objectList = currentObjectList;
+                    }
 
-                            glusFileClose(f);
+                    // Remember offset and reset values.
 
-                            return GLUS_FALSE;
-                        }
+                    offsetNumberCorners = totalNumberCorners;
 
-                        memcpy(&triangleNormals[3 * (totalNumberNormals)], &triangleNormals[3 * (totalNumberNormals - edgeCount)], 3 * sizeof(GLUSfloat));
-                        memcpy(&triangleNormals[3 * (totalNumberNormals + 1)], &triangleNormals[3 * (totalNumberNormals - 1)], 3 * sizeof(GLUSfloat));
-                        memcpy(&triangleNormals[3 * (totalNumberNormals + 2)], &normals[3 * vnIndex], 3 * sizeof(GLUSfloat));
+                    numberGroups = 0;
 
-                        totalNumberNormals += 3;
-                    }
+                    currentGroupList = 0;
                 }
-                if (vtIndex >= 0)
+                else if (wavefront)
                 {
-                    if (edgeCount < 3)
-                    {
-                        if (totalNumberTexCoords >= GLUS_MAX_TRIANGLE_ATTRIBUTES)
-                        {
-                            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+                    glusWavefrontParseName(event->begin, event->end, name);
 
-                            glusFileClose(f);
+                    if (!glusWavefrontAppendGroup(name, wavefront, &currentGroupList, &numberGroups, &numberIndicesGroup))
+                    {
+                        glusWavefrontDestroyChunks(chunks, numberChunks);
 
-                            return GLUS_FALSE;
-                        }
+                        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &corners);
 
-                        memcpy(&triangleTexCoords[2 * totalNumberTexCoords], &texCoords[2 * vtIndex], 2 * sizeof(GLUSfloat));
+                        glusFileUnmap(&mappedFile);
 
-                        totalNumberTexCoords++;
+                        return GLUS_FALSE;
                     }
-                    else
+                }
+                else
+                {
+                    if (numberObjects == GLUS_MAX_OBJECTS)
                     {
-                        if (totalNumberTexCoords >= GLUS_MAX_TRIANGLE_ATTRIBUTES - 2)
-                        {
-                            glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
-
-                            glusFileClose(f);
+                        glusWavefrontDestroyChunks(chunks, numberChunks);
 
-                            return GLUS_FALSE;
-                        }
+                        glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &corners);
 
-                        memcpy(&triangleTexCoords[2 * (totalNumberTexCoords)], &triangleTexCoords[2 * (totalNumberTexCoords - edgeCount)], 2 * sizeof(GLUSfloat));
-                        memcpy(&triangleTexCoords[2 * (totalNumberTexCoords + 1)], &triangleTexCoords[2 * (totalNumberTexCoords - 1)], 2 * sizeof(GLUSfloat));
-                        memcpy(&triangleTexCoords[2 * (totalNumberTexCoords + 2)], &texCoords[2 * vtIndex], 2 * sizeof(GLUSfloat));
+                        glusFileUnmap(&mappedFile);
 
-                        totalNumberTexCoords += 3;
+                        return GLUS_FALSE;
                     }
                 }
 
-                edgeCount++;
-
-                token = strtok(0, " \n");
+                numberObjects++;
             }
         }
     }
 
-    glusFileClose(f);
+    glusWavefrontDestroyChunks(chunks, numberChunks);
+
+    glusFileUnmap(&mappedFile);
+
+    // Faces after the last event.
+    numberIndicesGroup += (GLUSuint)(corners.size / sizeof(GLUSwavefrontCorner)) - totalNumberCorners;
+    totalNumberCorners = (GLUSuint)(corners.size / sizeof(GLUSwavefrontCorner));
 
     if (wavefront && currentGroupList)
     {
@@ -1297,9 +2187,9 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
         numberIndicesGroup                    = 0;
     }
 
-    result = glusWavefrontCopyData(shape, totalNumberVertices - offsetNumberVertices, &triangleVertices[4 * offsetNumberVertices], totalNumberNormals - offsetNumberNormals, &triangleNormals[3 * offsetNumberNormals], totalNumberTexCoords - offsetNumberTexCoords, &triangleTexCoords[2 * offsetNumberTexCoords]);
+    result = glusWavefrontCopyData(shape, (GLUSwavefrontCorner*)corners.data + offsetNumberCorners, totalNumberCorners - offsetNumberCorners, &vertices, &normals, &texCoords, expandVertices);
 
-    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
+    glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &corners);
 
     if (result)
     {
@@ -1342,18 +2232,15 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
 {
     GLUSboolean result;
 
-    FILE* f;
-
-    GLUSchar buffer[GLUS_BUFFERSIZE];
-    GLUSchar identifier[32];
+    GLUSmappedfile mappedFile;
 
-    GLUSfloat x, y, z;
+    const GLUSchar* current;
+    const GLUSchar* lineEnd;
+    const GLUSchar* end;
 
-    GLUSint start, end;
+    GLUSwavefrontBuffer vertices;
 
-    GLUSfloat* vertices = 0;
-
-    GLUSindex* indices = 0;
+    GLUSwavefrontBuffer indices;
 
     GLUSuint numberVertices = 0;
 
@@ -1373,129 +2260,128 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
         return GLUS_FALSE;
     }
 
-    f = glusFileOpen(filename, "r");
-
-    if (!f)
+    if (!glusFileMap(filename, &mappedFile))
     {
         return GLUS_FALSE;
     }
 
-    if (!glusWavefrontMallocTempMemoryLine(&vertices, &indices))
-    {
-        glusWavefrontFreeTempMemoryLine(&vertices, &indices);
-
-        glusFileClose(f);
+    glusWavefrontInitTempMemoryLine(&vertices, &indices);
 
-        return GLUS_FALSE;
-    }
+    current = (const GLUSchar*)mappedFile.data;
+    end     = current + mappedFile.length;
 
-    while (!feof(f))
+    for (; current < end; current = (lineEnd < end) ? lineEnd + 1 : end)
     {
-        buffer[0] = 0;
-
-        if (fgets(buffer, GLUS_BUFFERSIZE, f) == 0)
-        {
-            if (ferror(f))
-            {
-                glusWavefrontFreeTempMemoryLine(&vertices, &indices);
-
-                glusFileClose(f);
-
-                return GLUS_FALSE;
-            }
-        }
+        lineEnd = glusWavefrontFindLineEnd(current, end);
 
-        if (strncmp(buffer, "o", 1) == 0)
+        if (glusWavefrontIsKeyword(current, lineEnd, "o", 1))
         {
             if (numberObjects == GLUS_MAX_OBJECTS)
             {
                 glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-                glusFileClose(f);
+                glusFileUnmap(&mappedFile);
 
                 return GLUS_FALSE;
             }
 
             numberObjects++;
         }
-        else if (strncmp(buffer, "v", 1) == 0)
+        else if (glusWavefrontIsKeyword(current, lineEnd, "v", 1))
         {
-            if (numberVertices == GLUS_MAX_ATTRIBUTES)
+            GLUSfloat* vertex;
+
+            vertex = (GLUSfloat*)glusWavefrontBufferAppend(&vertices, 4 * sizeof(GLUSfloat));
+
+            if (!vertex)
             {
                 glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-                glusFileClose(f);
+                glusFileUnmap(&mappedFile);
 
                 return GLUS_FALSE;
             }
 
-            sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
+            vertex[0] = 0.0f;
+            vertex[1] = 0.0f;
+            vertex[2] = 0.0f;
+            vertex[3] = 1.0f;
 
-            vertices[4 * numberVertices + 0] = x;
-            vertices[4 * numberVertices + 1] = y;
-            vertices[4 * numberVertices + 2] = z;
-            vertices[4 * numberVertices + 3] = 1.0f;
+            current += 1;
+
+            if ((current = glusWavefrontParseFloat(current, lineEnd, &vertex[0])) != 0 && (current = glusWavefrontParseFloat(current, lineEnd, &vertex[1])) != 0)
+            {
+                glusWavefrontParseFloat(current, lineEnd, &vertex[2]);
+            }
 
             numberVertices++;
         }
-        else if (strncmp(buffer, "l", 1) == 0)
+        else if (glusWavefrontIsKeyword(current, lineEnd, "l", 1))
         {
-            if (numberIndices == GLUS_MAX_LINE_ATTRIBUTES)
-            {
-                glusWavefrontFreeTempMemoryLine(&vertices, &indices);
+            GLUSint index;
 
-                glusFileClose(f);
+            GLUSindex* lineIndices;
 
-                return GLUS_FALSE;
-            }
+            GLUSuint edgeCount = 0;
 
-            sscanf(buffer, "%s %d %d", identifier, &start, &end);
+            current += 1;
 
-            if (start > 0)
-            {
-                start--;
-            }
-            else if (start < 0)
-            {
-                start += numberVertices;
-            }
-            else
+            // A polyline is split into line segments.
+            while ((current = glusWavefrontSkipSpaces(current, lineEnd)) < lineEnd && *current != '#')
             {
-                glusWavefrontFreeTempMemoryLine(&vertices, &indices);
+                current = glusWavefrontParseInt(current, lineEnd, &index);
 
-                glusFileClose(f);
+                if (current && index < 0)
+                {
+                    index += (GLUSint)numberVertices + 1;
+                }
 
-                return GLUS_FALSE;
-            }
+                if (!current || index <= 0 || index > (GLUSint)numberVertices || !(lineIndices = (GLUSindex*)glusWavefrontBufferAppend(&indices, (edgeCount >= 2 ? 2 : 1) * sizeof(GLUSindex))))
+                {
+                    glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-            if (end > 0)
-            {
-                end--;
-            }
-            else if (end < 0)
-            {
-                end += numberVertices;
+                    glusFileUnmap(&mappedFile);
+
+                    return GLUS_FALSE;
+                }
+
+                // Skip texture coordinate index, if available.
+                while (current < lineEnd && !glusWavefrontIsSpace(*current))
+                {
+                    current++;
+                }
+
+                if (edgeCount >= 2)
+                {
+                    lineIndices[0] = lineIndices[-1];
+
+                    lineIndices++;
+
+                    numberIndices++;
+                }
+
+                // Indices are one based.
+                lineIndices[0] = (GLUSindex)(index - 1);
+
+                numberIndices++;
+
+                edgeCount++;
             }
-            else
+
+            if (edgeCount == 1)
             {
                 glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-                glusFileClose(f);
+                glusFileUnmap(&mappedFile);
 
                 return GLUS_FALSE;
             }
-
-            indices[numberIndices + 0] = (GLUSindex)start;
-            indices[numberIndices + 1] = (GLUSindex)end;
-
-            numberIndices += 2;
-            ;
         }
     }
 
-    glusFileClose(f);
+    glusFileUnmap(&mappedFile);
 
-    result = glusWavefrontCopyDataLine(line, numberVertices, vertices, numberIndices, indices);
+    result = glusWavefrontCopyDataLine(line, numberVertices, (GLUSfloat*)vertices.data, numberIndices, (GLUSindex*)indices.data);
 
     glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
@@ -1505,10 +2391,20 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
 //
 
 GLUSboolean GLUSAPIENTRY glusWavefrontLoad(const GLUSchar* filename, GLUSwavefront* wavefront)
+{
+    return glusWavefrontLoadWith(filename, 0, wavefront);
+}
+
+GLUSboolean GLUSAPIENTRY glusWavefrontLoadWith(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSwavefront* wavefront)
 {
     GLUSshape dummyShape;
 
-    if (!_glusWavefrontParse(filename, &dummyShape, wavefront, 0))
+    if (options && options->useCache && _glusWavefrontCacheLoad(filename, options, wavefront))
+    {
+        return GLUS_TRUE;
+    }
+
+    if (!_glusWavefrontParse(filename, options, &dummyShape, wavefront, 0))
     {
         glusWavefrontDestroy(wavefront);
 
@@ -1522,6 +2418,12 @@ GLUSboolean GLUSAPIENTRY glusWavefrontLoad(const GLUSchar* filename, GLUSwavefro
         return GLUS_FALSE;
     }
 
+    // Not being able to write the cache is not an error.
+    if (options && options->useCache)
+    {
+        _glusWavefrontCacheSave(filename, options, wavefront);
+    }
+
     return GLUS_TRUE;
 }
 
@@ -1574,6 +2476,11 @@ GLUSvoid GLUSAPIENTRY glusWavefrontDestroy(GLUSwavefront* wavefront)
 }
 
 GLUSboolean GLUSAPIENTRY glusWavefrontLoadScene(const GLUSchar* filename, GLUSscene* scene)
+{
+    return glusWavefrontLoadSceneWith(filename, 0, scene);
+}
+
+GLUSboolean GLUSAPIENTRY glusWavefrontLoadSceneWith(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSscene* scene)
 {
     GLUSshape     dummyShape;
     GLUSwavefront dummyWavefront;
@@ -1588,16 +2495,32 @@ GLUSboolean GLUSAPIENTRY glusWavefrontLoadScene(const GLUSchar* filename, GLUSsc
 
     memset(scene, 0, sizeof(GLUSscene));
 
-    if (!_glusWavefrontParse(filename, &dummyShape, &dummyWavefront, scene))
+    if (options && options->useCache && _glusWavefrontCacheLoadScene(filename, options, scene))
+    {
+        return GLUS_TRUE;
+    }
+
+    if (!_glusWavefrontParse(filename, options, &dummyShape, &dummyWavefront, scene))
     {
         glusWavefrontDestroyScene(scene);
 
         return GLUS_FALSE;
     }
 
+    // Not being able to write the cache is not an error.
+    if (options && options->useCache)
+    {
+        _glusWavefrontCacheSaveScene(filename, options, scene);
+    }
+
     return GLUS_TRUE;
 }
 
+size_t GLUSAPIENTRY glusWavefrontGetPeakScratchMemory(GLUSvoid)
+{
+    return g_wavefrontScratch.peak;
+}
+
 GLUSvoid GLUSAPIENTRY glusWavefrontDestroyScene(GLUSscene* scene)
 {
     GLUSobjectList* walker;
@@ -1624,7 +2547,7 @@ GLUSvoid GLUSAPIENTRY glusWavefrontDestroyScene(GLUSscene* scene)
 
         walker = walker->next;
 
-        free(toDelete);
+        glusMemoryFree(toDelete);
     }
 
     memset(scene, 0, sizeof(GLUSscene));
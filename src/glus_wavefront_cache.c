@@ -0,0 +1,983 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "GL/glus.h"
+
+/*
+ * Layout of a cache file:
+ *
+ * Header
+ * Material library table
+ * Material table
+ * Object table
+ * Group table
+ * Attribute and index blobs, each aligned to GLUS_WAVEFRONT_CACHE_ALIGNMENT bytes
+ *
+ * The data is stored in the native byte order and layout. A cache written by a different build or platform is detected by the header and rebuilt.
+ */
+
+#define GLUS_WAVEFRONT_CACHE_VERSION 2
+#define GLUS_WAVEFRONT_CACHE_ALIGNMENT 16
+#define GLUS_WAVEFRONT_CACHE_EXTENSION ".cache"
+
+#define GLUS_WAVEFRONT_CACHE_SCENE 0x1
+#define GLUS_WAVEFRONT_CACHE_EXPAND_VERTICES 0x2
+
+#define GLUS_WAVEFRONT_CACHE_NUMBER_ATTRIBUTES 5
+
+/**
+ * OBJ files with more material libraries are not cached.
+ */
+#define GLUS_WAVEFRONT_CACHE_MAX_LIBRARIES 16
+
+static const GLUSchar g_wavefrontCacheMagic[8] = { 'G', 'L', 'U', 'S', 'O', 'B', 'J', 'C' };
+
+typedef struct _GLUSwavefrontCacheHeader
+{
+    GLUSchar magic[8];
+
+    GLUSuint version;
+
+    GLUSuint flags;
+
+    // Key of the source file.
+    GLUSuint64 sourceSize;
+    GLUSuint64 sourceTime;
+
+    // Size of the cache file, to detect truncated files.
+    GLUSuint64 cacheSize;
+
+    // Native layout.
+    GLUSuint sizeofMaterial;
+    GLUSuint sizeofIndex;
+
+    GLUSuint numberLibraries;
+    GLUSuint numberMaterials;
+    GLUSuint numberObjects;
+    GLUSuint numberGroups;
+
+} GLUSwavefrontCacheHeader;
+
+typedef struct _GLUSwavefrontCacheLibrary
+{
+    GLUSchar filename[GLUS_MAX_STRING];
+
+    // Key of the material library, as the materials are stored in the cache.
+    GLUSuint64 size;
+    GLUSuint64 time;
+
+} GLUSwavefrontCacheLibrary;
+
+typedef struct _GLUSwavefrontCacheMaterial
+{
+    GLUSmaterial material;
+
+    // Index of the next material in the list or -1.
+    GLUSint next;
+
+    GLUSuint reserved;
+
+} GLUSwavefrontCacheMaterial;
+
+typedef struct _GLUSwavefrontCacheObject
+{
+    GLUSchar name[GLUS_MAX_STRING];
+
+    GLUSuint numberVertices;
+
+    // Index of the first material of the object material list or -1.
+    GLUSint materials;
+
+    GLUSuint firstGroup;
+    GLUSuint numberGroups;
+
+    // Offsets of vertices, normals, tangents, bitangents and texture coordinates. Zero, if not available.
+    GLUSuint64 attributes[GLUS_WAVEFRONT_CACHE_NUMBER_ATTRIBUTES];
+
+} GLUSwavefrontCacheObject;
+
+typedef struct _GLUSwavefrontCacheGroup
+{
+    GLUSchar name[GLUS_MAX_STRING];
+    GLUSchar materialName[GLUS_MAX_STRING];
+
+    // Index of the material or -1.
+    GLUSint material;
+
+    GLUSuint numberIndices;
+
+    GLUSenum mode;
+
+    GLUSuint reserved;
+
+    GLUSuint64 indices;
+
+} GLUSwavefrontCacheGroup;
+
+extern GLUSboolean _glusFileMapGetStatus(const GLUSchar* filename, GLUSuint64* size, GLUSuint64* time);
+
+extern GLUSboolean _glusWavefrontGetMaterialLibraries(const GLUSchar* filename, GLUSchar (*names)[GLUS_MAX_STRING], const GLUSuint maxNumberNames, GLUSuint* numberNames);
+
+static const GLUSuint g_wavefrontCacheAttributeComponents[GLUS_WAVEFRONT_CACHE_NUMBER_ATTRIBUTES] = { 4, 3, 3, 3, 2 };
+
+static GLUSfloat** glusWavefrontCacheGetAttribute(GLUSwavefront* wavefront, const GLUSuint attribute)
+{
+    switch (attribute)
+    {
+        case 0:
+            return &wavefront->vertices;
+        case 1:
+            return &wavefront->normals;
+        case 2:
+            return &wavefront->tangents;
+        case 3:
+            return &wavefront->bitangents;
+    }
+
+    return &wavefront->texCoords;
+}
+
+/**
+ * Offset of the material table. The material libraries are stored in front of it.
+ */
+static GLUSuint64 glusWavefrontCacheGetMaterialOffset(const GLUSwavefrontCacheHeader* header)
+{
+    return sizeof(GLUSwavefrontCacheHeader) + (GLUSuint64)header->numberLibraries * sizeof(GLUSwavefrontCacheLibrary);
+}
+
+static GLUSuint64 glusWavefrontCacheAlign(const GLUSuint64 offset)
+{
+    return (offset + GLUS_WAVEFRONT_CACHE_ALIGNMENT - 1) & ~((GLUSuint64)GLUS_WAVEFRONT_CACHE_ALIGNMENT - 1);
+}
+
+static GLUSboolean glusWavefrontCacheBuildFilename(const GLUSchar* filename, GLUSchar* buffer)
+{
+    if (strlen(filename) + strlen(GLUS_WAVEFRONT_CACHE_EXTENSION) >= GLUS_MAX_FILENAME)
+    {
+        return GLUS_FALSE;
+    }
+
+    strcpy(buffer, filename);
+    strcat(buffer, GLUS_WAVEFRONT_CACHE_EXTENSION);
+
+    return GLUS_TRUE;
+}
+
+static GLUSuint glusWavefrontCacheGetFlags(const GLUSwavefrontLoadOptions* options, const GLUSboolean isScene)
+{
+    GLUSuint flags = 0;
+
+    if (isScene)
+    {
+        flags |= GLUS_WAVEFRONT_CACHE_SCENE;
+    }
+
+    if (options && options->expandVertices)
+    {
+        flags |= GLUS_WAVEFRONT_CACHE_EXPAND_VERTICES;
+    }
+
+    return flags;
+}
+
+static GLUSint glusWavefrontCacheFindMaterial(GLUSmaterialList** materials, const GLUSuint numberMaterials, const GLUSmaterialList* material)
+{
+    GLUSuint i;
+
+    if (!material)
+    {
+        return -1;
+    }
+
+    for (i = 0; i < numberMaterials; i++)
+    {
+        if (materials[i] == material)
+        {
+            return (GLUSint)i;
+        }
+    }
+
+    return -1;
+}
+
+static GLUSboolean glusWavefrontCacheWritePadding(FILE* file, GLUSuint64* position, const GLUSuint64 offset)
+{
+    static const GLUSubyte zeros[GLUS_WAVEFRONT_CACHE_ALIGNMENT] = { 0 };
+
+    size_t length = (size_t)(offset - *position);
+
+    if (length > 0 && fwrite(zeros, 1, length, file) != length)
+    {
+        return GLUS_FALSE;
+    }
+
+    *position = offset;
+
+    return GLUS_TRUE;
+}
+
+static GLUSboolean glusWavefrontCacheWrite(FILE* file, GLUSuint64* position, const GLUSvoid* data, const size_t length)
+{
+    if (length > 0 && fwrite(data, 1, length, file) != length)
+    {
+        return GLUS_FALSE;
+    }
+
+    *position += length;
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Collects all materials reachable from the objects. Material lists of several objects can share nodes.
+ */
+static GLUSmaterialList** glusWavefrontCacheCollectMaterials(GLUSwavefront** objects, const GLUSuint numberObjects, GLUSuint* numberMaterials)
+{
+    GLUSmaterialList** materials;
+    GLUSmaterialList*  walker;
+
+    GLUSuint capacity = 0;
+    GLUSuint i;
+
+    *numberMaterials = 0;
+
+    for (i = 0; i < numberObjects; i++)
+    {
+        for (walker = objects[i]->materials; walker; walker = walker->next)
+        {
+            capacity++;
+        }
+    }
+
+    materials = (GLUSmaterialList**)glusMemoryMalloc((capacity + 1) * sizeof(GLUSmaterialList*));
+
+    if (!materials)
+    {
+        return 0;
+    }
+
+    for (i = 0; i < numberObjects; i++)
+    {
+        for (walker = objects[i]->materials; walker; walker = walker->next)
+        {
+            // The remaining list is shared and already collected.
+            if (glusWavefrontCacheFindMaterial(materials, *numberMaterials, walker) >= 0)
+            {
+                break;
+            }
+
+            materials[(*numberMaterials)++] = walker;
+        }
+    }
+
+    return materials;
+}
+
+static GLUSboolean glusWavefrontCacheSave(const GLUSchar* filename, const GLUSuint flags, GLUSwavefront** objects, const GLUSuint numberObjects)
+{
+    GLUSchar cacheFilename[GLUS_MAX_FILENAME];
+
+    GLUSwavefrontCacheHeader header;
+
+    GLUSwavefrontCacheLibrary cacheLibraries[GLUS_WAVEFRONT_CACHE_MAX_LIBRARIES];
+
+    GLUSchar libraryNames[GLUS_WAVEFRONT_CACHE_MAX_LIBRARIES][GLUS_MAX_STRING];
+
+    GLUSwavefrontCacheMaterial* cacheMaterials;
+    GLUSwavefrontCacheObject*   cacheObjects;
+    GLUSwavefrontCacheGroup*    cacheGroups;
+
+    GLUSmaterialList** materials;
+
+    GLUSgroupList* groupWalker;
+
+    GLUSuint numberMaterials;
+    GLUSuint numberGroups = 0;
+
+    GLUSuint64 offset;
+    GLUSuint64 position = 0;
+
+    GLUSuint i, k, groupIndex;
+
+    FILE* file;
+
+    GLUSboolean result;
+
+    memset(&header, 0, sizeof(GLUSwavefrontCacheHeader));
+
+    if (!glusWavefrontCacheBuildFilename(filename, cacheFilename) || !_glusFileMapGetStatus(filename, &header.sourceSize, &header.sourceTime))
+    {
+        return GLUS_FALSE;
+    }
+
+    // The materials are stored in the cache, so changed material libraries have to invalidate it as well.
+
+    if (!_glusWavefrontGetMaterialLibraries(filename, libraryNames, GLUS_WAVEFRONT_CACHE_MAX_LIBRARIES, &header.numberLibraries))
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(cacheLibraries, 0, sizeof(cacheLibraries));
+
+    for (i = 0; i < header.numberLibraries; i++)
+    {
+        strcpy(cacheLibraries[i].filename, libraryNames[i]);
+
+        if (!_glusFileMapGetStatus(cacheLibraries[i].filename, &cacheLibraries[i].size, &cacheLibraries[i].time))
+        {
+            return GLUS_FALSE;
+        }
+    }
+
+    for (i = 0; i < numberObjects; i++)
+    {
+        for (groupWalker = objects[i]->groups; groupWalker; groupWalker = groupWalker->next)
+        {
+            numberGroups++;
+        }
+    }
+
+    materials = glusWavefrontCacheCollectMaterials(objects, numberObjects, &numberMaterials);
+
+    if (!materials)
+    {
+        return GLUS_FALSE;
+    }
+
+    cacheMaterials = (GLUSwavefrontCacheMaterial*)glusMemoryMalloc((numberMaterials + 1) * sizeof(GLUSwavefrontCacheMaterial));
+    cacheObjects   = (GLUSwavefrontCacheObject*)glusMemoryMalloc((numberObjects + 1) * sizeof(GLUSwavefrontCacheObject));
+    cacheGroups    = (GLUSwavefrontCacheGroup*)glusMemoryMalloc((numberGroups + 1) * sizeof(GLUSwavefrontCacheGroup));
+
+    if (!cacheMaterials || !cacheObjects || !cacheGroups)
+    {
+        glusMemoryFree(cacheMaterials);
+        glusMemoryFree(cacheObjects);
+        glusMemoryFree(cacheGroups);
+
+        glusMemoryFree(materials);
+
+        return GLUS_FALSE;
+    }
+
+    memset(cacheMaterials, 0, numberMaterials * sizeof(GLUSwavefrontCacheMaterial));
+    memset(cacheObjects, 0, numberObjects * sizeof(GLUSwavefrontCacheObject));
+    memset(cacheGroups, 0, numberGroups * sizeof(GLUSwavefrontCacheGroup));
+
+    // Tables
+
+    for (i = 0; i < numberMaterials; i++)
+    {
+        cacheMaterials[i].material = materials[i]->material;
+        cacheMaterials[i].next     = glusWavefrontCacheFindMaterial(materials, numberMaterials, materials[i]->next);
+
+        // OpenGL objects are not valid in another process.
+        cacheMaterials[i].material.emissiveTextureName     = 0;
+        cacheMaterials[i].material.ambientTextureName      = 0;
+        cacheMaterials[i].material.diffuseTextureName      = 0;
+        cacheMaterials[i].material.specularTextureName     = 0;
+        cacheMaterials[i].material.transparencyTextureName = 0;
+        cacheMaterials[i].material.bumpTextureName         = 0;
+    }
+
+    offset = glusWavefrontCacheGetMaterialOffset(&header) + numberMaterials * sizeof(GLUSwavefrontCacheMaterial) + numberObjects * sizeof(GLUSwavefrontCacheObject) + numberGroups * sizeof(GLUSwavefrontCacheGroup);
+
+    groupIndex = 0;
+
+    for (i = 0; i < numberObjects; i++)
+    {
+        strcpy(cacheObjects[i].name, objects[i]->name);
+
+        cacheObjects[i].numberVertices = objects[i]->numberVertices;
+        cacheObjects[i].materials      = glusWavefrontCacheFindMaterial(materials, numberMaterials, objects[i]->materials);
+        cacheObjects[i].firstGroup     = groupIndex;
+
+        for (k = 0; k < GLUS_WAVEFRONT_CACHE_NUMBER_ATTRIBUTES; k++)
+        {
+            if (*glusWavefrontCacheGetAttribute(objects[i], k) && objects[i]->numberVertices > 0)
+            {
+                offset = glusWavefrontCacheAlign(offset);
+
+                cacheObjects[i].attributes[k] = offset;
+
+                offset += (GLUSuint64)objects[i]->numberVertices * g_wavefrontCacheAttributeComponents[k] * sizeof(GLUSfloat);
+            }
+        }
+
+        for (groupWalker = objects[i]->groups; groupWalker; groupWalker = groupWalker->next)
+        {
+            GLUSwavefrontCacheGroup* cacheGroup = &cacheGroups[groupIndex++];
+
+            strcpy(cacheGroup->name, groupWalker->group.name);
+            strcpy(cacheGroup->materialName, groupWalker->group.materialName);
+
+            cacheGroup->material      = -1;
+            cacheGroup->numberIndices = groupWalker->group.numberIndices;
+            cacheGroup->mode          = groupWalker->group.mode;
+
+            for (k = 0; k < numberMaterials && groupWalker->group.material; k++)
+            {
+                if (&materials[k]->material == groupWalker->group.material)
+                {
+                    cacheGroup->material = (GLUSint)k;
+
+                    break;
+                }
+            }
+
+            if (groupWalker->group.indices && groupWalker->group.numberIndices > 0)
+            {
+                offset = glusWavefrontCacheAlign(offset);
+
+                cacheGroup->indices = offset;
+
+                offset += (GLUSuint64)groupWalker->group.numberIndices * sizeof(GLUSindex);
+            }
+        }
+
+        cacheObjects[i].numberGroups = groupIndex - cacheObjects[i].firstGroup;
+    }
+
+    memcpy(header.magic, g_wavefrontCacheMagic, sizeof(g_wavefrontCacheMagic));
+    header.version         = GLUS_WAVEFRONT_CACHE_VERSION;
+    header.flags           = flags;
+    header.cacheSize       = offset;
+    header.sizeofMaterial  = (GLUSuint)sizeof(GLUSmaterial);
+    header.sizeofIndex     = (GLUSuint)sizeof(GLUSindex);
+    header.numberMaterials = numberMaterials;
+    header.numberObjects   = numberObjects;
+    header.numberGroups    = numberGroups;
+
+    glusMemoryFree(materials);
+
+    file = glusFileOpen(cacheFilename, "wb");
+
+    if (!file)
+    {
+        glusMemoryFree(cacheMaterials);
+        glusMemoryFree(cacheObjects);
+        glusMemoryFree(cacheGroups);
+
+        return GLUS_FALSE;
+    }
+
+    result = glusWavefrontCacheWrite(file, &position, &header, sizeof(GLUSwavefrontCacheHeader)) && glusWavefrontCacheWrite(file, &position, cacheLibraries, header.numberLibraries * sizeof(GLUSwavefrontCacheLibrary)) && glusWavefrontCacheWrite(file, &position, cacheMaterials, numberMaterials * sizeof(GLUSwavefrontCacheMaterial)) && glusWavefrontCacheWrite(file, &position, cacheObjects, numberObjects * sizeof(GLUSwavefrontCacheObject)) && glusWavefrontCacheWrite(file, &position, cacheGroups, numberGroups * sizeof(GLUSwavefrontCacheGroup));
+
+    // Blobs in the same order as the offsets were assigned.
+
+    groupIndex = 0;
+
+    for (i = 0; i < numberObjects && result; i++)
+    {
+        for (k = 0; k < GLUS_WAVEFRONT_CACHE_NUMBER_ATTRIBUTES && result; k++)
+        {
+            if (cacheObjects[i].attributes[k])
+            {
+                result = glusWavefrontCacheWritePadding(file, &position, cacheObjects[i].attributes[k]) && glusWavefrontCacheWrite(file, &position, *glusWavefrontCacheGetAttribute(objects[i], k), (size_t)objects[i]->numberVertices * g_wavefrontCacheAttributeComponents[k] * sizeof(GLUSfloat));
+            }
+        }
+
+        for (groupWalker = objects[i]->groups; groupWalker && result; groupWalker = groupWalker->next)
+        {
+            const GLUSwavefrontCacheGroup* cacheGroup = &cacheGroups[groupIndex++];
+
+            if (cacheGroup->indices)
+            {
+                result = glusWavefrontCacheWritePadding(file, &position, cacheGroup->indices) && glusWavefrontCacheWrite(file, &position, groupWalker->group.indices, (size_t)groupWalker->group.numberIndices * sizeof(GLUSindex));
+            }
+        }
+    }
+
+    glusMemoryFree(cacheMaterials);
+    glusMemoryFree(cacheObjects);
+    glusMemoryFree(cacheGroups);
+
+    if (fclose(file) != 0)
+    {
+        result = GLUS_FALSE;
+    }
+
+    // A partially written file is rejected, as the size does not match.
+    return result && position == header.cacheSize;
+}
+
+static GLUSboolean glusWavefrontCacheCheckRange(const GLUSmappedfile* mappedFile, const GLUSuint64 offset, const GLUSuint64 length)
+{
+    return offset % GLUS_WAVEFRONT_CACHE_ALIGNMENT == 0 && offset <= (GLUSuint64)mappedFile->length && length <= (GLUSuint64)mappedFile->length - offset;
+}
+
+static GLUSvoid* glusWavefrontCacheCopy(const GLUSmappedfile* mappedFile, const GLUSuint64 offset, const GLUSuint64 length)
+{
+    GLUSvoid* data;
+
+    if (!glusWavefrontCacheCheckRange(mappedFile, offset, length))
+    {
+        return 0;
+    }
+
+    data = glusMemoryMalloc((size_t)length);
+
+    if (!data)
+    {
+        return 0;
+    }
+
+    memcpy(data, mappedFile->data + offset, (size_t)length);
+
+    return data;
+}
+
+/**
+ * Checks, if the material libraries are unchanged. The library table has to be in the mapped file.
+ */
+static GLUSboolean glusWavefrontCacheCheckLibraries(const GLUSmappedfile* mappedFile, const GLUSwavefrontCacheHeader* header)
+{
+    const GLUSwavefrontCacheLibrary* cacheLibraries = (const GLUSwavefrontCacheLibrary*)(mappedFile->data + sizeof(GLUSwavefrontCacheHeader));
+
+    GLUSuint64 size;
+    GLUSuint64 time;
+
+    GLUSuint i;
+
+    if (header->numberLibraries > GLUS_WAVEFRONT_CACHE_MAX_LIBRARIES)
+    {
+        return GLUS_FALSE;
+    }
+
+    for (i = 0; i < header->numberLibraries; i++)
+    {
+        if (!memchr(cacheLibraries[i].filename, '\0', GLUS_MAX_STRING) || !_glusFileMapGetStatus(cacheLibraries[i].filename, &size, &time) || size != cacheLibraries[i].size || time != cacheLibraries[i].time)
+        {
+            return GLUS_FALSE;
+        }
+    }
+
+    return GLUS_TRUE;
+}
+
+static GLUSboolean glusWavefrontCacheLoadObject(const GLUSmappedfile* mappedFile, const GLUSwavefrontCacheHeader* header, const GLUSwavefrontCacheObject* cacheObject, GLUSmaterialList** materials, GLUSwavefront* wavefront)
+{
+    const GLUSwavefrontCacheGroup* cacheGroups = (const GLUSwavefrontCacheGroup*)(mappedFile->data + glusWavefrontCacheGetMaterialOffset(header) + header->numberMaterials * sizeof(GLUSwavefrontCacheMaterial) + header->numberObjects * sizeof(GLUSwavefrontCacheObject));
+
+    GLUSgroupList* currentGroupList = 0;
+
+    GLUSuint i;
+
+    memset(wavefront, 0, sizeof(GLUSwavefront));
+
+    if (cacheObject->firstGroup > header->numberGroups || cacheObject->numberGroups > header->numberGroups - cacheObject->firstGroup || cacheObject->materials >= (GLUSint)header->numberMaterials)
+    {
+        return GLUS_FALSE;
+    }
+
+    memcpy(wavefront->name, cacheObject->name, GLUS_MAX_STRING);
+    wavefront->name[GLUS_MAX_STRING - 1] = '\0';
+
+    wavefront->numberVertices = cacheObject->numberVertices;
+    wavefront->materials      = (cacheObject->materials >= 0) ? materials[cacheObject->materials] : 0;
+
+    for (i = 0; i < GLUS_WAVEFRONT_CACHE_NUMBER_ATTRIBUTES; i++)
+    {
+        if (cacheObject->attributes[i])
+        {
+            GLUSfloat* attribute = (GLUSfloat*)glusWavefrontCacheCopy(mappedFile, cacheObject->attributes[i], (GLUSuint64)cacheObject->numberVertices * g_wavefrontCacheAttributeComponents[i] * sizeof(GLUSfloat));
+
+            if (!attribute)
+            {
+                return GLUS_FALSE;
+            }
+
+            *glusWavefrontCacheGetAttribute(wavefront, i) = attribute;
+        }
+    }
+
+    for (i = 0; i < cacheObject->numberGroups; i++)
+    {
+        const GLUSwavefrontCacheGroup* cacheGroup = &cacheGroups[cacheObject->firstGroup + i];
+
+        GLUSgroupList* newGroupList;
+
+        if (cacheGroup->material >= (GLUSint)header->numberMaterials)
+        {
+            return GLUS_FALSE;
+        }
+
+        newGroupList = (GLUSgroupList*)glusMemoryMalloc(sizeof(GLUSgroupList));
+
+        if (!newGroupList)
+        {
+            return GLUS_FALSE;
+        }
+
+        memset(newGroupList, 0, sizeof(GLUSgroupList));
+
+        if (currentGroupList)
+        {
+            currentGroupList->next = newGroupList;
+        }
+        else
+        {
+            wavefront->groups = newGroupList;
+        }
+
+        currentGroupList = newGroupList;
+
+        memcpy(newGroupList->group.name, cacheGroup->name, GLUS_MAX_STRING);
+        newGroupList->group.name[GLUS_MAX_STRING - 1] = '\0';
+        memcpy(newGroupList->group.materialName, cacheGroup->materialName, GLUS_MAX_STRING);
+        newGroupList->group.materialName[GLUS_MAX_STRING - 1] = '\0';
+
+        newGroupList->group.material      = (cacheGroup->material >= 0) ? &materials[cacheGroup->material]->material : 0;
+        newGroupList->group.numberIndices = cacheGroup->numberIndices;
+        newGroupList->group.mode          = cacheGroup->mode;
+
+        if (cacheGroup->indices)
+        {
+            newGroupList->group.indices = (GLUSindex*)glusWavefrontCacheCopy(mappedFile, cacheGroup->indices, (GLUSuint64)cacheGroup->numberIndices * sizeof(GLUSindex));
+
+            if (!newGroupList->group.indices)
+            {
+                return GLUS_FALSE;
+            }
+        }
+        else if (cacheGroup->numberIndices > 0)
+        {
+            return GLUS_FALSE;
+        }
+    }
+
+    return GLUS_TRUE;
+}
+
+static GLUSboolean glusWavefrontCacheLoad(const GLUSchar* filename, const GLUSuint flags, GLUSwavefront** objects, const GLUSuint numberObjects, GLUSuint* loadedObjects, GLUSmaterialList*** materials, GLUSuint* numberMaterials)
+{
+    GLUSchar cacheFilename[GLUS_MAX_FILENAME];
+
+    GLUSmappedfile mappedFile;
+
+    GLUSwavefrontCacheHeader          header;
+    const GLUSwavefrontCacheMaterial* cacheMaterials;
+    const GLUSwavefrontCacheObject*   cacheObjects;
+
+    GLUSuint64 sourceSize;
+    GLUSuint64 sourceTime;
+
+    GLUSuint64 tableSize;
+
+    GLUSuint i;
+
+    *loadedObjects   = 0;
+    *materials       = 0;
+    *numberMaterials = 0;
+
+    if (!glusWavefrontCacheBuildFilename(filename, cacheFilename) || !_glusFileMapGetStatus(filename, &sourceSize, &sourceTime))
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!glusFileMap(cacheFilename, &mappedFile))
+    {
+        return GLUS_FALSE;
+    }
+
+    if (mappedFile.length < sizeof(GLUSwavefrontCacheHeader))
+    {
+        glusFileUnmap(&mappedFile);
+
+        return GLUS_FALSE;
+    }
+
+    memcpy(&header, mappedFile.data, sizeof(GLUSwavefrontCacheHeader));
+
+    tableSize = glusWavefrontCacheGetMaterialOffset(&header) + (GLUSuint64)header.numberMaterials * sizeof(GLUSwavefrontCacheMaterial) + (GLUSuint64)header.numberObjects * sizeof(GLUSwavefrontCacheObject) + (GLUSuint64)header.numberGroups * sizeof(GLUSwavefrontCacheGroup);
+
+    if (memcmp(header.magic, g_wavefrontCacheMagic, sizeof(g_wavefrontCacheMagic)) != 0 || header.version != GLUS_WAVEFRONT_CACHE_VERSION || header.flags != flags || header.sourceSize != sourceSize || header.sourceTime != sourceTime || header.cacheSize != (GLUSuint64)mappedFile.length || header.sizeofMaterial != sizeof(GLUSmaterial) || header.sizeofIndex != sizeof(GLUSindex) || tableSize > header.cacheSize || header.numberObjects == 0 || header.numberObjects > numberObjects || !glusWavefrontCacheCheckLibraries(&mappedFile, &header))
+    {
+        glusFileUnmap(&mappedFile);
+
+        return GLUS_FALSE;
+    }
+
+    cacheMaterials = (const GLUSwavefrontCacheMaterial*)(mappedFile.data + glusWavefrontCacheGetMaterialOffset(&header));
+    cacheObjects   = (const GLUSwavefrontCacheObject*)(mappedFile.data + glusWavefrontCacheGetMaterialOffset(&header) + header.numberMaterials * sizeof(GLUSwavefrontCacheMaterial));
+
+    // Materials are created first, as the objects and groups reference them.
+
+    *materials = (GLUSmaterialList**)glusMemoryMalloc((header.numberMaterials + 1) * sizeof(GLUSmaterialList*));
+
+    if (!*materials)
+    {
+        glusFileUnmap(&mappedFile);
+
+        return GLUS_FALSE;
+    }
+
+    for (i = 0; i < header.numberMaterials; i++)
+    {
+        (*materials)[i] = (GLUSmaterialList*)glusMemoryMalloc(sizeof(GLUSmaterialList));
+
+        if (!(*materials)[i])
+        {
+            glusFileUnmap(&mappedFile);
+
+            return GLUS_FALSE;
+        }
+
+        (*numberMaterials)++;
+
+        (*materials)[i]->material = cacheMaterials[i].material;
+        (*materials)[i]->next     = 0;
+    }
+
+    for (i = 0; i < header.numberMaterials; i++)
+    {
+        if (cacheMaterials[i].next >= (GLUSint)header.numberMaterials)
+        {
+            glusFileUnmap(&mappedFile);
+
+            return GLUS_FALSE;
+        }
+
+        (*materials)[i]->next = (cacheMaterials[i].next >= 0) ? (*materials)[cacheMaterials[i].next] : 0;
+    }
+
+    for (i = 0; i < header.numberObjects; i++)
+    {
+        (*loadedObjects)++;
+
+        if (!glusWavefrontCacheLoadObject(&mappedFile, &header, &cacheObjects[i], *materials, objects[i]))
+        {
+            glusFileUnmap(&mappedFile);
+
+            return GLUS_FALSE;
+        }
+    }
+
+    glusFileUnmap(&mappedFile);
+
+    return GLUS_TRUE;
+}
+
+/**
+ * Frees objects and materials of a failed cache load. Materials are freed separately, as they might be shared by the objects.
+ */
+static GLUSvoid glusWavefrontCacheDestroy(GLUSwavefront** objects, const GLUSuint numberObjects, GLUSmaterialList** materials, const GLUSuint numberMaterials)
+{
+    GLUSuint i;
+
+    for (i = 0; i < numberObjects; i++)
+    {
+        objects[i]->materials = 0;
+
+        glusWavefrontDestroy(objects[i]);
+    }
+
+    if (materials)
+    {
+        for (i = 0; i < numberMaterials; i++)
+        {
+            glusMemoryFree(materials[i]);
+        }
+
+        glusMemoryFree(materials);
+    }
+}
+
+GLUSboolean _glusWavefrontCacheLoad(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSwavefront* wavefront)
+{
+    GLUSmaterialList** materials;
+
+    GLUSuint numberMaterials;
+    GLUSuint loadedObjects;
+
+    if (!filename || !wavefront)
+    {
+        return GLUS_FALSE;
+    }
+
+    if (!glusWavefrontCacheLoad(filename, glusWavefrontCacheGetFlags(options, GLUS_FALSE), &wavefront, 1, &loadedObjects, &materials, &numberMaterials))
+    {
+        glusWavefrontCacheDestroy(&wavefront, loadedObjects, materials, numberMaterials);
+
+        memset(wavefront, 0, sizeof(GLUSwavefront));
+
+        return GLUS_FALSE;
+    }
+
+    glusMemoryFree(materials);
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean _glusWavefrontCacheLoadScene(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSscene* scene)
+{
+    GLUSchar cacheFilename[GLUS_MAX_FILENAME];
+
+    GLUSmappedfile mappedFile;
+
+    GLUSwavefrontCacheHeader header;
+
+    GLUSwavefront** objects;
+
+    GLUSobjectList* currentObjectList = 0;
+
+    GLUSmaterialList** materials;
+
+    GLUSuint numberMaterials;
+    GLUSuint loadedObjects;
+
+    GLUSuint i;
+
+    if (!filename || !scene)
+    {
+        return GLUS_FALSE;
+    }
+
+    memset(scene, 0, sizeof(GLUSscene));
+
+    // The number of objects is needed in advance.
+
+    if (!glusWavefrontCacheBuildFilename(filename, cacheFilename) || !glusFileMap(cacheFilename, &mappedFile))
+    {
+        return GLUS_FALSE;
+    }
+
+    if (mappedFile.length < sizeof(GLUSwavefrontCacheHeader))
+    {
+        glusFileUnmap(&mappedFile);
+
+        return GLUS_FALSE;
+    }
+
+    memcpy(&header, mappedFile.data, sizeof(GLUSwavefrontCacheHeader));
+
+    glusFileUnmap(&mappedFile);
+
+    if (header.numberObjects == 0 || header.numberObjects > (GLUSuint)(((size_t)-1) / sizeof(GLUSobjectList)))
+    {
+        return GLUS_FALSE;
+    }
+
+    objects = (GLUSwavefront**)glusMemoryMalloc(header.numberObjects * sizeof(GLUSwavefront*));
+
+    if (!objects)
+    {
+        return GLUS_FALSE;
+    }
+
+    for (i = 0; i < header.numberObjects; i++)
+    {
+        GLUSobjectList* newObjectList = (GLUSobjectList*)glusMemoryMalloc(sizeof(GLUSobjectList));
+
+        if (!newObjectList)
+        {
+            glusWavefrontDestroyScene(scene);
+
+            glusMemoryFree(objects);
+
+            return GLUS_FALSE;
+        }
+
+        memset(newObjectList, 0, sizeof(GLUSobjectList));
+
+        if (currentObjectList)
+        {
+            currentObjectList->next = newObjectList;
+        }
+        else
+        {
+            scene->objectList = newObjectList;
+        }
+
+        currentObjectList = newObjectList;
+
+        objects[i] = &newObjectList->object;
+    }
+
+    if (!glusWavefrontCacheLoad(filename, glusWavefrontCacheGetFlags(options, GLUS_TRUE), objects, header.numberObjects, &loadedObjects, &materials, &numberMaterials))
+    {
+        glusWavefrontCacheDestroy(objects, loadedObjects, materials, numberMaterials);
+
+        // Only the object list is left.
+        glusWavefrontDestroyScene(scene);
+
+        glusMemoryFree(objects);
+
+        return GLUS_FALSE;
+    }
+
+    glusMemoryFree(materials);
+
+    glusMemoryFree(objects);
+
+    return GLUS_TRUE;
+}
+
+GLUSboolean _glusWavefrontCacheSave(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, GLUSwavefront* wavefront)
+{
+    if (!filename || !wavefront)
+    {
+        return GLUS_FALSE;
+    }
+
+    return glusWavefrontCacheSave(filename, glusWavefrontCacheGetFlags(options, GLUS_FALSE), &wavefront, 1);
+}
+
+GLUSboolean _glusWavefrontCacheSaveScene(const GLUSchar* filename, const GLUSwavefrontLoadOptions* options, const GLUSscene* scene)
+{
+    GLUSwavefront** objects;
+
+    GLUSobjectList* walker;
+
+    GLUSuint numberObjects = 0;
+
+    GLUSboolean result;
+
+    if (!filename || !scene || !scene->objectList)
+    {
+        return GLUS_FALSE;
+    }
+
+    for (walker = scene->objectList; walker; walker = walker->next)
+    {
+        numberObjects++;
+    }
+
+    objects = (GLUSwavefront**)glusMemoryMalloc(numberObjects * sizeof(GLUSwavefront*));
+
+    if (!objects)
+    {
+        return GLUS_FALSE;
+    }
+
+    numberObjects = 0;
+
+    for (walker = scene->objectList; walker; walker = walker->next)
+    {
+        objects[numberObjects++] = &walker->object;
+    }
+
+    result = glusWavefrontCacheSave(filename, glusWavefrontCacheGetFlags(options, GLUS_TRUE), objects, numberObjects);
+
+    glusMemoryFree(objects);
+
+    return result;
+}
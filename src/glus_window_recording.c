@@ -29,7 +29,7 @@ static GLUSint   g_currentFrame  = 0;
 static GLUSint   g_numberFrames  = 0;
 static GLUSfloat g_recordingTime = 0.0f;
 
-static GLUStgaimage g_tgaimage = {0, 0, 0, 0, 0};
+static GLUStgaimage g_tgaimage = {0, 0, 0, 0, 0, 0};
 
 GLUSint _glusWindowGetCurrentRecordingFrame(GLUSvoid)
 {